@@ -0,0 +1,16 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file benchmark/__init__.py
+# @brief scalable synthetic benchmarks for INSTA
+
+# run (and its torch dependency) is imported on demand; generation is
+# pure stdlib so designs can be produced on hosts without the env
+from .generate import generate_design
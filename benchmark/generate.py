@@ -0,0 +1,194 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file benchmark/generate.py
+# @brief synthetic insta_inputs generator with scalable size knobs
+
+import os
+import csv
+import random
+import argparse
+
+# Header rows match the extractor's output byte for byte so the
+# generated designs go through the exact same parser paths as real ones
+_CELL_ARC_HEADER = ['from_pin.full_name', 'to_pin.full_name', 'sense',
+                    'delay_max_rise', 'delay_max_fall',
+                    'variation_delay_max_rise.mean',
+                    'variation_delay_max_rise.std_dev',
+                    'variation_delay_max_fall.mean',
+                    'variation_delay_max_fall.std_dev']
+_NET_ARC_HEADER = ['from_pin.full_name', 'to_pin.full_name',
+                   'delay_max_rise', 'delay_max_fall',
+                   'variation_delay_max_rise.mean',
+                   'variation_delay_max_rise.std_dev',
+                   'variation_delay_max_fall.mean',
+                   'variation_delay_max_fall.std_dev']
+_EP_HEADER = ['ep_name', 'ep_max_rise_slack', 'ep_max_fall_slack',
+              'ep_max_rise_arrival', 'ep_max_fall_arrival', 'sp_name',
+              'launch_clock_latency', 'clock_latency_mean',
+              'clock_latency_std', 'path_required', 'path_arrival',
+              'path_slack', 'path_num_points', 'path_crpr', 'ep_ck_name',
+              'rise_fall']
+_SP_HEADER = ['sp_name', 'launch_clock_latency', 'clock_latency_mean',
+              'clock_latency_std']
+
+
+def generate_design(out_dir, num_pins=100000, depth=50, inputs_per_cell=2,
+                    clock_domains=1, seed=0):
+    """
+    Emit a synthetic insta_inputs design of roughly num_pins pins
+
+    The graph is a layered DAG shaped like a real datapath: a bank of
+    launch registers (CLK -> Q rising_edge arcs), `depth` combinational
+    stages of {inputs_per_cell}-input cells (positive_unate arcs with
+    POCV stds), nets where each sink picks a uniform random driver from
+    the previous stage (so fanout follows the natural multinomial
+    distribution with mean inputs_per_cell), and a bank of capture
+    registers whose D pins are the endpoints. Registers are spread
+    round-robin over clock_domains, each with its own latency and
+    period, so per-clock CPPR and grouping paths get exercised.
+
+    Endpoint required/arrival columns are self-consistent estimates
+    (latency + sum of expected stage delays), tight enough that the
+    design times with realistic positive and negative slack; exact
+    values do not matter for performance benchmarking, only for the
+    slack planes to be finite.
+
+    Returns the stage width actually used.
+    """
+    rng = random.Random(seed)
+    os.makedirs(out_dir, exist_ok=True)
+
+    # ~2 pins per register, (inputs_per_cell + 1) per combinational cell
+    width = max(4, num_pins // ((inputs_per_cell + 1) * depth + 4))
+    in_names = [chr(ord('A') + i) for i in range(inputs_per_cell)]
+
+    periods = [500.0 + 100.0 * d for d in range(clock_domains)]
+    latencies = [100.0 + 40.0 * d for d in range(clock_domains)]
+
+    def _reg_domain(index):
+        return index % clock_domains
+
+    all_pins = []
+    cell_rows = []
+    net_rows = []
+
+    # Launch registers
+    launch_q = []
+    sp_rows = []
+    for i in range(width):
+        domain = _reg_domain(i)
+        clk = f'launch_reg_{i}/CLK'
+        q = f'launch_reg_{i}/Q'
+        latency = latencies[domain] + rng.uniform(-5.0, 5.0)
+        delay = rng.uniform(40.0, 55.0)
+        cell_rows.append([clk, q, 'rising_edge',
+                          f'{delay:.6f}', f'{delay * 1.01:.6f}',
+                          f'{delay:.6f}', f'{delay * 0.02:.6f}',
+                          f'{delay * 1.01:.6f}', f'{delay * 0.02:.6f}'])
+        sp_rows.append([clk, f'{latency:.6f}', f'{latency:.6f}',
+                        f'{latency * 0.01:.6f}'])
+        all_pins.extend([clk, q])
+        launch_q.append(q)
+
+    # Combinational stages
+    prev_outputs = launch_q
+    mean_stage_delay = 0.0
+    for stage in range(depth):
+        outputs = []
+        for i in range(width):
+            cell = f'g{stage}_{i}'
+            y = f'{cell}/Y'
+            for pin in in_names:
+                a = f'{cell}/{pin}'
+                driver = rng.choice(prev_outputs)
+                net_delay = rng.uniform(0.1, 2.0)
+                net_rows.append([driver, a,
+                                 f'{net_delay:.6f}', f'{net_delay * 1.01:.6f}',
+                                 f'{net_delay:.6f}', f'{net_delay * 0.05:.6f}',
+                                 f'{net_delay * 1.01:.6f}', f'{net_delay * 0.05:.6f}'])
+                delay = rng.uniform(10.0, 30.0)
+                cell_rows.append([a, y, 'positive_unate',
+                                  f'{delay:.6f}', f'{delay * 1.02:.6f}',
+                                  f'{delay:.6f}', f'{delay * 0.03:.6f}',
+                                  f'{delay * 1.02:.6f}', f'{delay * 0.03:.6f}'])
+                all_pins.append(a)
+            all_pins.append(y)
+            outputs.append(y)
+        prev_outputs = outputs
+        mean_stage_delay += 20.0 + 1.05  # expected cell + net delay
+
+    # Capture registers: D pins are the endpoints
+    ep_rows = []
+    for i in range(width):
+        domain = _reg_domain(i)
+        d = f'capture_reg_{i}/D'
+        ck = f'capture_reg_{i}/CLK'
+        driver = rng.choice(prev_outputs)
+        net_delay = rng.uniform(0.1, 2.0)
+        net_rows.append([driver, d,
+                         f'{net_delay:.6f}', f'{net_delay * 1.01:.6f}',
+                         f'{net_delay:.6f}', f'{net_delay * 0.05:.6f}',
+                         f'{net_delay * 1.01:.6f}', f'{net_delay * 0.05:.6f}'])
+        all_pins.extend([d])
+
+        sp_index = rng.randrange(width)
+        sp_name = f'launch_reg_{sp_index}/CLK'
+        latency = latencies[_reg_domain(sp_index)]
+        arrival = latency + 47.0 + mean_stage_delay + rng.uniform(-30.0, 30.0)
+        required = periods[domain] + latencies[domain]
+        slack = required - arrival
+        for rise_fall in ('rise', 'fall'):
+            ep_rows.append([d, f'{slack:.6f}', f'{slack:.6f}',
+                            f'{arrival:.6f}', f'{arrival:.6f}', sp_name,
+                            f'{latency:.6f}', f'{latency:.6f}',
+                            f'{latency * 0.01:.6f}', f'{required:.6f}',
+                            f'{arrival:.6f}', f'{slack:.6f}',
+                            str(2 * depth + 3), '0.000000', ck, rise_fall])
+
+    def _write(name, header, rows):
+        with open(os.path.join(out_dir, name), 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(header)
+            writer.writerows(rows)
+
+    _write('cell_arcs.csv', _CELL_ARC_HEADER, cell_rows)
+    _write('net_arcs.csv', _NET_ARC_HEADER, net_rows)
+    _write('sp_attributes.csv', _SP_HEADER, sp_rows)
+    _write('ep_attributes.csv', _EP_HEADER, ep_rows)
+    _write('no_timing_pins.csv', ['full_name', 'max_slack'], [])
+    _write('all_between_sp_ep_pins.csv', ['full_name'],
+           [[pin] for pin in all_pins])
+
+    print(f'[generate] {out_dir}: {len(all_pins)} pins, '
+          f'{len(cell_rows)} cell arcs, {len(net_rows)} net arcs, '
+          f'{len(ep_rows) // 2} endpoints, width {width}, depth {depth}, '
+          f'{clock_domains} clock domains')
+    return width
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate a synthetic insta_inputs design')
+    parser.add_argument('out_dir', help='design directory (insta_inputs/ is created inside)')
+    parser.add_argument('--num-pins', type=int, default=100000)
+    parser.add_argument('--depth', type=int, default=50)
+    parser.add_argument('--inputs-per-cell', type=int, default=2)
+    parser.add_argument('--clock-domains', type=int, default=1)
+    parser.add_argument('--seed', type=int, default=0)
+    args = parser.parse_args()
+    generate_design(os.path.join(args.out_dir, 'insta_inputs'),
+                    num_pins=args.num_pins, depth=args.depth,
+                    inputs_per_cell=args.inputs_per_cell,
+                    clock_domains=args.clock_domains, seed=args.seed)
+
+
+if __name__ == '__main__':
+    main()
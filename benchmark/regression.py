@@ -0,0 +1,183 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file benchmark/regression.py
+# @brief performance regression harness with per-stage budgets
+
+import os
+import csv
+import json
+import time
+import argparse
+
+import torch
+
+from src.core.insta import INSTA
+
+
+def _pearson(a, b):
+    a = a - a.mean()
+    b = b - b.mean()
+    return float((a * b).sum() / (a.norm() * b.norm() + 1e-12))
+
+
+class _StageTimer:
+    """
+    Wall time + peak GPU memory per stage, without extra syncs
+
+    Kernel-level accounting inside the eval sweep comes from the
+    CUDA-event LevelProfiler; this only brackets whole stages, where the
+    one synchronize per stage boundary is the measurement we want.
+    """
+
+    def __init__(self):
+        self.stages = {}
+        self._name = None
+        self._t0 = None
+
+    def begin(self, name):
+        if torch.cuda.is_available():
+            torch.cuda.synchronize()
+            torch.cuda.reset_peak_memory_stats()
+        self._name = name
+        self._t0 = time.perf_counter()
+
+    def end(self):
+        if torch.cuda.is_available():
+            torch.cuda.synchronize()
+        self.stages[self._name] = {
+            'wall_s': time.perf_counter() - self._t0,
+            'gpu_gb': (torch.cuda.max_memory_allocated() / 1e9
+                       if torch.cuda.is_available() else 0.0)
+        }
+
+
+def run_regression(design_path='testcase/aes_cipher_top', design_name='aes',
+                   budget_path='benchmark/budgets.json',
+                   tolerance=0.10, min_correlation=0.99,
+                   update_budgets=False):
+    """
+    Guard the release against performance and accuracy regressions
+
+    Runs do_initialization, do_eval_propagation and do_diff_propagation
+    (plus a backward) on the checked-in testcase, correlates predicted
+    endpoint slacks against the golden outputs/plots/anal.csv, and
+    compares per-stage wall time and peak GPU memory against the
+    recorded budgets. A stage more than `tolerance` (default 10%) over
+    its budget fails the run with a non-zero exit; accuracy failures
+    (Pearson r below min_correlation) fail regardless of budgets. When
+    no budget file exists — or with update_budgets — the measured
+    numbers are written as the new baseline and only accuracy is
+    enforced.
+
+    Returns the measurement dict (stages, correlation, profiler totals).
+    """
+    timer = _StageTimer()
+    insta = INSTA()
+    insta.do_set_insta_path(design_path, design_name)
+
+    timer.begin('init')
+    assert insta.do_initialization(), 'initialization failed'
+    timer.end()
+
+    # Eval runs under the CUDA-event profiler: kernel-time accounting
+    # comes from resolved event pairs, not extra host syncs
+    timer.begin('eval_prop')
+    eval_report = insta.do_profiled_propagation(top=10)
+    timer.end()
+
+    timer.begin('diff_prop')
+    assert insta.do_diff_propagation()
+    (-insta.tns).backward()
+    timer.end()
+
+    # --- accuracy: slack correlation against the golden artifacts -------
+    golden_path = os.path.join(design_path, 'outputs', 'plots', 'anal.csv')
+    assert os.path.exists(golden_path), f'missing golden artifact {golden_path}'
+    golden_slacks, pred_slacks = [], []
+    rise_slack = insta.timing_tensors['Gid_2_rise_slack'].to(torch.float32).cpu()
+    fall_slack = insta.timing_tensors['Gid_2_fall_slack'].to(torch.float32).cpu()
+    with open(golden_path) as f:
+        for row in csv.DictReader(f):
+            ep_name = row['epName']
+            if ep_name not in insta.pinName_2_Gid:
+                continue
+            gid = insta.pinName_2_Gid[ep_name]
+            plane = rise_slack if row['riseFall'] == 'rise' else fall_slack
+            value = float(plane[gid])
+            if value == float('-inf'):
+                continue
+            golden_slacks.append(float(row['true_slack']))
+            pred_slacks.append(value)
+    assert len(golden_slacks) > 0, 'no golden endpoints matched the loaded design'
+    correlation = _pearson(torch.tensor(golden_slacks), torch.tensor(pred_slacks))
+    print(f'[regression] slack correlation vs golden: r = {correlation:.5f} '
+          f'over {len(golden_slacks)} endpoints')
+
+    result = {
+        'stages': timer.stages,
+        'eval_kernel_ms': eval_report['total_ms'],
+        'correlation': correlation,
+        'num_golden_endpoints': len(golden_slacks)
+    }
+
+    failures = []
+    if correlation < min_correlation:
+        failures.append(f'slack correlation {correlation:.5f} '
+                        f'< required {min_correlation}')
+
+    # --- budgets --------------------------------------------------------
+    if os.path.exists(budget_path) and not update_budgets:
+        with open(budget_path) as f:
+            budgets = json.load(f)
+        for stage, measured in timer.stages.items():
+            budget = budgets.get('stages', {}).get(stage)
+            if budget is None:
+                continue
+            for metric, label in (('wall_s', 's'), ('gpu_gb', 'GB')):
+                limit = budget[metric] * (1.0 + tolerance)
+                if budget[metric] > 0 and measured[metric] > limit:
+                    failures.append(
+                        f'{stage} {metric}: {measured[metric]:.3f}{label} '
+                        f'> budget {budget[metric]:.3f}{label} + {tolerance:.0%}')
+    else:
+        with open(budget_path, 'w') as f:
+            json.dump(result, f, indent=2)
+        print(f'[regression] wrote new baseline budgets to {budget_path}')
+
+    for stage, measured in timer.stages.items():
+        print(f"[regression] {stage}: {measured['wall_s']:.3f}s, "
+              f"{measured['gpu_gb']:.3f}GB peak")
+
+    if failures:
+        for failure in failures:
+            print(f'[regression] FAIL: {failure}')
+        raise SystemExit(1)
+    print('[regression] PASS')
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run the performance/accuracy regression harness')
+    parser.add_argument('--design-path', default='testcase/aes_cipher_top')
+    parser.add_argument('--design-name', default='aes')
+    parser.add_argument('--budgets', default='benchmark/budgets.json')
+    parser.add_argument('--tolerance', type=float, default=0.10)
+    parser.add_argument('--min-correlation', type=float, default=0.99)
+    parser.add_argument('--update-budgets', action='store_true',
+                        help='record the measured numbers as the new baseline')
+    args = parser.parse_args()
+    run_regression(args.design_path, args.design_name, args.budgets,
+                   args.tolerance, args.min_correlation, args.update_budgets)
+
+
+if __name__ == '__main__':
+    main()
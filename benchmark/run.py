@@ -0,0 +1,133 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file benchmark/run.py
+# @brief scripted benchmark runs over generated or real designs
+
+import os
+import json
+import time
+import argparse
+import resource
+
+import torch
+
+from src.core.insta import INSTA
+from .generate import generate_design
+
+
+def _peak_rss_gb():
+    # ru_maxrss is KB on Linux
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1e6
+
+
+def benchmark_design(design_path, design_name, warm_iters=20, use_cache=False):
+    """
+    Measure one design: init time, cold/warm propagation, memory peaks
+
+    Cold latency is the first do_eval_propagation (allocations, graph
+    warmup); warm throughput comes from do_context_propagation, which is
+    the allocation-free loop an optimizer actually sits in. GPU peaks
+    are torch.cuda.max_memory_allocated; host peak is ru_maxrss for the
+    whole process so far (monotone — comparable across runs, not across
+    designs within one process). use_cache=False forces a full re-parse
+    so init time measures the parser, not the pickle loader.
+
+    Returns a flat dict, also JSON-serializable for trend tracking.
+    """
+    insta = INSTA()
+    insta.do_set_insta_path(design_path, design_name)
+
+    if not use_cache:
+        # Drop any stale cache so init measures parsing + build
+        import shutil
+        save_dir = insta.save_dir
+        if os.path.isdir(save_dir):
+            shutil.rmtree(save_dir)
+            os.makedirs(save_dir, exist_ok=True)
+
+    if torch.cuda.is_available():
+        torch.cuda.reset_peak_memory_stats()
+
+    t0 = time.perf_counter()
+    assert insta.do_initialization(), 'initialization failed'
+    init_s = time.perf_counter() - t0
+    init_rss_gb = _peak_rss_gb()
+
+    t0 = time.perf_counter()
+    assert insta.do_eval_propagation()
+    if torch.cuda.is_available():
+        torch.cuda.synchronize()
+    cold_s = time.perf_counter() - t0
+
+    # Warm loop through the pre-allocated context
+    insta.do_context_propagation()
+    if torch.cuda.is_available():
+        torch.cuda.synchronize()
+    t0 = time.perf_counter()
+    for _ in range(warm_iters):
+        insta.do_context_propagation()
+    if torch.cuda.is_available():
+        torch.cuda.synchronize()
+    warm_s = (time.perf_counter() - t0) / warm_iters
+
+    result = {
+        'design': design_name,
+        'path': design_path,
+        'init_s': init_s,
+        'cold_prop_s': cold_s,
+        'warm_prop_s': warm_s,
+        'props_per_sec': (1.0 / warm_s) if warm_s > 0 else float('inf'),
+        'peak_rss_gb': init_rss_gb,
+        'peak_gpu_gb': (torch.cuda.max_memory_allocated() / 1e9
+                        if torch.cuda.is_available() else 0.0),
+        'wns': float(insta.wns),
+        'tns': float(insta.tns),
+    }
+    print(f"[benchmark] {design_name}: init {init_s:.2f}s, "
+          f"cold {cold_s:.3f}s, warm {warm_s * 1e3:.1f}ms "
+          f"({result['props_per_sec']:.1f} props/s), "
+          f"rss {result['peak_rss_gb']:.2f}GB, "
+          f"gpu {result['peak_gpu_gb']:.2f}GB")
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate synthetic designs across sizes and benchmark them')
+    parser.add_argument('--out', default='benchmark/runs',
+                        help='directory for generated designs and results JSON')
+    parser.add_argument('--sizes', type=int, nargs='+',
+                        default=[50000, 200000, 1000000],
+                        help='approximate pin counts to sweep')
+    parser.add_argument('--depth', type=int, default=50)
+    parser.add_argument('--clock-domains', type=int, default=2)
+    parser.add_argument('--warm-iters', type=int, default=20)
+    parser.add_argument('--seed', type=int, default=0)
+    args = parser.parse_args()
+
+    results = []
+    for size in args.sizes:
+        name = f'synth_{size}'
+        design_path = os.path.join(args.out, name)
+        generate_design(os.path.join(design_path, 'insta_inputs'),
+                        num_pins=size, depth=args.depth,
+                        clock_domains=args.clock_domains, seed=args.seed)
+        results.append(benchmark_design(design_path, name,
+                                        warm_iters=args.warm_iters))
+
+    report_path = os.path.join(args.out, 'results.json')
+    with open(report_path, 'w') as f:
+        json.dump(results, f, indent=2)
+    print(f'[benchmark] wrote {report_path}')
+
+
+if __name__ == '__main__':
+    main()
@@ -17,6 +17,10 @@ import torch
 DEFAULT_DEVICE = torch.device('cuda:0')
 DEFAULT_FLOAT_DTYPE = torch.float32
 DEFAULT_TOPK = 256
+
+# Top-K widths with template-specialized kernel variants in the
+# sta_compute_arrival extension; other widths fall back to the generic path
+SUPPORTED_TOPK_VALUES = [1, 8, 16, 32, 64, 128, 256]
 DEFAULT_SCALING = 1.0
 
 # File paths
@@ -20,34 +20,56 @@ import torch
 import collections
 from typing import Dict, List, Set, Tuple, Optional, Union, Any
 import copy
+import math
 import time
+import pickle
 import numpy as np
 from ..io.parsers import (
     read_cell_libcell_file, read_no_timing_pin_file, read_valid_pin_file,
     read_cell_arc_file, read_net_arc_file, read_sp_file, read_ep_file,
-    read_pocvm_file
+    read_pocvm_file, PinInterner, ArcColumns
 )
 from ..io.serialization import save_pickle, load_pickle, save_torch_tensor, load_torch_tensor
-from ..graph.builder import build_timing_graph
-from ..graph.levelization import levelize_graph
+from ..io.serialization import save_cache_manifest, validate_cache_manifest
+from ..graph.builder import build_timing_graph, build_timing_graph_columnar
+from ..graph.csr import CSRGraph, CSRAdjacencyView
+from ..graph.names import PinNameIndex
+from ..graph.partition import partition_timing_domains, build_domain_schedules
+from ..graph.levelization import levelize_csr_graph, relevel_affected_cone
 from ..timing.propagation import clear_timing_cache, propagate_arrival_times, save_arrival_tensors
-from ..timing.collaterals import precompute_collaterals, move_collaterals_to_device
+from ..timing.propagation import propagate_required_times, propagate_hold_arrival_times, PropagationContext
+from ..timing.propagation import build_dirty_subset_collaterals, propagate_incremental_event_driven
+from ..timing.propagation import DiffPropagationContext
+from ..timing.collaterals import precompute_collaterals, move_collaterals_to_device, cast_collaterals_dtype
+from ..timing.collaterals import patch_collateral_delays, schedule_level_launches
 from ..timing.pocv   import initialize_timing_tensors, apply_cppr_correction
+from ..timing.pocv   import build_cppr_metadata, apply_cppr_correction_tensorized
+from ..timing.pocv   import build_cppr_tensors, apply_cppr_correction_gpu
+from ..timing.pocv   import build_groundtruth_device_tensors, compare_to_groundtruth_gpu
+from ..timing.profiler import nvtx_annotate, py_scope, set_py_profile_dir
 from ..timing.pocv   import extract_cellArc_grad, extract_netArc_grad, extract_stage_grad
+from ..timing.pocv   import ArcPairGradView, StageGradView
 from ..visualization.plotting import plot_ep_correlation, write_analysis_csv
 import ipdb
 
 from .constants import (
     DEFAULT_DEVICE, DEFAULT_FLOAT_DTYPE, DEFAULT_TOPK, DEFAULT_SCALING,
     DEFAULT_INPUT_FOLDER, DEFAULT_OUTPUT_FOLDER, NESTED_LIB_DICT_PATH,
-    NESTED_PIN_DICT_PATH, DEFAULT_SIGMA, DEFAULT_TEMPERATURE
+    NESTED_PIN_DICT_PATH, DEFAULT_SIGMA, DEFAULT_TEMPERATURE,
+    SUPPORTED_TOPK_VALUES
 )
 
 class INSTA:
     """Main infrastructure for Neural Static Timing Analysis"""
 
-    def __init__(self):
-        """Initialize the INSTA analyzer with default settings"""
+    def __init__(self, compile: bool = False):
+        """Initialize the INSTA analyzer with default settings
+
+        Args:
+            compile: Wrap the elementwise glue between the custom kernels
+                (net-arc level math, slack reduction, CPPR candidate scan)
+                with torch.compile; falls back to eager on any failure
+        """
         # Core configuration
         self.device = DEFAULT_DEVICE
         self.float_dtype = DEFAULT_FLOAT_DTYPE
@@ -57,13 +79,10 @@ class INSTA:
         # Paths and design info
         self.prefix = './'
         self.save_dir = os.path.join(self.prefix, DEFAULT_OUTPUT_FOLDER)
+        self.run_dir = None  # per-run scratch; set by do_set_insta_path
         self.design_name = ""
         self.input_folderName = DEFAULT_INPUT_FOLDER
 
-        self.pinG = None
-        self.gt_graph = None
-        self.nx_2_gt = {}
-        self.gt_2_nx = {}
         self.max_Gid = 0
 
         self.pinName_2_Gid = {}
@@ -79,10 +98,29 @@ class INSTA:
         self.Gid_2_children = collections.defaultdict(set)
         self.inPin_parent_dict = {}
         self.outPin_set = set()
+        # Canonical int32 CSR connectivity (fwd + transpose), built
+        # alongside the legacy structures by _build_graph
+        self.csr_graph = None
 
         self.cell_arc_2_variation = {}
         self.net_arc_2_variation = {}
         self.is_pocv = False
+        # Columnar arc tables (ArcColumns over a shared pin interner)
+        # instead of dict-of-tuples; same mapping interface downstream
+        self.columnar_arcs = False
+        # Bounded-memory lazy/streaming arc parse (implies columnar_arcs)
+        self.streaming_parse = False
+        self._pin_interner = None
+        # Packed UTF-8 name arena instead of the name<->Gid string dicts
+        self.compact_pin_names = False
+        # Level-major Gid renumbering after levelization for coalesced
+        # plane gathers
+        self.level_major_gids = False
+        self.pin_name_index = None
+        # Clock-domain partition state (do_partition_domains)
+        self.domain_labels = None
+        self.domain_level_2_nodes = None
+        self._domain_collaterals = None
 
         self.valid_pinNames_set = set()
         self.noTiming_pinNames_set = set()
@@ -115,106 +153,4463 @@ class INSTA:
         self.max_cellArcId = 0
         self.max_netArcId = 0
 
-        self.net_2_pocvScaling = {}
-        self.libCell_2_riseFallguardband = {}
-        self.libCell_2_riseFallStd = {}
+        self.net_2_pocvScaling = {}
+        self.libCell_2_riseFallguardband = {}
+        self.libCell_2_riseFallStd = {}
+
+        self.timing_tensors = {}
+        self.graph_propagator = None
+        self.cppr_tensors = None
+        self.propagation_context = None
+        self.cone_selector = None
+        self.cone_collateral_cache = None
+        self._eco_transaction = None
+        self._loss_scaler = None
+        self._multi_gpu_propagator = None
+        self.query_server = None
+        self.committed_snapshot = None
+        self.launch_timing_tensors = None
+        self._endpoint_groups = None
+        self._endpoint_clusters = None
+        self._dispatch_tuner = None
+        self._report_executor = None
+        self._report_future = None
+        self._report_pinned = {}
+        self._propagation_result = None
+        self._fuse_cppr = False
+        self._endpoint_reference = None
+        self._pin_index_df = None
+        self._gid_level_tensor = None
+        self._cppr_metadata = None
+        self._groundtruth_gpu = None
+        self._fast_mode = None
+        self._fast_levels_scheduled = False
+        self._required_components = None
+        self._tns_estimator = None
+        self._snapshot_ring = None
+        self._delay_model = None
+        self._cell_arc_delay_index = None
+        self._si_overlay = {}
+        self._si_dirty_sinks = set()
+        self._arc_patch_buffer = None
+        self._patch_dirty_sinks = set()
+        self._name_service = None
+        self.stable_id_tensor = None
+
+        self.compile_glue = False
+        if compile:
+            self.do_enable_compiled_glue()
+
+
+
+    def do_set_insta_path(self, path: str, design_name: str, input_folderName: Optional[str] = None):
+        """
+        Set the base path and design information
+
+        Args:
+            path: Base directory path for the design
+            design_name: Name of the design
+            input_folderName: Optional custom folder name for inputs
+        """
+        self.prefix = path
+        self.design_name = design_name
+        self.save_dir = os.path.join(self.prefix, DEFAULT_OUTPUT_FOLDER)
+        os.makedirs(self.save_dir, exist_ok=True)
+        # save_dir is shared between concurrent runs on the design: the
+        # immutable caches live there (published atomically, so runs
+        # share warm caches instead of fighting over files) while
+        # mutable per-run reports — anal.csv, plots, profiles — go to a
+        # unique scratch subdir
+        from ..io.serialization import run_scratch_dir
+        self.run_dir = run_scratch_dir(self.save_dir)
+        set_py_profile_dir(self.run_dir)
+
+        if input_folderName:
+            self.input_folderName = input_folderName
+
+    def set_device(self, num: int):
+        torch.cuda.set_device(num)
+        self.device = torch.device(f'cuda:{num}')
+        print(f'INSTA set device to {num}')
+
+    def do_set_topk(self, topk: int):
+        """
+        Set the number of arrival candidates tracked per pin
+
+        Most flows only need K=16/32 for CPPR credit to converge; lowering K
+        shrinks every Gid_2_* tensor and the top-K merge cost accordingly.
+        The kernels are template-specialized per supported width, so only
+        values in SUPPORTED_TOPK_VALUES are accepted.
+        """
+        assert topk in SUPPORTED_TOPK_VALUES, \
+            f'topK {topk} not supported, choose one of {SUPPORTED_TOPK_VALUES}'
+        if topk != self.topK:
+            self.topK = topk
+            # Cached timing tensors and any captured CUDA graph are shaped
+            # for the old K; drop them so the next propagation reallocates
+            self.timing_tensors = {}
+            self.propagation_context = None
+            if self.graph_propagator is not None:
+                self.graph_propagator.reset()
+        print(f'INSTA set topK to {topk}')
+
+    def do_preflight_capacity_check(self, gpu_budget_gb: Optional[float] = None,
+                                    host_budget_gb: Optional[float] = None,
+                                    auto_adjust: bool = True,
+                                    strict: bool = False) -> dict:
+        """
+        Estimate peak memory from input-file metadata before initializing
+
+        An hour-long initialization that OOMs at the end wastes the whole
+        attempt, so this predicts the big allocations up front from polars
+        scan row counts alone: peak host RSS across the parse/graph
+        stages, device collateral residency, and the arrival-plane arena
+        for the configured K/dtype. With auto_adjust the same degradation
+        ladder clear_timing_cache applies at allocation time (bfloat16
+        planes, then lower K) is applied here instead, before any work;
+        strict=True turns an unfittable design into an immediate failure.
+        The returned dict carries the raw byte estimates for farm-side
+        machine-class binning.
+        """
+        from ..timing.memory import estimate_capacity, plan_capacity
+
+        input_dir = os.path.join(self.prefix, self.input_folderName)
+        estimate = estimate_capacity(input_dir, self.topK, self.float_dtype)
+        gb = 1 << 30
+        print(f"[capacity] {estimate['pins']} pins, "
+              f"{estimate['cell_arcs']} cell arcs, {estimate['net_arcs']} net arcs")
+        print(f"[capacity] host peak ~{estimate['peak_host_bytes'] / gb:.1f}GB, "
+              f"collaterals ~{estimate['collateral_bytes'] / gb:.1f}GB, "
+              f"planes ~{estimate['plane_bytes'] / gb:.1f}GB "
+              f"(K={self.topK}, {self.float_dtype})")
+
+        if gpu_budget_gb is None and self.device.type == 'cuda':
+            gpu_budget_gb = torch.cuda.get_device_properties(
+                self.device).total_memory / gb
+        plan = plan_capacity(
+            estimate,
+            None if gpu_budget_gb is None else int(gpu_budget_gb * gb),
+            None if host_budget_gb is None else int(host_budget_gb * gb),
+            SUPPORTED_TOPK_VALUES)
+        for reason in plan['reasons']:
+            print(f'[capacity] {reason}')
+
+        if auto_adjust:
+            if plan['topk'] != self.topK:
+                self.do_set_topk(plan['topk'])
+            if plan['plane_dtype'] != self.float_dtype:
+                # Pre-initialization there are no tensors to convert, so
+                # the dtype is set directly rather than via
+                # do_set_float_dtype
+                self.float_dtype = plan['plane_dtype']
+                print(f'INSTA set float dtype to {plan["plane_dtype"]}')
+        if strict:
+            assert plan['fits'], \
+                f"design does not fit the configured budgets: {plan['reasons']}"
+        estimate['fits'] = plan['fits']
+        return estimate
+
+    # Cache artifacts derived from the graph structure; any change to an
+    # arc or pin-filter input invalidates this whole chain
+    _GRAPH_CHAIN_PKLS = [
+        'pinG.pkl', 'nx_2_gt.pkl', 'gt_2_nx.pkl',
+        'pinName_2_Gid.pkl', 'Gid_2_pinName.pkl',
+        'cellName_2_pinNames.pkl', 'cellName_2_inPinNames.pkl', 'cellName_2_outPinNames.pkl',
+        'Gid_2_parents.pkl', 'Gid_2_children.pkl',
+        'inPin_parent_dict.pkl', 'outPin_set.pkl', 'max_Gid.pkl',
+        'level_2_nodes.pkl', 'node_2_level.pkl',
+        'level_2_nodes_bw.pkl', 'node_2_level_bw.pkl',
+        'source_nodes.pkl', 'dest_nodes.pkl',
+        'level_2_collaterals.pkl',
+        'cell_arc_2_collateral_loc.pkl', 'net_arc_2_collateral_loc.pkl',
+        'cellArcId_2_cellName.pkl', 'cellArcKey_2_cellArcId.pkl', 'cellArcId_2_cellArcKey.pkl',
+        'netArcId_2_inCellName.pkl', 'netArcId_2_outCellName.pkl',
+        'netArcKey_2_netArcId.pkl', 'netArcId_2_netArcKey.pkl'
+    ]
+
+    # Which cache pickles each input file feeds directly
+    _INPUT_2_CACHE_PKLS = {
+        'cell_arcs.csv': ['cell_arc_2_variation.pkl', 'cell_arc_columns.pkl'],
+        'net_arcs.csv': ['net_arc_2_variation.pkl', 'net_arc_columns.pkl'],
+        'all_between_sp_ep_pins.csv': ['valid_pinNames_set.pkl'],
+        'no_timing_pins.csv': ['noTiming_pinNames_set.pkl'],
+        'sp_attributes.csv': ['spName_2_attributes.pkl'],
+        'clock_latency_timing_launch.rpt': ['spName_2_attributes.pkl'],
+        'ep_attributes.csv': [
+            'epName_riseFall_2_attributes.pkl', 'epName_riseFall_2_spName.pkl',
+            'epName_riseFall_2_launch_clock_latency.pkl', 'epName_riseFall_2_ckPinName.pkl'
+        ],
+        'cell_2_libCell.csv': [
+            'cellName_2_orgLibCell.pkl', 'cellName_2_funcId.pkl', 'funcId_2_libCellNames.pkl'
+        ]
+    }
+
+    # Inputs whose change also invalidates the graph chain
+    _STRUCTURAL_INPUTS = {
+        'cell_arcs.csv', 'net_arcs.csv', 'all_between_sp_ep_pins.csv', 'no_timing_pins.csv'
+    }
+
+    def _validate_caches(self):
+        """
+        Content-hash cache validation against the insta_inputs files
+
+        Compares O(1) fingerprints of every input (plus the code-relevant
+        constants) with the stored manifest and removes only the cache
+        artifacts derived from inputs that actually changed — the graph
+        chain survives an sp_attributes-only drop, for instance — then
+        refreshes the manifest. Without this, a netlist drop over existing
+        outputs would silently serve stale collaterals.
+        """
+        input_dir = os.path.join(self.prefix, self.input_folderName)
+        input_files = [os.path.join(input_dir, name) for name in self._INPUT_2_CACHE_PKLS]
+        constants = {'scale': self.scale, 'inPinMod': 1, 'float_dtype': str(self.float_dtype)}
+
+        verdict = validate_cache_manifest(self.save_dir, input_files, constants)
+        if verdict is not None:
+            stale_inputs, constants_changed = verdict
+            doomed = set()
+            if constants_changed:
+                stale_inputs = set(self._INPUT_2_CACHE_PKLS)
+            for name in stale_inputs:
+                doomed.update(self._INPUT_2_CACHE_PKLS.get(name, []))
+                if name in self._STRUCTURAL_INPUTS:
+                    doomed.update(self._GRAPH_CHAIN_PKLS)
+            removed = 0
+            for pkl_name in doomed:
+                for path in (os.path.join(self.save_dir, pkl_name),
+                             os.path.join(self.save_dir, pkl_name + '.tensors')):
+                    if os.path.exists(path):
+                        os.remove(path)
+                        removed += 1
+            if stale_inputs:
+                print(f'[cache manifest] stale inputs: {sorted(stale_inputs)}, '
+                      f'removed {removed} cache artifacts')
+
+        save_cache_manifest(self.save_dir, input_files, constants)
+
+    @py_scope('do_initialization')
+    def do_initialization(self, full_diff_sta: bool=False):
+        """
+        Perform the complete initialization sequence
+
+        Each stage runs under the InitProfiler: wall time, peak RSS,
+        peak GPU memory and parsed row counts are recorded per stage
+        and written to save_dir/init_profile.json at the end, and every
+        stage doubles as an NVTX range (INSTA_NVTX=1) for Nsight
+        attribution.
+        """
+        from ..timing.profiler import InitProfiler
+
+        profiler = InitProfiler(self.device)
+        self._validate_caches()
+
+        print('[reading noTiming file]')
+        with profiler.stage('read noTiming file'):
+            self._read_no_timing_pin_file()
+        profiler.annotate(no_timing_pins=len(self.noTiming_pinNames_set))
+
+        print('[reading valid pin file]')
+        with profiler.stage('read valid pin file'):
+            if not self._read_valid_pin_file():
+                return False
+        profiler.annotate(valid_pins=len(self.valid_pinNames_set))
+
+        print('[reading cell arc file]')
+        with profiler.stage('read cell arc file'):
+            if not self._read_cell_arc_file():
+                return False
+        profiler.annotate(cell_arcs=len(self.cell_arc_2_variation))
+
+        print('[reading net arc file]')
+        with profiler.stage('read net arc file'):
+            if not self._read_net_arc_file():
+                return False
+        profiler.annotate(net_arcs=len(self.net_arc_2_variation))
+
+        print('[building nx and gt graph]')
+        with profiler.stage('build graph'):
+            if not self._build_graph():
+                return False
+        profiler.annotate(nodes=self.max_Gid)
+
+        print('[reading sp file and launch clock rpt file]')
+        with profiler.stage('read sp file'):
+            if not self._read_sp_file():
+                return False
+        profiler.annotate(startpoints=len(self.spName_2_attributes))
+
+        print('[reading ep file]')
+        with profiler.stage('read ep file'):
+            if not self._read_ep_file():
+                return False
+        profiler.annotate(endpoints=len(self.epName_riseFall_2_spName))
+
+        print('[initializing timing groundtruths]')
+        with profiler.stage('timing groundtruths'):
+            if not self._initialize_timing_groundtruths():
+                return False
+
+        print('[levelizing]')
+        with profiler.stage('levelize'):
+            if not self._levelize():
+                return False
+        profiler.annotate(levelized_nodes=len(self.node_2_level),
+                          levels=len(self.level_2_nodes))
+
+        if self.level_major_gids:
+            print('[renumbering gids level-major]')
+            with profiler.stage('renumber gids level-major'):
+                self._renumber_gids_level_major()
+
+        print('[reading pocvm guardband file]')
+        with profiler.stage('read pocvm file'):
+            if not self._read_pocvm_file():
+                return False
+
+        print('[precomputing collaterals]')
+        with profiler.stage('precompute collaterals'):
+            if not self._precompute_collaterals():
+                return False
+        profiler.annotate(levels=len(self.level_2_collaterals))
+
+        profiler.write(self.run_dir or self.save_dir)
+        return True
+
+    @py_scope('do_parallel_initialization')
+    def do_parallel_initialization(self, full_diff_sta: bool = False, max_workers: int = 6):
+        """
+        Initialization with independent stages overlapped on a thread pool
+
+        Runs the same stages as do_initialization, scheduled as a DAG
+        instead of a straight line: all six file parses (pin filters, cell
+        and net arcs, endpoints, POCVM guardbands) launch together, the
+        graph build starts as soon as the four parses it needs finish, and
+        the sp parse (which needs pinName_2_Gid from the graph) overlaps
+        with the endpoint and guardband futures still in flight. polars
+        and pickle I/O release the GIL, so the file-bound stages overlap
+        well even on threads. Results and failure handling match the
+        sequential path stage for stage.
+        """
+        from concurrent.futures import ThreadPoolExecutor
+
+        start_time = time.time()
+        self._validate_caches()
+        if (self.columnar_arcs or self.streaming_parse) and self._pin_interner is None:
+            self._pin_interner = PinInterner()
+
+        with ThreadPoolExecutor(max_workers=max_workers) as pool:
+            # Independent file parses, all in flight at once
+            print('[parallel init] launching file parses')
+            f_no_timing = pool.submit(self._read_no_timing_pin_file)
+            f_valid = pool.submit(self._read_valid_pin_file)
+            f_cell_arc = pool.submit(self._read_cell_arc_file)
+            f_net_arc = pool.submit(self._read_net_arc_file)
+            f_ep = pool.submit(self._read_ep_file)
+            f_pocvm = pool.submit(self._read_pocvm_file)
+
+            # Graph build needs the pin filters and both arc tables
+            f_no_timing.result()
+            if not (f_valid.result() and f_cell_arc.result() and f_net_arc.result()):
+                return False
+            print('[building nx and gt graph]')
+            if not self._build_graph():
+                return False
+
+            # sp parsing needs pinName_2_Gid from the graph; the ep and
+            # pocvm futures keep running underneath it
+            print('[reading sp file and launch clock rpt file]')
+            if not self._read_sp_file():
+                return False
+            if not f_ep.result():
+                return False
+
+            print('[initializing timing groundtruths]')
+            if not self._initialize_timing_groundtruths():
+                return False
+
+            print('[levelizing]')
+            if not self._levelize():
+                return False
+
+            if self.level_major_gids:
+                print('[renumbering gids level-major]')
+                self._renumber_gids_level_major()
+
+            if not f_pocvm.result():
+                return False
+
+        print('[precomputing collaterals]')
+        if not self._precompute_collaterals():
+            return False
+
+        print(f'[parallel init] completed in {time.time() - start_time:.2f} seconds')
+        return True
+
+    # Tensor attributes stored as named payloads in the warm-start bundle
+    _SNAPSHOT_TENSOR_ATTRS = [
+        'sp_mean_tensor', 'sp_std_tensor',
+        'ep_rise_required_truth', 'ep_fall_required_truth',
+        'inPin_parent_tensor'
+    ]
+
+    # Python-side state captured in the snapshot's pickled section; the
+    # nx/gt graph objects are deliberately excluded (queries never touch
+    # them once the collaterals exist)
+    _SNAPSHOT_PICKLE_ATTRS = [
+        'design_name', 'scale', 'topK', 'is_pocv', 'max_Gid',
+        'pinName_2_Gid', 'Gid_2_pinName',
+        'cellName_2_pinNames', 'cellName_2_inPinNames', 'cellName_2_outPinNames',
+        'cellName_2_orgLibCell', 'cellName_2_funcId', 'funcId_2_libCellNames',
+        'Gid_2_parents', 'Gid_2_children', 'inPin_parent_dict', 'outPin_set',
+        'source_nodes', 'dest_nodes',
+        'spName_2_attributes', 'epName_riseFall_2_attributes',
+        'epName_riseFall_2_spName', 'epName_riseFall_2_ckPinName',
+        'epName_riseFall_2_launch_clock_latency',
+        'level_2_nodes', 'node_2_level', 'level_2_nodes_bw', 'node_2_level_bw',
+        'cell_arc_2_collateral_loc', 'net_arc_2_collateral_loc',
+        'cellArcId_2_cellName', 'cellArcKey_2_cellArcId', 'cellArcId_2_cellArcKey',
+        'netArcId_2_inCellName', 'netArcId_2_outCellName',
+        'netArcKey_2_netArcId', 'netArcId_2_netArcKey',
+        'max_cellArcId', 'max_netArcId',
+        'net_2_pocvScaling', 'libCell_2_riseFallguardband', 'libCell_2_riseFallStd',
+        'cell_arc_2_variation', 'net_arc_2_variation',
+        'valid_pinNames_set', 'noTiming_pinNames_set'
+    ]
+
+    def do_save_snapshot(self, file_path: Optional[str] = None) -> str:
+        """
+        Write the fully initialized state into one warm-start bundle
+
+        Every collateral tensor goes into the mmap tensor bundle under a
+        per-level field name, the sp/ep truth tensors as named payloads,
+        and the Python-side maps (pin/arc ids, levelization, loc maps) as
+        one pickled section embedded in the same file — so a later
+        process is query-ready after a single do_load_snapshot instead of
+        replaying parsing, graph build and levelization. The nx/gt graph
+        objects are not captured; rerun do_initialization if a structural
+        edit is needed.
+        """
+        from ..io.serialization import save_tensor_bundle
+
+        assert self.level_2_collaterals is not None, 'run do_initialization before snapshotting'
+        if file_path is None:
+            file_path = os.path.join(self.save_dir, 'insta_snapshot.bin')
+        start_time = time.time()
+
+        tensors = {}
+        layout = {}
+        python_fields = {}
+        for level, coll in self.level_2_collaterals.items():
+            if isinstance(coll, torch.Tensor):  # level 1: startpoint tensor
+                tensors[f'coll_{level}'] = coll
+                layout[level] = None
+                continue
+            field_kinds = []
+            for idx, field in enumerate(coll):
+                if isinstance(field, torch.Tensor):
+                    tensors[f'coll_{level}_{idx}'] = field
+                    field_kinds.append('t')
+                else:  # python lists (arc id fields) ride in the pickled section
+                    python_fields[(level, idx)] = field
+                    field_kinds.append('p')
+            layout[level] = field_kinds
+
+        for name in self._SNAPSHOT_TENSOR_ATTRS:
+            value = getattr(self, name, None)
+            if isinstance(value, torch.Tensor):
+                tensors[name] = value
+
+        state = {name: getattr(self, name) for name in self._SNAPSHOT_PICKLE_ATTRS
+                 if hasattr(self, name)}
+        state['_collateral_layout'] = layout
+        state['_collateral_python_fields'] = python_fields
+        blob = pickle.dumps(state, protocol=pickle.HIGHEST_PROTOCOL)
+        tensors['snapshot_state_blob'] = torch.frombuffer(bytearray(blob), dtype=torch.uint8)
+
+        save_tensor_bundle(tensors, file_path,
+                           meta={'max_gid': self.max_Gid, 'topK': self.topK,
+                                 'design_name': self.design_name})
+        print(f'[snapshot] wrote {file_path} ({len(tensors)} payloads, '
+              f'{len(blob)} state bytes) in {time.time() - start_time:.2f} seconds')
+        return file_path
+
+    def do_load_snapshot(self, file_path: Optional[str] = None) -> bool:
+        """
+        Restore a do_save_snapshot bundle; inverse of do_save_snapshot
+
+        Collateral and truth tensors come back as mmap views over the
+        bundle (pages fault in on first touch; move_collaterals_to_device
+        or the first propagation pulls them to the device), and the
+        pickled section restores the id maps and levelization. After this
+        the instance is ready for do_eval_propagation without any parsing
+        or graph build.
+        """
+        from ..io.serialization import load_tensor_bundle
+
+        if file_path is None:
+            file_path = os.path.join(self.save_dir, 'insta_snapshot.bin')
+        if not os.path.exists(file_path):
+            print(f'[snapshot] cannot find {file_path}')
+            return False
+        start_time = time.time()
+
+        bundle = load_tensor_bundle(file_path)
+        state = pickle.loads(bundle['snapshot_state_blob'].numpy().tobytes())
+        layout = state.pop('_collateral_layout')
+        python_fields = state.pop('_collateral_python_fields')
+        for name, value in state.items():
+            setattr(self, name, value)
+
+        level_2_collaterals = {}
+        for level, field_kinds in layout.items():
+            if field_kinds is None:
+                level_2_collaterals[level] = bundle[f'coll_{level}']
+                continue
+            coll = []
+            for idx, kind in enumerate(field_kinds):
+                if kind == 't':
+                    coll.append(bundle[f'coll_{level}_{idx}'])
+                else:
+                    coll.append(python_fields[(level, idx)])
+            level_2_collaterals[level] = coll
+        self.level_2_collaterals = level_2_collaterals
+
+        for name in self._SNAPSHOT_TENSOR_ATTRS:
+            if name in bundle:
+                setattr(self, name, bundle[name])
+
+        # Derived runtime state must be rebuilt against the new tensors
+        self.timing_tensors = {}
+        self.propagation_context = None
+        self.graph_propagator = None
+        self.cppr_tensors = None
+        self.cone_selector = None
+
+        print(f'[snapshot] loaded {file_path} in {time.time() - start_time:.2f} seconds, '
+              f'{len(level_2_collaterals)} levels, max_Gid {self.max_Gid}')
+        return True
+
+    def do_export_core_snapshot(self, file_path: Optional[str] = None) -> str:
+        """
+        Write the flattened propagation core for non-Python clients
+
+        Produces the interchange file behind the C API declared in
+        installed_ops/sta_compute_arrival/insta_core.h: the flattened
+        level schedule the persistent kernel already consumes
+        (flatten_level_collaterals), the startpoint mean/std planes, the
+        startpoint/endpoint gid lists and the endpoint required times,
+        all in the mmap'able tensor bundle format. A C++ client loads it
+        once and then drives the level sweep, incremental patches and
+        the slack reduction with no interpreter in the call path; this
+        Python object stays one client of the same core among several.
+
+        Endpoint rows are sorted by gid — the order the C API's slack
+        reader returns. Patch handles are positions into the
+        concatenated arc tables (see do_flat_arc_position). Export
+        before do_schedule_levels: like the persistent and streaming
+        modes, the flattened layout consumes unscheduled levels.
+        """
+        from ..timing.collaterals import flatten_level_collaterals
+        from ..io.serialization import save_tensor_bundle
+
+        assert self.level_2_collaterals is not None, \
+            'run do_initialization before exporting the core'
+        if file_path is None:
+            file_path = os.path.join(self.save_dir, 'insta_core_snapshot.bin')
+        start_time = time.time()
+
+        tensors = dict(flatten_level_collaterals(self.level_2_collaterals,
+                                                 self.device))
+        tensors['level_ids'] = torch.tensor(
+            list(self.level_2_collaterals.keys()), dtype=torch.int32)
+
+        dest = torch.tensor(sorted(self.dest_nodes), dtype=torch.int64)
+        tensors['source_node_tensor'] = torch.tensor(
+            sorted(self.source_nodes), dtype=torch.int64)
+        tensors['dest_node_tensor'] = dest
+        tensors['sp_mean_tensor'] = self.sp_mean_tensor
+        tensors['sp_std_tensor'] = self.sp_std_tensor
+        tensors['ep_rise_required'] = self.ep_rise_required_truth[dest]
+        tensors['ep_fall_required'] = self.ep_fall_required_truth[dest]
+
+        save_tensor_bundle(tensors, file_path, meta={
+            'schema': 'insta_core_snapshot',
+            'core_version': 1,
+            'design_name': self.design_name,
+            'max_gid': self.max_Gid,
+            'topk': self.topK,
+            'float_dtype': str(self.float_dtype).replace('torch.', ''),
+            'num_levels': len(self.level_2_collaterals),
+            'num_endpoints': int(dest.numel()),
+        })
+        total_bytes = sum(t.numel() * t.element_size() for t in tensors.values())
+        print(f'[core export] {file_path}: {len(tensors)} tensors, '
+              f'{total_bytes / (1 << 20):.1f} MB in '
+              f'{time.time() - start_time:.2f} seconds')
+        return file_path
+
+    def do_flat_arc_position(self, arc_key) -> Optional[int]:
+        """
+        Translate an arc key into its patch handle for the C API
+
+        Net arcs are keyed (fromPin, toPin) and cell arcs
+        (fromPin, toPin, sense), as in the *_collateral_loc maps; the
+        returned position indexes the concatenated arc delay tables of
+        the exported core snapshot, where insta_core_patch_arcs scatters
+        new delays. Returns None for unknown arcs. Positions are stable
+        for the lifetime of the snapshot (re-export after structural
+        edits).
+        """
+        loc = self.net_arc_2_collateral_loc.get(arc_key) \
+            or self.cell_arc_2_collateral_loc.get(arc_key)
+        if loc is None:
+            return None
+        level, pos = loc
+        base = 0
+        for flat_level in self.level_2_collaterals:
+            if flat_level == level:
+                return base + pos
+            coll = self.level_2_collaterals[flat_level]
+            if flat_level != 1:
+                base += coll[2 if flat_level % 2 == 1 else 1].numel()
+        return None
+
+    @staticmethod
+    def _partition_of(pin_name: str, num_partitions: int) -> int:
+        """
+        Deterministic partition of a pin's owning cell
+
+        crc32 rather than hash(): Python string hashing is salted per
+        process, and every parse host must agree on the assignment
+        without coordination.
+        """
+        import zlib
+        cell_name = '/'.join(pin_name.split('/')[:-1])
+        return zlib.crc32(cell_name.encode()) % num_partitions
+
+    def do_partition_initialization(self, partition_index: int,
+                                    num_partitions: int,
+                                    file_path: Optional[str] = None) -> Optional[str]:
+        """
+        Parse one cell-region partition of the arc files on this host
+
+        The parse and the per-arc Python structures dominate cold-start
+        RSS, so N hosts each run this with a different partition_index:
+        the full arc files are scanned but only arcs whose SINK pin's
+        owning cell falls in the partition are retained, cutting the
+        resident tables to ~1/N. The result — arc variation tables, pin
+        filter sets and (in columnar mode) the local interner — is
+        written as one partition bundle. Everything is keyed by pin NAME
+        (or carries its interner for name recovery), so boundary pins
+        that appear in several partitions unify in the merge step with
+        no cross-host interning service. do_merge_partition_snapshots
+        assembles the bundles into a fully initialized instance.
+        """
+        assert 0 <= partition_index < num_partitions
+        start_time = time.time()
+        self._read_no_timing_pin_file()
+        if not self._read_valid_pin_file():
+            return None
+        if not (self._read_cell_arc_file() and self._read_net_arc_file()):
+            return None
+
+        def _filter(arcs):
+            if isinstance(arcs, ArcColumns):
+                # One crc per distinct pin id, then a lut gather over the
+                # sink column — never a per-row Python probe
+                owned = torch.tensor(
+                    [self._partition_of(name, num_partitions) == partition_index
+                     for name in arcs.interner.id_2_name], dtype=torch.bool)
+                rows = owned[arcs.dst_ids]
+                return ArcColumns(
+                    arcs.interner, arcs.src_ids[rows], arcs.dst_ids[rows],
+                    None if arcs.senses is None else arcs.senses[rows],
+                    arcs.delays[rows], arcs.is_pocv)
+            return {key: value for key, value in arcs.items()
+                    if self._partition_of(key[1], num_partitions) == partition_index}
+
+        total = len(self.cell_arc_2_variation) + len(self.net_arc_2_variation)
+        self.cell_arc_2_variation = _filter(self.cell_arc_2_variation)
+        self.net_arc_2_variation = _filter(self.net_arc_2_variation)
+        kept = len(self.cell_arc_2_variation) + len(self.net_arc_2_variation)
+
+        if file_path is None:
+            file_path = os.path.join(
+                self.save_dir,
+                f'insta_partition_{partition_index}of{num_partitions}.pkl')
+        save_pickle({
+            'partition_index': partition_index,
+            'num_partitions': num_partitions,
+            'scale': self.scale,
+            'is_pocv': self.is_pocv,
+            'cell_arc_2_variation': self.cell_arc_2_variation,
+            'net_arc_2_variation': self.net_arc_2_variation,
+            'valid_pinNames_set': self.valid_pinNames_set,
+            'noTiming_pinNames_set': self.noTiming_pinNames_set,
+            'pin_interner': self._pin_interner,
+        }, file_path)
+        print(f'[partition init] partition {partition_index}/{num_partitions}: '
+              f'kept {kept}/{total} arcs, wrote {file_path} '
+              f'in {time.time() - start_time:.2f} seconds')
+        return file_path
+
+    def do_merge_partition_snapshots(self, partition_files: List[str],
+                                     full_diff_sta: bool = False) -> bool:
+        """
+        Assemble partition bundles into a fully initialized instance
+
+        Loads every do_partition_initialization bundle, unions the
+        name-keyed arc tables (columnar tables are re-interned into one
+        merged id space by name, which is where boundary pins shared
+        between regions collapse to a single id), then runs the normal
+        post-parse pipeline — graph build, sp/ep parsing, levelization,
+        collateral precompute — exactly once on this host. Pair with
+        do_save_snapshot to turn the merged state into the single-file
+        warm-start bundle the farm jobs load.
+        """
+        start_time = time.time()
+        bundles = [load_pickle(path) for path in partition_files]
+        assert bundles and all(b is not None for b in bundles), \
+            'missing or unreadable partition bundle'
+        num_partitions = bundles[0]['num_partitions']
+        seen = sorted(b['partition_index'] for b in bundles)
+        assert seen == list(range(num_partitions)), \
+            f'expected all {num_partitions} partitions, got indices {seen}'
+        assert all(b['num_partitions'] == num_partitions and
+                   b['scale'] == self.scale for b in bundles), \
+            'partition bundles disagree on num_partitions or scale'
+
+        self.valid_pinNames_set = set()
+        self.noTiming_pinNames_set = set()
+        for bundle in bundles:
+            self.valid_pinNames_set |= bundle['valid_pinNames_set']
+            self.noTiming_pinNames_set |= bundle['noTiming_pinNames_set']
+        self.is_pocv = bundles[0]['is_pocv']
+
+        if isinstance(bundles[0]['cell_arc_2_variation'], ArcColumns):
+            # Merge the per-host interners by name: boundary pins interned
+            # independently on different hosts land on one merged id here
+            merged = PinInterner()
+            luts = [torch.tensor([merged.intern(name)
+                                  for name in bundle['pin_interner'].id_2_name],
+                                 dtype=torch.int64)
+                    for bundle in bundles]
+
+            def _concat(tables, with_sense):
+                return ArcColumns(
+                    merged,
+                    torch.cat([lut[t.src_ids] for lut, t in zip(luts, tables)]),
+                    torch.cat([lut[t.dst_ids] for lut, t in zip(luts, tables)]),
+                    torch.cat([t.senses for t in tables]) if with_sense else None,
+                    torch.cat([t.delays for t in tables]),
+                    tables[0].is_pocv)
+
+            self.cell_arc_2_variation = _concat(
+                [b['cell_arc_2_variation'] for b in bundles], True)
+            self.net_arc_2_variation = _concat(
+                [b['net_arc_2_variation'] for b in bundles], False)
+            self._pin_interner = merged
+        else:
+            self.cell_arc_2_variation = {}
+            self.net_arc_2_variation = {}
+            for bundle in bundles:
+                self.cell_arc_2_variation.update(bundle['cell_arc_2_variation'])
+                self.net_arc_2_variation.update(bundle['net_arc_2_variation'])
+        del bundles
+        print(f'[partition merge] {len(partition_files)} bundles: '
+              f'{len(self.cell_arc_2_variation)} cell arcs, '
+              f'{len(self.net_arc_2_variation)} net arcs')
+
+        print('[building nx and gt graph]')
+        if not self._build_graph():
+            return False
+        print('[reading sp file and launch clock rpt file]')
+        if not self._read_sp_file():
+            return False
+        print('[reading ep file]')
+        if not self._read_ep_file():
+            return False
+        print('[initializing timing groundtruths]')
+        if not self._initialize_timing_groundtruths():
+            return False
+        print('[levelizing]')
+        if not self._levelize():
+            return False
+        if self.level_major_gids:
+            print('[renumbering gids level-major]')
+            self._renumber_gids_level_major()
+        print('[reading pocvm guardband file]')
+        if not self._read_pocvm_file():
+            return False
+        print('[precomputing collaterals]')
+        if not self._precompute_collaterals():
+            return False
+        print(f'[partition merge] initialized in '
+              f'{time.time() - start_time:.2f} seconds')
+        return True
+
+    def do_enable_name_service(self, file_path: Optional[str] = None) -> torch.Tensor:
+        """
+        Bind this run's gids to the design's persistent stable-id table
+
+        Gids are parse-order and shift with every netlist edit, so
+        cross-run tooling joins on pin-name strings. The name service
+        keeps an append-only id per name in a mmap-shared bundle
+        (save_dir/name_service.bin by default, shared by concurrent
+        processes on the same block): this registers every current pin,
+        persists any new names, and returns — and keeps as
+        self.stable_id_tensor — the [max_Gid] gid -> stable-id lut.
+        Cross-run diffs then gather through the lut instead of joining
+        strings. Run after initialization (or a snapshot load).
+        """
+        from ..graph.names import PinNameService
+
+        assert self.Gid_2_pinName, 'initialize (or load a snapshot) first'
+        if file_path is None:
+            file_path = os.path.join(self.save_dir, 'name_service.bin')
+        start_time = time.time()
+        self._name_service = PinNameService(file_path)
+        names = [self.Gid_2_pinName.get(gid, f'__unnamed_gid_{gid}')
+                 for gid in range(self.max_Gid)]
+        self.stable_id_tensor = self._name_service.assign(names)
+        grew = self._name_service.save()
+        print(f'[name service] {len(self._name_service)} stable ids '
+              f'({"updated" if grew else "unchanged"} {file_path}) '
+              f'in {time.time() - start_time:.2f} seconds')
+        return self.stable_id_tensor
+
+    def do_remap_plane_to_stable(self, plane_name: str) -> torch.Tensor:
+        """
+        One timing plane reindexed by stable id for cross-run diffing
+
+        Scatters the worst-candidate column of the named plane into a
+        [num_stable_ids] host tensor positioned by stable id, so two
+        runs' exports subtract elementwise regardless of how their gids
+        were assigned.
+        """
+        assert self.stable_id_tensor is not None, 'run do_enable_name_service first'
+        plane = self.timing_tensors[plane_name]
+        if plane.dim() > 1:
+            plane = plane[:, 0]
+        out = torch.full((len(self._name_service),), float('-inf'),
+                         dtype=torch.float32)
+        out[self.stable_id_tensor] = plane.detach().to(torch.float32).cpu()
+        return out
+
+    @py_scope('do_eval_propagation')
+    def do_eval_propagation(self, plot=False, use_cuda_graph=False,
+                            deterministic=False, async_plot=False,
+                            output_level='full', sigma=3.0, mode='full'):
+        # async_plot hands the reporting tail (CPPR, plots, anal.csv) to
+        # a background worker over a pinned-buffer snapshot, so the
+        # caller can issue the next propagation while reports render;
+        # do_wait_for_reports() joins before the artifacts are read.
+        # output_level ('full' | 'endpoints' | 'summary') trims what
+        # save_arrival_tensors persists — sweep jobs that only consume
+        # endpoint slacks cut their I/O volume by ~99% with 'endpoints'.
+        # sigma picks the POCV guard-band (sigma sweeps evaluate at
+        # 1/2/3 for different signoff modes); it threads down to the
+        # kernels as a runtime device scalar.
+        # mode='fast' runs the calibrated degraded-accuracy sweep (K=1,
+        # mean-only, merged tiny levels) and attaches conservative
+        # per-endpoint error bounds; see do_calibrate_fast_mode
+        if mode == 'fast':
+            if not self._fast_propagate(output_level=output_level):
+                return False
+        elif not self._propagate_arrival(use_cuda_graph=use_cuda_graph,
+                                         deterministic=deterministic,
+                                         output_level=output_level,
+                                         sigma=sigma):
+            return False
+        self._record_snapshot_history()
+
+        if plot:
+            print('[plotting]')
+            if async_plot:
+                self._submit_async_plot()
+            elif not self._plot_correlation(topK=self.topK):
+                return False
+
+        return True
+
+    def _submit_async_plot(self):
+        """
+        Queue the reporting tail on the report worker
+
+        The snapshot's D2H copies are enqueued on the current stream
+        into pinned buffers, so the GPU is free for the next
+        propagation the moment they drain; the worker blocks on the
+        copy-completion event, not the caller. A previous in-flight
+        report is joined first, since it reads the same pinned buffers.
+        """
+        from concurrent.futures import ThreadPoolExecutor
+
+        if self._report_executor is None:
+            self._report_executor = ThreadPoolExecutor(
+                max_workers=1, thread_name_prefix='insta-report')
+        if self._report_future is not None:
+            self._report_future.result()
+
+        snapshot, copy_done = self._snapshot_report_tensors(async_copy=True)
+        topK = self.topK
+
+        def run_report():
+            if copy_done is not None:
+                copy_done.synchronize()
+            return self._plot_correlation_from_snapshot(snapshot, topK=topK)
+
+        self._report_future = self._report_executor.submit(run_report)
+
+    def do_wait_for_reports(self):
+        """Join the in-flight async report, if any; returns its result"""
+        if self._report_future is None:
+            return True
+        result = self._report_future.result()
+        self._report_future = None
+        return result
+
+    def do_calibrate_fast_mode(self, sigma=3.0):
+        """
+        Characterize the degraded-accuracy fast mode against one full run
+
+        Fast mode (do_eval_propagation(mode='fast')) drops exactly two
+        things from the full sweep: the POCV guard-band (it propagates
+        at sigma=0, pure mean mode) and the topK candidate lists (K=1,
+        so no CPPR credit). Both omissions are boundable from one
+        full-accuracy run: the winning path's arrival exceeds the
+        mean-only maximum by at most sigma * std of that path, so the
+        per-endpoint sigma contribution — taken as the max over the topK
+        candidate stds for headroom against delay drift between
+        calibration and query — bounds the arrival underestimate; a
+        depth-scaled rounding term (dtype eps * |arrival| * cell stages)
+        covers reduced-precision accumulation when a half-precision
+        policy is active. This also merges tiny levels once
+        (do_schedule_levels), which is where most of fast mode's launch
+        savings come from on deep designs.
+
+        The calibration run is at full settings, so WNS/TNS afterwards
+        are the reference values; they are kept for fast-mode drift
+        reporting. Recalibrate after large delay updates — the bounds
+        stay sound in direction (fast slack is optimistic by at most the
+        bound) but lose tightness as the design moves.
+        """
+        if not self._fast_levels_scheduled:
+            self.do_schedule_levels()
+            self._fast_levels_scheduled = True
+
+        print('[fast-mode] calibration propagation (full accuracy)')
+        if not self._propagate_arrival(sigma=sigma, output_level='summary'):
+            return False
+
+        dest = self.timing_tensors['dest_node_tensor'].to(torch.long)
+        eps = torch.finfo(self.float_dtype).eps
+
+        # Cell stages per endpoint: even levels carry the cell arcs, so
+        # half the endpoint's level depth bounds the accumulation count
+        stages = torch.tensor(
+            [max(self.node_2_level.get(int(gid), 0) // 2, 1)
+             for gid in dest.tolist()],
+            dtype=torch.float32, device=self.device
+        )
+
+        def bound_of(std_plane, arrival_plane):
+            std = std_plane[dest].to(torch.float32)
+            arr = arrival_plane[dest].to(torch.float32)
+            if std.ndim > 1:
+                std = torch.where(torch.isfinite(std), std,
+                                  torch.zeros_like(std)).max(dim=1).values
+                arr = arr[:, 0]
+            else:
+                std = torch.where(torch.isfinite(std), std,
+                                  torch.zeros_like(std))
+            arr = torch.where(torch.isfinite(arr), arr, torch.zeros_like(arr))
+            return sigma * std + eps * arr.abs() * stages
+
+        rise_bound = bound_of(self.timing_tensors['Gid_2_rise_arrival_std'],
+                              self.timing_tensors['Gid_2_rise_arrival'])
+        fall_bound = bound_of(self.timing_tensors['Gid_2_fall_arrival_std'],
+                              self.timing_tensors['Gid_2_fall_arrival'])
+
+        self._fast_mode = {
+            'sigma': sigma,
+            'dest_node_tensor': dest,
+            'ep_rise_error_bound': rise_bound,
+            'ep_fall_error_bound': fall_bound,
+            'ref_wns': self.wns,
+            'ref_tns': self.tns,
+        }
+        worst = torch.maximum(rise_bound, fall_bound)
+        print(f'[fast-mode] calibrated over {dest.numel()} eps: '
+              f'mean bound {worst.mean().item():.4f}, '
+              f'max bound {worst.max().item():.4f}')
+        return True
+
+    def _fast_propagate(self, output_level='summary'):
+        """
+        The calibrated K=1 / mean-only sweep behind mode='fast'
+
+        Propagates at sigma=0 with K forced to 1 (the planes reallocate
+        for the temporary K and again on the next full run), then
+        attaches the calibrated per-endpoint bounds to timing_tensors as
+        'ep_rise_error_bound' / 'ep_fall_error_bound', aligned with
+        dest_node_tensor. Fast slack is optimistic by at most the bound:
+        the mean-only arrival never exceeds the true arrival and falls
+        short of it by at most the winning path's sigma contribution, so
+        true slack >= fast slack - bound everywhere. The conservative
+        WNS printed alongside applies that worst-case bound — an
+        endpoint clean by more than its bound is clean at signoff sigma.
+        """
+        if self._fast_mode is None:
+            if not self.do_calibrate_fast_mode():
+                return False
+
+        orig_topK = self.topK
+        if orig_topK != 1:
+            self.do_set_topk(1)
+        try:
+            if not self._propagate_arrival(sigma=0.0,
+                                           output_level=output_level):
+                return False
+        finally:
+            if orig_topK != 1:
+                self.do_set_topk(orig_topK)
+
+        self.timing_tensors['ep_rise_error_bound'] = \
+            self._fast_mode['ep_rise_error_bound']
+        self.timing_tensors['ep_fall_error_bound'] = \
+            self._fast_mode['ep_fall_error_bound']
+
+        worst_bound = torch.maximum(
+            self._fast_mode['ep_rise_error_bound'],
+            self._fast_mode['ep_fall_error_bound']
+        ).max()
+        print(f'[fast-mode] wns: {self.wns:.4f} '
+              f'(conservative: {self.wns - worst_bound.item():.4f}), '
+              f'tns: {self.tns:.4f}, '
+              f'calibration wns was {self._fast_mode["ref_wns"]:.4f}')
+        return True
+
+    def do_autotune_propagation(self):
+        """
+        Tune fused-kernel vs torch-formulation dispatch per level shape
+
+        The prebuilt extension's launch configuration is fixed, so the
+        available knob is which implementation serves each level: fused
+        kernels win on wide levels, the batched torch formulation can
+        win on the narrow ones that dominate deep designs. If a tuning
+        table exists in save_dir it is loaded; otherwise one measuring
+        propagation runs both implementations per level under CUDA
+        events, picks a winner per (kind, width bucket, K), and persists
+        the table (outputs/dispatch_tuning.json). Every later
+        propagation of this instance dispatches through the table.
+        """
+        from ..timing.autotune import DispatchTuner
+
+        assert str(self.device).startswith('cuda'), \
+            'dispatch tuning measures CUDA events; run on a CUDA device'
+        tuner = DispatchTuner(self.device, self.topK, self.save_dir)
+        if not tuner.load():
+            tuner.measuring = True
+            self._dispatch_tuner = tuner
+            print('[autotune] measuring propagation (both implementations per level)')
+            if not self._propagate_arrival():
+                self._dispatch_tuner = None
+                return False
+            tuner.finalize()
+        self._dispatch_tuner = tuner
+        return True
+
+    def do_memory_report(self):
+        """
+        Enable per-subsystem GPU memory accounting and print the table
+
+        Accounting is also switched on by INSTA_MEM=1. Once enabled,
+        collateral movement, timing-plane allocation, CPPR tables and
+        the eager/diff sweeps tag their allocations; an OOM inside a
+        tagged region prints the watermark table automatically before
+        the exception propagates. Returns the per-subsystem records
+        (retained bytes, watermark, fragmentation, event counts).
+        """
+        from ..timing import memory
+
+        tracker = memory.enable(self.device)
+        tracker.print_table()
+        return tracker.report()
+
+    def do_profiled_propagation(self, top=20):
+        """
+        One eval propagation under the CUDA-event level profiler
+
+        Unlike log=True (which syncs per level to read time.time() and
+        floods stdout at 4000+ levels), the profiler records event pairs
+        asynchronously and resolves them with a single synchronize after
+        the run, so the measured sweep is the production sweep. Prints
+        the top-N straggler levels and returns the full report dict
+        (per-level width, kernel ms, gather bytes).
+        """
+        from ..timing.profiler import LevelProfiler
+
+        profiler = LevelProfiler(self.device)
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors
+        )
+        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            topk=self.topK,
+            profiler=profiler
+        )
+        profiler.print_summary(top=top)
+        return profiler.report()
+
+    def do_benchmark_propagation(self, n_iters=20, warmup=3):
+        """
+        Steady-state repeat-propagation rate, the number we track
+        release to release
+
+        Single-shot eval latency and the repeat rate an optimizer sees
+        diverge wildly: cold allocator, cold caches and the plot/save
+        tail dominate the former. This runs warmup iterations, then
+        n_iters back-to-back propagations with no plotting or tensor
+        saving and no host sync inside the loop — iteration boundaries
+        are marked with CUDA events resolved once at the end, so the
+        measured loop is the back-to-back loop. Reports mean and p95
+        iteration time, propagations/sec, kernel occupancy (sweep
+        kernel time over GPU iteration time) and the host-overhead
+        fraction (wall time the GPU spent waiting on the host).
+        """
+        from ..timing.profiler import LevelProfiler
+
+        def _one_iteration(profiler=None):
+            self.timing_tensors = clear_timing_cache(
+                self.max_Gid,
+                self.topK,
+                self.device,
+                self.float_dtype,
+                self.sp_mean_tensor,
+                self.sp_std_tensor,
+                self.ep_rise_required_truth,
+                self.ep_fall_required_truth,
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.source_nodes,
+                self.dest_nodes,
+                self.timing_tensors
+            )
+            self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+                self.timing_tensors,
+                self.level_2_collaterals,
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                topk=self.topK,
+                profiler=profiler,
+                tuner=self._dispatch_tuner
+            )
+
+        is_cuda = str(self.device).startswith('cuda')
+        print(f'[benchmark] warming up ({warmup} iterations)')
+        for _ in range(warmup):
+            _one_iteration()
+        if is_cuda:
+            torch.cuda.synchronize(self.device)
+
+        profiler = LevelProfiler(self.device)
+        boundaries = []
+        if is_cuda:
+            event = torch.cuda.Event(enable_timing=True)
+            event.record()
+            boundaries.append(event)
+        wall_start = time.perf_counter()
+        for _ in range(n_iters):
+            _one_iteration(profiler=profiler)
+            if is_cuda:
+                event = torch.cuda.Event(enable_timing=True)
+                event.record()
+                boundaries.append(event)
+            else:
+                boundaries.append(time.perf_counter())
+        if is_cuda:
+            torch.cuda.synchronize(self.device)
+        wall_s = time.perf_counter() - wall_start
+
+        if is_cuda:
+            iter_ms = [boundaries[i].elapsed_time(boundaries[i + 1])
+                       for i in range(n_iters)]
+        else:
+            starts = [wall_start] + boundaries[:-1]
+            iter_ms = [(end - start) * 1e3
+                       for start, end in zip(starts, boundaries)]
+
+        kernel_ms = profiler.report()['total_ms']
+        gpu_ms = sum(iter_ms)
+        report = {
+            'n_iters': n_iters,
+            'mean_iter_ms': gpu_ms / n_iters,
+            'p95_iter_ms': sorted(iter_ms)[max(0, int(round(0.95 * n_iters)) - 1)],
+            'props_per_sec': n_iters / wall_s,
+            'kernel_occupancy': kernel_ms / gpu_ms if gpu_ms > 0 else 0.0,
+            'host_overhead_fraction': max(0.0, 1.0 - gpu_ms / (wall_s * 1e3))
+        }
+        print(f"[benchmark] {n_iters} iterations: "
+              f"{report['mean_iter_ms']:.2f} ms mean, "
+              f"{report['p95_iter_ms']:.2f} ms p95, "
+              f"{report['props_per_sec']:.2f} props/sec")
+        print(f"[benchmark] kernel occupancy {report['kernel_occupancy']:.1%}, "
+              f"host overhead {report['host_overhead_fraction']:.1%}")
+        return report
+
+    def do_launch_capture_propagation(self, launch_sp_mean_tensor=None,
+                                      launch_sp_std_tensor=None, log=False):
+        """
+        Propagate launch and capture clock configurations in one sweep
+
+        CPPR needs arrivals under both latency sets; running two
+        sequential eval sweeps doubles the wall time, and adjusting per
+        endpoint on the host afterwards serializes on a full plane
+        download. Both configurations read the same collaterals and
+        write disjoint planes, so the two sweeps overlap on separate
+        CUDA streams (see propagate_dual_arrival_times).
+
+        When no launch tensors are given they are built from
+        spName_2_attributes: column 0 is the launch clock latency
+        (sp_attributes.csv / clock_latency_timing_launch.rpt), column 2
+        the shared std. Capture results land in self.timing_tensors and
+        self.wns/self.tns as usual; launch arrivals stay in
+        self.launch_timing_tensors for CPPR credit math.
+        """
+        from ..timing.propagation import propagate_dual_arrival_times
+
+        if launch_sp_mean_tensor is None:
+            launch_sp_mean_tensor = self.sp_mean_tensor.clone()
+            launch_sp_std_tensor = self.sp_std_tensor.clone()
+            for spName, sp_attrs in self.spName_2_attributes.items():
+                if spName in self.pinName_2_Gid:
+                    launch_sp_mean_tensor[self.pinName_2_Gid[spName]] = sp_attrs[0]
+        elif launch_sp_std_tensor is None:
+            launch_sp_std_tensor = self.sp_std_tensor
+
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors
+        )
+        self.launch_timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            launch_sp_mean_tensor.to(self.float_dtype),
+            launch_sp_std_tensor.to(self.float_dtype),
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.launch_timing_tensors
+        )
+
+        (self.timing_tensors, self.launch_timing_tensors,
+         self.wns, self.tns) = propagate_dual_arrival_times(
+            self.timing_tensors,
+            self.launch_timing_tensors,
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            topk=self.topK,
+            log=log
+        )
+        print(f'[dual prop] wns: {self.wns}, tns: {self.tns}')
+        return True
+
+    def do_propagate_clock_latencies(self, clock_arcs, source_latencies,
+                                     sigma=3.0):
+        """
+        Propagate clock-network latencies on device and refresh startpoints
+
+        Replaces the clock_latency_timing_launch.rpt round trip: a CTS
+        change hands in clock_arcs — (fromPin, toPin) to (latency_mean,
+        latency_std) over the clock network — and source_latencies, the
+        clock-root pin latencies in the same form, and the levelized
+        subgraph sweep (see timing/clock_tree.py) produces every sink's
+        latency without the reference tool. Startpoints the network
+        reaches get their sp_mean_tensor/sp_std_tensor entries (host and
+        the device copies in timing_tensors) rewritten, and
+        spName_2_attributes is updated with (mean + sigma*std, mean,
+        std) — the rpt's arr/mean/std convention — so the CPPR
+        launch-capture path (do_launch_capture_propagation) picks up the
+        new latencies as well.
+        """
+        from ..timing.clock_tree import (levelize_clock_arcs,
+                                         propagate_clock_latencies)
+
+        clock_levels, root_gids, _ = levelize_clock_arcs(
+            clock_arcs, self.pinName_2_Gid, self.device, self.float_dtype)
+        root_latencies = {}
+        for pinName, lat in source_latencies.items():
+            if pinName not in self.pinName_2_Gid:
+                continue
+            mean, std = lat if isinstance(lat, (tuple, list)) else (lat, 0.0)
+            root_latencies[self.pinName_2_Gid[pinName]] = (mean, std)
+        assert root_latencies, 'no source latency maps to a known pin'
+        unseeded = [g for g in root_gids if g not in root_latencies]
+        if unseeded:
+            print(f'[clock tree] warning: {len(unseeded)} clock roots '
+                  'without a source latency stay unreached')
+
+        lat_mean, lat_std = propagate_clock_latencies(
+            clock_levels, root_latencies, self.max_Gid, self.device,
+            self.float_dtype, sigma=sigma)
+
+        # Rewrite only startpoints the clock network reaches; other sps
+        # keep their parsed latencies
+        mean_cpu = lat_mean.cpu()
+        std_cpu = lat_std.cpu()
+        updated = torch.isfinite(mean_cpu) & torch.isfinite(self.sp_mean_tensor)
+        self.sp_mean_tensor[updated] = mean_cpu[updated].to(self.sp_mean_tensor.dtype)
+        self.sp_std_tensor[updated] = std_cpu[updated].to(self.sp_std_tensor.dtype)
+        if self.timing_tensors and 'sp_mean_tensor' in self.timing_tensors:
+            upd_dev = updated.to(self.device)
+            tt_mean = self.timing_tensors['sp_mean_tensor']
+            tt_std = self.timing_tensors['sp_std_tensor']
+            tt_mean[upd_dev] = lat_mean[upd_dev].to(tt_mean.dtype)
+            tt_std[upd_dev] = lat_std[upd_dev].to(tt_std.dtype)
+
+        refreshed = 0
+        for spName in self.spName_2_attributes:
+            gid = self.pinName_2_Gid.get(spName)
+            if gid is None or not updated[gid]:
+                continue
+            mean = mean_cpu[gid].item()
+            std = std_cpu[gid].item()
+            self.spName_2_attributes[spName] = (mean + sigma * std, mean, std)
+            refreshed += 1
+        print(f'[clock tree] refreshed {refreshed} startpoint latencies')
+        return True
+
+    @py_scope('do_context_propagation')
+    def do_context_propagation(self):
+        """
+        Repeated eval propagation through a pre-allocated PropagationContext
+
+        The first call initializes the timing tensors and builds the context
+        (constant device scalars, cached argument tuple); every later call
+        is allocation-free on the hot path: two arena memsets, the level
+        sweep, and the fused slack reduction. Meant for optimizer loops that
+        re-evaluate timing thousands of times after scattering new delays
+        into the collaterals.
+        """
+        if self.propagation_context is None:
+            self.timing_tensors = clear_timing_cache(
+                self.max_Gid,
+                self.topK,
+                self.device,
+                self.float_dtype,
+                self.sp_mean_tensor,
+                self.sp_std_tensor,
+                self.ep_rise_required_truth,
+                self.ep_fall_required_truth,
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.source_nodes,
+                self.dest_nodes,
+                self.timing_tensors
+            )
+            self.propagation_context = PropagationContext(
+                self.timing_tensors,
+                self.level_2_collaterals,
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                topk=self.topK
+            )
+
+        self.wns, self.tns = self.propagation_context.run()
+        self._record_snapshot_history()
+        return True
+
+    def do_group_slack_analysis(self, group_of=None, log=True):
+        """
+        Per-group WNS/TNS without pulling endpoint slacks to host
+
+        Endpoints are bucketed once into integer group ids and the
+        per-group totals come from segmented device reductions
+        (calculate_group_slack), replacing the full slack download and
+        pandas groupby per optimizer iteration. The default grouping is
+        the path class derived from the parsed ep->sp map — reg2reg,
+        in2reg, reg2out, in2out, with ports recognized as names without
+        a hierarchy separator. Pass group_of (epName -> label) to group
+        differently, e.g. by capture clock via
+        epName_riseFall_2_ckPinName; the bucketing is recomputed and
+        cached whenever group_of is supplied.
+
+        Returns:
+            {group label: (wns, tns)} floats, after one host sync for
+            the whole table
+        """
+        assert self.timing_tensors, 'run a propagation before group slack analysis'
+        from ..timing.pocv import calculate_group_slack
+
+        if self._endpoint_groups is None or group_of is not None:
+            def _path_class(ep_name):
+                sp_name = self.epName_riseFall_2_spName.get((ep_name, 'rise')) \
+                    or self.epName_riseFall_2_spName.get((ep_name, 'fall'))
+                src = 'reg' if (sp_name and '/' in sp_name) else 'in'
+                dst = 'reg' if '/' in ep_name else 'out'
+                return f'{src}2{dst}'
+
+            classify = group_of if group_of is not None else _path_class
+            gid_2_epName = {self.pinName_2_Gid[ep]: ep
+                            for (ep, _) in self.epName_riseFall_2_spName.keys()
+                            if ep in self.pinName_2_Gid}
+            dest_nodes = self.timing_tensors['dest_node_tensor']
+            labels = [classify(gid_2_epName.get(int(gid), '')) or 'default'
+                      for gid in dest_nodes.cpu()]
+            group_names = sorted(set(labels))
+            name_2_id = {name: i for i, name in enumerate(group_names)}
+            group_ids = torch.tensor([name_2_id[label] for label in labels],
+                                     dtype=torch.int64, device=self.device)
+            self._endpoint_groups = (group_ids, group_names)
+
+        group_ids, group_names = self._endpoint_groups
+        group_wns, group_tns = calculate_group_slack(
+            self.timing_tensors['Gid_2_slack'],
+            self.timing_tensors['dest_node_tensor'],
+            group_ids,
+            len(group_names)
+        )
+        group_wns = group_wns.cpu()
+        group_tns = group_tns.cpu()
+        results = {name: (float(group_wns[i]), float(group_tns[i]))
+                   for i, name in enumerate(group_names)}
+        if log:
+            for name, (wns, tns) in results.items():
+                print(f'[group slack] {name}: wns {wns:.4f}, tns {tns:.4f}')
+        return results
+
+    def do_slack_statistics(self, bin_width=0.03, log=True):
+        """
+        Endpoint slack histogram and percentiles without the host round
+        trip
+
+        Runs slack_distribution_stats over Gid_2_slack at the endpoint
+        rows: the gather, fixed-bin histogram and quantiles all reduce
+        on device and only the summaries transfer. The returned dict
+        (counts, bin_edges, percentiles, violation count) is what the
+        plotting side renders from; at 2M endpoints this replaces a
+        full-tensor download that took longer than the propagation.
+        """
+        from ..timing.pocv import slack_distribution_stats
+
+        assert self.timing_tensors and 'Gid_2_slack' in self.timing_tensors, \
+            'run a propagation before requesting slack statistics'
+        stats = slack_distribution_stats(
+            self.timing_tensors['Gid_2_slack'],
+            self.timing_tensors['dest_node_tensor'],
+            bin_width=bin_width
+        )
+        if log:
+            print(f"[slack stats] {stats['num_endpoints']} endpoints, "
+                  f"{stats['num_violating']} violating, "
+                  f"wns {stats['min']:.4f}")
+            for name, value in stats['percentiles'].items():
+                print(f'[slack stats]   {name}: {value:.4f}')
+        return stats
+
+    def do_blame_analysis(self, endpoints=None, top=50, normalize=True, log=True):
+        """
+        Rank the arcs feeding the worst endpoints by blame, on device
+
+        Answers "which arcs contribute to these endpoints' arrival" with
+        one backward sweep over the levelization (reverse_blame_analysis)
+        instead of a per-pin Python BFS over Gid_2_parents: each arc in
+        the selected reverse cones accumulates an occurrence count and a
+        delay-weighted arrival contribution, seeded by the endpoints'
+        top-K path mass. endpoints may be pin names, gids or a gid
+        tensor; the default is every violating endpoint (falling back to
+        the 100 worst when nothing violates). Returns the top arcs as a
+        polars DataFrame sorted by contribution — only those rows ever
+        leave the device.
+        """
+        from ..timing.pocv import reverse_blame_analysis
+        import polars as pl
+
+        assert self.timing_tensors and 'Gid_2_slack' in self.timing_tensors, \
+            'run a propagation before blame analysis'
+        start_time = time.time()
+
+        if endpoints is None:
+            dest = self.timing_tensors['dest_node_tensor'].to(torch.long)
+            slack = self.timing_tensors['Gid_2_slack'][dest]
+            violating = (slack < 0) & torch.isfinite(slack)
+            if bool(violating.any()):
+                ep_gids = dest[violating]
+            else:
+                worst = torch.argsort(slack)[:min(100, dest.numel())]
+                ep_gids = dest[worst]
+        elif isinstance(endpoints, torch.Tensor):
+            ep_gids = endpoints.to(torch.long).to(self.device)
+        elif len(endpoints) > 0 and isinstance(endpoints[0], str):
+            ep_gids = torch.tensor([self.pinName_2_Gid[name] for name in endpoints],
+                                   dtype=torch.long, device=self.device)
+        else:
+            ep_gids = torch.tensor(list(endpoints), dtype=torch.long,
+                                   device=self.device)
+
+        net_count, net_contrib, cell_count, cell_contrib = reverse_blame_analysis(
+            self.level_2_collaterals,
+            ep_gids,
+            len(self.netArcId_2_netArcKey),
+            len(self.cellArcId_2_cellArcKey),
+            self.max_Gid,
+            self.device,
+            timing_tensors=self.timing_tensors,
+            normalize=normalize
+        )
+
+        # Device-side top-k per arc kind, then one small transfer
+        rows = []
+        for kind, count, contrib, id_2_key in (
+                ('net', net_count, net_contrib, self.netArcId_2_netArcKey),
+                ('cell', cell_count, cell_contrib, self.cellArcId_2_cellArcKey)):
+            k = min(top, contrib.numel())
+            if k == 0:
+                continue
+            values, ids = torch.topk(contrib, k)
+            counts = count[ids].cpu().tolist()
+            for arc_id, contribution, occurrence in zip(
+                    ids.cpu().tolist(), values.cpu().tolist(), counts):
+                if occurrence <= 0:
+                    continue
+                key = id_2_key[arc_id]
+                rows.append((kind, key[0], key[1], occurrence, contribution))
+
+        rows.sort(key=lambda r: r[4], reverse=True)
+        rows = rows[:top]
+        table = pl.DataFrame({
+            'kind': [r[0] for r in rows],
+            'fromPin': [r[1] for r in rows],
+            'toPin': [r[2] for r in rows],
+            'count': [r[3] for r in rows],
+            'contribution': [r[4] for r in rows],
+        })
+        if log:
+            print(f'[blame] ranked arcs behind {ep_gids.numel()} endpoints '
+                  f'in {time.time() - start_time:.4f} seconds')
+        return table
+
+    def do_multi_sigma_analysis(self, sigmas=(0.0, 1.5, 3.0), log=True):
+        """
+        Per-sigma endpoint WNS/TNS from the last propagation's candidates
+
+        A signoff at several guard-bands (0/1.5/3 sigma modes) used to
+        cost one full propagation per sigma. Mean/std propagation is
+        sigma-independent, so this re-scores the K endpoint candidates
+        the sweep already kept as mean + sigma*std per requested sigma —
+        endpoint-only elementwise work, all on device. Shared-K
+        approximation: exact whenever each sigma's critical candidate
+        made the anchor-sigma top-K cut (see multi_sigma_endpoint_slacks).
+        Returns the result dict with [S, E] slack planes and [S] WNS/TNS
+        device tensors.
+        """
+        from ..timing.pocv import multi_sigma_endpoint_slacks
+
+        assert self.timing_tensors and 'Gid_2_rise_arrival_mean' in self.timing_tensors, \
+            'run a propagation before requesting multi-sigma analysis'
+        result = multi_sigma_endpoint_slacks(self.timing_tensors,
+                                             sigmas=tuple(sigmas))
+        if log:
+            wns = result['wns'].cpu().tolist()
+            tns = result['tns'].cpu().tolist()
+            for s, w, t in zip(sigmas, wns, tns):
+                print(f'[multi-sigma] sigma {s:g}: WNS {w:.4f}, TNS {t:.4f}')
+        return result
+
+    def do_set_required_sigma(self, sigma: float, derate: float = 1.0):
+        """
+        Retarget the endpoint required times to a sigma/derate setting
+
+        initialize_timing_tensors bakes required times at the signoff
+        sigma of the ep CSV; changing analysis sigma (or running a clock
+        derate experiment) used to mean regenerating ep_attributes.csv
+        externally. The required-time components (the lumped period/setup
+        base and the capture latency mean/std carried in the ep rows) are
+        split out once and kept on device; every later call is one fused
+        elementwise pass that rewrites ep_rise/fall_required_truth and,
+        when timing tensors exist, refreshes the endpoint-gathered
+        ep_rise/fall_required planes in place — so a live
+        PropagationContext (which holds references into them) sees the
+        new requirements on its next run without a rebuild. Re-run the
+        slack pass (or a propagation) afterwards to refresh slacks.
+        """
+        from ..timing.pocv import (build_required_time_components,
+                                   recompute_required_times)
+        start_time = time.time()
+        if self._required_components is None:
+            self._required_components = build_required_time_components(
+                self.epName_riseFall_2_attributes,
+                self.pinName_2_Gid,
+                self.max_Gid,
+                self.float_dtype,
+                signoff_sigma=DEFAULT_SIGMA,
+                device=self.device
+            )
+        rise, fall = recompute_required_times(
+            self._required_components, sigma, derate=derate)
+        self.ep_rise_required_truth = rise.cpu()
+        self.ep_fall_required_truth = fall.cpu()
+
+        if self.timing_tensors and 'ep_rise_required' in self.timing_tensors:
+            dest = self.timing_tensors['dest_node_tensor'].to(torch.long)
+            self.timing_tensors['ep_rise_required'].copy_(
+                rise.index_select(0, dest))
+            self.timing_tensors['ep_fall_required'].copy_(
+                fall.index_select(0, dest))
+        print(f'[required sigma] retargeted required times to sigma '
+              f'{sigma:g}, derate {derate:g} in '
+              f'{time.time() - start_time:.6f} seconds')
+
+    def estimate_tns_delta(self, gids, deltas, applied: bool = False,
+                           drift_budget: float = 0.05):
+        """
+        First-order TNS delta estimate for a candidate move, no sweep
+
+        Scores the move as dot(stage_grad, delay_delta) over the stage
+        gradients cached by do_extract_arc_grads — one gather per call,
+        fast enough to rank every candidate a placer generates. gids are
+        the output-pin Gids of the touched stages; deltas is [M] for one
+        move or [M, N] for N candidates over the same stages, returned
+        as a scalar or [N] device tensor (leave it on device in a hot
+        loop).
+
+        Pass applied=True when the move is committed: the estimator
+        charges its first-order TNS magnitude against drift_budget, and
+        once the budget is exhausted the gradients no longer describe
+        the design — it warns once, and the next do_extract_arc_grads
+        (after a true propagation) rebuilds the estimator.
+        """
+        assert getattr(self, 'stage_grad_tensor', None) is not None, \
+            'run do_extract_arc_grads before estimating TNS deltas'
+        from ..timing.pocv import TnsEstimator
+
+        if self._tns_estimator is None:
+            self._tns_estimator = TnsEstimator(
+                self.stage_grad_tensor, drift_budget=drift_budget)
+
+        device = self._tns_estimator._grads.device
+        if not torch.is_tensor(gids):
+            gids = torch.tensor(gids, dtype=torch.long)
+        gids = gids.to(torch.long).to(device)
+        if not torch.is_tensor(deltas):
+            deltas = torch.tensor(deltas)
+        deltas = deltas.to(device)
+
+        was_stale = self._tns_estimator.is_stale()
+        score = self._tns_estimator.estimate(gids, deltas)
+        if applied:
+            self._tns_estimator.note_applied(gids, deltas)
+            if not was_stale and self._tns_estimator.is_stale():
+                print('[tns estimate] drift budget exhausted: scores are '
+                      'stale, re-propagate and re-extract gradients')
+        return score
+
+    def query_pins(self, pins, fields=None):
+        """
+        Bulk timing query over a batch of pins, returned as a table
+
+        Resolves all names against the packed pin index with one join
+        (no per-pin dict loop) and performs one gather per requested
+        field over the timing planes, so a 50k-pin bus query is a
+        handful of kernels plus one transfer per column. pins may be a
+        list of names, a list of gids, or a gid tensor. fields defaults
+        to rise/fall arrival, rise/fall std, slack, level and the
+        rise/fall worst startpoints. Returns a polars DataFrame
+        (arrow-backed; .to_arrow() for pyarrow consumers).
+        """
+        import polars as pl
+
+        default_fields = ('rise_arrival', 'fall_arrival',
+                          'rise_std', 'fall_std', 'slack', 'level',
+                          'rise_startpoint', 'fall_startpoint')
+        fields = tuple(fields) if fields is not None else default_fields
+
+        if isinstance(pins, torch.Tensor):
+            gids = pins.to(torch.long).cpu()
+            names = [self.Gid_2_pinName[g] for g in gids.tolist()]
+        elif len(pins) > 0 and isinstance(pins[0], int):
+            gids = torch.tensor(pins, dtype=torch.long)
+            names = [self.Gid_2_pinName[g] for g in pins]
+        else:
+            if self._pin_index_df is None:
+                self._pin_index_df = pl.DataFrame({
+                    'pinName': list(self.pinName_2_Gid.keys()),
+                    'gid': list(self.pinName_2_Gid.values())
+                })
+            requested = pl.DataFrame({'pinName': list(pins)})
+            joined = requested.join(self._pin_index_df, on='pinName', how='left')
+            unknown = joined.filter(pl.col('gid').is_null())
+            assert unknown.height == 0, \
+                f"unknown pins in query: {unknown['pinName'].head(5).to_list()}"
+            names = joined['pinName'].to_list()
+            gids = torch.tensor(joined['gid'].to_list(), dtype=torch.long)
+
+        device_gids = gids.to(self.device)
+
+        def worst_column(plane):
+            rows = plane[device_gids]
+            return (rows[:, 0] if rows.dim() > 1 else rows).to(torch.float32)
+
+        columns = {'pinName': names}
+        for field in fields:
+            if field == 'rise_arrival':
+                values = worst_column(self.timing_tensors['Gid_2_rise_arrival'])
+            elif field == 'fall_arrival':
+                values = worst_column(self.timing_tensors['Gid_2_fall_arrival'])
+            elif field == 'rise_std':
+                values = worst_column(self.timing_tensors['Gid_2_rise_arrival_std'])
+            elif field == 'fall_std':
+                values = worst_column(self.timing_tensors['Gid_2_fall_arrival_std'])
+            elif field == 'slack':
+                values = self.timing_tensors['Gid_2_slack'][device_gids].to(torch.float32)
+            elif field == 'level':
+                if self._gid_level_tensor is None:
+                    levels = torch.full((self.max_Gid,), -1, dtype=torch.int32)
+                    for name, gid in self.pinName_2_Gid.items():
+                        levels[gid] = self.node_2_level.get(name, -1)
+                    self._gid_level_tensor = levels.to(self.device)
+                values = self._gid_level_tensor[device_gids]
+            elif field == 'rise_startpoint':
+                rows = self.timing_tensors['Gid_2_rise_startpoints'][device_gids]
+                values = rows[:, 0] if rows.dim() > 1 else rows
+            elif field == 'fall_startpoint':
+                rows = self.timing_tensors['Gid_2_fall_startpoints'][device_gids]
+                values = rows[:, 0] if rows.dim() > 1 else rows
+            else:
+                raise AssertionError(f'unknown query field: {field}')
+            columns[field] = values.cpu().numpy()
+
+        return pl.DataFrame(columns)
+
+    def do_enable_snapshot_history(self, capacity: int = 10):
+        """
+        Keep a rolling delta ring of the last N propagation states
+
+        Arms SnapshotRing: every do_eval_propagation (and
+        do_context_propagation) records the changed rows versus the
+        previous state, so N retained snapshots cost one full host copy
+        plus the deltas instead of N full saves. Reconstruct with
+        do_snapshot_history_state; built for optimizer-divergence
+        debugging, where the question is always "what moved between
+        iteration k and k-1".
+        """
+        from .snapshot import SnapshotRing
+
+        self._snapshot_ring = SnapshotRing(capacity=capacity)
+        print(f'[snapshot ring] recording the last {capacity} propagation '
+              f'states as deltas')
+
+    def _record_snapshot_history(self):
+        if self._snapshot_ring is None or not self.timing_tensors:
+            return
+        changed = self._snapshot_ring.record(self.timing_tensors,
+                                             wns=self.wns, tns=self.tns)
+        print(f'[snapshot ring] recorded state {len(self._snapshot_ring.history())}'
+              f' ({changed} changed rows, '
+              f'{self._snapshot_ring.storage_bytes() / 1e9:.3f} GB retained)')
+
+    def do_snapshot_history_state(self, steps_back: int = 0):
+        """
+        Reconstruct the timing planes steps_back propagations ago
+
+        Returns host tensors keyed by plane name (worst candidate
+        column); steps_back=0 is the latest recorded state. O(changed
+        rows) replay, no full-state storage behind it.
+        """
+        assert self._snapshot_ring is not None, \
+            'call do_enable_snapshot_history first'
+        return self._snapshot_ring.state(steps_back)
+
+    def do_snapshot_endpoint_state(self):
+        """
+        Capture the current endpoint slacks/arrivals as the diff
+        reference
+
+        Clones stay on device; do_diff_endpoints compares later runs
+        against them without any host transfer.
+        """
+        assert self.timing_tensors and 'Gid_2_slack' in self.timing_tensors, \
+            'run a propagation before snapshotting endpoint state'
+        dest = self.timing_tensors['dest_node_tensor'].to(torch.long)
+        rise = self.timing_tensors['Gid_2_rise_arrival']
+        fall = self.timing_tensors['Gid_2_fall_arrival']
+        self._endpoint_reference = {
+            'dest': dest.clone(),
+            'slack': self.timing_tensors['Gid_2_slack'][dest].detach().clone(),
+            'rise_arrival': (rise[dest, 0] if rise.dim() > 1
+                             else rise[dest]).detach().clone(),
+            'fall_arrival': (fall[dest, 0] if fall.dim() > 1
+                             else fall[dest]).detach().clone(),
+        }
+        return True
+
+    def do_diff_endpoints(self, threshold=1e-4, top=None, log=True):
+        """
+        Report only the endpoints whose slack moved since the snapshot
+
+        The ECO flow used to diff two full anal.csv files in pandas even
+        though >99% of endpoints are unchanged run to run. Here the
+        comparison against the do_snapshot_endpoint_state reference is a
+        handful of elementwise kernels on device; only the moved rows
+        (|delta| > threshold, or a finite/-inf validity flip) cross to
+        host, sorted by |delta| descending, and pin names are resolved
+        just for those rows. Returns a list of
+        (epName, ref_slack, new_slack, delta) tuples, capped at top.
+        """
+        assert self._endpoint_reference is not None, \
+            'call do_snapshot_endpoint_state before do_diff_endpoints'
+        ref = self._endpoint_reference
+        dest = ref['dest']
+        cur_slack = self.timing_tensors['Gid_2_slack'][dest].to(torch.float32)
+        ref_slack = ref['slack'].to(torch.float32)
+
+        finite_cur = torch.isfinite(cur_slack)
+        finite_ref = torch.isfinite(ref_slack)
+        both = finite_cur & finite_ref
+        delta = torch.where(both, cur_slack - ref_slack,
+                            torch.zeros_like(cur_slack))
+        moved = (delta.abs() > threshold) | (finite_cur ^ finite_ref)
+
+        moved_idx = moved.nonzero().squeeze(1)
+        order = delta[moved_idx].abs().argsort(descending=True)
+        moved_idx = moved_idx[order]
+        if top is not None:
+            moved_idx = moved_idx[:top]
+
+        # Only the moved rows transfer; names resolve lazily per row
+        moved_gids = dest[moved_idx].cpu().tolist()
+        moved_ref = ref_slack[moved_idx].cpu().tolist()
+        moved_cur = cur_slack[moved_idx].cpu().tolist()
+        moved_delta = delta[moved_idx].cpu().tolist()
+
+        results = [(self.Gid_2_pinName[gid], r, c, d)
+                   for gid, r, c, d in zip(moved_gids, moved_ref,
+                                           moved_cur, moved_delta)]
+        if log:
+            print(f'[endpoint diff] {len(results)} endpoints moved '
+                  f'beyond {threshold} (of {dest.numel()})')
+            for epName, r, c, d in results[:20]:
+                print(f'[endpoint diff]   {epName}: {r:.4f} -> {c:.4f} '
+                      f'({d:+.4f})')
+        return results
+
+    def do_set_float_dtype(self, float_dtype: torch.dtype):
+        """
+        Switch the propagation precision (fp32 or bf16/fp16)
+
+        bf16 halves the dominant arrival/std tensors and lets the extension
+        dispatch to its bfloat16 kernels; the net-arc std update keeps fp32
+        accumulation regardless. Collateral tables are cast in place and the
+        cached timing tensors are dropped so the next call reallocates.
+        """
+        assert float_dtype in (torch.float32, torch.float16, torch.bfloat16), \
+            f'unsupported float dtype: {float_dtype}'
+        if float_dtype == self.float_dtype:
+            return
+        self.float_dtype = float_dtype
+        self.sp_mean_tensor = self.sp_mean_tensor.to(float_dtype)
+        self.sp_std_tensor = self.sp_std_tensor.to(float_dtype)
+        self.ep_rise_required_truth = self.ep_rise_required_truth.to(float_dtype)
+        self.ep_fall_required_truth = self.ep_fall_required_truth.to(float_dtype)
+        if self.level_2_collaterals is not None:
+            self.level_2_collaterals = cast_collaterals_dtype(self.level_2_collaterals, float_dtype)
+        self.timing_tensors = {}
+        self.propagation_context = None
+        if self.graph_propagator is not None:
+            self.graph_propagator.reset()
+        print(f'INSTA set float dtype to {float_dtype}')
+
+    def do_quantize_collaterals(self, storage_dtype: torch.dtype = torch.float16):
+        """
+        Store the per-arc delay/std/sigma tables in half precision
+
+        After the scale normalization applied in read_cell_arc_file the
+        delay values span a tiny dynamic range, so fp16 storage loses very
+        little; the sweep dequantizes one level at a time back to the
+        compute dtype. Halves collateral memory, which is what bounds the
+        largest design that stays fully resident. Compute precision
+        (float_dtype) is unchanged; the diff path needs full-precision
+        tables for gradient extraction, so quantize only for eval flows.
+        """
+        assert storage_dtype in (torch.float16, torch.bfloat16), \
+            f'unsupported storage dtype: {storage_dtype}'
+        self.level_2_collaterals = cast_collaterals_dtype(self.level_2_collaterals, storage_dtype)
+        # Captured graphs and cached contexts hold pointers into the old
+        # fp32 tables; drop them so the next propagation rebinds
+        self.propagation_context = None
+        if self.graph_propagator is not None:
+            self.graph_propagator.reset()
+        print(f'INSTA quantized collateral tables to {storage_dtype}')
+
+    def do_set_level_dtype_policy(self, depth_fraction: float = 0.8,
+                                  trunk_dtype: torch.dtype = torch.bfloat16):
+        """
+        Half-precision trunk, full-precision endpoint levels
+
+        Applies cast_collaterals_dtype_policy: collateral tables of
+        levels below depth_fraction of the schedule are stored in
+        trunk_dtype while the remaining (endpoint-adjacent) levels keep
+        fp32, and the sweep's per-level dequantize handles the casting
+        gather at the transition. Captures most of
+        do_quantize_collaterals' memory win without the endpoint
+        correlation loss of quantizing everything. Keep float_dtype at
+        fp32 — the policy governs storage, not arithmetic.
+        """
+        from ..timing.collaterals import cast_collaterals_dtype_policy
+
+        assert trunk_dtype in (torch.float16, torch.bfloat16), \
+            f'unsupported trunk dtype: {trunk_dtype}'
+        assert 0.0 < depth_fraction <= 1.0, \
+            f'depth_fraction must be in (0, 1]: {depth_fraction}'
+        self.level_2_collaterals = cast_collaterals_dtype_policy(
+            self.level_2_collaterals, depth_fraction,
+            trunk_dtype=trunk_dtype)
+        # Same rebind rule as do_quantize_collaterals: cached contexts
+        # and captured graphs point into the old tables
+        self.propagation_context = None
+        if self.graph_propagator is not None:
+            self.graph_propagator.reset()
+        return True
+
+    def do_check_half_precision_correlation(self, float_dtype: torch.dtype = torch.bfloat16):
+        """
+        Propagate in fp32 and in the given half precision, and report the
+        endpoint-arrival correlation between the two (sanity gate for bf16)
+        """
+        self.do_set_float_dtype(torch.float32)
+        if not self._propagate_arrival():
+            return None
+        dest = self.timing_tensors['dest_node_tensor'].to(torch.long)
+        ref = self.timing_tensors['Gid_2_slack'][dest].to(torch.float32).cpu()
+
+        self.do_set_float_dtype(float_dtype)
+        if not self._propagate_arrival():
+            return None
+        half = self.timing_tensors['Gid_2_slack'][dest].to(torch.float32).cpu()
+
+        valid = torch.isfinite(ref) & torch.isfinite(half)
+        corr = torch.corrcoef(torch.stack([ref[valid], half[valid]]))[0, 1].item()
+        max_err = (ref[valid] - half[valid]).abs().max().item()
+        print(f'[dtype check] fp32 vs {float_dtype}: corr {corr:.6f}, max |slack err| {max_err:.6f}')
+        return corr
+
+    def do_kernel_differential_check(self, topk_values=(1, 8), atol=1e-4,
+                                     rtol=1e-4):
+        """
+        Vet the arrival kernels against the golden reference fixtures
+
+        Runs the shipped kernel path over the randomized property
+        fixtures (fanin sweeps, dangling parents, K widths) and asserts
+        elementwise agreement with the independent pure-torch golden
+        propagator — the same harness kernel changes must pass before
+        landing (see timing/verification.py). Uses this instance's
+        device and float dtype; raises on the first disagreement.
+        """
+        from ..timing.verification import run_differential_harness, default_fixtures
+
+        return run_differential_harness(
+            fixtures=default_fixtures(device=self.device,
+                                      float_dtype=self.float_dtype),
+            topk_values=tuple(topk_values), atol=atol, rtol=rtol
+        )
+
+    def do_required_propagation(self):
+        """
+        Backward-propagate required times so every pin gets a true slack
+
+        Must follow do_eval_propagation; fills Gid_2_rise/fall_required and
+        turns the endpoint-only slack planes into full per-pin slacks.
+        """
+        if not self.timing_tensors or 'dest_node_tensor' not in self.timing_tensors:
+            print('[required propagation] run do_eval_propagation first')
+            return False
+
+        self.timing_tensors = propagate_required_times(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            self.float_dtype
+        )
+        return True
+
+    def do_hold_propagation(self, ep_hold_rise_required=None, ep_hold_fall_required=None):
+        """
+        Early-mode (min-delay) sweep over the same levelized collaterals
+
+        Must follow do_eval_propagation (the sweep reuses its startpoint
+        and endpoint tensors). Fills Gid_2_rise/fall_arrival_early and
+        Gid_2_hold_slack and records hold WNS/TNS on self.hold_wns /
+        self.hold_tns. Hold required-time truths are per-Gid tensors like
+        the setup ones; with none given the requirement is zero.
+        """
+        if not self.timing_tensors or 'dest_node_tensor' not in self.timing_tensors:
+            print('[hold propagation] run do_eval_propagation first')
+            return False
+
+        self.hold_wns, self.hold_tns = propagate_hold_arrival_times(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            ep_hold_rise_required,
+            ep_hold_fall_required
+        )
+        return True
+
+    def do_gpu_cppr_correction(self):
+        """
+        Apply CPPR credit on device, straight off the propagated Gid tensors
+
+        The legacy path (apply_cppr_correction in timing/pocv.py) copies all
+        Gid_2_* tensors to host and loops over endpoints in Python; here the
+        ep -> golden-startpoint maps are tensorized once and the topK scan
+        runs as a handful of batched ops on the propagation device.
+
+        Returns the corrected per-endpoint arrivals/startpoints dict from
+        apply_cppr_correction_gpu, or None if no propagation has run yet.
+        """
+        if not self.timing_tensors or 'dest_node_tensor' not in self.timing_tensors:
+            print('[gpu-cppr] no propagated timing tensors, run do_eval_propagation first')
+            return None
+
+        if self.cppr_tensors is None:
+            self.cppr_tensors = build_cppr_tensors(
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.max_Gid,
+                self.device
+            )
+
+        from ..timing.profiler import nvtx_range
+        with nvtx_range('cppr correction'):
+            corrected = apply_cppr_correction_gpu(
+                self.timing_tensors['Gid_2_rise_arrival'],
+                self.timing_tensors['Gid_2_rise_startpoints'],
+                self.timing_tensors['Gid_2_fall_arrival'],
+                self.timing_tensors['Gid_2_fall_startpoints'],
+                self.timing_tensors['dest_node_tensor'],
+                self.cppr_tensors,
+                self.topK if self.timing_tensors['Gid_2_rise_arrival'].ndim > 1 else 1
+            )
+        print(f'[gpu-cppr] # ep mismatch: {corrected["cnt_mismatch"].item()}, '
+              f'# corrected by topK crpr: {corrected["cnt_found_crpr"].item()}')
+        return corrected
+
+    def do_evaluate_accuracy(self, worst_n=32, log=True):
+        """
+        Truth-vs-prediction accuracy straight off the propagated planes
+
+        The plotting path joins truth against prediction on host over a
+        full snapshot — fine once per run, far too slow per iteration.
+        This compares against the endpoint-compact device truth table
+        built at initialization: CPPR candidate substitution, slack
+        deltas, Pearson correlation and the worst-offender scan all run
+        as device ops, and only the summary scalars plus worst_n
+        offender rows ever reach host. An optimizer loop can therefore
+        track signoff accuracy every evaluation for propagation plus
+        epsilon; with log=False the returned dict holds device scalars
+        and nothing syncs at all.
+        """
+        if not self.timing_tensors or 'Gid_2_rise_arrival' not in self.timing_tensors:
+            print('[accuracy] no propagated timing tensors, run do_eval_propagation first')
+            return None
+
+        if self._cppr_metadata is None:
+            self._cppr_metadata = build_cppr_metadata(
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.dest_nodes,
+                self.Gid_2_pinName
+            )
+        if self._groundtruth_gpu is None:
+            self._groundtruth_gpu = build_groundtruth_device_tensors(
+                self._cppr_metadata,
+                self.ep_rise_arrival_truth, self.ep_rise_required_truth,
+                self.ep_rise_slack_truth, self.ep_rise_depth_truth,
+                self.ep_fall_arrival_truth, self.ep_fall_required_truth,
+                self.ep_fall_slack_truth, self.ep_fall_depth_truth,
+                self.device
+            )
+
+        from ..timing.profiler import nvtx_range
+        with nvtx_range('groundtruth compare'):
+            report = compare_to_groundtruth_gpu(
+                self.timing_tensors['Gid_2_rise_arrival'],
+                self.timing_tensors['Gid_2_rise_startpoints'],
+                self.timing_tensors['Gid_2_fall_arrival'],
+                self.timing_tensors['Gid_2_fall_startpoints'],
+                self._groundtruth_gpu,
+                worst_n=worst_n
+            )
+
+        if log:
+            print(f'[accuracy] pearson r: {report["pearson_r"].item():.4f}, '
+                  f'mean |err|: {report["mean_abs_err"].item():.4f}, '
+                  f'max |err|: {report["max_abs_err"].item():.4f}, '
+                  f'rms: {report["rms_err"].item():.4f} '
+                  f'over {int(report["num_eps"].item())} eps')
+            print(f'[accuracy] wns true/pred: {report["true_wns"].item():.4f} / '
+                  f'{report["pred_wns"].item():.4f}, tns true/pred: '
+                  f'{report["true_tns"].item():.4f} / {report["pred_tns"].item():.4f}')
+            worst = zip(report['worst_ep_gids'].tolist(),
+                        report['worst_true_slack'].tolist(),
+                        report['worst_pred_slack'].tolist(),
+                        report['worst_is_rise'].tolist())
+            for gid, true_slack, pred_slack, is_rise in list(worst)[:10]:
+                print(f'  {self.Gid_2_pinName[gid]} '
+                      f'({"rise" if is_rise else "fall"}): '
+                      f'true {true_slack:.4f} vs pred {pred_slack:.4f}')
+
+        return report
+
+    def do_enable_fused_cppr(self, enable: bool = True):
+        """
+        Fuse CPPR credit into the propagation slack pass
+
+        Once enabled, every eval and diff propagation produces corrected
+        and uncorrected slacks in the same pass over dest_node_tensor:
+        the golden-startpoint candidate scan rides the endpoint gathers
+        calculate_slack_fused already does, leaving corrected slacks in
+        timing_tensors['Gid_2_cppr_slack'] and corrected WNS/TNS device
+        scalars in 'cppr_wns'/'cppr_tns'. The correction is
+        differentiable, so optimizer loops can descend on corrected TNS
+        instead of overfixing endpoints whose violation is common-point
+        pessimism. Needs topK > 1 and tracked startpoints to find the
+        golden path in the candidate lists.
+        """
+        if enable and self.cppr_tensors is None:
+            self.cppr_tensors = build_cppr_tensors(
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.max_Gid,
+                self.device
+            )
+        self._fuse_cppr = enable
+        print(f'[gpu-cppr] fused slack correction '
+              f'{"enabled" if enable else "disabled"}')
+
+    def do_enable_compiled_glue(self, enable: bool = True):
+        """
+        torch.compile the elementwise glue between the custom kernels
+
+        The net-arc level math, the endpoint slack reduction and the CPPR
+        candidate scan are eager torch chains of a handful of elementwise
+        ops each; inductor fuses every chain into one kernel, which is a
+        cheap win on the non-kernel fraction of propagation. The chains
+        are dispatched per level with static shapes (dynamic=False), and
+        any compilation or first-call failure demotes the affected chain
+        back to eager — results are identical either way.
+        """
+        from ..timing.glue import enable_compiled_glue
+        self.compile_glue = enable_compiled_glue(enable)
+        print(f'[compile glue] compiled dispatch '
+              f'{"active" if self.compile_glue else "inactive (eager)"}')
+
+    def do_enable_strict_alloc(self):
+        """
+        Assert the steady-state propagation stays allocation-free
+
+        Arms strict allocation checking (equivalent to
+        INSTA_STRICT_ALLOC=1): each phase of do_context_propagation —
+        plane reset, arrival sweep, fused slack — snapshots the
+        torch.cuda.memory_stats allocation counters at its boundaries.
+        The first strict run calibrates each phase's steady-state
+        counts; any later run that allocates beyond that baseline, or
+        maps a new cudaMalloc segment at all, raises immediately with
+        the allocating stacks when the allocator's history recorder is
+        available. Use it in CI around an optimizer-loop smoke test so
+        allocator churn regressions (a per-call torch.tensor, a stray
+        temporary) fail the run instead of surfacing as p95 latency
+        jumps under fragmentation.
+        """
+        from ..timing.memory import enable_strict_alloc
+        enable_strict_alloc()
+        print('[strict alloc] zero-allocation checking armed for '
+              'context propagation')
+
+    def do_two_phase_propagation(self, slack_margin: float = 0.05, refine_topK: Optional[int] = None):
+        """
+        Two-phase propagation: cheap K=1 screening pass, then top-K
+        refinement restricted to the near-critical fanin cone
+
+        Phase 1 runs the flattened K=1 propagation over the whole design and
+        selects endpoints whose slack is within slack_margin of WNS. Phase 2
+        rebuilds collaterals for the union fanin cone of those endpoints and
+        re-propagates only that cone at refine_topK (default self.topK), so
+        full-K accuracy is paid only where CPPR credit can matter.
+        """
+        refine_topK = refine_topK if refine_topK is not None else self.topK
+
+        # --- phase 1: K=1 screening over the full design -----------------
+        orig_topK = self.topK
+        self.do_set_topk(1)
+        if not self._propagate_arrival():
+            return False
+
+        dest_tensor = self.timing_tensors['dest_node_tensor'].to(torch.long)
+        ep_slacks = self.timing_tensors['Gid_2_slack'][dest_tensor]
+        valid_mask = ~torch.isinf(ep_slacks)
+        if not valid_mask.any():
+            print('[two-phase] no valid endpoint slacks after screening pass')
+            self.do_set_topk(orig_topK)
+            return False
+
+        wns = ep_slacks[valid_mask].min()
+        near_critical_mask = valid_mask & (ep_slacks <= wns + slack_margin)
+        near_critical_eps = dest_tensor[near_critical_mask].tolist()
+        print(f'[two-phase] wns: {wns.item():.4f}, '
+              f'# near-critical eps: {len(near_critical_eps)} / {int(valid_mask.sum())}')
+
+        # --- phase 2: top-K refinement on the near-critical cone ---------
+        cone_level_2_nodes = self._extract_fanin_cone_levels(near_critical_eps)
+        (cone_collaterals, _, _, _, _, _, _, _, _, _) = precompute_collaterals(
+            self.net_arc_2_variation,
+            self.cell_arc_2_variation,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            cone_level_2_nodes,
+            self.Gid_2_pinName,
+            self.inPin_parent_tensor,
+            self.Gid_2_parents,
+            self.device,
+            self.max_Gid,
+            self.cellName_2_orgLibCell,
+            self.libCell_2_riseFallguardband,
+            self.libCell_2_riseFallStd,
+            self.net_2_pocvScaling,
+            self.float_dtype,
+            self.save_dir,
+            use_cache=False,
+            save=False
+        )
+        if str(self.device) != 'cpu':
+            cone_collaterals = move_collaterals_to_device(cone_collaterals, self.device)
+
+        self.do_set_topk(refine_topK)
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors
+        )
+        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+            self.timing_tensors,
+            cone_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            topk=self.topK
+        )
+
+        self.do_set_topk(orig_topK)
+        return True
+
+    def _extract_fanin_cone_levels(self, endpoints: List[int]) -> Dict[int, List[int]]:
+        """
+        Collect the union fanin cone of the given endpoints and return it as
+        a level_2_nodes dict (levels taken from the full-design levelization)
+        """
+        cone_nodes = set()
+        frontier = list(endpoints)
+        while frontier:
+            node = frontier.pop()
+            if node in cone_nodes:
+                continue
+            cone_nodes.add(node)
+            frontier.extend(self.Gid_2_parents[node])
+
+        cone_level_2_nodes = collections.defaultdict(list)
+        for node in cone_nodes:
+            level = self.node_2_level.get(node)
+            if level is not None:
+                cone_level_2_nodes[level].append(node)
+        return {level: cone_level_2_nodes[level] for level in sorted(cone_level_2_nodes)}
+
+    def do_incremental_propagation(self, changed_arcs, convergence_eps=None):
+        """
+        Re-propagate only the fanout of a set of arc delay updates
+
+        changed_arcs maps an arc key to its new delay tuple
+        (rise_mean, rise_std, fall_mean, fall_std): net arcs are keyed
+        (fromPin, toPin) and cell arcs (fromPin, toPin, sense), matching the
+        *_collateral_loc maps from precompute_collaterals. The new values
+        are scattered straight into the collateral tables, the downstream
+        levels are marked dirty through Gid_2_children, and only those
+        levels are swept again; arrivals everywhere else stay valid from
+        the previous propagation. Requires one prior full
+        do_eval_propagation to seed the planes.
+
+        With convergence_eps set, the sweep is event-driven: nodes whose
+        arrival means move by at most eps drop out of the frontier and
+        their fanout is never relaunched, which usually stops small delay
+        updates within a couple of levels.
+        """
+        assert self.timing_tensors, 'run do_eval_propagation once before incremental updates'
+
+        # Scatter the new delays into the collateral tables in place
+        dirty_sinks = []
+        for arc_key, (rise_mean, rise_std, fall_mean, fall_std) in changed_arcs.items():
+            if arc_key in self.net_arc_2_collateral_loc:
+                level, pos = self.net_arc_2_collateral_loc[arc_key]
+                coll = self.level_2_collaterals[level]
+                coll[2][pos] = rise_mean
+                coll[3][pos] = rise_std
+                coll[5][pos] = fall_mean
+                coll[6][pos] = fall_std
+            elif arc_key in self.cell_arc_2_collateral_loc:
+                level, pos = self.cell_arc_2_collateral_loc[arc_key]
+                coll = self.level_2_collaterals[level]
+                coll[1][pos] = rise_mean
+                coll[2][pos] = rise_std
+                coll[4][pos] = fall_mean
+                coll[5][pos] = fall_std
+            else:
+                print(f'[incremental prop] unknown arc key: {arc_key}, skipping')
+                continue
+            dirty_sinks.append(self.pinName_2_Gid[arc_key[1]])
+
+        if not dirty_sinks:
+            return True
+        return self._repropagate_dirty_sinks(dirty_sinks, convergence_eps)
+
+    def _repropagate_dirty_sinks(self, dirty_sinks, convergence_eps=None):
+        """
+        Re-sweep only the forward cone of already-scattered delay updates
+
+        Shared tail of do_incremental_propagation and the SI delta
+        overlay: the caller has written new values into the collaterals
+        and hands over the sink gids of the changed arcs.
+        """
+        # Mark every level reachable from the changed sinks as dirty
+        dirty_levels = set()
+        visited = set(dirty_sinks)
+        frontier = list(dirty_sinks)
+        while frontier:
+            node = frontier.pop()
+            level = self.node_2_level.get(node)
+            if level is not None and level != 1:
+                dirty_levels.add(level)
+            for child in self.Gid_2_children[node]:
+                if child not in visited:
+                    visited.add(child)
+                    frontier.append(child)
+
+        if convergence_eps is not None:
+            seed_mask = torch.zeros(self.max_Gid, dtype=torch.bool, device=self.device)
+            seed_mask[torch.tensor(dirty_sinks, dtype=torch.long, device=self.device)] = True
+            self.wns, self.tns = propagate_incremental_event_driven(
+                self.timing_tensors,
+                {level: self.level_2_collaterals[level] for level in sorted(dirty_levels)},
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                seed_mask,
+                convergence_eps,
+                topk=self.topK
+            )
+            return True
+
+        # Cut the touched levels down to the dirty node subsets: clean
+        # levels are skipped entirely and clean rows within dirty levels
+        # keep their arrivals, so the sweep is O(changed cone)
+        dirty_mask = torch.zeros(self.max_Gid, dtype=torch.bool, device=self.device)
+        dirty_mask[torch.tensor(list(visited), dtype=torch.long, device=self.device)] = True
+        dirty_collaterals = build_dirty_subset_collaterals(
+            {level: self.level_2_collaterals[level] for level in sorted(dirty_levels)},
+            dirty_mask
+        )
+        print(f'[incremental prop] {len(dirty_sinks)} changed sinks, '
+              f'{len(visited)} dirty nodes, re-sweeping '
+              f'{len(dirty_collaterals)}/{len(self.level_2_collaterals)} levels')
+
+        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+            self.timing_tensors,
+            dirty_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            topk=self.topK
+        )
+        return True
+
+    def apply_delta_delays(self, arc_ids, deltas, convergence_eps=None):
+        """
+        Overlay SI delta delays onto the collaterals and re-sweep the cone
+
+        arc_ids lists arc keys in the *_collateral_loc form — net arcs
+        (fromPin, toPin), cell arcs (fromPin, toPin, sense) — and deltas
+        the aligned per-arc adjustments, each a (rise_mean, rise_std,
+        fall_mean, fall_std) tuple or a scalar applied to both means.
+        Deltas add on top of the current values (repeated applications
+        accumulate), but the pre-overlay base of every touched position
+        is snapshotted on first touch, so clear_delta_delays restores
+        the whole window in O(changed) scatters — no input regeneration
+        when the SI what-if is discarded. Each call chains into the
+        dirty-cone re-propagation (do_incremental_propagation's tail);
+        convergence_eps selects the event-driven variant.
+        """
+        assert self.timing_tensors, 'run do_eval_propagation once before SI overlays'
+
+        net_cols, cell_cols = (2, 3, 5, 6), (1, 2, 4, 5)
+        batches = {}  # (level, cols) -> (positions, per-column deltas)
+        dirty_sinks = []
+        for arc_key, delta in zip(arc_ids, deltas):
+            if not isinstance(delta, (tuple, list)):
+                delta = (delta, 0.0, delta, 0.0)
+            if arc_key in self.net_arc_2_collateral_loc:
+                level, pos = self.net_arc_2_collateral_loc[arc_key]
+                cols = net_cols
+            elif arc_key in self.cell_arc_2_collateral_loc:
+                level, pos = self.cell_arc_2_collateral_loc[arc_key]
+                cols = cell_cols
+            else:
+                print(f'[si overlay] unknown arc key: {arc_key}, skipping')
+                continue
+            positions, col_deltas = batches.setdefault(
+                (level, cols), ([], [[], [], [], []]))
+            positions.append(pos)
+            for idx in range(4):
+                col_deltas[idx].append(float(delta[idx]))
+            dirty_sinks.append(self.pinName_2_Gid[arc_key[1]])
+
+        for (level, cols), (positions, col_deltas) in batches.items():
+            coll = self.level_2_collaterals[level]
+            pos_tensor = torch.tensor(positions, dtype=torch.long,
+                                      device=coll[cols[0]].device)
+            for idx, col in enumerate(cols):
+                # Snapshot the base of first-touched positions before the add
+                window = self._si_overlay.setdefault((level, col), {'seen': set(), 'chunks': []})
+                fresh = [p for p in positions if p not in window['seen']]
+                if fresh:
+                    fresh_tensor = torch.tensor(fresh, dtype=torch.long,
+                                                device=coll[col].device)
+                    window['chunks'].append(
+                        (fresh_tensor, coll[col][fresh_tensor].clone()))
+                    window['seen'].update(fresh)
+                delta_tensor = torch.tensor(col_deltas[idx], dtype=coll[col].dtype,
+                                            device=coll[col].device)
+                coll[col].index_put_((pos_tensor,), delta_tensor, accumulate=True)
+
+        if not dirty_sinks:
+            return True
+        self._si_dirty_sinks.update(dirty_sinks)
+        print(f'[si overlay] applied {len(dirty_sinks)} delta delays '
+              f'({sum(len(w["seen"]) for w in self._si_overlay.values())} '
+              'overlaid positions total)')
+        return self._repropagate_dirty_sinks(dirty_sinks, convergence_eps)
+
+    def clear_delta_delays(self, convergence_eps=None):
+        """
+        Drop the SI overlay: restore snapshotted bases, re-sweep the cone
+
+        O(changed) — one index_copy_ per touched (level, column) window
+        plus the dirty-cone propagation over the arcs that carried
+        deltas; untouched collaterals are never read or written.
+        """
+        if not self._si_overlay:
+            return True
+        restored = 0
+        for (level, col), window in self._si_overlay.items():
+            coll = self.level_2_collaterals[level]
+            for pos_tensor, base_values in window['chunks']:
+                coll[col].index_copy_(0, pos_tensor, base_values)
+                restored += pos_tensor.numel()
+        dirty_sinks = list(self._si_dirty_sinks)
+        self._si_overlay = {}
+        self._si_dirty_sinks = set()
+        print(f'[si overlay] restored {restored} positions')
+        return self._repropagate_dirty_sinks(dirty_sinks, convergence_eps)
+
+    def queue_arc_patch(self, arc_key, delta) -> bool:
+        """
+        Stage one accumulating arc delay patch in the device patch buffer
+
+        Same keying and delta form as apply_delta_delays — net arcs
+        (fromPin, toPin), cell arcs (fromPin, toPin, sense), delta a
+        (rise_mean, rise_std, fall_mean, fall_std) tuple or a scalar
+        applied to both means — but nothing touches the device here:
+        the patch lands in pinned host staging at the buffer's head
+        pointer, so thousands of per-arc updates per iteration cost
+        host writes until flush_patches moves them in one transfer.
+        A full buffer flushes itself (values only, no re-sweep) and
+        keeps queueing. Patches accumulate with no restore window; use
+        apply_delta_delays when the base must come back.
+        """
+        from ..timing.collaterals import ArcPatchBuffer
+
+        if self._arc_patch_buffer is None:
+            self._arc_patch_buffer = ArcPatchBuffer(
+                self.device, float_dtype=self.float_dtype)
+        if not isinstance(delta, (tuple, list)):
+            delta = (delta, 0.0, delta, 0.0)
+        if arc_key in self.net_arc_2_collateral_loc:
+            level, pos = self.net_arc_2_collateral_loc[arc_key]
+            cols = (2, 3, 5, 6)
+        elif arc_key in self.cell_arc_2_collateral_loc:
+            level, pos = self.cell_arc_2_collateral_loc[arc_key]
+            cols = (1, 2, 4, 5)
+        else:
+            print(f'[patch buffer] unknown arc key: {arc_key}, skipping')
+            return False
+        if self._arc_patch_buffer.full:
+            self.flush_patches(repropagate=False)
+        self._arc_patch_buffer.queue(level, cols, pos, delta)
+        self._patch_dirty_sinks.add(self.pinName_2_Gid[arc_key[1]])
+        return True
+
+    def flush_patches(self, convergence_eps=None, repropagate=True):
+        """
+        Apply every queued patch in one transfer, then re-sweep the cone
+
+        One H2D copy of the used buffer prefix, one accumulating scatter
+        per contiguous (level, columns) segment, then the dirty-cone
+        re-propagation over all sinks patched since the last flush.
+        repropagate=False applies the values only (used by the
+        buffer-full self-flush, or to batch several queue rounds into a
+        single sweep).
+        """
+        if self._arc_patch_buffer is None or len(self._arc_patch_buffer) == 0:
+            applied = 0
+        else:
+            applied = self._arc_patch_buffer.flush(self.level_2_collaterals)
+            print(f'[patch buffer] applied {applied} patches')
+        if not repropagate:
+            return True
+        dirty_sinks = list(self._patch_dirty_sinks)
+        self._patch_dirty_sinks = set()
+        if not dirty_sinks:
+            return True
+        return self._repropagate_dirty_sinks(dirty_sinks, convergence_eps)
+
+    def do_micro_query(self, net_arc_key, new_delays, sigma=3.0):
+        """
+        Evaluate one stage against the committed planes, touching nothing
+
+        Optimizer inner loops ask "what does THIS net delay do to the
+        arrivals right behind it" thousands of times per second, and
+        even the cone-level what-if machinery is overkill for that: it
+        rebuilds dirty collaterals and re-sweeps. This answers the
+        single-stage version directly from the current Gid_2_* planes —
+        the driver's worst arrival plus the hypothetical net delay gives
+        the load input pin, then every driven output pin is re-maxed
+        over all of its input arcs (the changed input uses the new
+        arrival, siblings read the committed planes), with the same
+        sense swap and RSS sigma combination as the sweep. One gather
+        batch per touched collateral level, one transfer back; nothing
+        is written, so queries need no cleanup and compose freely.
+
+        net_arc_key is (fromPin, toPin); new_delays is the full
+        (rise_mean, rise_std, fall_mean, fall_std) replacement delay or
+        a scalar applied to both means. Returns {pinName:
+        (rise_arrival, fall_arrival)} at the given sigma for the load
+        pin and each driven output pin. Worst-1 only: second-order
+        effects past the driven cell (and topK reshuffling) are the
+        re-sweep's job.
+        """
+        from ..io.parsers import _SENSE_2_CODE
+
+        assert self.timing_tensors, \
+            'run do_eval_propagation once before micro queries'
+        assert net_arc_key in self.net_arc_2_collateral_loc, \
+            f'unknown net arc key: {net_arc_key}'
+        if not isinstance(new_delays, (tuple, list)):
+            new_delays = (new_delays, 0.0, new_delays, 0.0)
+        d_rise_mean, d_rise_std, d_fall_mean, d_fall_std = \
+            (float(v) for v in new_delays)
+
+        def _worst(name):
+            plane = self.timing_tensors[name]
+            return plane[:, 0] if plane.dim() > 1 else plane
+
+        rise_mean = _worst('Gid_2_rise_arrival_mean')
+        rise_std = _worst('Gid_2_rise_arrival_std')
+        fall_mean = _worst('Gid_2_fall_arrival_mean')
+        fall_std = _worst('Gid_2_fall_arrival_std')
+
+        driver_gid = self.pinName_2_Gid[net_arc_key[0]]
+        load_gid = self.pinName_2_Gid[net_arc_key[1]]
+        in_rise_mean = float(rise_mean[driver_gid]) + d_rise_mean
+        in_rise_std = math.hypot(float(rise_std[driver_gid]), d_rise_std)
+        in_fall_mean = float(fall_mean[driver_gid]) + d_fall_mean
+        in_fall_std = math.hypot(float(fall_std[driver_gid]), d_fall_std)
+        results = {net_arc_key[1]: (in_rise_mean + sigma * in_rise_std,
+                                    in_fall_mean + sigma * in_fall_std)}
+
+        # Resolve every input arc of every driven output pin; the loc
+        # map is keyed with the sense string, so probe all four per
+        # (parent, out) pair. Rows are bucketed by collateral level so
+        # each touched level costs one gather batch.
+        out_gids = sorted(self.Gid_2_children[load_gid])
+        level_2_rows = collections.defaultdict(lambda: ([], [], []))
+        for slot, out_gid in enumerate(out_gids):
+            out_name = self.Gid_2_pinName[out_gid]
+            for p_gid in self.Gid_2_parents[out_gid]:
+                p_name = self.Gid_2_pinName[p_gid]
+                for sense in _SENSE_2_CODE:
+                    key = (p_name, out_name, sense)
+                    if key not in self.cell_arc_2_collateral_loc:
+                        continue
+                    level, pos = self.cell_arc_2_collateral_loc[key]
+                    positions, parents, slots = level_2_rows[level]
+                    positions.append(pos)
+                    parents.append(p_gid)
+                    slots.append(slot)
+
+        best_rise = torch.full((len(out_gids),), float('-inf'),
+                               dtype=torch.float32, device=self.device)
+        best_fall = torch.full_like(best_rise, float('-inf'))
+        for level, (positions, parents, slots) in level_2_rows.items():
+            coll = self.level_2_collaterals[level]
+            pos_tensor = torch.tensor(positions, dtype=torch.int64,
+                                      device=self.device)
+            parent_tensor = torch.tensor(parents, dtype=torch.int64,
+                                         device=self.device)
+            slot_tensor = torch.tensor(slots, dtype=torch.int64,
+                                       device=self.device)
+            arc_rise_mean = coll[1][pos_tensor].float()
+            arc_rise_std = coll[2][pos_tensor].float()
+            arc_fall_mean = coll[4][pos_tensor].float()
+            arc_fall_std = coll[5][pos_tensor].float()
+            swap = coll[7][pos_tensor] == 1
+
+            src_rise_mean = rise_mean[parent_tensor].float()
+            src_rise_std = rise_std[parent_tensor].float()
+            src_fall_mean = fall_mean[parent_tensor].float()
+            src_fall_std = fall_std[parent_tensor].float()
+            changed = parent_tensor == load_gid
+            src_rise_mean = torch.where(
+                changed, torch.full_like(src_rise_mean, in_rise_mean),
+                src_rise_mean)
+            src_rise_std = torch.where(
+                changed, torch.full_like(src_rise_std, in_rise_std),
+                src_rise_std)
+            src_fall_mean = torch.where(
+                changed, torch.full_like(src_fall_mean, in_fall_mean),
+                src_fall_mean)
+            src_fall_std = torch.where(
+                changed, torch.full_like(src_fall_std, in_fall_std),
+                src_fall_std)
+
+            # negative-unate arcs launch the opposite edge, same as the
+            # sweep's arc_senses swap
+            sel_rise_mean = torch.where(swap, src_fall_mean, src_rise_mean)
+            sel_rise_std = torch.where(swap, src_fall_std, src_rise_std)
+            sel_fall_mean = torch.where(swap, src_rise_mean, src_fall_mean)
+            sel_fall_std = torch.where(swap, src_rise_std, src_fall_std)
+
+            cand_rise = sel_rise_mean + arc_rise_mean + sigma * torch.sqrt(
+                sel_rise_std ** 2 + arc_rise_std ** 2)
+            cand_fall = sel_fall_mean + arc_fall_mean + sigma * torch.sqrt(
+                sel_fall_std ** 2 + arc_fall_std ** 2)
+            best_rise.scatter_reduce_(0, slot_tensor, cand_rise,
+                                      reduce='amax')
+            best_fall.scatter_reduce_(0, slot_tensor, cand_fall,
+                                      reduce='amax')
+
+        host_rise = best_rise.tolist()
+        host_fall = best_fall.tolist()
+        for slot, out_gid in enumerate(out_gids):
+            results[self.Gid_2_pinName[out_gid]] = (host_rise[slot],
+                                                    host_fall[slot])
+        return results
+
+    def do_warmstart_propagation(self, epsilon=1e-4, sigma=3.0, log=False):
+        """
+        Re-propagate with early termination once the sweep converges
+
+        Between optimizer iterations the arc delays move slightly; this
+        keeps the previous arrival planes, re-sweeps level by level, and
+        stops as soon as the frontier's max |mean delta| drops below
+        epsilon — the reported WNS/TNS are then within epsilon of the
+        converged numbers (adds and maxes never amplify a frontier
+        perturbation). Typical iterations stop at a fraction of the
+        depth. Requires one prior full do_eval_propagation at the same
+        K; runs the plain eager sweep, so patched collateral columns
+        are picked up. Returns (wns, tns, stop_level).
+        """
+        from ..timing.propagation import propagate_arrival_warmstart
+
+        assert self.timing_tensors and '_float_arena' in self.timing_tensors, \
+            'run do_eval_propagation once before warm-start iteration'
+        self.timing_tensors, wns, tns, stop_level = propagate_arrival_warmstart(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            epsilon,
+            sigma=sigma,
+            topk=self.timing_tensors.get('_effective_topk', self.topK),
+            log=log)
+        self.wns, self.tns = float(wns), float(tns)
+        return self.wns, self.tns, stop_level
+
+    def do_build_fused_schedule(self, keep_pins=None):
+        """
+        Build the half-depth stage schedule (net arcs folded into cells)
+
+        Wraps fuse_stage_schedule over the current collaterals: cell-arc
+        rows absorb their input pin's net delay and reparent onto the
+        driver output pins, so each logic stage costs one launch instead
+        of two. Endpoint loads (and keep_pins, by name) survive as
+        residual net rows so their arrivals stay readable. The fused
+        dict is a derived artifact — arc patching and arc gradients
+        address the base collaterals — and is invalidated by any ECO
+        that rebuilds them; call again after.
+        """
+        from ..timing.collaterals import fuse_stage_schedule
+
+        assert self.level_2_collaterals, \
+            'run initialization before building the fused schedule'
+        keep_gids = None
+        if keep_pins:
+            keep_gids = torch.tensor(
+                [self.pinName_2_Gid[pin] for pin in keep_pins],
+                dtype=torch.int64)
+        self.level_2_fused_collaterals, stats = fuse_stage_schedule(
+            self.level_2_collaterals,
+            self.max_Gid,
+            dest_nodes=self.dest_nodes,
+            keep_gids=keep_gids)
+        return stats
+
+    def do_fused_propagation(self, sigma=3.0, log=False):
+        """
+        Full propagation over the fused stage schedule
+
+        Same planes, same WNS/TNS as do_eval_propagation at roughly half
+        the launch depth; input pins folded away never receive arrivals
+        (their loads' cell rows read the drivers directly), so pin
+        reports at input pins need the regular sweep. Builds the fused
+        schedule on first use.
+        """
+        if getattr(self, 'level_2_fused_collaterals', None) is None:
+            self.do_build_fused_schedule()
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors
+        )
+        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+            self.timing_tensors,
+            self.level_2_fused_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            sigma=sigma,
+            topk=self.topK,
+            log=log)
+        return self.wns, self.tns
+
+    def do_compact_propagation(self, sigma=3.0, log=False, replan=False):
+        """
+        Full propagation with arrival memory bounded by the peak live-set
+
+        For designs whose [max_Gid, K] arenas do not fit the GPU even
+        after do_preflight_capacity_check's precision/K ladder: a node's
+        arrival row is dead once its deepest fanout level has run, so
+        the planner (plan_arrival_compaction) sizes the arenas by the
+        maximum number of simultaneously live rows across the schedule —
+        typically well under a quarter of max_Gid for deep designs — and
+        the sweep runs through a static gid -> slot table. Endpoint rows
+        are pinned, so WNS/TNS match the dense path; what is given up is
+        dense post-sweep queryability (recycled rows hold later nodes'
+        arrivals), so required-time propagation and pin reports stay on
+        do_eval_propagation. The plan is cached on the instance and
+        reused across calls; pass replan=True after collateral or
+        levelization changes.
+
+        Returns (wns, tns).
+        """
+        from ..timing.propagation import propagate_arrival_compact
+
+        assert self.level_2_collaterals, \
+            'run initialization before compact propagation'
+        if replan:
+            self._compaction_plan = None
+        plan = getattr(self, '_compaction_plan', None)
+        self.compact_timing_tensors, wns, tns = propagate_arrival_compact(
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.dest_nodes,
+            topk=self.topK,
+            sigma=sigma,
+            plan=plan,
+            log=log)
+        self._compaction_plan = self.compact_timing_tensors['_compaction_plan']
+        self.wns, self.tns = float(wns), float(tns)
+        return self.wns, self.tns
+
+    def do_latch_borrow_propagation(self, latch_pairs, max_borrow=float('inf'),
+                                    eps=1e-4, max_iters=10):
+        """
+        Iterate transparent-latch time borrowing to a fixpoint
+
+        A single forward sweep cannot express borrowing: a latch whose
+        D arrival lands past the open edge launches its downstream path
+        late by the overrun, which can push further latches into
+        borrowing in turn. latch_pairs lists (d_pin, q_pin) or
+        (d_pin, q_pin, max_borrow) tuples; D pins are endpoints with
+        required times from ep_attributes.csv and Q pins are
+        startpoints. Each iteration reads the D arrivals, sets
+        borrow = clamp(arrival - required, 0, max_borrow), shifts the
+        Q launch times by it, and re-sweeps only the downstream cones
+        of the borrowing latches (the cone membership is static, so the
+        dirty subset collaterals are cut once and replayed). Converges
+        when no borrow moves by more than eps — typically a few sweeps,
+        since each pass only deepens borrows along latch-to-latch
+        chains. Requires one prior full do_eval_propagation.
+        """
+        assert self.timing_tensors, 'run do_eval_propagation once before latch iteration'
+        tt = self.timing_tensors
+
+        d_gids, q_gids, limits = [], [], []
+        for pair in latch_pairs:
+            d_pin, q_pin = pair[0], pair[1]
+            if d_pin not in self.pinName_2_Gid or q_pin not in self.pinName_2_Gid:
+                print(f'[latch borrow] unknown latch pins ({d_pin}, {q_pin}), skipping')
+                continue
+            d_gids.append(self.pinName_2_Gid[d_pin])
+            q_gids.append(self.pinName_2_Gid[q_pin])
+            limits.append(pair[2] if len(pair) > 2 else max_borrow)
+        if not d_gids:
+            return True
+        d_gids = torch.tensor(d_gids, dtype=torch.int64, device=self.device)
+        q_gids = torch.tensor(q_gids, dtype=torch.int64, device=self.device)
+        limits = torch.tensor(limits, dtype=torch.float32, device=self.device)
+
+        # The downstream cones never change shape across iterations, so
+        # the dirty levels are cut once; level 1 re-seeds the Q launches
+        visited = set(q_gids.tolist())
+        frontier = list(visited)
+        dirty_levels = set()
+        while frontier:
+            node = frontier.pop()
+            level = self.node_2_level.get(node)
+            if level is not None and level != 1:
+                dirty_levels.add(level)
+            for child in self.Gid_2_children[node]:
+                if child not in visited:
+                    visited.add(child)
+                    frontier.append(child)
+        dirty_mask = torch.zeros(self.max_Gid, dtype=torch.bool, device=self.device)
+        dirty_mask[torch.tensor(list(visited), dtype=torch.long, device=self.device)] = True
+        dirty_collaterals = {1: q_gids}
+        dirty_collaterals.update(build_dirty_subset_collaterals(
+            {level: self.level_2_collaterals[level] for level in sorted(dirty_levels)},
+            dirty_mask
+        ))
+
+        d_pos = tt['gid_2_ep_position'][d_gids].to(torch.long)
+        rise_req = tt['ep_rise_required'][d_pos].to(torch.float32)
+        fall_req = tt['ep_fall_required'][d_pos].to(torch.float32)
+        sp_mean = tt['sp_mean_tensor']
+        base_launch = sp_mean[q_gids].clone()
+        borrow = torch.zeros_like(limits)
+
+        for iteration in range(max_iters):
+            rise_arr = tt['Gid_2_rise_arrival']
+            fall_arr = tt['Gid_2_fall_arrival']
+            if rise_arr.ndim > 1:
+                rise_arr = rise_arr[:, 0]
+                fall_arr = fall_arr[:, 0]
+            overrun = torch.maximum(rise_arr[d_gids].to(torch.float32) - rise_req,
+                                    fall_arr[d_gids].to(torch.float32) - fall_req)
+            new_borrow = overrun.clamp(min=0.0).minimum(limits)
+            delta = (new_borrow - borrow).abs().max().item()
+            print(f'[latch borrow] iter {iteration}: '
+                  f'{int((new_borrow > 0).sum())} borrowing latches, '
+                  f'max borrow delta {delta:.6f}')
+            if delta <= eps:
+                break
+            borrow = new_borrow
+            sp_mean.index_copy_(
+                0, q_gids, (base_launch + borrow).to(sp_mean.dtype))
+
+            self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+                self.timing_tensors,
+                dirty_collaterals,
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                topk=self.topK
+            )
+        else:
+            print(f'[latch borrow] no fixpoint within {max_iters} iterations '
+                  f'(last delta {delta:.6f})')
+
+        print(f'[latch borrow] wns: {self.wns}, tns: {self.tns}')
+        return True
+
+    def do_incremental_input_refresh(self):
+        """
+        Diff a fresh arc-file drop against the loaded timing state
+
+        Re-parses cell_arcs/net_arcs with the cache bypassed and compares
+        every arc against the in-memory variation tables. Arcs whose
+        delays moved are scattered straight into the collateral tensors
+        through the loc maps — no graph build, no levelization, no
+        re-tensorization — after which the next propagation (full or
+        incremental) picks them up. If arcs appeared or disappeared, the
+        connectivity itself changed and the method leaves the state
+        untouched: rerun do_initialization (the cache manifest has
+        already invalidated the graph chain by then).
+
+        Returns:
+            (num_patched, structural_change)
+        """
+        assert self.level_2_collaterals is not None, 'run do_initialization first'
+
+        cell_path = os.path.join(self.prefix, self.input_folderName, 'cell_arcs.csv')
+        net_path = os.path.join(self.prefix, self.input_folderName, 'net_arcs.csv')
+        columnar = self.columnar_arcs or self.streaming_parse
+        new_cell, _, ok_cell = read_cell_arc_file(
+            cell_path, self.save_dir, self.scale, use_cache=False,
+            columnar=columnar, interner=self._pin_interner, streaming=self.streaming_parse)
+        new_net, _, ok_net = read_net_arc_file(
+            net_path, self.save_dir, self.scale, use_cache=False,
+            columnar=columnar, interner=self._pin_interner, streaming=self.streaming_parse)
+        if not (ok_cell and ok_net):
+            print('[input refresh] arc re-parse failed, keeping current state')
+            return 0, False
+
+        changed_arcs = {}
+        structural = False
+        for new_table, old_table in ((new_net, self.net_arc_2_variation),
+                                     (new_cell, self.cell_arc_2_variation)):
+            new_keys = set(new_table.keys())
+            old_keys = set(old_table.keys())
+            if new_keys != old_keys:
+                added = len(new_keys - old_keys)
+                removed = len(old_keys - new_keys)
+                print(f'[input refresh] connectivity changed: '
+                      f'{added} arcs added, {removed} removed')
+                structural = True
+                continue
+            for key in new_keys:
+                new_values = new_table[key]
+                if tuple(new_values) != tuple(old_table[key]):
+                    if len(new_values) == 2:  # pre-POCV: no std columns
+                        new_values = (new_values[0], 0.0, new_values[1], 0.0)
+                    changed_arcs[key] = tuple(new_values)
+
+        if structural:
+            return 0, True
+
+        if changed_arcs:
+            patched = patch_collateral_delays(
+                self.level_2_collaterals,
+                self.net_arc_2_collateral_loc,
+                self.cell_arc_2_collateral_loc,
+                changed_arcs
+            )
+            # Keep the variation tables in sync with the patched tensors
+            for new_table, old_table in ((new_net, self.net_arc_2_variation),
+                                         (new_cell, self.cell_arc_2_variation)):
+                for key in new_table.keys():
+                    new_values = new_table[key]
+                    if tuple(new_values) != tuple(old_table[key]):
+                        old_table[key] = tuple(new_values)
+            print(f'[input refresh] patched {patched} arc delay entries in place')
+            return patched, False
+
+        print('[input refresh] no arc delay changes detected')
+        return 0, False
+
+    def do_load_delay_model(self, table_file):
+        """
+        Load NLDM-lite delay tables and index the cell arcs against them
+
+        table_file is a CSV of per-libcell slew x load grid points (see
+        NldmDelayModel.from_csv). The tables move to device once and a
+        one-time walk of cell_arc_2_collateral_loc maps every covered
+        cell-arc collateral row to its libcell table and driving-pin gid,
+        so later do_recompute_cell_delays calls are pure device work.
+        """
+        from ..timing.delay_model import NldmDelayModel, build_cell_arc_delay_index
+
+        model = NldmDelayModel.from_csv(table_file, self.device)
+        if model is None:
+            return False
+        assert self.cell_arc_2_collateral_loc, \
+            'run do_initialization first: the delay index needs collateral positions'
+        self._delay_model = model
+        self._cell_arc_delay_index = build_cell_arc_delay_index(
+            self.cell_arc_2_collateral_loc,
+            self.cellName_2_orgLibCell,
+            self.pinName_2_Gid,
+            model.libcell_2_id,
+            self.device
+        )
+        return True
+
+    def do_recompute_cell_delays(self, gid_2_load, gid_2_slew=None,
+                                 nominal_slew=0.05):
+        """
+        Refresh cell-arc delays from updated per-net loads, on device
+
+        gid_2_load is a dense [max_Gid] tensor of the load each driving
+        output pin sees; a placement move only has to rewrite it. Delays
+        come from the loaded NLDM-lite tables (do_load_delay_model) and
+        scatter straight into the prepared collaterals, replacing the
+        extraction + reference-tool round trip that regenerated
+        cell_arcs.csv. Arrivals are stale afterwards; run a propagation.
+
+        Returns:
+            Number of cell arcs recomputed
+        """
+        from ..timing.delay_model import recompute_cell_arc_delays
+
+        assert self._delay_model is not None, 'run do_load_delay_model first'
+        gid_2_load = gid_2_load.to(self.device)
+        if gid_2_slew is not None:
+            gid_2_slew = gid_2_slew.to(self.device)
+        elif self.timing_tensors and 'Gid_2_rise_slew' in self.timing_tensors:
+            # A prior do_propagate_slews supplies real slews; take the
+            # worst polarity per driver
+            gid_2_slew = torch.maximum(self.timing_tensors['Gid_2_rise_slew'],
+                                       self.timing_tensors['Gid_2_fall_slew'])
+        return recompute_cell_arc_delays(
+            self.level_2_collaterals,
+            self._cell_arc_delay_index,
+            self._delay_model,
+            gid_2_load,
+            gid_2_slew=gid_2_slew,
+            nominal_slew=nominal_slew
+        )
+
+    def do_propagate_slews(self, gid_2_load=None, sp_slew=0.05):
+        """
+        Propagate rise/fall slew planes over the arrival level schedule
+
+        Input pins inherit their driver's slew and output pins take the
+        worst transformed slew over their input arcs; cells covered by a
+        delay model with output-slew tables (do_load_delay_model) look
+        the transform up per (input slew, load), everything else passes
+        the worst input slew through. The planes land in timing_tensors
+        ('Gid_2_rise_slew' etc.) where do_recompute_cell_delays picks
+        them up, closing the load -> slew -> delay loop on device.
+        """
+        from ..timing.propagation import propagate_slews
+
+        assert self.timing_tensors, 'run a propagation (or initialization) first'
+        if gid_2_load is not None:
+            gid_2_load = gid_2_load.to(self.device)
+        self.timing_tensors = propagate_slews(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            delay_model=self._delay_model,
+            delay_index=self._cell_arc_delay_index,
+            gid_2_load=gid_2_load,
+            sp_slew=sp_slew
+        )
+        return True
+
+    def do_propagate_depths(self, sigma=3.0):
+        """
+        Propagate path depths (argmax stage counts) on device
+
+        Replaces the reference-tool ep_*_depth_truth import for AOCV:
+        the sweep recovers each pin's worst-path stage count from the
+        level schedule and stores int16 planes ('Gid_2_rise_depth' /
+        'Gid_2_fall_depth') in timing_tensors. Feed a plane plus a
+        stage-indexed derate table to do_aocv_derates for the lookup.
+        """
+        from ..timing.propagation import propagate_depths
+
+        assert self.timing_tensors, 'run a propagation (or initialization) first'
+        self.timing_tensors = propagate_depths(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            sigma=sigma
+        )
+        return True
+
+    def do_aocv_derates(self, derate_table):
+        """
+        Depth-indexed AOCV derate planes from the propagated depths
+
+        derate_table is a 1D sequence of derate factors indexed by stage
+        count; depths beyond the table clamp to its last entry. Returns
+        dense [max_gid] (rise, fall) float32 derate tensors on device
+        (1.0 where unreached). Runs do_propagate_depths first if the
+        depth planes are not present yet.
+        """
+        from ..timing.propagation import aocv_derates_from_depths
+
+        if 'Gid_2_rise_depth' not in self.timing_tensors:
+            self.do_propagate_depths()
+        if not isinstance(derate_table, torch.Tensor):
+            derate_table = torch.tensor(derate_table, dtype=torch.float32)
+        rise_derates = aocv_derates_from_depths(
+            self.timing_tensors['Gid_2_rise_depth'], derate_table)
+        fall_derates = aocv_derates_from_depths(
+            self.timing_tensors['Gid_2_fall_depth'], derate_table)
+        return rise_derates, fall_derates
+
+    def do_incremental_levelization(self, added_arcs=None, removed_arcs=None):
+        """
+        Re-levelize only the fanout cone of a connectivity delta
+
+        added_arcs maps an arc key to its delay tuple (rise_mean,
+        rise_std, fall_mean, fall_std) — net arcs keyed (fromPin, toPin)
+        and cell arcs (fromPin, toPin, sense) — and removed_arcs is an
+        iterable of existing keys. Both endpoints must already be pins of
+        the graph; deltas that introduce new pins go through a full
+        do_initialization. The CSR is repacked with the edge delta,
+        levels are recomputed only inside the affected forward cone
+        (nothing upstream or sideways can move), level_2_nodes membership
+        is updated in place, and collateral rows are regenerated for the
+        re-leveled levels only — the hour-scale full
+        levelize + precompute rebuild becomes cone-sized work. Arrivals
+        are stale afterwards; run a propagation to refresh them.
+
+        Returns:
+            Number of re-leveled nodes, or -1 if the delta could not be
+            applied incrementally
+        """
+        assert self.level_2_collaterals is not None, 'run do_initialization first'
+        added_arcs = added_arcs or {}
+        removed_arcs = list(removed_arcs or [])
+        if not added_arcs and not removed_arcs:
+            return 0
+
+        if isinstance(self.cell_arc_2_variation, ArcColumns):
+            print('[incremental levelization] columnar arc tables are append-only, '
+                  'rerun do_initialization for connectivity changes')
+            return -1
+
+        for key in list(added_arcs) + removed_arcs:
+            if key[0] not in self.pinName_2_Gid or key[1] not in self.pinName_2_Gid:
+                print(f'[incremental levelization] arc {key} references an unknown pin, '
+                      'rerun do_initialization')
+                return -1
+
+        # Apply the delta to the variation tables
+        for key in removed_arcs:
+            table = self.net_arc_2_variation if len(key) == 2 else self.cell_arc_2_variation
+            if key in table:
+                del table[key]
+        for key, values in added_arcs.items():
+            table = self.net_arc_2_variation if len(key) == 2 else self.cell_arc_2_variation
+            table[key] = tuple(values)
+
+        def edge_alive(fromPin, toPin):
+            if (fromPin, toPin) in self.net_arc_2_variation:
+                return True
+            return any((fromPin, toPin, s) in self.cell_arc_2_variation for s in range(4))
+
+        added_edges = set()
+        removed_edges = set()
+        seed_gids = set()
+        for key in added_arcs:
+            pair = (self.pinName_2_Gid[key[0]], self.pinName_2_Gid[key[1]])
+            added_edges.add(pair)
+            seed_gids.add(pair[1])
+        for key in removed_arcs:
+            pair = (self.pinName_2_Gid[key[0]], self.pinName_2_Gid[key[1]])
+            seed_gids.add(pair[1])
+            # Other senses of the same pin pair may keep the edge alive
+            if not edge_alive(key[0], key[1]):
+                removed_edges.add(pair)
+        removed_edges -= added_edges
+
+        # Repack the CSR with the edge delta and sync the legacy adjacency
+        src, dst = self.csr_graph.edge_list()
+        if removed_edges:
+            removed_keys = torch.tensor(
+                [f * self.max_Gid + t for f, t in removed_edges], dtype=torch.int64)
+            keep = ~torch.isin(src * self.max_Gid + dst, removed_keys)
+            src, dst = src[keep], dst[keep]
+        if added_edges:
+            new_pairs = sorted(added_edges)
+            src = torch.cat([src, torch.tensor([f for f, _ in new_pairs], dtype=torch.int64)])
+            dst = torch.cat([dst, torch.tensor([t for _, t in new_pairs], dtype=torch.int64)])
+            uniq = torch.unique(src * self.max_Gid + dst)
+            src, dst = uniq // self.max_Gid, uniq % self.max_Gid
+        self.csr_graph = CSRGraph.from_edges(src, dst, self.max_Gid)
+
+        for f, t in added_edges:
+            self.Gid_2_parents[t].add(f)
+            self.Gid_2_children[f].add(t)
+        for f, t in removed_edges:
+            self.Gid_2_parents[t].discard(f)
+            self.Gid_2_children[f].discard(t)
+
+        # Net-arc deltas also move the single-driver bookkeeping
+        for key in removed_arcs:
+            if len(key) == 2:
+                toGid = self.pinName_2_Gid[key[1]]
+                if self.inPin_parent_dict.get(toGid) == self.pinName_2_Gid[key[0]]:
+                    del self.inPin_parent_dict[toGid]
+                    self.inPin_parent_tensor[toGid] = -1
+        for key in added_arcs:
+            if len(key) == 2:
+                fromGid, toGid = self.pinName_2_Gid[key[0]], self.pinName_2_Gid[key[1]]
+                if toGid in self.inPin_parent_dict and self.inPin_parent_dict[toGid] != fromGid:
+                    raise ValueError(f'sink pin {key[1]} has multiple drivers')
+                self.inPin_parent_dict[toGid] = fromGid
+                self.inPin_parent_tensor[toGid] = fromGid
+                self.outPin_set.add(fromGid)
+            else:
+                self.outPin_set.add(self.pinName_2_Gid[key[1]])
+
+        # Recompute levels inside the affected forward cone only
+        level_tensor = torch.zeros(self.max_Gid, dtype=torch.int32)
+        for node, level in self.node_2_level.items():
+            level_tensor[node] = level
+        source_mask = torch.zeros(self.max_Gid, dtype=torch.bool)
+        source_mask[torch.tensor(sorted(self.source_nodes), dtype=torch.int64)] = True
+
+        cone_gids, old_levels, new_levels = relevel_affected_cone(
+            self.csr_graph, level_tensor,
+            torch.tensor(sorted(seed_gids), dtype=torch.int64),
+            source_mask
+        )
+        moved = old_levels != new_levels
+        releveled = cone_gids[moved].tolist()
+        old_moved = old_levels[moved].tolist()
+        new_moved = new_levels[moved].tolist()
+
+        # Update level_2_nodes membership in place
+        affected_levels = set()
+        for node, old_lvl, new_lvl in zip(releveled, old_moved, new_moved):
+            if old_lvl > 0:
+                self.level_2_nodes[old_lvl].remove(node)
+                affected_levels.add(old_lvl)
+                if not self.level_2_nodes[old_lvl]:
+                    del self.level_2_nodes[old_lvl]
+            if new_lvl > 0:
+                self.level_2_nodes.setdefault(new_lvl, []).append(node)
+                affected_levels.add(new_lvl)
+                self.node_2_level[node] = new_lvl
+            else:
+                self.node_2_level.pop(node, None)
+        self.level_2_nodes = {lvl: self.level_2_nodes[lvl]
+                              for lvl in sorted(self.level_2_nodes)}
+        affected_levels &= set(self.level_2_nodes)
+
+        # Regenerate collateral rows for the re-leveled levels only; the
+        # sinks of the changed arcs re-tensorize even if their level held
+        for gid in seed_gids:
+            lvl = self.node_2_level.get(gid)
+            if lvl is not None and lvl > 1:
+                affected_levels.add(lvl)
+        if affected_levels:
+            affected_subset = {lvl: self.level_2_nodes[lvl]
+                               for lvl in sorted(affected_levels)}
+            (new_collaterals, net_loc, cell_loc,
+             _, _, _, _, _, _, _) = precompute_collaterals(
+                self.net_arc_2_variation,
+                self.cell_arc_2_variation,
+                self.sp_mean_tensor,
+                self.sp_std_tensor,
+                affected_subset,
+                self.Gid_2_pinName,
+                self.inPin_parent_tensor,
+                self.Gid_2_parents,
+                self.device,
+                self.max_Gid,
+                self.cellName_2_orgLibCell,
+                self.libCell_2_riseFallguardband,
+                self.libCell_2_riseFallStd,
+                self.net_2_pocvScaling,
+                self.float_dtype,
+                self.save_dir,
+                use_cache=False,
+                save=False
+            )
+            if str(self.device) != 'cpu':
+                new_collaterals = move_collaterals_to_device(new_collaterals, self.device)
+            for lvl, collateral in new_collaterals.items():
+                self.level_2_collaterals[lvl] = collateral
+            for lvl in set(self.level_2_collaterals) - set(self.level_2_nodes):
+                del self.level_2_collaterals[lvl]
+            self.level_2_collaterals = {lvl: self.level_2_collaterals[lvl]
+                                        for lvl in sorted(self.level_2_collaterals)}
+            self.net_arc_2_collateral_loc.update(net_loc)
+            self.cell_arc_2_collateral_loc.update(cell_loc)
+        for key in removed_arcs:
+            self.net_arc_2_collateral_loc.pop(key, None)
+            self.cell_arc_2_collateral_loc.pop(key, None)
+
+        print(f'[incremental levelization] {len(added_arcs)} arcs added, '
+              f'{len(removed_arcs)} removed, {len(releveled)} nodes re-leveled, '
+              f'{len(affected_levels)} levels re-tensorized')
+        return len(releveled)
+
+    def do_partition_domains(self):
+        """
+        Partition the design into independent clock-domain schedules
+
+        Weakly-connected components over the CSR graph, grouped by the
+        clock roots in source_nodes: asynchronous domains never exchange
+        arrivals, so each one gets its own level schedule whose launch
+        depth is its own critical depth rather than the design-wide
+        maximum. The schedules feed do_domain_propagation, which sweeps
+        them concurrently.
+
+        Returns:
+            Number of timing domains found
+        """
+        assert self.csr_graph is not None, 'timing graph not built'
+        assert self.level_2_nodes, 'run levelization first'
+
+        self.domain_labels, num_domains = partition_timing_domains(
+            self.csr_graph, self.source_nodes
+        )
+        self.domain_level_2_nodes = build_domain_schedules(
+            self.level_2_nodes, self.domain_labels
+        )
+        self._domain_collaterals = None
+        return num_domains
+
+    def do_domain_propagation(self):
+        """
+        Propagate arrivals domain-by-domain on overlapping CUDA streams
+
+        Requires do_partition_domains. Each domain's levels are
+        tensorized once (cached across calls) and swept through
+        propagate_arrival_times; domains write disjoint rows of the
+        shared timing planes, so on GPU every domain runs on its own
+        stream and short domains finish without waiting out the deepest
+        one. wns/tns are merged across domains.
+        """
+        assert self.domain_level_2_nodes is not None, 'run do_partition_domains first'
+
+        if self._domain_collaterals is None:
+            self._domain_collaterals = {}
+            for domain, schedule in sorted(self.domain_level_2_nodes.items()):
+                (collaterals, _, _, _, _, _, _, _, _, _) = precompute_collaterals(
+                    self.net_arc_2_variation,
+                    self.cell_arc_2_variation,
+                    self.sp_mean_tensor,
+                    self.sp_std_tensor,
+                    schedule,
+                    self.Gid_2_pinName,
+                    self.inPin_parent_tensor,
+                    self.Gid_2_parents,
+                    self.device,
+                    self.max_Gid,
+                    self.cellName_2_orgLibCell,
+                    self.libCell_2_riseFallguardband,
+                    self.libCell_2_riseFallStd,
+                    self.net_2_pocvScaling,
+                    self.float_dtype,
+                    self.save_dir,
+                    use_cache=False,
+                    save=False
+                )
+                if str(self.device) != 'cpu':
+                    collaterals = move_collaterals_to_device(collaterals, self.device)
+                self._domain_collaterals[domain] = collaterals
+
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            self.topK,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors
+        )
+
+        use_streams = str(self.device).startswith('cuda')
+        streams = {domain: torch.cuda.Stream(device=self.device)
+                   for domain in self._domain_collaterals} if use_streams else {}
+
+        domain_wns, domain_tns = [], []
+        for domain, collaterals in sorted(self._domain_collaterals.items()):
+            if use_streams:
+                with torch.cuda.stream(streams[domain]):
+                    self.timing_tensors, wns, tns = propagate_arrival_times(
+                        self.timing_tensors, collaterals, self.inPin_parent_tensor,
+                        self.device, self.max_Gid, self.float_dtype, topk=self.topK
+                    )
+            else:
+                self.timing_tensors, wns, tns = propagate_arrival_times(
+                    self.timing_tensors, collaterals, self.inPin_parent_tensor,
+                    self.device, self.max_Gid, self.float_dtype, topk=self.topK
+                )
+            domain_wns.append(wns)
+            domain_tns.append(tns)
+        if use_streams:
+            torch.cuda.synchronize(self.device)
+
+        self.wns = min(domain_wns)
+        self.tns = sum(domain_tns)
+        print(f'[domain propagation] {len(domain_wns)} domains, '
+              f'wns: {self.wns:.4f}, tns: {self.tns:.4f}')
+        return True
+
+    def do_schedule_levels(self, tiny_level_rows: int = 2048,
+                           giant_level_rows: int = 1 << 21,
+                           num_chunks: int = 2):
+        """
+        Rebalance the level launch schedule for GPU occupancy
+
+        Fuses dependency-clear runs of tiny net-arc levels into single
+        launches and splits giant net-arc levels into node-disjoint
+        chunks that the eager sweep overlaps on two streams (see
+        schedule_level_launches). The collateral-loc entries of fused
+        levels are rewritten so incremental delay patching keeps working.
+        Applies to the eager propagation path; skip this before using
+        the persistent-kernel or streaming modes, which consume the
+        unscheduled layout.
+        """
+        assert self.level_2_collaterals is not None, 'run do_initialization first'
+
+        self.level_2_collaterals, level_moves = schedule_level_launches(
+            self.level_2_collaterals,
+            tiny_level_rows=tiny_level_rows,
+            giant_level_rows=giant_level_rows,
+            num_chunks=num_chunks
+        )
+        if level_moves:
+            for key, (level, pos) in list(self.net_arc_2_collateral_loc.items()):
+                if level in level_moves:
+                    anchor, offset = level_moves[level]
+                    self.net_arc_2_collateral_loc[key] = (anchor, offset + pos)
+        return True
+
+    # Planes whose dirty-cone rows are buffered by an ECO transaction; the
+    # max_arrival planes are derived from these and rebuilt on rollback
+    _ECO_SHADOW_PLANES = [
+        'Gid_2_rise_arrival',
+        'Gid_2_rise_arrival_mean',
+        'Gid_2_rise_arrival_std',
+        'Gid_2_rise_startpoints',
+        'Gid_2_fall_arrival',
+        'Gid_2_fall_arrival_mean',
+        'Gid_2_fall_arrival_std',
+        'Gid_2_fall_startpoints',
+        'Gid_2_rise_slack',
+        'Gid_2_fall_slack',
+        'Gid_2_slack'
+    ]
+
+    def do_begin_eco_transaction(self, changed_arcs, convergence_eps=None):
+        """
+        Propagate an ECO candidate speculatively, with cheap rollback
+
+        Before running do_incremental_propagation, snapshots the previous
+        delay entries of the changed arcs and the dirty cone's rows of the
+        arrival/slack planes — the only state the incremental sweep can
+        touch. A rejected candidate is then undone with
+        do_rollback_eco_transaction at the cost of a few row copies
+        instead of a second full propagation; an accepted one is sealed
+        with do_commit_eco_transaction, which just discards the shadow.
+        One transaction may be open at a time.
+        """
+        assert self._eco_transaction is None, 'an ECO transaction is already open'
+        assert self.timing_tensors, 'run do_eval_propagation once before ECO transactions'
+
+        # Previous delay values of the touched arcs, read back through the
+        # same loc maps the incremental scatter writes through
+        old_delays = {}
+        dirty_sinks = set()
+        for arc_key in changed_arcs:
+            if arc_key in self.net_arc_2_collateral_loc:
+                level, pos = self.net_arc_2_collateral_loc[arc_key]
+                coll = self.level_2_collaterals[level]
+                old_delays[arc_key] = (coll[2][pos].item(), coll[3][pos].item(),
+                                       coll[5][pos].item(), coll[6][pos].item())
+            elif arc_key in self.cell_arc_2_collateral_loc:
+                level, pos = self.cell_arc_2_collateral_loc[arc_key]
+                coll = self.level_2_collaterals[level]
+                old_delays[arc_key] = (coll[1][pos].item(), coll[2][pos].item(),
+                                       coll[4][pos].item(), coll[5][pos].item())
+            else:
+                continue
+            dirty_sinks.add(self.pinName_2_Gid[arc_key[1]])
+
+        # Only the fanout cone of the changed sinks needs buffering;
+        # arrivals and slacks everywhere else are never written
+        visited = set(dirty_sinks)
+        frontier = list(dirty_sinks)
+        while frontier:
+            node = frontier.pop()
+            for child in self.Gid_2_children[node]:
+                if child not in visited:
+                    visited.add(child)
+                    frontier.append(child)
+
+        rows = torch.tensor(sorted(visited), dtype=torch.long, device=self.device)
+        shadow = {name: self.timing_tensors[name][rows].clone()
+                  for name in self._ECO_SHADOW_PLANES if name in self.timing_tensors}
+        self._eco_transaction = {
+            'rows': rows,
+            'shadow': shadow,
+            'old_delays': old_delays,
+            'wns': self.wns,
+            'tns': self.tns
+        }
+        print(f'[eco txn] opened: {len(old_delays)} changed arcs, '
+              f'buffering {rows.numel()} plane rows')
+        return self.do_incremental_propagation(changed_arcs, convergence_eps=convergence_eps)
+
+    def do_commit_eco_transaction(self):
+        """Accept the speculative candidate by discarding the shadow rows"""
+        assert self._eco_transaction is not None, 'no ECO transaction is open'
+        self._eco_transaction = None
+        print('[eco txn] committed')
+        return True
+
+    def do_rollback_eco_transaction(self):
+        """
+        Drop the speculative candidate and restore the pre-ECO state
+
+        Scatters the saved arc delays back into the collateral tables,
+        restores the buffered plane rows, and rebuilds the derived
+        max-arrival planes from the restored arrivals
+        """
+        assert self._eco_transaction is not None, 'no ECO transaction is open'
+        txn = self._eco_transaction
+        patch_collateral_delays(
+            self.level_2_collaterals,
+            self.net_arc_2_collateral_loc,
+            self.cell_arc_2_collateral_loc,
+            txn['old_delays']
+        )
+        rows = txn['rows']
+        for name, saved in txn['shadow'].items():
+            self.timing_tensors[name][rows] = saved
+        self.timing_tensors['Gid_2_max_arrival_mean'] = torch.max(
+            self.timing_tensors['Gid_2_rise_arrival_mean'],
+            self.timing_tensors['Gid_2_fall_arrival_mean'])
+        self.timing_tensors['Gid_2_max_arrival_std'] = torch.max(
+            self.timing_tensors['Gid_2_rise_arrival_std'],
+            self.timing_tensors['Gid_2_fall_arrival_std'])
+        self.wns, self.tns = txn['wns'], txn['tns']
+        self._eco_transaction = None
+        print('[eco txn] rolled back')
+        return True
+
+    def do_select_khop_cones(self, roots, k, include_backward=True):
+        """
+        Select node-disjoint k-hop cones around the given root Gids
+
+        The CSR adjacency is built once on first use and reused across
+        queries, so repeated cone selection for the what-if pipeline is a
+        few tensor gathers per hop instead of a Python BFS. Returns a list
+        of (cone_gid_list, gid2local_map) pairs consumable by
+        precompute_collaterals(subgraph=True).
+        """
+        if self.cone_selector is None:
+            from ..graph.khop import ConeSelector
+            self.cone_selector = ConeSelector(
+                self.Gid_2_children, self.Gid_2_parents, self.max_Gid)
+        from ..graph.khop import select_nonoverlapping_khop
+        return select_nonoverlapping_khop(
+            self.cone_selector, roots, k, include_backward=include_backward)
+
+    def do_extract_cone_collateral(self, cone_gid_list, gid2local_map=None,
+                                   with_locs=True):
+        """
+        Build a cone's collateral tuple by device-side filtering
+
+        Replaces precompute_collaterals(subgraph=True) for cones over an
+        already-prepared design: the full-graph collaterals are filtered
+        by cone membership on device (milliseconds) instead of re-running
+        the Python per-node assembly (seconds). The returned tuple has
+        the subgraph-mode shape, so it drops into
+        propagate_subgraph_collateral, do_monte_carlo_cone and the cone
+        collateral cache unchanged; with_locs=False skips rebuilding the
+        cone-local loc maps when no delay patching is planned.
+        """
+        from ..timing.collaterals import extract_cone_collaterals
+
+        assert self.level_2_collaterals is not None, \
+            'run do_precompute_collaterals first'
+        cone_gid_list = torch.as_tensor(cone_gid_list, dtype=torch.int64)
+        cone_gid_list = torch.unique(cone_gid_list).to(self.device)
+        cone_lvl2, net_loc, cell_loc = extract_cone_collaterals(
+            self.level_2_collaterals, cone_gid_list, self.max_Gid, self.device,
+            self.netArcId_2_netArcKey if with_locs else None,
+            self.cellArcId_2_cellArcKey if with_locs else None)
+        if gid2local_map is None:
+            gid2local_map = {gid: idx for idx, gid
+                             in enumerate(cone_gid_list.tolist())}
+        return (
+                cone_lvl2,
+                net_loc, cell_loc,
+                self.cellArcId_2_cellName, self.cellArcKey_2_cellArcId,
+                self.cellArcId_2_cellArcKey,
+                self.netArcId_2_inCellName, self.netArcId_2_outCellName,
+                self.netArcKey_2_netArcId, self.netArcId_2_netArcKey,
+                cone_gid_list, gid2local_map
+               )
+
+    def do_propagate_from_startpoints(self, sp_gids, sigma=3.0,
+                                      endpoint_gids=None):
+        """
+        Propagate only the paths launched from a startpoint subset
+
+        Clock-domain-crossing audits ask the same question per domain:
+        which endpoint arrivals are attributable to this set of launch
+        points? Zeroing the other startpoints and re-running pays
+        full-graph cost per query; instead the subset's forward-reachable
+        cone comes from the CSR adjacency, its collaterals from the
+        device-side cone filter, and one cone sweep yields the
+        per-endpoint arrivals — arcs fed from outside the cone are
+        dropped, so every reported arrival traces back to the subset.
+        Dozens of per-domain queries each cost a cone, not a run.
+
+        endpoint_gids defaults to the design endpoints inside the cone.
+        Returns {endpoint gid -> arrival} for the reachable endpoints.
+        """
+        from ..timing.propagation import propagate_subgraph_collateral
+
+        sp_gids = sorted(set(int(g) for g in sp_gids))
+        assert sp_gids, 'empty startpoint subset'
+        if self.cone_selector is None:
+            from ..graph.khop import ConeSelector
+            self.cone_selector = ConeSelector(
+                self.Gid_2_children, self.Gid_2_parents, self.max_Gid)
+        # Full forward reachability: hops are bounded by the level count
+        # and the expansion stops early once the frontier empties
+        reach = self.cone_selector.expand(
+            sp_gids, k=max(self.level_2_collaterals.keys()), direction='forward')
+        cone_gid_list = torch.nonzero(reach).flatten()
+
+        subgraph_tuple = self.do_extract_cone_collateral(
+            cone_gid_list, with_locs=False)
+        cone_gid_list = subgraph_tuple[-2]
+
+        if endpoint_gids is None:
+            dest_t = torch.tensor(sorted(self.dest_nodes), dtype=torch.int64)
+            endpoint_gids = dest_t[reach[dest_t]]
+        else:
+            endpoint_gids = torch.as_tensor(
+                list(endpoint_gids), dtype=torch.int64)
+            endpoint_gids = endpoint_gids[reach[endpoint_gids]]
+        if endpoint_gids.numel() == 0:
+            print('[sp filter] no endpoints reachable from the subset')
+            return {}
+
+        _, _, endpoint_arr = propagate_subgraph_collateral(
+            subgraph_tuple[0],
+            cone_gid_list,
+            subgraph_tuple[-1],
+            self.sp_mean_tensor.to(self.device),
+            self.sp_std_tensor.to(self.device),
+            sigma=sigma,
+            endpoint_globals=endpoint_gids.to(self.device))
+        print(f'[sp filter] {len(sp_gids)} startpoints -> '
+              f'{cone_gid_list.numel()} cone nodes, '
+              f'{len(endpoint_arr)} endpoints')
+        return endpoint_arr
+
+    def do_lookup_cone_collateral(self, roots, changed_arcs=None):
+        """
+        Fetch a cached cone collateral tuple for a what-if root set
+
+        On a hit the prepared device collaterals come back immediately,
+        optionally with changed delays patched in place via the loc maps,
+        so the query is a pure kernel launch. Returns None on a miss; the
+        caller runs precompute_collaterals(subgraph=True) and registers the
+        result with do_store_cone_collateral.
+        """
+        if self.cone_collateral_cache is None:
+            from ..timing.collaterals import ConeCollateralCache
+            self.cone_collateral_cache = ConeCollateralCache()
+        subgraph_tuple = self.cone_collateral_cache.get(roots)
+        if subgraph_tuple is not None and changed_arcs:
+            self.cone_collateral_cache.patch_delays(roots, changed_arcs)
+        return subgraph_tuple
+
+    def do_store_cone_collateral(self, roots, subgraph_tuple):
+        """Register a freshly prepared cone in the LRU collateral cache"""
+        if self.cone_collateral_cache is None:
+            from ..timing.collaterals import ConeCollateralCache
+            self.cone_collateral_cache = ConeCollateralCache()
+        self.cone_collateral_cache.put(roots, subgraph_tuple)
+
+    def do_monte_carlo_cone(self, subgraph_tuple, num_samples=512,
+                            quantiles=(0.5, 0.95, 0.997), seed=None,
+                            endpoint_globals=None):
+        """
+        Monte-Carlo sampled SSTA over one prepared cone
+
+        Draws num_samples N(mean, std) delays per arc of the cone and
+        sweeps sample-parallel hard maxima instead of the POCV
+        mean/sigma*std approximation, so the reported arrivals are
+        empirical quantiles of the true max distribution. Runs on a
+        subgraph tuple from precompute_collaterals(subgraph=True) (e.g.
+        via do_lookup_cone_collateral); endpoint_globals defaults to the
+        cone's last-level pins. Returns {endpoint Gid: {quantile:
+        arrival}}.
+        """
+        from ..timing.montecarlo import mc_propagate_subgraph, mc_endpoint_quantiles
+
+        level_2_collaterals = subgraph_tuple[0]
+        cone_gid_list = subgraph_tuple[-2].to(torch.int64).to(self.device)
+
+        rise_samples, fall_samples = mc_propagate_subgraph(
+            level_2_collaterals,
+            cone_gid_list,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            num_samples=num_samples,
+            seed=seed,
+            device=self.device
+        )
+
+        if endpoint_globals is None:
+            max_lvl = max(level_2_collaterals.keys())
+            coll = level_2_collaterals[max_lvl]
+            if max_lvl == 1:
+                endpoint_globals = coll.tolist()
+            elif max_lvl % 2 == 1:  # input-pin level
+                endpoint_globals = coll[0].tolist()
+            else:  # output-pin level: unique child pins, dup fallback
+                eps = coll[10] if len(coll[10]) else coll[0]
+                endpoint_globals = eps.tolist() if torch.is_tensor(eps) else list(eps)
+
+        return mc_endpoint_quantiles(
+            rise_samples, fall_samples, cone_gid_list,
+            endpoint_globals, quantiles)
+
+    def do_path_based_analysis(self, num_paths=1000, sigma=3.0,
+                               path_derates=None, log=True):
+        """
+        Path-based re-analysis of the worst-N endpoint paths
+
+        Graph-based top-K propagation is pessimistic on reconvergent
+        datapaths; this backtraces the N worst paths through the argmax
+        predecessor pointers and re-times each one exactly — arc means
+        summed and stds root-sum-squared along the exact pin sequence,
+        with optional per-path derates — as one batched walk. The
+        recovered pessimism is credited back to the endpoint slacks, so
+        the worst paths get signoff-style PBA numbers without exporting
+        to the reference tool. Requires a completed propagation.
+        Returns the dict from pba_reanalyze_worst_endpoints.
+        """
+        from ..timing.pba import pba_reanalyze_worst_endpoints
+
+        assert self.timing_tensors, 'run do_eval_propagation first'
+        if path_derates is not None:
+            path_derates = torch.as_tensor(path_derates, dtype=self.float_dtype)
+        return pba_reanalyze_worst_endpoints(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            num_paths=num_paths,
+            sigma=sigma,
+            path_derates=path_derates,
+            log=log)
+
+    def do_apply_timing_exceptions(self, exceptions, period=1.0, log=True):
+        """
+        Compile SDC exceptions and fold them into the endpoint slacks
+
+        Each exception dict carries 'type' ('false_path' or 'multicycle'
+        with 'multiplier') and optional 'from'/'through'/'to' pin lists
+        (names or Gids). Specs resolve once against the CSR graph into
+        per-node tag masks, the tags sweep the level schedule as a
+        bitset plane, and each live tag credits the affected endpoints'
+        required times before slack is recomputed — replacing the
+        host-side pandas post-filter that dropped excepted endpoints
+        instead of re-timing them. The packed tag plane is kept at
+        timing_tensors['Gid_2_exception_tags']. Requires a completed
+        propagation. Returns (wns, tns) after adjustment.
+        """
+        from ..timing.exceptions import (MAX_TAGS_PER_BATCH, compile_exceptions,
+                                         propagate_exception_tags,
+                                         exception_required_credits)
+        from ..timing.pocv import calculate_slack_fused
+
+        assert self.timing_tensors, 'run do_eval_propagation first'
+        if self.cone_selector is None:
+            from ..graph.khop import ConeSelector
+            self.cone_selector = ConeSelector(
+                self.Gid_2_children, self.Gid_2_parents, self.max_Gid)
+
+        def _resolve(pins):
+            return [p if isinstance(p, int) else self.pinName_2_Gid[p]
+                    for p in pins]
+
+        exceptions = [dict(exc,
+                           **{key: _resolve(exc[key])
+                              for key in ('from', 'through', 'to') if key in exc})
+                      for exc in exceptions]
+
+        tt = self.timing_tensors
+        dest = tt['dest_node_tensor']
+        num_hops = max(self.level_2_collaterals.keys())
+        rise_credit = torch.zeros(dest.numel(), dtype=self.float_dtype,
+                                  device=self.device)
+        fall_credit = torch.zeros_like(rise_credit)
+        packed = torch.zeros(self.max_Gid, dtype=torch.int64, device=self.device)
+
+        for base in range(0, len(exceptions), MAX_TAGS_PER_BATCH):
+            batch = exceptions[base:base + MAX_TAGS_PER_BATCH]
+            compiled = compile_exceptions(
+                batch, self.cone_selector, self.max_Gid, num_hops,
+                period=period, device=self.device)
+            tag_lanes, batch_packed = propagate_exception_tags(
+                self.level_2_collaterals, compiled, self.max_Gid, self.device)
+            r_credit, f_credit = exception_required_credits(
+                tag_lanes, compiled, tt)
+            rise_credit = torch.maximum(rise_credit, r_credit.to(self.float_dtype))
+            fall_credit = torch.maximum(fall_credit, f_credit.to(self.float_dtype))
+            packed |= batch_packed
+
+        tt['Gid_2_exception_tags'] = packed
+        wns, tns = calculate_slack_fused(
+            tt['Gid_2_rise_slack'],
+            tt['Gid_2_fall_slack'],
+            tt['Gid_2_slack'],
+            tt['Gid_2_rise_arrival'],
+            tt['Gid_2_fall_arrival'],
+            tt['ep_rise_required'] + rise_credit,
+            tt['ep_fall_required'] + fall_credit,
+            dest,
+            topk=self.topK)
+        if log:
+            credited = int(((rise_credit > 0) | (fall_credit > 0)).sum())
+            print(f'[exceptions] {len(exceptions)} exceptions credited '
+                  f'{credited} endpoints, '
+                  f'WNS: {wns.item():.4f}, TNS: {tns.item():.4f}')
+        return wns, tns
+
+    def do_batched_eco_evaluation(self, Gid_2_cellId, cellId_2_deltas, cellId_2_probs=None):
+        """
+        Score N candidate sizing/swap vectors with one batched sweep
+
+        Gid_2_cellId maps output-pin Gids to cell ids and cellId_2_deltas
+        is [num_cells, N], each column one candidate's per-cell delay
+        adjustment. All N alternatives propagate together through a K=1
+        screening sweep with a trailing candidate dimension, instead of N
+        sequential do_eval_propagation calls. Returns per-candidate
+        (wns, tns) device tensors of shape [N]; confirm the winning
+        candidate with a full propagation afterwards.
+        """
+        from ..timing.cuda_ops import cuda_batched_eco_propagate
+
+        rise_arr, fall_arr = cuda_batched_eco_propagate(
+            self.sp_mean_tensor.to(self.device),
+            self.sp_std_tensor.to(self.device),
+            self.level_2_collaterals,
+            self.device,
+            self.max_Gid,
+            Gid_2_cellId.to(self.device),
+            cellId_2_deltas.to(self.device),
+            self.float_dtype,
+            cellId_2_probs=cellId_2_probs.to(self.device) if cellId_2_probs is not None else None
+        )
+
+        dest = torch.tensor(list(self.dest_nodes), dtype=torch.long, device=self.device)
+        rise_req = self.ep_rise_required_truth.to(self.device)[dest].unsqueeze(1)
+        fall_req = self.ep_fall_required_truth.to(self.device)[dest].unsqueeze(1)
+        slack = torch.minimum(rise_req - rise_arr[dest], fall_req - fall_arr[dest])  # [E, N]
+        valid = torch.isfinite(slack)
+        slack = torch.where(valid, slack, torch.zeros_like(slack))
+        wns = torch.where(valid, slack, torch.full_like(slack, float('inf'))).amin(dim=0)
+        tns = slack.clamp(max=0.0).sum(dim=0)
+        return wns, tns
+
+    def do_corner_propagation(self, corner_arc_variations, log=False):
+        """
+        Evaluate S delay corners with one scenario-batched sweep
+
+        Each entry of corner_arc_variations is a (net_arc_2_variation,
+        cell_arc_2_variation) pair for one corner; the graph and the
+        levelization are shared, so the per-corner collaterals stack into
+        [rows, S] delay columns and all corners propagate in lockstep
+        through one K=1 screening sweep. Per-corner WNS/TNS land in
+        corner_wns / corner_tns ([S] device tensors); wns/tns are set to
+        the worst corner. Returns the number of corners evaluated.
+        """
+        assert self.level_2_nodes is not None, "levelization not initialized"
+        from ..timing.collaterals import stack_corner_collaterals
+        from ..timing.cuda_ops import cuda_corner_batched_propagate
+
+        corner_collaterals = []
+        for net_vars, cell_vars in corner_arc_variations:
+            (collaterals, _, _, _, _, _, _, _, _, _) = precompute_collaterals(
+                net_vars,
+                cell_vars,
+                self.sp_mean_tensor,
+                self.sp_std_tensor,
+                self.level_2_nodes,
+                self.Gid_2_pinName,
+                self.inPin_parent_tensor,
+                self.Gid_2_parents,
+                self.device,
+                self.max_Gid,
+                self.cellName_2_orgLibCell,
+                self.libCell_2_riseFallguardband,
+                self.libCell_2_riseFallStd,
+                self.net_2_pocvScaling,
+                self.float_dtype,
+                self.save_dir,
+                use_cache=False,
+                save=False
+            )
+            corner_collaterals.append(collaterals)
+
+        stacked = stack_corner_collaterals(corner_collaterals)
+        if str(self.device) != 'cpu':
+            stacked = move_collaterals_to_device(stacked, self.device)
+
+        rise_arr, fall_arr = cuda_corner_batched_propagate(
+            self.sp_mean_tensor.to(self.device),
+            self.sp_std_tensor.to(self.device),
+            stacked,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            log=log
+        )
+
+        dest = torch.tensor(list(self.dest_nodes), dtype=torch.long, device=self.device)
+        rise_req = self.ep_rise_required_truth.to(self.device)[dest].unsqueeze(1)
+        fall_req = self.ep_fall_required_truth.to(self.device)[dest].unsqueeze(1)
+        slack = torch.minimum(rise_req - rise_arr[dest], fall_req - fall_arr[dest])  # [E, S]
+        valid = torch.isfinite(slack)
+        slack = torch.where(valid, slack, torch.zeros_like(slack))
+        self.corner_wns = torch.where(valid, slack, torch.full_like(slack, float('inf'))).amin(dim=0)
+        self.corner_tns = slack.clamp(max=0.0).sum(dim=0)
+        self.wns = float(self.corner_wns.min())
+        self.tns = float(self.corner_tns.min())
+        for corner, (corner_wns, corner_tns) in enumerate(
+                zip(self.corner_wns.tolist(), self.corner_tns.tolist())):
+            print(f'[corner {corner}] wns: {corner_wns:.4f}, tns: {corner_tns:.4f}')
+        return len(corner_collaterals)
+
+    def do_capture_snapshot(self):
+        """
+        Freeze the committed timing state for concurrent readers
+
+        Returns an immutable TimingSnapshot (cloned host planes + the
+        packed name arena) that any number of threads may query with no
+        locks while the next propagation overwrites the live tensors.
+        Reporting goes through the packed name arena, never the shared
+        Python dicts; the arena is built here on first use when
+        compact_pin_names did not already install it. The snapshot is
+        also kept as self.committed_snapshot for convenience.
+        """
+        from .snapshot import TimingSnapshot
+        assert self.timing_tensors, 'run a propagation before capturing a snapshot'
+        if self.pin_name_index is None:
+            self.pin_name_index = PinNameIndex.from_names(
+                [self.Gid_2_pinName[gid] for gid in range(self.max_Gid)]
+            )
+        wns = float(self.wns) if self.wns is not None else float('inf')
+        tns = float(self.tns) if self.tns is not None else 0.0
+        snapshot = TimingSnapshot.capture(
+            self.timing_tensors,
+            self.dest_nodes,
+            self.node_2_level,
+            self.pin_name_index,
+            self.max_Gid,
+            wns, tns
+        )
+        self.committed_snapshot = snapshot
+        return snapshot
+
+    def do_start_query_server(self):
+        """
+        Serve this warm instance to many clients with request batching
+
+        Returns a TimingQueryServer whose futures-based API (query_slacks,
+        whatif_cones, update_delays) any thread may call; bursts of small
+        queries coalesce into single batched GPU work against the last
+        committed timing state, and delay updates act as ordering
+        barriers. Requires a completed propagation.
+        """
+        from .server import TimingQueryServer
+        assert self.timing_tensors, 'run a propagation before serving queries'
+        if self.query_server is None:
+            self.query_server = TimingQueryServer(self)
+            self.query_server.start()
+        return self.query_server
+
+    def do_stop_query_server(self):
+        """Stop the query server and drop it"""
+        if self.query_server is not None:
+            self.query_server.stop()
+            self.query_server = None
+
+    def do_export_timing_handles(self, kind='dlpack', include_grads=True):
+        """
+        Zero-copy export of slacks, arrivals and arc gradients
+
+        Returns a name->handle dict aliasing the live device tensors —
+        no D2H copy, no serialization. kind='dlpack' hands capsules to a
+        co-resident consumer (DREAMPlace-style placers import them with
+        from_dlpack); kind='cuda_ipc' gives picklable handles a separate
+        process maps via from_cuda_ipc_handle. The handles alias storage
+        the next propagation overwrites in place, so consumers re-fetch
+        per iteration (capsules are single-use anyway) and this instance
+        must outlive every mapping.
+        """
+        from ..io.interop import export_tensor_map
+
+        tensors = {}
+        if self.timing_tensors:
+            for name in ('Gid_2_slack', 'Gid_2_rise_slack', 'Gid_2_fall_slack',
+                         'Gid_2_rise_arrival', 'Gid_2_fall_arrival',
+                         'Gid_2_rise_arrival_mean', 'Gid_2_fall_arrival_mean'):
+                if name in self.timing_tensors:
+                    tensors[name] = self.timing_tensors[name]
+        if include_grads:
+            tensors['netArc_grad_tensor'] = getattr(self, 'netArc_grad_tensor', None)
+            tensors['cellArc_grad_tensor'] = getattr(self, 'cellArc_grad_tensor', None)
+            tensors['stage_grad_tensor'] = getattr(self, 'stage_grad_tensor', None)
+        assert tensors, 'no timing tensors to export; run a propagation first'
+        return export_tensor_map(tensors, kind=kind)
+
+    def do_multi_gpu_propagation(self, devices=None, log=False):
+        """
+        Full-chip propagation partitioned across multiple GPUs
+
+        Splits the node space into contiguous Gid blocks (one per
+        device), runs each level's row subsets concurrently, and
+        exchanges only boundary-crossing parent arrivals with peer index
+        copies before every level. The partitioner and its exchange plan
+        are built on first use and cached; call again with a different
+        device list to repartition. K=1 screening semantics — sets
+        self.wns/self.tns and keeps the merged planes on the first
+        device in self.timing_tensors.
+        """
+        from ..timing.multigpu import MultiGpuPropagator
+
+        if devices is None:
+            devices = [torch.device(f'cuda:{i}')
+                       for i in range(torch.cuda.device_count())]
+        if self._multi_gpu_propagator is None or \
+                self._multi_gpu_propagator.devices != [torch.device(d) for d in devices]:
+            self._multi_gpu_propagator = MultiGpuPropagator(
+                self.level_2_collaterals,
+                devices,
+                self.max_Gid,
+                self.float_dtype
+            )
+
+        valid_sps = self.timing_tensors.get('valid_sps') \
+            if self.timing_tensors else None
+        if valid_sps is None:
+            valid_sps = torch.zeros(self.max_Gid, dtype=torch.bool)
+            valid_sps[torch.tensor(list(self.source_nodes), dtype=torch.long)] = True
+
+        planes = self._multi_gpu_propagator.propagate(
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.inPin_parent_tensor,
+            valid_sps,
+            log=log
+        )
+        primary = planes['Gid_2_rise_arrival'].device
+        dest = torch.tensor(list(self.dest_nodes), dtype=torch.long, device=primary)
+        rise_req = self.ep_rise_required_truth.to(primary)[dest]
+        fall_req = self.ep_fall_required_truth.to(primary)[dest]
+        slack = torch.minimum(rise_req - planes['Gid_2_rise_arrival'][dest],
+                              fall_req - planes['Gid_2_fall_arrival'][dest])
+        valid = torch.isfinite(slack)
+        slack = torch.where(valid, slack, torch.zeros_like(slack))
+        self.wns = float(torch.where(valid, slack,
+                                     torch.full_like(slack, float('inf'))).min())
+        self.tns = float(slack.clamp(max=0.0).sum())
+        self.timing_tensors = self.timing_tensors or {}
+        self.timing_tensors.update(planes)
+        print(f'[multi-gpu] wns: {self.wns:.4f}, tns: {self.tns:.4f}')
+        return True
+
+    def do_export_block_model(self, out_file, boundary_in_pins=None,
+                              boundary_out_pins=None, sigma=3.0):
+        """
+        Export this block as ETM-style interface arcs for top-level runs
 
-        self.timing_tensors = {}
+        Distills the propagated planes (requires one do_eval_propagation)
+        into boundary input -> output delay arcs via the per-candidate
+        startpoint tracking, and writes them in the cell_arcs.csv POCV
+        schema so a top-level instance ingests the block as one
+        pre-characterized cell (see timing/etm.py). Boundary pins
+        default to the block's ports: pins without a hierarchy
+        separator, split into startpoint-side and endpoint-side sets.
+        """
+        from ..timing.etm import extract_interface_timing, write_interface_arcs
 
+        assert self.timing_tensors and \
+            'Gid_2_rise_startpoints' in self.timing_tensors, \
+            'run do_eval_propagation before exporting a block model'
+        if boundary_in_pins is None:
+            boundary_in_pins = [self.Gid_2_pinName[gid]
+                                for gid in self.source_nodes
+                                if '/' not in self.Gid_2_pinName[gid]]
+        if boundary_out_pins is None:
+            boundary_out_pins = [self.Gid_2_pinName[gid]
+                                 for gid in self.dest_nodes
+                                 if '/' not in self.Gid_2_pinName[gid]]
 
+        interface_arcs = extract_interface_timing(
+            self.timing_tensors,
+            self.pinName_2_Gid,
+            self.Gid_2_pinName,
+            boundary_in_pins,
+            boundary_out_pins,
+            self.max_Gid,
+            sigma=sigma
+        )
+        write_interface_arcs(interface_arcs, out_file, scale=self.scale)
+        return interface_arcs
 
-    def do_set_insta_path(self, path: str, design_name: str, input_folderName: Optional[str] = None):
+    @staticmethod
+    def do_multi_design_propagation(instas, sigma=3.0):
         """
-        Set the base path and design information
+        Batch several initialized designs through one GPU
 
-        Args:
-            path: Base directory path for the design
-            design_name: Name of the design
-            input_folderName: Optional custom folder name for inputs
+        The regression-farm counterpart of do_multi_gpu_propagation:
+        instead of one design spread over many devices, many small
+        designs share one device and one process (so the kernel modules
+        load once). Each design gets its own stream and its whole sweep
+        is submitted without host syncs, letting the hardware scheduler
+        run design B's small levels in the SMs design A's wide level
+        leaves idle. Every instance ends up with its own
+        timing_tensors/wns/tns as if it had run do_eval_propagation.
+
+        Returns:
+            design_name -> (wns, tns)
         """
-        self.prefix = path
-        self.design_name = design_name
-        self.save_dir = os.path.join(self.prefix, DEFAULT_OUTPUT_FOLDER)
-        os.makedirs(self.save_dir, exist_ok=True)
+        from ..timing.multidesign import MultiDesignScheduler
 
-        if input_folderName:
-            self.input_folderName = input_folderName
+        return MultiDesignScheduler(instas).propagate_all(sigma=sigma)
 
-    def set_device(self, num: int):
-        torch.cuda.set_device(num)
-        self.device = torch.device(f'cuda:{num}')
-        print(f'INSTA set device to {num}')
+    def do_cluster_endpoints(self, bucket_width=0.05, log=True):
+        """
+        Bucket endpoints sharing a timing context into gradient clusters
 
-    def do_initialization(self, full_diff_sta: bool=False):
-        """Perform the complete initialization sequence"""
+        50k endpoints of one bus differ only in their bit index: same
+        launch startpoint, same capture clock pin, required times within
+        routing noise of each other. Clustering by (sp, ck pin,
+        required-time bucket) over the tensorized ep metadata collapses
+        them to one representative each (the tightest required time in
+        the cluster), and do_diff_propagation(use_clusters=True) then
+        reduces TNS over representatives only, weighting each by its
+        cluster size so the broadcast gradient keeps full-design
+        magnitude. Rebuild after required-time changes
+        (do_set_required_sigma) — the buckets key on the signoff values.
+        """
+        from ..timing.pocv import build_endpoint_clusters
 
-        print('[reading noTiming file]')
-        self._read_no_timing_pin_file()
+        if self._cppr_metadata is None:
+            self._cppr_metadata = build_cppr_metadata(
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.dest_nodes,
+                self.Gid_2_pinName
+            )
 
-        print('[reading valid pin file]')
-        if not self._read_valid_pin_file():
-            return False
+        # Enumerate the capture clock pin names into a dense id column;
+        # the cluster builder never sees strings
+        ck_name_2_id = {}
+        ck_ids = []
+        for gid in self._cppr_metadata['ep_gids'].tolist():
+            epName = self.Gid_2_pinName[gid]
+            ck = self.epName_riseFall_2_ckPinName.get((epName, 'rise')) \
+                or self.epName_riseFall_2_ckPinName.get((epName, 'fall'))
+            ck_ids.append(-1 if ck is None
+                          else ck_name_2_id.setdefault(ck, len(ck_name_2_id)))
 
-        print('[reading cell arc file]')
-        if not self._read_cell_arc_file():
-            return False
+        self._endpoint_clusters = build_endpoint_clusters(
+            self._cppr_metadata,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            torch.tensor(ck_ids, dtype=torch.int64),
+            bucket_width,
+            self.device
+        )
+        num_eps = self._endpoint_clusters['ep_gids'].numel()
+        num_clusters = self._endpoint_clusters['rep_gids'].numel()
+        if log:
+            print(f'[ep clusters] {num_eps} endpoints -> {num_clusters} '
+                  f'clusters ({num_eps / max(num_clusters, 1):.1f}x, '
+                  f'bucket width {bucket_width})')
+        return num_clusters
 
-        print('[reading net arc file]')
-        if not self._read_net_arc_file():
+    def do_diff_propagation(self, plot=False, checkpoint_segment_levels=0, topk=1,
+                            grad_arc_stds=False, amp_dtype=None,
+                            track_startpoints=True, grad_sp_latencies=False,
+                            use_clusters=False):
+        # amp_dtype=torch.bfloat16 runs the sweep with half-precision
+        # stored activations (pairs with checkpointing for the largest
+        # trainable designs); master arc gradients stay fp32 and
+        # do_scaled_backward guards the backward with loss scaling.
+        # plot=True gives the fp32-vs-bf16 acceptance check.
+        # track_startpoints=False skips the startpoint plane updates for
+        # loops that never read them (do_train_loop-style optimizers).
+        # use_clusters=True reduces TNS over the cluster representatives
+        # from do_cluster_endpoints (built with defaults if missing),
+        # weighted by cluster size — same gradient magnitude, ~20x fewer
+        # endpoint rows feeding the backward on bus-dominated designs.
+        if amp_dtype is not None:
+            self.do_set_float_dtype(amp_dtype)
+        if use_clusters and self._endpoint_clusters is None:
+            self.do_cluster_endpoints()
+        # grad_sp_latencies additionally differentiates the startpoint
+        # clock latencies (useful-skew surface; see do_extract_sp_grads)
+        if not self._diff_propagate_arrival(checkpoint_segment_levels=checkpoint_segment_levels,
+                                            topk=topk, grad_arc_stds=grad_arc_stds,
+                                            track_startpoints=track_startpoints,
+                                            grad_sp_latencies=grad_sp_latencies,
+                                            cluster_tensors=(self._endpoint_clusters
+                                                             if use_clusters else None)):
             return False
 
-        print('[building nx and gt graph]')
-        if not self._build_graph():
-            return False
+        if plot:
+            print('[plotting]')
+            if not self._plot_correlation(topK=1):
+                return False
 
-        print('[reading sp file and launch clock rpt file]')
-        if not self._read_sp_file():
-            return False
+        return True
 
-        print('[reading ep file]')
-        if not self._read_ep_file():
-            return False
+    def do_scaled_backward(self):
+        """
+        Backward of -TNS with dynamic loss scaling
 
-        print('[initializing timing groundtruths]')
-        if not self._initialize_timing_groundtruths():
-            return False
+        Scales the loss before backward so half-precision chain terms
+        survive, then divides the accumulated arc gradients back down (or
+        drops them and backs the scale off when the backward overflowed).
+        Returns True when the gradients are usable; on False skip the
+        optimizer step and rerun the propagation. A no-op wrapper cost in
+        fp32 runs, so optimizer loops can call it unconditionally.
+        """
+        from ..timing.cuda_ops import DynamicLossScaler
+        accumulator = self.timing_tensors.get('_arc_grad_accumulator')
+        assert accumulator is not None, 'run do_diff_propagation first'
+        if self._loss_scaler is None:
+            self._loss_scaler = DynamicLossScaler()
+        loss = -self.tns
+        self._loss_scaler.scale(loss).backward()
+        return self._loss_scaler.unscale_and_update(accumulator)
 
-        print('[levelizing]')
-        if not self._levelize():
-            return False
+    def do_compute_tns_hvp(self, v_net, v_cell, topk=1, temperature=1.0):
+        """
+        Hessian-vector product of -TNS w.r.t. the arc delay means
 
-        print('[reading pocvm guardband file]')
-        if not self._read_pocvm_file():
-            return False
+        v_net / v_cell are [num_net_arcs, 2] / [num_cell_arcs, 2]
+        (rise, fall) direction vectors in the netArcId / cellArcId
+        spaces. One forward-over-reverse pass: the sweep runs with the
+        arc-delay columns kept as autograd leaves, the first-order
+        gradients come out of torch.autograd.grad with create_graph, are
+        contracted with the direction, and a second backward yields H·v.
+        Costs roughly two gradient extractions; no finite differencing.
+        Returns (hvp_net, hvp_cell) shaped like the inputs.
+        """
+        from ..timing.pocv import collect_arc_delay_leaves
 
-        print('[precomputing collaterals]')
-        if not self._precompute_collaterals():
-            return False
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            topk,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors,
+            is_diff_prop=True
+        )
+        self.timing_tensors, wns, tns = propagate_arrival_times(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            is_diff_prop=True,
+            topk=topk,
+            temperature=temperature,
+            second_order=True
+        )
+        leaves = collect_arc_delay_leaves(self.level_2_collaterals)
+        assert leaves, 'second-order sweep left no arc-delay leaves'
+        leaf_tensors = [leaf for leaf, _, _, _ in leaves]
 
-        return True
+        grads = torch.autograd.grad(-tns, leaf_tensors,
+                                    create_graph=True, allow_unused=True)
+        directional = None
+        for grad, (_, ids, is_net, is_rise) in zip(grads, leaves):
+            if grad is None:
+                continue
+            direction = v_net if is_net else v_cell
+            v_vals = direction.to(grad.device)[ids, 0 if is_rise else 1]
+            term = (grad * v_vals).sum()
+            directional = term if directional is None else directional + term
+        assert directional is not None, 'TNS has no dependence on the arc delays'
 
-    def do_eval_propagation(self, plot=False):
-        if not self._propagate_arrival():
-            return False
+        hv_grads = torch.autograd.grad(directional, leaf_tensors, allow_unused=True)
+        hvp_net = torch.zeros_like(v_net)
+        hvp_cell = torch.zeros_like(v_cell)
+        for hv, (_, ids, is_net, is_rise) in zip(hv_grads, leaves):
+            if hv is None:
+                continue
+            target = hvp_net if is_net else hvp_cell
+            target[:, 0 if is_rise else 1].index_add_(
+                0, ids.to(target.device), hv.to(target.dtype).to(target.device))
 
-        if plot:
-            print('[plotting]')
-            if not self._plot_correlation():
-                return False
+        # Un-mark the cached collateral tensors so later eval sweeps see
+        # plain buffers again
+        for leaf in leaf_tensors:
+            leaf.requires_grad_(False)
+        return hvp_net, hvp_cell
 
-        return True
+    def do_train_loop(self, schedule, step_fn, checkpoint_segment_levels=0,
+                      topk=1, grad_arc_stds=False):
+        """
+        Run a temperature-annealed sequence of differentiable propagations
 
-    def do_diff_propagation(self, plot=False):
-        if not self._diff_propagate_arrival():
-            return False
+        schedule is an iterable of temperatures (soft to hard) and step_fn
+        is called after each forward as step_fn(iteration, temperature,
+        wns, tns) with WNS/TNS device scalars; it owns the backward pass
+        and any delay patching (do_patch_arc_delays), and may return False
+        to stop early. Unlike repeated do_diff_propagation calls, all
+        state persists across iterations — the temperature scalar updates
+        in place, the arc-gradient buffers are zeroed rather than rebuilt,
+        and only the rows written by the previous sweep are re-armed — so
+        per-iteration cost is the sweep itself. Returns the number of
+        iterations run; the last iteration's tensors stay in
+        timing_tensors and self.wns/self.tns.
+        """
+        self.timing_tensors = clear_timing_cache(
+            self.max_Gid,
+            topk,
+            self.device,
+            self.float_dtype,
+            self.sp_mean_tensor,
+            self.sp_std_tensor,
+            self.ep_rise_required_truth,
+            self.ep_fall_required_truth,
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.source_nodes,
+            self.dest_nodes,
+            self.timing_tensors,
+            is_diff_prop=True
+        )
+        context = DiffPropagationContext(
+            self.timing_tensors,
+            self.level_2_collaterals,
+            self.inPin_parent_tensor,
+            self.device,
+            self.max_Gid,
+            self.float_dtype,
+            topk=topk,
+            checkpoint_segment_levels=checkpoint_segment_levels,
+            grad_arc_stds=grad_arc_stds
+        )
 
-        if plot:
-            print('[plotting]')
-            if not self._plot_correlation(topK=1):
-                return False
+        iterations = 0
+        wns = tns = None
+        for iteration, temperature in enumerate(schedule):
+            wns, tns = context.step(temperature)
+            iterations += 1
+            if step_fn(iteration, temperature, wns, tns) is False:
+                break
 
-        return True
+        if tns is not None:
+            self.wns, self.tns = float(wns), float(tns)
+            print(f'[train loop] {iterations} iterations, '
+                  f'final wns: {self.wns:.4f}, tns: {self.tns:.4f}')
+        return iterations
 
+    @py_scope('do_extract_arc_grads')
+    @nvtx_annotate('arc grad extraction')
     def do_extract_arc_grads(self, inPinMod=1):
         """
         Get timing gradients of each cell arc and net arc
@@ -228,21 +4623,64 @@ class INSTA:
         assert self.Gid_2_children, "Gid children mapping not initialized"
         assert self.Gid_2_parents, "Gid parent mapping not initialized"
 
+        # Backward already accumulated flat arc gradients when the sweep
+        # ran with an ArcGradAccumulator; only legacy diff runs (no
+        # accumulator) still collect per-level .grad leaves
+        accumulator = self.timing_tensors.get('_arc_grad_accumulator') \
+            if self.timing_tensors is not None else None
+
         start_time = time.time()
-        self.cellArc_2_riseFallGrads = extract_cellArc_grad(self.level_2_collaterals, self.cellArcId_2_cellArcKey)
+        if accumulator is not None:
+            self.cellArc_grad_tensor = accumulator.cell_grad_tensor()
+        else:
+            self.cellArc_grad_tensor = extract_cellArc_grad(self.level_2_collaterals, self.cellArcId_2_cellArcKey)
+        self.cellArc_2_riseFallGrads = ArcPairGradView(self.cellArc_grad_tensor, self.cellArcKey_2_cellArcId)
         print(f"cell arc grad extraction time: {time.time() - start_time:.2}s")
 
         start_time = time.time()
-        self.netArc_2_riseFallGrads = extract_netArc_grad(self.level_2_collaterals, self.netArcId_2_netArcKey)
+        if accumulator is not None:
+            self.netArc_grad_tensor = accumulator.net_grad_tensor()
+        else:
+            self.netArc_grad_tensor = extract_netArc_grad(self.level_2_collaterals, self.netArcId_2_netArcKey)
+        self.netArc_2_riseFallGrads = ArcPairGradView(self.netArc_grad_tensor, self.netArcKey_2_netArcId)
         print(f"net arc grad extraction time: {time.time() - start_time:.2}s")
 
+        # Std gradients exist when the sweep ran with grad_arc_stds; the
+        # buffers are all-zero otherwise
+        if accumulator is not None:
+            self.cellArc_std_grad_tensor = accumulator.cell_std_grad_tensor()
+            self.netArc_std_grad_tensor = accumulator.net_std_grad_tensor()
+
         start_time = time.time()
-        self.outPinName_2_stageGrad = extract_stage_grad(
-            self.outPin_set, self.Gid_2_pinName, self.Gid_2_children, self.Gid_2_parents,
-            self.netArc_2_riseFallGrads, self.cellArc_2_riseFallGrads
+        self.stage_grad_tensor = extract_stage_grad(
+            self.level_2_collaterals, self.netArc_grad_tensor, self.cellArc_grad_tensor,
+            self.max_Gid
         )
+        self.outPinName_2_stageGrad = StageGradView(
+            self.stage_grad_tensor, self.outPin_set, self.Gid_2_pinName
+        )
+        self._tns_estimator = None # fresh gradients, fresh linearization
         print(f"stage grad extraction time: {time.time() - start_time:.2f}s")
 
+    def do_extract_sp_grads(self):
+        """
+        Per-startpoint d(loss)/d(clock latency) — the useful-skew surface
+
+        After do_diff_propagation(grad_sp_latencies=True) and a backward
+        pass, the device sp_mean_tensor leaf holds the gradient of the
+        loss (typically -TNS) w.r.t. every startpoint's clock arrival:
+        one backward replaces per-register finite differencing for skew
+        scheduling. Returns the dense [max_Gid] gradient tensor (zero at
+        non-startpoint gids); rows index by gid, so CTS-side joins stay
+        array lookups.
+        """
+        assert self.timing_tensors, 'no propagation has run yet'
+        sp_dev = self.timing_tensors.get('sp_mean_tensor')
+        assert sp_dev is not None and sp_dev.grad is not None, \
+            'run do_diff_propagation(grad_sp_latencies=True) and a backward first'
+        self.sp_grad_tensor = sp_dev.grad.detach()
+        return self.sp_grad_tensor
+
     def _read_cell_libCell_file(self) -> bool:
         """Read cell to library cell mapping file"""
         file_path = os.path.join(self.prefix, self.input_folderName, 'cell_2_libCell.csv')
@@ -270,28 +4708,57 @@ class INSTA:
     def _read_cell_arc_file(self) -> bool:
         """Read timing arcs for cells"""
         file_path = os.path.join(self.prefix, self.input_folderName, 'cell_arcs.csv')
+        if (self.columnar_arcs or self.streaming_parse) and self._pin_interner is None:
+            self._pin_interner = PinInterner()
         self.cell_arc_2_variation, self.is_pocv, success = read_cell_arc_file(
-            file_path, self.save_dir, self.scale
+            file_path, self.save_dir, self.scale,
+            columnar=self.columnar_arcs or self.streaming_parse,
+            interner=self._pin_interner, streaming=self.streaming_parse
         )
         return success
 
     def _read_net_arc_file(self) -> bool:
         """Read timing arcs for nets"""
         file_path = os.path.join(self.prefix, self.input_folderName, 'net_arcs.csv')
+        if (self.columnar_arcs or self.streaming_parse) and self._pin_interner is None:
+            self._pin_interner = PinInterner()
         self.net_arc_2_variation, _, success = read_net_arc_file(
-            file_path, self.save_dir, self.scale
+            file_path, self.save_dir, self.scale,
+            columnar=self.columnar_arcs or self.streaming_parse,
+            interner=self._pin_interner, streaming=self.streaming_parse
         )
         return success
 
     def _build_graph(self) -> bool:
         """Build the timing graph from cell and net arcs"""
+        # Columnar tables skip the per-arc Python loop entirely: the graph
+        # is assembled from the id arrays with sort/prefix-sum passes and
+        # the CSR views stand in for the dict-of-sets adjacency
+        if isinstance(self.cell_arc_2_variation, ArcColumns):
+            (
+                self.pinName_2_Gid, self.Gid_2_pinName,
+                self.cellName_2_pinNames, self.cellName_2_inPinNames, self.cellName_2_outPinNames,
+                self.csr_graph,
+                self.inPin_parent_dict, self.outPin_set, self.max_Gid
+            ) = build_timing_graph_columnar(
+                self.cell_arc_2_variation, self.net_arc_2_variation,
+                self._pin_interner,
+                self.valid_pinNames_set, self.noTiming_pinNames_set
+            )
+            self.Gid_2_parents = self.csr_graph.parents_view()
+            self.Gid_2_children = self.csr_graph.children_view()
+            self._compact_pin_name_maps()
+            return True
+
         # Create lists of arcs
         cell_arcs = list(self.cell_arc_2_variation.keys())
         net_arcs = list(self.net_arc_2_variation.keys())
 
-        # Build the graph
+        # Build the graph; the nx/gt objects and id cross-maps the serial
+        # builder produces are construction scaffolding only — the CSR is
+        # the single resident graph over the Gid space
         (
-            self.pinG, self.gt_graph, self.nx_2_gt, self.gt_2_nx,
+            _pinG, _gt_graph, _nx_2_gt, _gt_2_nx,
             self.pinName_2_Gid, self.Gid_2_pinName,
             self.cellName_2_pinNames, self.cellName_2_inPinNames, self.cellName_2_outPinNames,
             self.Gid_2_parents, self.Gid_2_children,
@@ -300,9 +4767,47 @@ class INSTA:
             cell_arcs, net_arcs, self.save_dir,
             self.valid_pinNames_set, self.noTiming_pinNames_set
         )
+        del _pinG, _gt_graph, _nx_2_gt, _gt_2_nx
+
+        # Pack connectivity into the canonical CSR once; traversal passes
+        # read the tensors directly instead of walking dicts of sets
+        self.csr_graph = CSRGraph.from_adjacency(self.Gid_2_children, self.max_Gid)
+        print(f"[build graph] CSR packed: {self.csr_graph.num_nodes} nodes, "
+              f"{self.csr_graph.num_edges} edges")
 
+        self._compact_pin_name_maps()
         return True
 
+    def _compact_pin_name_maps(self):
+        """Swap the name<->Gid string dicts for packed-arena views"""
+        if not self.compact_pin_names:
+            return
+        self.pin_name_index = PinNameIndex.from_names(
+            [self.Gid_2_pinName[gid] for gid in range(self.max_Gid)]
+        )
+        self.pinName_2_Gid = self.pin_name_index.name_2_gid_view()
+        self.Gid_2_pinName = self.pin_name_index.gid_2_name_view()
+        arena_mb = self.pin_name_index.arena.numel() / (1 << 20)
+        print(f'[pin names] packed {self.max_Gid} names into a '
+              f'{arena_mb:.1f}MB arena')
+
+    def do_lookup_pins(self, pinNames):
+        """
+        Bulk pin name -> Gid resolution
+
+        Args:
+            pinNames: List of pin names to resolve
+
+        Returns:
+            Int64 tensor of Gids, -1 for names not in the design
+        """
+        if self.pin_name_index is not None:
+            return self.pin_name_index.lookup(pinNames)
+        return torch.tensor(
+            [self.pinName_2_Gid.get(name, -1) for name in pinNames],
+            dtype=torch.int64
+        )
+
 
     def _read_sp_file(self) -> bool:
         """Read startpoint attributes file for timing propagation"""
@@ -340,6 +4845,28 @@ class INSTA:
             self.save_dir
         )
 
+        # Pre-tensorize the endpoint/golden-startpoint maps here, once:
+        # the host CPPR correction then consumes only tensors instead of
+        # redoing string-keyed lookups over all endpoints per plot call
+        self._cppr_metadata = build_cppr_metadata(
+            self.epName_riseFall_2_spName,
+            self.pinName_2_Gid,
+            self.dest_nodes,
+            self.Gid_2_pinName
+        )
+
+        # Endpoint-compact device copies of the truth columns, built
+        # once next to the metadata: do_evaluate_accuracy compares
+        # against these without ever touching the host planes again
+        self._groundtruth_gpu = build_groundtruth_device_tensors(
+            self._cppr_metadata,
+            self.ep_rise_arrival_truth, self.ep_rise_required_truth,
+            self.ep_rise_slack_truth, self.ep_rise_depth_truth,
+            self.ep_fall_arrival_truth, self.ep_fall_required_truth,
+            self.ep_fall_slack_truth, self.ep_fall_depth_truth,
+            self.device
+        )
+
         return True
 
     def _precompute_collaterals(self) -> bool:
@@ -412,25 +4939,158 @@ class INSTA:
 
     def _levelize(self) -> bool:
         """Levelize the timing graph for efficient propagation"""
+        # Frontier relaxation over the canonical CSR; the graph-tool
+        # topological sort and its id translation are gone
+        assert self.csr_graph is not None, "timing graph not built"
         (
             self.level_2_nodes, self.node_2_level,
             self.inPin_parent_tensor,
             self.level_2_nodes_bw, self.node_2_level_bw
-        ) = levelize_graph(
-            self.gt_graph,
-            self.gt_2_nx,
+        ) = levelize_csr_graph(
+            self.csr_graph,
             self.source_nodes,
             self.dest_nodes,
-            self.Gid_2_parents,
-            self.Gid_2_children,
             self.inPin_parent_dict,
             self.save_dir
         )
 
         return True
 
-    def _propagate_arrival(self) -> bool:
-        """Propagate arrival times through the timing graph"""
+    def _renumber_gids_level_major(self):
+        """
+        Renumber Gids level-major so level gathers read contiguous memory
+
+        Parse-order Gid assignment makes the per-level parent gathers
+        (Gid_2_rise_arrival_mean[p_indices] and the kernel's parent
+        reads) effectively random across the full planes. Re-assigning
+        gids in level order clusters every level — and therefore the
+        parents of the next level — into contiguous plane rows, turning
+        those gathers into near-sequential reads. Runs between
+        levelization and collateral precompute (the collaterals capture
+        gids); the permutation is deterministic, so warm-started caches
+        from the earlier stages stay consistent.
+        """
+        assert self.level_2_collaterals is None, \
+            'renumber before collateral precompute'
+
+        # Level-major permutation: leveled nodes in level order, then the
+        # unleveled remainder in old order
+        ordered = torch.cat([
+            torch.tensor(self.level_2_nodes[level], dtype=torch.int64)
+            for level in sorted(self.level_2_nodes)
+        ])
+        perm = torch.full((self.max_Gid,), -1, dtype=torch.int64)
+        perm[ordered] = torch.arange(ordered.numel(), dtype=torch.int64)
+        rest = torch.nonzero(perm < 0).flatten()
+        perm[rest] = torch.arange(
+            ordered.numel(), ordered.numel() + rest.numel(), dtype=torch.int64
+        )
+        perm_l = perm.tolist()
+
+        def remap_plane(plane):
+            remapped = torch.empty_like(plane)
+            remapped[perm] = plane
+            return remapped
+
+        # Gid-indexed ground-truth planes
+        for attr in ('ep_rise_arrival_truth', 'ep_rise_required_truth',
+                     'ep_rise_slack_truth', 'ep_rise_depth_truth',
+                     'ep_fall_arrival_truth', 'ep_fall_required_truth',
+                     'ep_fall_slack_truth', 'ep_fall_depth_truth',
+                     'sp_arrival_truth', 'sp_mean_tensor', 'sp_std_tensor'):
+            plane = getattr(self, attr, None)
+            if plane is not None:
+                setattr(self, attr, remap_plane(plane))
+
+        # inPin_parent_tensor carries gids on both axes
+        old_parent = self.inPin_parent_tensor.to(torch.int64)
+        remapped_parent = torch.where(
+            old_parent >= 0, perm[old_parent.clamp(min=0)],
+            torch.tensor(-1, dtype=torch.int64)
+        )
+        self.inPin_parent_tensor = remap_plane(
+            remapped_parent.to(self.inPin_parent_tensor.dtype)
+        )
+
+        # Connectivity
+        src, dst = self.csr_graph.edge_list()
+        self.csr_graph = CSRGraph.from_edges(perm[src], perm[dst], self.max_Gid)
+        if isinstance(self.Gid_2_parents, CSRAdjacencyView):
+            self.Gid_2_parents = self.csr_graph.parents_view()
+            self.Gid_2_children = self.csr_graph.children_view()
+        else:
+            self.Gid_2_parents = collections.defaultdict(
+                set, {perm_l[n]: {perm_l[p] for p in parents}
+                      for n, parents in self.Gid_2_parents.items()}
+            )
+            self.Gid_2_children = collections.defaultdict(
+                set, {perm_l[n]: {perm_l[c] for c in children}
+                      for n, children in self.Gid_2_children.items()}
+            )
+
+        # Name maps and node sets
+        if self.pin_name_index is not None:
+            inverse = torch.argsort(perm)
+            self.pin_name_index = PinNameIndex.from_names(
+                [self.Gid_2_pinName[int(old)] for old in inverse]
+            )
+            self.pinName_2_Gid = self.pin_name_index.name_2_gid_view()
+            self.Gid_2_pinName = self.pin_name_index.gid_2_name_view()
+        else:
+            self.Gid_2_pinName = {perm_l[gid]: name
+                                  for gid, name in self.Gid_2_pinName.items()}
+            self.pinName_2_Gid = {name: gid
+                                  for gid, name in self.Gid_2_pinName.items()}
+
+        self.inPin_parent_dict = {perm_l[k]: perm_l[v]
+                                  for k, v in self.inPin_parent_dict.items()}
+        self.outPin_set = {perm_l[g] for g in self.outPin_set}
+        self.source_nodes = {perm_l[g] for g in self.source_nodes}
+        self.dest_nodes = {perm_l[g] for g in self.dest_nodes}
+
+        # Levelization maps; the level lists become contiguous gid runs
+        self.node_2_level = {perm_l[n]: level
+                             for n, level in self.node_2_level.items()}
+        self.level_2_nodes = {level: [perm_l[n] for n in nodes]
+                              for level, nodes in self.level_2_nodes.items()}
+        if self.node_2_level_bw:
+            self.node_2_level_bw = {perm_l[n]: level
+                                    for n, level in self.node_2_level_bw.items()}
+        if self.level_2_nodes_bw:
+            self.level_2_nodes_bw = {level: [perm_l[n] for n in nodes]
+                                     for level, nodes in self.level_2_nodes_bw.items()}
+
+        # Partition state is gid-addressed; recompute on demand
+        self.domain_labels = None
+        self.domain_level_2_nodes = None
+        self._domain_collaterals = None
+
+        # The CPPR metadata and the device truth table carry old gids;
+        # both rebuild lazily from the remapped maps on first use
+        self._cppr_metadata = None
+        self._groundtruth_gpu = None
+
+        print(f'[renumber] {ordered.numel()} leveled gids now level-major, '
+              f'{rest.numel()} unleveled appended')
+
+    def _propagate_arrival(self, use_cuda_graph: bool = False,
+                           deterministic: bool = False,
+                           output_level: str = 'full',
+                           sigma: float = 3.0) -> bool:
+        """
+        Propagate arrival times through the timing graph
+
+        deterministic trades the fused kernels for the stable-sorted torch
+        cell path so repeated runs give bit-identical top-K orderings
+        (signoff diffing); it requires the eager sweep, so it cannot be
+        combined with use_cuda_graph.
+        """
+        assert not (use_cuda_graph and deterministic), \
+            'deterministic propagation requires the eager level sweep'
+        if use_cuda_graph and self.graph_propagator is None:
+            from ..timing.cuda_ops import CudaGraphArrivalPropagator
+            self.graph_propagator = CudaGraphArrivalPropagator()
+
         # Clear timing cache and initialize timing tensors
         self.timing_tensors = clear_timing_cache(
             self.max_Gid,
@@ -449,25 +5109,54 @@ class INSTA:
         )
 
         # Propagate arrival times
-        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
-            self.timing_tensors,
-            self.level_2_collaterals,
-            self.inPin_parent_tensor,
-            self.device,
-            self.max_Gid,
-            self.float_dtype
-        )
+        from ..timing.memory import track as track_memory
+        with track_memory('propagation'):
+            self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+                self.timing_tensors,
+                self.level_2_collaterals,
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                sigma=sigma,
+                topk=self.topK,
+                graph_propagator=self.graph_propagator if use_cuda_graph else None,
+                deterministic=deterministic,
+                cppr_tensors=self.cppr_tensors if self._fuse_cppr else None,
+                tuner=self._dispatch_tuner
+            )
 
         # Save arrival tensors
-        save_arrival_tensors(self.timing_tensors, self.save_dir)
+        save_arrival_tensors(self.timing_tensors, self.save_dir,
+                             output_level=output_level)
 
         return True
 
-    def _diff_propagate_arrival(self) -> bool:
-        """Propagate arrival times through the timing graph"""
+    def _diff_propagate_arrival(self, checkpoint_segment_levels: int = 0,
+                                topk: int = 1, grad_arc_stds: bool = False,
+                                track_startpoints: bool = True,
+                                grad_sp_latencies: bool = False,
+                                cluster_tensors=None) -> bool:
+        """
+        Propagate arrival times through the timing graph differentiably
+
+        topk > 1 (small K, 4-16) keeps K arrival candidates per pin and
+        merges them with the soft top-K path, so gradients see the
+        near-critical path population instead of only the argmax.
+        grad_arc_stds additionally differentiates the arc std columns
+        (d(arrival)/d(std)); cell levels then take the torch-native path
+        since the fused kernel only differentiates means.
+        track_startpoints=False drops the startpoint gather/scatter pair
+        every level otherwise pays; training loops that never read the
+        startpoint planes should turn it off.
+        cluster_tensors (from do_cluster_endpoints) restricts the
+        endpoint reduction to cluster representatives and replaces
+        self.tns with the size-weighted representative TNS, so the
+        backward touches one slack row per cluster while every cluster
+        member's gradient contribution is carried by its representative.
+        """
         # Clear timing cache and initialize timing tensors
 
-        topk = 1
         self.timing_tensors = clear_timing_cache(
             self.max_Gid,
             topk,
@@ -485,17 +5174,64 @@ class INSTA:
             is_diff_prop=True
         )
 
-        # Propagate arrival times
-        self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
-            self.timing_tensors,
-            self.level_2_collaterals,
-            self.inPin_parent_tensor,
-            self.device,
-            self.max_Gid,
-            self.float_dtype,
-            is_diff_prop=True,
-            topk=topk
-        )
+        if cluster_tensors is not None:
+            # Swap the endpoint reduction onto the cluster
+            # representatives: the sweep itself is unchanged (it covers
+            # the whole graph either way), but the slack scatter and the
+            # WNS/TNS reduction — and therefore the backward — see one
+            # row per cluster
+            rep = cluster_tensors['rep_gids']
+            self.timing_tensors['dest_node_tensor'] = rep.to(torch.int32)
+            self.timing_tensors['ep_rise_required'] = \
+                cluster_tensors['rep_rise_required'].to(self.float_dtype)
+            self.timing_tensors['ep_fall_required'] = \
+                cluster_tensors['rep_fall_required'].to(self.float_dtype)
+            positions = torch.full((self.max_Gid,), -1, dtype=torch.int32,
+                                   device=self.device)
+            positions[rep] = torch.arange(rep.numel(), dtype=torch.int32,
+                                          device=self.device)
+            self.timing_tensors['gid_2_ep_position'] = positions
+
+        if grad_sp_latencies:
+            # Re-leaf the device sp latencies each sweep so repeated
+            # backwards see a fresh graph; level-1 seeding then carries
+            # the gradient into the planes like any arc column
+            sp_dev = self.timing_tensors['sp_mean_tensor']
+            self.timing_tensors['sp_mean_tensor'] =                 sp_dev.detach().requires_grad_()
+
+        # Propagate arrival times; the autograd tag folds in the saved
+        # activations this sweep retains for backward
+        from ..timing.memory import track as track_memory
+        with track_memory('autograd'):
+            self.timing_tensors, self.wns, self.tns = propagate_arrival_times(
+                self.timing_tensors,
+                self.level_2_collaterals,
+                self.inPin_parent_tensor,
+                self.device,
+                self.max_Gid,
+                self.float_dtype,
+                is_diff_prop=True,
+                topk=topk,
+                checkpoint_segment_levels=checkpoint_segment_levels,
+                grad_arc_stds=grad_arc_stds,
+                track_startpoints=track_startpoints,
+                cppr_tensors=(self.cppr_tensors
+                              if self._fuse_cppr and track_startpoints
+                              else None)
+            )
+
+        if cluster_tensors is not None:
+            # Size-weighted representative TNS: every member of a
+            # cluster shares its representative's critical cone, so the
+            # broadcast gradient is the representative's scaled by the
+            # cluster population. Differentiable — the slack plane rows
+            # are in the autograd graph
+            rep_slack = self.timing_tensors['Gid_2_slack'][
+                cluster_tensors['rep_gids']]
+            negative = torch.isfinite(rep_slack) & (rep_slack < 0)
+            self.tns = (torch.where(negative, rep_slack,
+                                    torch.zeros_like(rep_slack))
+                        * cluster_tensors['rep_weights']).sum()
 
         # Save arrival tensors
         save_arrival_tensors(self.timing_tensors, self.save_dir)
@@ -503,28 +5239,117 @@ class INSTA:
         return True
 
 
-    def _plot_correlation(self, topK=256) -> bool:
+    def do_get_propagation_result(self):
         """
-        Generate correlation plots and analysis of timing results.
+        Typed result view over the last committed propagation
+
+        Returns a PropagationResult holding the live device planes with
+        lazy, cached host views: full-plane host copies materialize on
+        first access only, and endpoint-sliced accessors gather on
+        device before the transfer, so query wrappers stop paying
+        full-plane D2H for fields they read once or only at endpoints.
+        The object is reused across calls until a new sweep bumps the
+        propagation serial, at which point a fresh one (with empty
+        caches) is handed out.
+        """
+        from ..timing.results import PropagationResult
+
+        assert self.timing_tensors, 'no propagation has run yet'
+        serial = self.timing_tensors.get('_propagation_serial', 0)
+        cached = self._propagation_result
+        if cached is not None and cached.serial == serial \
+                and cached.device_tensor('dest_node_tensor') is \
+                    self.timing_tensors['dest_node_tensor']:
+            return cached
+        self._propagation_result = PropagationResult(
+            self.timing_tensors, self.wns, self.tns)
+        return self._propagation_result
+
+    def _snapshot_report_tensors(self, async_copy=False):
+        """
+        Host copies of the tensors the reporting tail reads
+
+        With async_copy the D2H transfers go non-blocking into cached
+        pinned buffers and a CUDA event marks their completion; the
+        returned (snapshot, event) lets a background worker wait for
+        the copies without the caller synchronizing. Stream ordering
+        guarantees the copies read the just-finished propagation even
+        if the caller immediately enqueues the next one.
         """
         tensor_extraction_params = {
             'rise_arrival': self.timing_tensors['Gid_2_rise_arrival'],
             'rise_startpoints': self.timing_tensors['Gid_2_rise_startpoints'],
-            'rise_required': self.timing_tensors['ep_rise_required_truth'],
             'fall_arrival': self.timing_tensors['Gid_2_fall_arrival'],
             'fall_startpoints': self.timing_tensors['Gid_2_fall_startpoints'],
-            'fall_required': self.timing_tensors['ep_fall_required_truth'],
         }
+        # The dense gid-indexed required truths never left the host (the
+        # device copies are endpoint-compact), so they join the snapshot
+        # without a D2H transfer
+        host_truths = {
+            'rise_required': self.ep_rise_required_truth,
+            'fall_required': self.ep_fall_required_truth,
+        }
+
+        if not (async_copy and str(self.device).startswith('cuda')):
+            # Route through the lazy result so repeated reporting calls
+            # over the same sweep copy each plane at most once
+            result = self.do_get_propagation_result()
+            snapshot = {
+                'rise_arrival': result.host('Gid_2_rise_arrival'),
+                'rise_startpoints': result.host('Gid_2_rise_startpoints'),
+                'fall_arrival': result.host('Gid_2_fall_arrival'),
+                'fall_startpoints': result.host('Gid_2_fall_startpoints'),
+            }
+            snapshot.update(host_truths)
+            return snapshot, None
+
+        for name, tensor in tensor_extraction_params.items():
+            pinned = self._report_pinned.get(name)
+            if pinned is None or pinned.shape != tensor.shape \
+                    or pinned.dtype != tensor.dtype:
+                pinned = torch.empty(tensor.shape, dtype=tensor.dtype,
+                                     pin_memory=True)
+                self._report_pinned[name] = pinned
+            pinned.copy_(tensor, non_blocking=True)
+        event = torch.cuda.Event()
+        event.record()
+        snapshot = dict(self._report_pinned)
+        snapshot.update(host_truths)
+        return snapshot, event
+
+    def _plot_correlation(self, topK=256, worst_n=None) -> bool:
+        """
+        Generate correlation plots and analysis of timing results.
+
+        worst_n caps anal.csv to the N endpoints with the largest
+        absolute slack miscorrelation; the default writes all of them.
+        """
+        timing_tensors_cpu, _ = self._snapshot_report_tensors()
+        return self._plot_correlation_from_snapshot(timing_tensors_cpu,
+                                                    topK=topK, worst_n=worst_n)
 
-        timing_tensors_cpu = {k: v.cpu() for k, v in tensor_extraction_params.items()}
+    def _plot_correlation_from_snapshot(self, timing_tensors_cpu,
+                                        topK=256, worst_n=None) -> bool:
+        """
+        Host-side reporting tail over a tensor snapshot
 
+        Everything here reads the snapshot and initialization-time host
+        maps only, so it can run on the report worker while the GPU is
+        already propagating the next evaluation.
+        """
+        if self._cppr_metadata is None:
+            # Warm-started instances skip _initialize_timing_groundtruths
+            self._cppr_metadata = build_cppr_metadata(
+                self.epName_riseFall_2_spName,
+                self.pinName_2_Gid,
+                self.dest_nodes,
+                self.Gid_2_pinName
+            )
 
-        temporal_metadata = apply_cppr_correction(
+        temporal_metadata = apply_cppr_correction_tensorized(
             timing_tensors_cpu,
-            self.dest_nodes,
+            self._cppr_metadata,
             self.Gid_2_pinName,
-            self.pinName_2_Gid,
-            self.epName_riseFall_2_spName,
             topK,
             self.ep_rise_depth_truth,
             self.ep_rise_slack_truth,
@@ -564,30 +5389,43 @@ class INSTA:
             rasterized=True, # save memory
         )
 
-        analysis_dir = os.path.join(self.save_dir, 'plots')
+        analysis_dir = os.path.join(self.run_dir or self.save_dir, 'plots')
         os.makedirs(analysis_dir, exist_ok=True)
 
-        with open(os.path.join(analysis_dir, 'anal.csv'), 'w') as analysis_file:
-            analysis_file.write(
-                'epName,true_slack,pred_slack,diff_slack,true_arr,pred_arr,diff_arr,required,spName,riseFall\n')
-            diff_slacks = true_slacks - pred_slacks
-            diff_arrivals = true_arrivals - pred_arrivals
-
-            sort_indices = torch.argsort(torch.abs(diff_slacks), descending=True)
-
-            for record_index in sort_indices.tolist():
-                analysis_file.write(
-                    f'{temporal_metadata["epNames"][record_index]},'
-                    f'{true_slacks[record_index]},'
-                    f'{pred_slacks[record_index]},'
-                    f'{diff_slacks[record_index]},'
-                    f'{true_arrivals[record_index]},'
-                    f'{pred_arrivals[record_index]},'
-                    f'{diff_arrivals[record_index]},'
-                    f'{true_requireds[record_index]},'
-                    f'{temporal_metadata["spNames"][record_index]},'
-                    f'{temporal_metadata["riseFalls"][record_index]}\n'
-                )
+        # Columnar writer: gather each column once with the sort
+        # permutation and hand polars the whole table, instead of the
+        # per-row f-string loop that serialized minutes of single-core
+        # time after every evaluation at millions of endpoints
+        import numpy as np
+        import polars as pl
+
+        diff_slacks = true_slacks - pred_slacks
+        diff_arrivals = true_arrivals - pred_arrivals
+
+        sort_indices = torch.argsort(torch.abs(diff_slacks), descending=True)
+        if worst_n is not None:
+            sort_indices = sort_indices[:worst_n]
+        order = sort_indices.numpy()
+
+        def float_column(tensor):
+            return tensor.to(torch.float32).numpy()[order]
+
+        def name_column(names):
+            return np.asarray(names, dtype=object)[order].tolist()
+
+        table = pl.DataFrame({
+            'epName': name_column(temporal_metadata['epNames']),
+            'true_slack': float_column(true_slacks),
+            'pred_slack': float_column(pred_slacks),
+            'diff_slack': float_column(diff_slacks),
+            'true_arr': float_column(true_arrivals),
+            'pred_arr': float_column(pred_arrivals),
+            'diff_arr': float_column(diff_arrivals),
+            'required': float_column(true_requireds),
+            'spName': name_column(temporal_metadata['spNames']),
+            'riseFall': name_column(temporal_metadata['riseFalls']),
+        })
+        table.write_csv(os.path.join(analysis_dir, 'anal.csv'))
 
         return True
 
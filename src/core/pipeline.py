@@ -0,0 +1,108 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file core/pipeline.py
+# @brief prefetching design pipeline for batch regression runs
+
+import gc
+import time
+import torch
+from concurrent.futures import ThreadPoolExecutor
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+
+class DesignPipeline:
+    """
+    Overlap design k+1's build with design k's propagation
+
+    A sequential loop of do_set_insta_path + do_initialization +
+    do_eval_propagation leaves the GPU idle through every parse and the
+    CPU idle through every sweep. The pipeline stages the next design's
+    whole initialization on a background worker while the current one
+    propagates on the main thread: the parse stages are polars/pickle
+    bound and release the GIL, and the collateral handoff goes through
+    move_collaterals_to_device's pinned staging buffers, so the H2D
+    copies of design k+1 overlap design k's kernels on the copy engine.
+    With parse times comparable to sweep times the nightly many-block
+    run approaches GPU-bound.
+
+    prefetch_depth designs are resident beyond the one propagating;
+    the default of 1 doubles peak host/device footprint, which small
+    regression blocks afford comfortably.
+    """
+
+    def __init__(self, device: Optional[torch.device] = None,
+                 prefetch_depth: int = 1):
+        assert prefetch_depth >= 1, 'prefetch_depth must be at least 1'
+        self.device = device
+        self.prefetch_depth = prefetch_depth
+
+    def _stage_design(self, spec: Dict[str, Any]) -> Any:
+        """Worker-side build: parse, levelize, precompute, ship collaterals"""
+        from .insta import INSTA
+
+        insta = INSTA()
+        if self.device is not None:
+            insta.device = torch.device(self.device)
+        insta.do_set_insta_path(spec['path'], spec['design_name'],
+                                spec.get('input_folderName'))
+        if not insta.do_initialization():
+            raise RuntimeError(f"initialization failed for {spec['design_name']}")
+        return insta
+
+    def run(self,
+            design_specs: List[Dict[str, Any]],
+            propagate: Optional[Callable[[Any], Any]] = None,
+            on_done: Optional[Callable[[Any], None]] = None
+            ) -> Dict[str, Tuple[float, float]]:
+        """
+        Drive the staged loop over design_specs
+
+        design_specs entries carry 'path', 'design_name' and optionally
+        'input_folderName' — the do_set_insta_path arguments. propagate
+        defaults to do_eval_propagation; on_done runs after each
+        design's propagation (reporting, exports) before the instance
+        is dropped and its memory reclaimed.
+
+        Returns:
+            design_name -> (wns, tns)
+        """
+        results = {}
+        start_time = time.time()
+        with ThreadPoolExecutor(max_workers=self.prefetch_depth,
+                                thread_name_prefix='insta-stage') as pool:
+            futures = [pool.submit(self._stage_design, spec)
+                       for spec in design_specs[:self.prefetch_depth]]
+            for idx, spec in enumerate(design_specs):
+                insta = futures[idx].result()
+                # Next design starts parsing the moment this one's build
+                # is handed over, and runs through this propagation
+                next_idx = idx + self.prefetch_depth
+                if next_idx < len(design_specs):
+                    futures.append(
+                        pool.submit(self._stage_design, design_specs[next_idx]))
+
+                if propagate is not None:
+                    propagate(insta)
+                else:
+                    insta.do_eval_propagation()
+                results[insta.design_name] = (insta.wns, insta.tns)
+                if on_done is not None:
+                    on_done(insta)
+
+                # Reclaim before the staged design's planes land
+                del insta
+                gc.collect()
+                if torch.cuda.is_available():
+                    torch.cuda.empty_cache()
+
+        print(f'[design pipeline] {len(design_specs)} designs in '
+              f'{time.time() - start_time:.2f} seconds')
+        return results
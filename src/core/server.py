@@ -0,0 +1,205 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file core/server.py
+# @brief in-process timing-query server with request batching
+
+import time
+import queue
+import threading
+from collections import deque
+from concurrent.futures import Future
+from typing import Any, Dict, List, Optional, Tuple
+
+import torch
+
+
+class TimingQueryServer:
+    """
+    In-process query service over one warm INSTA instance
+
+    One worker thread owns every GPU touch; clients (placer, CTS, manual
+    what-ifs) submit from any thread and receive concurrent.futures
+    Futures. The worker drains its queue before acting, so bursts
+    coalesce: a run of pending pin lookups becomes a single gather plus
+    one host sync against the last committed planes, and a run of cone
+    what-ifs merges into one subgraph sweep via
+    merge_subgraph_collaterals — hundreds of small queries cost one
+    launch batch. Only consecutive same-kind requests coalesce, so a
+    delay update acts as a barrier: it commits through the incremental
+    sweep before any later query is answered, giving clients
+    read-your-writes ordering without per-tensor locks.
+    """
+
+    def __init__(self, insta):
+        self.insta = insta
+        self._queue: 'queue.Queue' = queue.Queue()
+        self._pending = deque()
+        self._thread: Optional[threading.Thread] = None
+        self._running = False
+
+    def start(self) -> None:
+        assert self._thread is None, 'query server already running'
+        self._running = True
+        self._thread = threading.Thread(
+            target=self._serve, name='insta-query-server', daemon=True)
+        self._thread.start()
+        print('[server] timing query server started')
+
+    def stop(self) -> None:
+        if self._thread is None:
+            return
+        self._running = False
+        self._queue.put(None)
+        self._thread.join()
+        self._thread = None
+        print('[server] timing query server stopped')
+
+    # ------------------------------ client API ------------------------------
+
+    def query_slacks(self, pin_names: List[str]) -> Future:
+        """
+        Pin arrivals/slacks from the committed state. Resolves to
+        {pin_name: (rise_arrival, fall_arrival, slack)}, None entries for
+        unknown pins.
+        """
+        return self._submit('slacks', pin_names)
+
+    def whatif_cones(self, subgraph_tuples: List[Tuple[Any, ...]]) -> Future:
+        """
+        Cone what-ifs over prepared subgraph tuples (see
+        do_lookup_cone_collateral). Resolves to one {endpoint gid:
+        arrival} dict per tuple; concurrent submissions from other
+        clients merge into the same sweep.
+        """
+        return self._submit('whatif', list(subgraph_tuples))
+
+    def update_delays(self, changed_arcs: Dict, convergence_eps=None) -> Future:
+        """
+        Commit arc delay updates through the incremental dirty-cone
+        sweep. Resolves to (wns, tns) once the new state is committed;
+        later queries see the updated timing.
+        """
+        return self._submit('update', (changed_arcs, convergence_eps))
+
+    def _submit(self, kind: str, payload) -> Future:
+        future = Future()
+        self._queue.put((kind, payload, future))
+        return future
+
+    # ------------------------------- worker ---------------------------------
+
+    def _serve(self) -> None:
+        while self._running:
+            if not self._pending:
+                item = self._queue.get()
+                if item is None:
+                    break
+                self._pending.append(item)
+            # Drain whatever arrived meanwhile so bursts batch together
+            while True:
+                try:
+                    item = self._queue.get_nowait()
+                except queue.Empty:
+                    break
+                if item is None:
+                    self._running = False
+                    break
+                self._pending.append(item)
+
+            # Take the longest same-kind prefix; the rest keeps its order
+            batch = [self._pending.popleft()]
+            while self._pending and self._pending[0][0] == batch[0][0]:
+                batch.append(self._pending.popleft())
+
+            kind = batch[0][0]
+            try:
+                if kind == 'slacks':
+                    self._serve_slacks(batch)
+                elif kind == 'whatif':
+                    self._serve_whatifs(batch)
+                else:
+                    self._serve_update(batch)
+            except Exception as exc:  # propagate to every waiting client
+                for _, _, future in batch:
+                    if not future.done():
+                        future.set_exception(exc)
+
+    def _serve_slacks(self, batch) -> None:
+        insta = self.insta
+        all_names = [name for _, names, _ in batch for name in names]
+        gids = insta.do_lookup_pins(all_names)
+
+        rise = insta.timing_tensors['Gid_2_rise_arrival']
+        fall = insta.timing_tensors['Gid_2_fall_arrival']
+        slack = insta.timing_tensors['Gid_2_slack']
+        if rise.ndim > 1:
+            rise = rise[:, 0]
+            fall = fall[:, 0]
+        rows = gids.clamp(min=0).to(rise.device)
+        # one gather per plane, one host sync for the whole burst
+        values = torch.stack(
+            [rise[rows], fall[rows], slack[rows]], dim=1).to(torch.float32).cpu()
+
+        offset = 0
+        for _, names, future in batch:
+            result = {}
+            for i, name in enumerate(names):
+                if int(gids[offset + i]) < 0:
+                    result[name] = None
+                else:
+                    row = values[offset + i]
+                    result[name] = (float(row[0]), float(row[1]), float(row[2]))
+            offset += len(names)
+            future.set_result(result)
+
+    def _serve_whatifs(self, batch) -> None:
+        from ..timing.propagation import (merge_subgraph_collaterals,
+                                          propagate_subgraph_collateral)
+        insta = self.insta
+        device = insta.device
+        tuples = [tpl for _, payload, _ in batch for tpl in payload]
+        counts = [len(payload) for _, payload, _ in batch]
+
+        if len(tuples) == 1:
+            tpl = tuples[0]
+            _, _, endpoint_arr = propagate_subgraph_collateral(
+                tpl[0], tpl[-2].to(torch.int64).to(device), tpl[-1],
+                insta.sp_mean_tensor.to(device), insta.sp_std_tensor.to(device))
+            per_cone = [endpoint_arr]
+        else:
+            (merged, merged_gid_list, gid2local, new2orig, new2cone,
+             endpoints_syn) = merge_subgraph_collaterals(tuples, device)
+            # synthetic ids are dense, so the remapped sp tensors index
+            # directly by synthetic gid
+            sp_mean_syn = insta.sp_mean_tensor.to(device)[new2orig.to(torch.int64)]
+            sp_std_syn = insta.sp_std_tensor.to(device)[new2orig.to(torch.int64)]
+            _, _, endpoint_arr = propagate_subgraph_collateral(
+                merged, merged_gid_list.to(torch.int64), gid2local,
+                sp_mean_syn, sp_std_syn,
+                endpoint_globals=endpoints_syn.to(torch.int64))
+            new2orig_cpu = new2orig.cpu()
+            new2cone_cpu = new2cone.cpu()
+            per_cone = [dict() for _ in tuples]
+            for syn, arrival in endpoint_arr.items():
+                per_cone[int(new2cone_cpu[syn])][int(new2orig_cpu[syn])] = arrival
+
+        cursor = 0
+        for (_, _, future), count in zip(batch, counts):
+            future.set_result(per_cone[cursor:cursor + count])
+            cursor += count
+
+    def _serve_update(self, batch) -> None:
+        # Updates never coalesce with reads; apply them in order so each
+        # client's (wns, tns) reflects its own commit point
+        for _, (changed_arcs, convergence_eps), future in batch:
+            self.insta.do_incremental_propagation(
+                changed_arcs, convergence_eps=convergence_eps)
+            future.set_result((self.insta.wns, self.insta.tns))
@@ -0,0 +1,233 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file core/snapshot.py
+# @brief immutable committed-timing snapshot for concurrent readers
+
+import torch
+from typing import Dict, List, Optional, Tuple
+
+
+class SnapshotRing:
+    """
+    Rolling history of the last N timing states at O(delta) storage
+
+    Saving each propagation via save_arrival_tensors costs a full copy
+    of every plane — tens of GB for a handful of optimizer iterations.
+    Between iterations only the fanout of the touched arcs actually
+    moves, so the ring keeps ONE materialized state (the latest, on
+    host) plus per-record delta entries holding the changed rows' old
+    and new values. Ten snapshots of a converging optimizer cost about
+    1.1x one snapshot; reconstruction walks the deltas backward from
+    the live copy, applying old values, so any retained state comes
+    back without a base image. Evicting the oldest entry is a plain
+    drop for the same reason. The changed set is recovered by exact
+    elementwise diff against the running copy — it matches whatever
+    dirty set the incremental machinery produced, including
+    convergence-eps early stops, without coupling to it.
+    """
+
+    PLANES = ('Gid_2_rise_arrival', 'Gid_2_rise_arrival_mean',
+              'Gid_2_rise_arrival_std', 'Gid_2_fall_arrival',
+              'Gid_2_fall_arrival_mean', 'Gid_2_fall_arrival_std',
+              'Gid_2_slack')
+
+    def __init__(self, capacity: int = 10, planes: Optional[Tuple[str, ...]] = None):
+        self.capacity = capacity
+        self.planes = tuple(planes) if planes is not None else self.PLANES
+        self._current: Optional[Dict[str, torch.Tensor]] = None
+        self._entries: List[Dict] = []
+        self._serial = 0
+
+    @staticmethod
+    def _worst(plane: torch.Tensor) -> torch.Tensor:
+        return plane[:, 0] if plane.dim() > 1 else plane
+
+    def record(self, timing_tensors: Dict[str, torch.Tensor],
+               wns: Optional[float] = None, tns: Optional[float] = None) -> int:
+        """
+        Capture the state after a propagation; returns changed-row count
+
+        The worst candidate column of each tracked plane transfers to
+        host once, the diff and the delta extraction run there. -inf
+        rows that stay -inf compare equal and cost nothing.
+        """
+        state = {name: self._worst(timing_tensors[name]).detach().cpu()
+                 for name in self.planes if name in timing_tensors}
+        if self._current is None:
+            self._current = {name: plane.clone() for name, plane in state.items()}
+            self._entries.append({'serial': self._serial, 'rows': None,
+                                  'old': None, 'new': None,
+                                  'wns': wns, 'tns': tns})
+            self._serial += 1
+            return self._current[next(iter(self._current))].numel()
+
+        changed = None
+        for name, plane in state.items():
+            mask = plane != self._current[name]
+            changed = mask if changed is None else changed | mask
+        rows = torch.nonzero(changed).squeeze(1)
+        entry = {
+            'serial': self._serial, 'rows': rows.to(torch.int32),
+            'old': {name: self._current[name][rows].clone() for name in state},
+            'new': {name: state[name][rows].clone() for name in state},
+            'wns': wns, 'tns': tns
+        }
+        for name, plane in state.items():
+            self._current[name][rows] = plane[rows]
+        self._entries.append(entry)
+        self._serial += 1
+        # oldest entries drop cleanly: reconstruction never needs them
+        while len(self._entries) > self.capacity:
+            self._entries.pop(0)
+        return rows.numel()
+
+    def state(self, steps_back: int = 0) -> Dict[str, torch.Tensor]:
+        """
+        Reconstruct the state steps_back records ago (0 = latest)
+
+        Clones the live copy and replays the last steps_back deltas in
+        reverse, writing each entry's old values — O(affected rows),
+        not O(design).
+        """
+        assert self._current is not None, 'nothing recorded yet'
+        assert 0 <= steps_back < len(self._entries), \
+            f'only {len(self._entries)} snapshots retained'
+        planes = {name: plane.clone() for name, plane in self._current.items()}
+        for entry in reversed(self._entries[len(self._entries) - steps_back:]):
+            rows = entry['rows'].to(torch.int64)
+            for name, old_values in entry['old'].items():
+                planes[name][rows] = old_values
+        return planes
+
+    def history(self) -> List[Dict[str, float]]:
+        """Per-retained-snapshot summary rows, oldest first"""
+        return [{'serial': entry['serial'],
+                 'changed_rows': -1 if entry['rows'] is None
+                 else entry['rows'].numel(),
+                 'wns': entry['wns'], 'tns': entry['tns']}
+                for entry in self._entries]
+
+    def storage_bytes(self) -> int:
+        total = sum(plane.numel() * plane.element_size()
+                    for plane in (self._current or {}).values())
+        for entry in self._entries:
+            if entry['rows'] is None:
+                continue
+            total += entry['rows'].numel() * entry['rows'].element_size()
+            for values in list(entry['old'].values()) + list(entry['new'].values()):
+                total += values.numel() * values.element_size()
+        return total
+
+
+class TimingSnapshot:
+    """
+    Immutable view of one committed propagation for lock-free readers
+
+    The live timing_tensors are overwritten in place by the next sweep,
+    and the shared name/level dicts force every reader to hold a lock
+    (and the GIL) while walking them. A snapshot clones the endpoint-
+    relevant planes at commit time and keeps only flat tensors plus the
+    packed PinNameIndex arena, so any number of threads can query it
+    while the next propagation builds the following snapshot. Nothing
+    here mutates after construction; queries are gathers over the clones
+    and arena slices for names.
+    """
+
+    def __init__(self, rise_arrival: torch.Tensor, fall_arrival: torch.Tensor,
+                 slack: torch.Tensor, dest_nodes: torch.Tensor,
+                 level_tensor: torch.Tensor, pin_name_index,
+                 wns: float, tns: float):
+        self.rise_arrival = rise_arrival
+        self.fall_arrival = fall_arrival
+        self.slack = slack
+        self.dest_nodes = dest_nodes
+        self.level_tensor = level_tensor
+        self.pin_name_index = pin_name_index
+        self.wns = wns
+        self.tns = tns
+
+    @classmethod
+    def capture(cls, timing_tensors: Dict[str, torch.Tensor],
+                dest_nodes, node_2_level: Dict[int, int],
+                pin_name_index, max_gid: int,
+                wns: float, tns: float) -> 'TimingSnapshot':
+        """
+        Clone the committed planes into a new snapshot
+
+        The clones go to host memory pinned down to 1-D K=1 columns — a
+        snapshot is a reporting surface, not a compute input, and host
+        residency keeps readers off the GPU the next sweep is using.
+        node_2_level flattens into an int32 tensor once so level queries
+        stop being dict lookups.
+        """
+        rise = timing_tensors['Gid_2_rise_arrival']
+        fall = timing_tensors['Gid_2_fall_arrival']
+        if rise.ndim > 1:
+            rise = rise[:, 0]
+            fall = fall[:, 0]
+        level_tensor = torch.full((max_gid,), -1, dtype=torch.int32)
+        if node_2_level:
+            gids = torch.tensor(list(node_2_level.keys()), dtype=torch.int64)
+            levels = torch.tensor(list(node_2_level.values()), dtype=torch.int32)
+            level_tensor[gids] = levels
+        if not torch.is_tensor(dest_nodes):
+            dest_nodes = torch.tensor(sorted(dest_nodes), dtype=torch.int64)
+        return cls(
+            rise.detach().to(torch.float32).cpu().clone(),
+            fall.detach().to(torch.float32).cpu().clone(),
+            timing_tensors['Gid_2_slack'].detach().to(torch.float32).cpu().clone(),
+            dest_nodes.to(torch.int64).cpu().clone(),
+            level_tensor,
+            pin_name_index,
+            wns, tns
+        )
+
+    def query_slacks(self, pin_names: List[str]) -> Dict[str, Optional[Tuple[float, float, float]]]:
+        """
+        Batched {pin: (rise_arrival, fall_arrival, slack)} lookup; None
+        for unknown pins. Safe from any thread.
+        """
+        gids = self.pin_name_index.lookup(pin_names)
+        rows = gids.clamp(min=0)
+        values = torch.stack(
+            [self.rise_arrival[rows], self.fall_arrival[rows], self.slack[rows]], dim=1)
+        results = {}
+        for i, name in enumerate(pin_names):
+            if int(gids[i]) < 0:
+                results[name] = None
+            else:
+                row = values[i]
+                results[name] = (float(row[0]), float(row[1]), float(row[2]))
+        return results
+
+    def query_levels(self, pin_names: List[str]) -> Dict[str, int]:
+        """Batched {pin: level} lookup, -1 for unknown/unlevelized pins"""
+        gids = self.pin_name_index.lookup(pin_names)
+        levels = self.level_tensor[gids.clamp(min=0)]
+        return {name: (int(levels[i]) if int(gids[i]) >= 0 else -1)
+                for i, name in enumerate(pin_names)}
+
+    def worst_endpoints(self, num_endpoints: int = 50) -> List[Tuple[str, float]]:
+        """
+        The N worst endpoints as (pin name, slack), most negative first.
+        One topk over the endpoint gather; names come from arena slices,
+        not a dict walk.
+        """
+        ep_slacks = self.slack[self.dest_nodes]
+        finite = torch.isfinite(ep_slacks)
+        candidates = torch.where(finite, ep_slacks, torch.full_like(ep_slacks, float('inf')))
+        k = min(num_endpoints, int(finite.sum()))
+        if k == 0:
+            return []
+        values, indices = torch.topk(candidates, k, largest=False)
+        gids = self.dest_nodes[indices]
+        return [(self.pin_name_index.name(int(gid)), float(value))
+                for gid, value in zip(gids, values)]
@@ -12,11 +12,35 @@
 from .builder import (
     add_node,
     add_arc_to_graph,
-    build_timing_graph
+    build_timing_graph,
+    build_timing_graph_columnar
 )
 
 from .levelization import (
     levelize_graph,
+    levelize_csr_graph,
+    relevel_affected_cone,
     forward_levelization,
     backward_levelization
 )
+
+from .khop import (
+    ConeSelector,
+    select_nonoverlapping_khop,
+    select_khop_cones
+)
+
+from .csr import (
+    CSRGraph,
+    CSRAdjacencyView
+)
+
+from .names import (
+    PinNameIndex
+)
+
+from .partition import (
+    weakly_connected_components,
+    partition_timing_domains,
+    build_domain_schedules
+)
@@ -0,0 +1,210 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file graph/csr.py
+# @brief canonical CSR representation of the timing graph
+
+import torch
+from typing import Dict, Iterator, List, Optional, Set, Tuple
+
+
+class CSRAdjacencyView:
+    """
+    Dict-of-sets facade over one direction of a CSRGraph
+
+    The few call sites that still want `Gid_2_parents[gid]` set semantics
+    (membership tests, iteration) can be handed this view instead of a
+    materialized defaultdict. Lookups slice the CSR arrays on demand, so
+    no per-node Python objects are ever allocated for the full graph.
+    """
+
+    def __init__(self, indptr: torch.Tensor, indices: torch.Tensor):
+        self._indptr = indptr
+        self._indices = indices
+
+    def __getitem__(self, gid: int) -> Set[int]:
+        start = int(self._indptr[gid])
+        end = int(self._indptr[gid + 1])
+        return set(self._indices[start:end].tolist())
+
+    def get(self, gid: int, default: Optional[Set[int]] = None) -> Optional[Set[int]]:
+        if gid not in self:
+            return default
+        return self[gid]
+
+    def __contains__(self, gid: int) -> bool:
+        if gid < 0 or gid + 1 >= self._indptr.numel():
+            return False
+        return bool(self._indptr[gid + 1] > self._indptr[gid])
+
+    def __len__(self) -> int:
+        # Number of nodes with at least one neighbor, matching what a
+        # defaultdict populated by the arc loops would contain
+        return int((self._indptr[1:] > self._indptr[:-1]).sum())
+
+    def keys(self) -> Iterator[int]:
+        nonzero = torch.nonzero(self._indptr[1:] > self._indptr[:-1]).flatten()
+        return iter(nonzero.tolist())
+
+    def __iter__(self) -> Iterator[int]:
+        return self.keys()
+
+    def items(self) -> Iterator[Tuple[int, Set[int]]]:
+        for gid in self.keys():
+            yield gid, self[gid]
+
+
+class CSRGraph:
+    """
+    Int32 CSR (forward + transpose) over the timing graph Gid space
+
+    This is the canonical connectivity structure: two indptr/indices pairs
+    cover every traversal need (children via fwd, parents via bwd), at
+    8 bytes per edge instead of the hundreds that the NetworkX/graph-tool/
+    dict-of-sets triplicate costs. Downstream passes (levelization, cone
+    expansion, backtracing) should consume the tensors directly; the
+    parents_view()/children_view() facades exist only for the remaining
+    set-semantics call sites.
+    """
+
+    def __init__(
+        self,
+        num_nodes: int,
+        fwd_indptr: torch.Tensor,
+        fwd_indices: torch.Tensor,
+        bwd_indptr: torch.Tensor,
+        bwd_indices: torch.Tensor
+    ):
+        self.num_nodes = num_nodes
+        self.fwd_indptr = fwd_indptr
+        self.fwd_indices = fwd_indices
+        self.bwd_indptr = bwd_indptr
+        self.bwd_indices = bwd_indices
+
+    @staticmethod
+    def _pack_direction(
+        src: torch.Tensor,
+        dst: torch.Tensor,
+        num_nodes: int
+    ) -> Tuple[torch.Tensor, torch.Tensor]:
+        """Sort an edge list by source and emit int32 indptr/indices"""
+        order = torch.argsort(src, stable=True)
+        indptr = torch.zeros(num_nodes + 1, dtype=torch.int64)
+        indptr[1:] = torch.bincount(src, minlength=num_nodes).cumsum(0)
+        return indptr.to(torch.int32), dst[order].to(torch.int32)
+
+    @classmethod
+    def from_edges(cls, src: torch.Tensor, dst: torch.Tensor, num_nodes: int) -> 'CSRGraph':
+        """
+        Build a CSRGraph from parallel source/destination Gid tensors
+
+        Args:
+            src: Source Gid per edge (any integer dtype)
+            dst: Destination Gid per edge
+            num_nodes: Gid space size (max_Gid)
+
+        Returns:
+            CSRGraph with forward (src->dst) and transposed adjacency
+        """
+        src = src.to(torch.int64).cpu()
+        dst = dst.to(torch.int64).cpu()
+        fwd_indptr, fwd_indices = cls._pack_direction(src, dst, num_nodes)
+        bwd_indptr, bwd_indices = cls._pack_direction(dst, src, num_nodes)
+        return cls(num_nodes, fwd_indptr, fwd_indices, bwd_indptr, bwd_indices)
+
+    @classmethod
+    def from_adjacency(cls, Gid_2_children: Dict[int, Set[int]], num_nodes: int) -> 'CSRGraph':
+        """
+        Build a CSRGraph from the legacy children dict-of-sets
+
+        Args:
+            Gid_2_children: Mapping from node IDs to sets of child node IDs
+            num_nodes: Gid space size (max_Gid)
+
+        Returns:
+            CSRGraph covering both edge directions
+        """
+        src = torch.tensor(
+            [node for node, children in Gid_2_children.items() for _ in children],
+            dtype=torch.int64
+        )
+        dst = torch.tensor(
+            [child for children in Gid_2_children.values() for child in children],
+            dtype=torch.int64
+        )
+        return cls.from_edges(src, dst, num_nodes)
+
+    @property
+    def num_edges(self) -> int:
+        return self.fwd_indices.numel()
+
+    def children(self, gid: int) -> torch.Tensor:
+        """Int32 tensor of the fanout Gids of one node"""
+        return self.fwd_indices[self.fwd_indptr[gid]:self.fwd_indptr[gid + 1]]
+
+    def parents(self, gid: int) -> torch.Tensor:
+        """Int32 tensor of the fanin Gids of one node"""
+        return self.bwd_indices[self.bwd_indptr[gid]:self.bwd_indptr[gid + 1]]
+
+    def out_degrees(self) -> torch.Tensor:
+        """Int32 tensor of out-degree per Gid"""
+        return self.fwd_indptr[1:] - self.fwd_indptr[:-1]
+
+    def in_degrees(self) -> torch.Tensor:
+        """Int32 tensor of in-degree per Gid"""
+        return self.bwd_indptr[1:] - self.bwd_indptr[:-1]
+
+    def children_view(self) -> CSRAdjacencyView:
+        """Dict-of-sets facade equivalent to Gid_2_children"""
+        return CSRAdjacencyView(self.fwd_indptr, self.fwd_indices)
+
+    def parents_view(self) -> CSRAdjacencyView:
+        """Dict-of-sets facade equivalent to Gid_2_parents"""
+        return CSRAdjacencyView(self.bwd_indptr, self.bwd_indices)
+
+    def edge_list(self) -> Tuple[torch.Tensor, torch.Tensor]:
+        """Int64 (src, dst) tensors of every edge in forward order"""
+        src = torch.repeat_interleave(
+            torch.arange(self.num_nodes, dtype=torch.int64, device=self.fwd_indptr.device),
+            self.out_degrees().to(torch.int64)
+        )
+        return src, self.fwd_indices.to(torch.int64)
+
+    def gather_neighbors(self, frontier: torch.Tensor, direction: str = 'forward') -> torch.Tensor:
+        """
+        Vectorized neighbor gather for a frontier of Gids
+
+        Args:
+            frontier: Int tensor of Gids to expand
+            direction: 'forward' (children) or 'backward' (parents)
+
+        Returns:
+            Int64 tensor of all neighbors, duplicates included
+        """
+        indptr, indices = ((self.fwd_indptr, self.fwd_indices) if direction == 'forward'
+                           else (self.bwd_indptr, self.bwd_indices))
+        frontier = frontier.to(torch.int64)
+        starts = indptr[frontier].to(torch.int64)
+        counts = (indptr[frontier + 1] - indptr[frontier]).to(torch.int64)
+        total = int(counts.sum())
+        if total == 0:
+            return torch.empty(0, dtype=torch.int64, device=indices.device)
+        base = torch.repeat_interleave(starts, counts)
+        local = torch.arange(total, dtype=torch.int64, device=indices.device) \
+            - torch.repeat_interleave(counts.cumsum(0) - counts, counts)
+        return indices[base + local].to(torch.int64)
+
+    def to(self, device: torch.device) -> 'CSRGraph':
+        """Move all four CSR tensors to a device (returns self)"""
+        self.fwd_indptr = self.fwd_indptr.to(device)
+        self.fwd_indices = self.fwd_indices.to(device)
+        self.bwd_indptr = self.bwd_indptr.to(device)
+        self.bwd_indices = self.bwd_indices.to(device)
+        return self
@@ -0,0 +1,172 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file graph/khop.py
+# @brief k-hop cone selection utilities
+
+import torch
+from typing import Dict, List, Set, Tuple, Optional
+
+
+class ConeSelector:
+    """
+    CSR adjacency over the timing graph for vectorized cone expansion
+
+    A Python BFS over Gid_2_children costs seconds per what-if query. Here
+    both edge directions are packed once into CSR (indptr/indices) tensors,
+    after which every hop of an expansion is a handful of gathers plus a
+    mask update — O(frontier edges) with no per-node Python.
+    """
+
+    def __init__(
+        self,
+        Gid_2_children: Dict[int, Set[int]],
+        Gid_2_parents: Dict[int, Set[int]],
+        max_gid: int,
+        device: torch.device = torch.device('cpu')
+    ):
+        self.max_gid = max_gid
+        self.device = device
+        self.fwd_indptr, self.fwd_indices = self._build_csr(Gid_2_children, max_gid, device)
+        self.bwd_indptr, self.bwd_indices = self._build_csr(Gid_2_parents, max_gid, device)
+
+    @staticmethod
+    def _build_csr(adjacency: Dict[int, Set[int]], max_gid: int, device: torch.device):
+        """Pack an adjacency dict into CSR indptr/indices tensors"""
+        src = torch.tensor([node for node, nbrs in adjacency.items() for _ in nbrs],
+                           dtype=torch.int64)
+        dst = torch.tensor([nbr for nbrs in adjacency.values() for nbr in nbrs],
+                           dtype=torch.int64)
+        order = torch.argsort(src, stable=True)
+        src, dst = src[order], dst[order]
+        indptr = torch.zeros(max_gid + 1, dtype=torch.int64)
+        indptr[1:] = torch.bincount(src, minlength=max_gid).cumsum(0)
+        return indptr.to(device), dst.to(device)
+
+    def expand(
+        self,
+        roots: List[int],
+        k: int,
+        direction: str = 'forward',
+        blocked: Optional[torch.Tensor] = None
+    ) -> torch.Tensor:
+        """
+        k-hop expansion from a set of roots
+
+        Args:
+            roots: Starting Gids
+            k: Number of hops
+            direction: 'forward' (fanout) or 'backward' (fanin)
+            blocked: Optional bool [max_gid] mask of nodes the expansion
+                must not enter (used for non-overlapping selection)
+
+        Returns:
+            Bool [max_gid] mask of the reached nodes (roots included)
+        """
+        indptr, indices = ((self.fwd_indptr, self.fwd_indices) if direction == 'forward'
+                           else (self.bwd_indptr, self.bwd_indices))
+        visited = torch.zeros(self.max_gid, dtype=torch.bool, device=self.device)
+        frontier = torch.as_tensor(list(roots), dtype=torch.int64, device=self.device)
+        if blocked is not None:
+            frontier = frontier[~blocked[frontier]]
+        visited[frontier] = True
+
+        for _ in range(k):
+            if frontier.numel() == 0:
+                break
+            starts = indptr[frontier]
+            counts = indptr[frontier + 1] - starts
+            total = int(counts.sum().item())
+            if total == 0:
+                break
+            # CSR gather of every frontier node's neighbor list
+            base = torch.repeat_interleave(starts, counts)
+            local = torch.arange(total, dtype=torch.int64, device=self.device) \
+                - torch.repeat_interleave(counts.cumsum(0) - counts, counts)
+            neighbors = indices[base + local]
+            keep = ~visited[neighbors]
+            if blocked is not None:
+                keep &= ~blocked[neighbors]
+            neighbors = torch.unique(neighbors[keep])
+            visited[neighbors] = True
+            frontier = neighbors
+
+        return visited
+
+
+def select_nonoverlapping_khop(
+    selector: ConeSelector,
+    roots: List[int],
+    k: int,
+    include_backward: bool = True
+) -> List[Tuple[List[int], Dict[int, int]]]:
+    """
+    Select node-disjoint k-hop cones around a list of root Gids
+
+    Roots are processed in order; each cone is the union of the root's
+    k-hop fanout and (optionally) fanin, clipped so it never enters a node
+    already claimed by an earlier cone. Use this when clipped cones are
+    acceptable (e.g. coverage-style sweeps); what-if batches whose roots
+    genuinely share fanout should keep full cones via select_khop_cones —
+    merge_subgraph_collaterals handles the overlap.
+
+    Returns:
+        One (cone_gid_list, gid2local_map) pair per surviving root,
+        directly consumable by precompute_collaterals(subgraph=True)
+    """
+    claimed = torch.zeros(selector.max_gid, dtype=torch.bool, device=selector.device)
+    cones = []
+    for root in roots:
+        if bool(claimed[root]):
+            continue
+        cone = selector.expand([root], k, 'forward', blocked=claimed)
+        if include_backward:
+            cone |= selector.expand([root], k, 'backward', blocked=claimed)
+        cone_gids = torch.nonzero(cone).flatten().tolist()
+        if not cone_gids:
+            continue
+        claimed |= cone
+        gid2local_map = {gid: local for local, gid in enumerate(cone_gids)}
+        cones.append((cone_gids, gid2local_map))
+    return cones
+
+
+def select_khop_cones(
+    selector: ConeSelector,
+    roots: List[int],
+    k: int,
+    include_backward: bool = True
+) -> List[Tuple[List[int], Dict[int, int]]]:
+    """
+    Select k-hop cones around a list of root Gids, overlap allowed
+
+    Unlike select_nonoverlapping_khop, every root keeps its FULL cone
+    even when cones share nodes, so realistic move sets (placer
+    candidates with common fanout) batch into one merge instead of being
+    serialized into disjoint groups. merge_subgraph_collaterals detects
+    the shared nodes and propagates each one once while per-cone deltas
+    stay isolated.
+
+    Returns:
+        One (cone_gid_list, gid2local_map) pair per root with a
+        non-empty cone, directly consumable by
+        precompute_collaterals(subgraph=True)
+    """
+    cones = []
+    for root in roots:
+        cone = selector.expand([root], k, 'forward')
+        if include_backward:
+            cone |= selector.expand([root], k, 'backward')
+        cone_gids = torch.nonzero(cone).flatten().tolist()
+        if not cone_gids:
+            continue
+        gid2local_map = {gid: local for local, gid in enumerate(cone_gids)}
+        cones.append((cone_gids, gid2local_map))
+    return cones
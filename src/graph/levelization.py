@@ -183,6 +183,258 @@ def backward_levelization(
     return sorted_level_2_nodes, node_2_level
 
 
+def _relax_levels_csr(
+    indptr: torch.Tensor,
+    indices: torch.Tensor,
+    seeds: torch.Tensor,
+    num_nodes: int,
+    device: torch.device
+) -> torch.Tensor:
+    """
+    Iterative frontier relaxation of longest-path levels over one CSR direction
+
+    Seeds start at level 1; each sweep gathers the frontier's neighbors and
+    scatter-maxes candidate levels into them, and only nodes whose level
+    actually grew re-enter the frontier. The fixpoint equals the
+    topological-sort walk's longest-path levels, but every sweep is a
+    handful of tensor ops instead of a per-node Python loop.
+
+    Returns:
+        Int32 [num_nodes] level tensor; 0 marks unleveled (unreachable) nodes
+    """
+    indptr = indptr.to(device)
+    indices = indices.to(device)
+    level = torch.zeros(num_nodes, dtype=torch.int32, device=device)
+    frontier = seeds.to(torch.int64).to(device)
+    level[frontier] = 1
+
+    while frontier.numel() > 0:
+        starts = indptr[frontier].to(torch.int64)
+        counts = (indptr[frontier + 1] - indptr[frontier]).to(torch.int64)
+        total = int(counts.sum())
+        if total == 0:
+            break
+        # CSR gather of every frontier node's neighbor list
+        base = torch.repeat_interleave(starts, counts)
+        local = torch.arange(total, dtype=torch.int64, device=device) \
+            - torch.repeat_interleave(counts.cumsum(0) - counts, counts)
+        neighbors = indices[base + local].to(torch.int64)
+        candidates = torch.repeat_interleave(level[frontier] + 1, counts)
+
+        touched = torch.unique(neighbors)
+        before = level[touched].clone()
+        level.index_reduce_(0, neighbors, candidates, 'amax', include_self=True)
+        frontier = touched[level[touched] > before]
+
+    return level
+
+
+def _group_levels(
+    level: torch.Tensor,
+    tag: str,
+    marker_nodes: Set[int],
+    marker_name: str
+) -> Tuple[Dict[int, List[int]], Dict[int, int]]:
+    """Pack a level tensor into the level_2_nodes / node_2_level dicts"""
+    leveled = torch.nonzero(level > 0).flatten()
+    order = leveled[torch.argsort(level[leveled], stable=True)]
+    counts = torch.bincount(level[leveled].to(torch.int64))
+
+    sorted_level_2_nodes = {}
+    offset = 0
+    for lvl in range(1, counts.numel()):
+        n = int(counts[lvl])
+        if n == 0:
+            continue
+        sorted_level_2_nodes[lvl] = order[offset:offset + n].tolist()
+        offset += n
+
+    node_2_level = dict(zip(leveled.tolist(), level[leveled].tolist()))
+
+    for lvl, nodes in sorted_level_2_nodes.items():
+        marker_count = sum(1 for n in nodes if n in marker_nodes)
+        print(f"[{tag}] Level {lvl}: {len(nodes)} nodes, {marker_count} {marker_name}")
+
+    return sorted_level_2_nodes, node_2_level
+
+
+def relevel_affected_cone(
+    csr_graph,
+    level: torch.Tensor,
+    seeds: torch.Tensor,
+    source_mask: torch.Tensor
+) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor]:
+    """
+    Recompute forward levels only inside the fanout cone of changed arcs
+
+    A connectivity delta can only move levels inside the forward cone of
+    the touched sink pins; everything upstream and sideways keeps its
+    level and acts as a fixed boundary. The cone is collected with a CSR
+    BFS, its levels are cleared, and restricted relaxation sweeps pull
+    each cone node's level from its (possibly out-of-cone) parents until
+    fixpoint — cost is O(cone edges x cone depth), not a full relevel.
+
+    Args:
+        csr_graph: Canonical CSRGraph, already reflecting the new edges
+        level: Int32 [num_nodes] forward level tensor (modified in place)
+        seeds: Int64 tensor of sink Gids of the added/removed arcs
+        source_mask: Bool [num_nodes] mask of the timing startpoints
+
+    Returns:
+        Tuple of (cone_gids, old_levels, new_levels) for the cone nodes
+    """
+    num_nodes = csr_graph.num_nodes
+    cone_mask = torch.zeros(num_nodes, dtype=torch.bool)
+    frontier = seeds.to(torch.int64)
+    cone_mask[frontier] = True
+    while frontier.numel() > 0:
+        neighbors = torch.unique(csr_graph.gather_neighbors(frontier, 'forward'))
+        neighbors = neighbors[~cone_mask[neighbors]]
+        cone_mask[neighbors] = True
+        frontier = neighbors
+
+    cone_gids = torch.nonzero(cone_mask).flatten()
+    old_levels = level[cone_gids].clone()
+    level[cone_gids] = 0
+
+    # Restricted relaxation: recompute every cone node from its parents
+    # each sweep until nothing moves; out-of-cone parent levels are fixed
+    indptr, indices = csr_graph.bwd_indptr, csr_graph.bwd_indices
+    starts = indptr[cone_gids].to(torch.int64)
+    counts = (indptr[cone_gids + 1] - indptr[cone_gids]).to(torch.int64)
+    total = int(counts.sum())
+    if total > 0:
+        base = torch.repeat_interleave(starts, counts)
+        local = torch.arange(total, dtype=torch.int64) \
+            - torch.repeat_interleave(counts.cumsum(0) - counts, counts)
+        parents = indices[base + local].to(torch.int64)
+        segments = torch.repeat_interleave(
+            torch.arange(cone_gids.numel(), dtype=torch.int64), counts
+        )
+        while True:
+            parent_max = torch.zeros(cone_gids.numel(), dtype=torch.int32)
+            parent_max.index_reduce_(0, segments, level[parents], 'amax', include_self=True)
+            new_levels = torch.where(
+                parent_max > 0, parent_max + 1,
+                torch.where(source_mask[cone_gids], torch.ones_like(parent_max), 0)
+            )
+            if torch.equal(new_levels, level[cone_gids]):
+                break
+            level[cone_gids] = new_levels
+    else:
+        level[cone_gids] = torch.where(
+            source_mask[cone_gids],
+            torch.ones(cone_gids.numel(), dtype=torch.int32),
+            torch.zeros(cone_gids.numel(), dtype=torch.int32)
+        )
+
+    return cone_gids, old_levels, level[cone_gids].clone()
+
+
+def levelize_csr_graph(
+    csr_graph,
+    source_nodes: Set[int],
+    dest_nodes: Set[int],
+    inPin_parent_dict: Dict[int, int],
+    save_dir: str,
+    do_backward: bool = True,
+    use_cache: bool = True,
+    device: torch.device = torch.device('cpu')
+) -> Tuple[
+    Dict[int, List[int]],            # level_2_nodes
+    Dict[int, int],                  # node_2_level
+    torch.Tensor,                    # inPin_parent_tensor
+    Optional[Dict[int, List[int]]],  # level_2_nodes_bw
+    Optional[Dict[int, int]]         # node_2_level_bw
+]:
+    """
+    Levelize the timing graph via frontier relaxation on the CSRGraph
+
+    Drop-in replacement for levelize_graph that needs neither the
+    graph-tool topological sort nor the gt_2_nx id translation: forward
+    levels relax along the CSR forward direction from the sources,
+    backward levels along the transpose from the destinations. Shares
+    levelize_graph's cache files so either path can resume the other's.
+
+    Args:
+        csr_graph: Canonical CSRGraph over the Gid space
+        source_nodes: Set of starting nodes (e.g., clock pins)
+        dest_nodes: Set of ending nodes (e.g., register data pins)
+        inPin_parent_dict: Mapping from input pin IDs to parent pin IDs
+        save_dir: Directory to save/load cache
+        do_backward: Whether to perform backward levelization
+        use_cache: Whether to use cached results if available
+        device: Device to run the relaxation sweeps on
+
+    Returns:
+        Tuple of (level_2_nodes, node_2_level, inPin_parent_tensor, level_2_nodes_bw, node_2_level_bw)
+    """
+    if not source_nodes or not dest_nodes:
+        print('[levelization] error: missing source or destination nodes')
+        return None, None, None, None, None
+
+    # Reuse the levelize_graph cache layout
+    if use_cache:
+        cache_path = os.path.join(save_dir, 'level_2_nodes.pkl')
+        if os.path.exists(cache_path):
+            level_2_nodes = load_pickle(cache_path)
+            node_2_level = load_pickle(os.path.join(save_dir, 'node_2_level.pkl'))
+            inPin_parent_tensor = torch.load(os.path.join(save_dir, 'inPin_parent_tensor.pt'))
+
+            level_2_nodes_bw = None
+            node_2_level_bw = None
+            if do_backward:
+                bw_cache = os.path.join(save_dir, 'level_2_nodes_bw.pkl')
+                if os.path.exists(bw_cache):
+                    level_2_nodes_bw = load_pickle(bw_cache)
+                    node_2_level_bw = load_pickle(os.path.join(save_dir, 'node_2_level_bw.pkl'))
+
+            return level_2_nodes, node_2_level, inPin_parent_tensor, level_2_nodes_bw, node_2_level_bw
+
+    import time
+    start_time = time.time()
+
+    num_nodes = csr_graph.num_nodes
+    fwd_level = _relax_levels_csr(
+        csr_graph.fwd_indptr, csr_graph.fwd_indices,
+        torch.tensor(sorted(source_nodes), dtype=torch.int64),
+        num_nodes, device
+    ).cpu()
+    level_2_nodes, node_2_level = _group_levels(
+        fwd_level, 'forward levelization', dest_nodes, 'endpoints'
+    )
+
+    level_2_nodes_bw = None
+    node_2_level_bw = None
+    if do_backward:
+        bwd_level = _relax_levels_csr(
+            csr_graph.bwd_indptr, csr_graph.bwd_indices,
+            torch.tensor(sorted(dest_nodes), dtype=torch.int64),
+            num_nodes, device
+        ).cpu()
+        level_2_nodes_bw, node_2_level_bw = _group_levels(
+            bwd_level, 'backward levelization', source_nodes, 'startpoints'
+        )
+
+    # Create input pin parent tensor
+    inPin_parent_tensor = torch.full((num_nodes,), -1, dtype=torch.int32)
+    for toPin, fromPin in inPin_parent_dict.items():
+        inPin_parent_tensor[toPin] = fromPin
+
+    print(f'[levelization] completed in {time.time() - start_time:.2f}s')
+
+    # Save results
+    save_pickle(level_2_nodes, os.path.join(save_dir, 'level_2_nodes.pkl'))
+    save_pickle(node_2_level, os.path.join(save_dir, 'node_2_level.pkl'))
+    torch.save(inPin_parent_tensor, os.path.join(save_dir, 'inPin_parent_tensor.pt'))
+
+    if do_backward:
+        save_pickle(level_2_nodes_bw, os.path.join(save_dir, 'level_2_nodes_bw.pkl'))
+        save_pickle(node_2_level_bw, os.path.join(save_dir, 'node_2_level_bw.pkl'))
+
+    return level_2_nodes, node_2_level, inPin_parent_tensor, level_2_nodes_bw, node_2_level_bw
+
+
 def levelize_graph(
     gt_graph: gt.Graph,
     gt_2_nx: Dict[int, int],
@@ -0,0 +1,255 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file graph/names.py
+# @brief packed pin-name arena replacing the name<->Gid dicts
+
+import os
+import torch
+from typing import Dict, Iterator, List, Optional, Tuple
+
+
+class PinNameIndex:
+    """
+    Packed UTF-8 arena plus sorted index over the design's pin names
+
+    The pinName_2_Gid / Gid_2_pinName dicts hold one interned Python
+    string object per pin — multi-GB of pointer-chased heap at 15M pins.
+    Here all names live contiguously in one uint8 arena with an int64
+    offset array (gid -> name is two offset reads and a slice), and
+    name -> gid is binary search over a name-sorted gid permutation.
+    lookup() resolves whole name batches at once, so reporting over
+    millions of pins stops being a dict workload.
+    """
+
+    def __init__(self, arena: torch.Tensor, offsets: torch.Tensor, sorted_gids: torch.Tensor):
+        self.arena = arena
+        self.offsets = offsets
+        self.sorted_gids = sorted_gids
+
+    @classmethod
+    def from_names(cls, names: List[str]) -> 'PinNameIndex':
+        """
+        Build the index from the pin names in Gid order
+
+        Args:
+            names: Pin name per Gid, index position == gid
+
+        Returns:
+            PinNameIndex over the packed arena
+        """
+        encoded = [n.encode('utf-8') for n in names]
+        offsets = torch.zeros(len(encoded) + 1, dtype=torch.int64)
+        offsets[1:] = torch.tensor([len(e) for e in encoded], dtype=torch.int64).cumsum(0)
+        arena = torch.frombuffer(bytearray(b''.join(encoded)), dtype=torch.uint8).clone()
+        sorted_gids = torch.tensor(
+            sorted(range(len(encoded)), key=encoded.__getitem__), dtype=torch.int64
+        )
+        return cls(arena, offsets, sorted_gids)
+
+    def __len__(self) -> int:
+        return self.offsets.numel() - 1
+
+    def name_bytes(self, gid: int) -> bytes:
+        """Raw UTF-8 bytes of one pin name"""
+        start = int(self.offsets[gid])
+        end = int(self.offsets[gid + 1])
+        return bytes(self.arena[start:end].tolist())
+
+    def name(self, gid: int) -> str:
+        """Pin name of one Gid"""
+        return self.name_bytes(gid).decode('utf-8')
+
+    def gid(self, name: str) -> int:
+        """Gid of one pin name, or -1 if absent"""
+        target = name.encode('utf-8')
+        lo, hi = 0, len(self)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self.name_bytes(int(self.sorted_gids[mid])) < target:
+                lo = mid + 1
+            else:
+                hi = mid
+        if lo < len(self):
+            candidate = int(self.sorted_gids[lo])
+            if self.name_bytes(candidate) == target:
+                return candidate
+        return -1
+
+    def lookup(self, names: List[str]) -> torch.Tensor:
+        """
+        Bulk name -> gid resolution
+
+        Args:
+            names: Pin names to resolve
+
+        Returns:
+            Int64 tensor of gids, -1 for names not in the design
+        """
+        return torch.tensor([self.gid(n) for n in names], dtype=torch.int64)
+
+    def name_2_gid_view(self) -> '_NameToGidView':
+        """Dict facade equivalent to pinName_2_Gid"""
+        return _NameToGidView(self)
+
+    def gid_2_name_view(self) -> '_GidToNameView':
+        """Dict facade equivalent to Gid_2_pinName"""
+        return _GidToNameView(self)
+
+
+class _NameToGidView:
+    """pinName_2_Gid facade over a PinNameIndex"""
+
+    def __init__(self, index: PinNameIndex):
+        self._index = index
+
+    def __getitem__(self, name: str) -> int:
+        gid = self._index.gid(name)
+        if gid < 0:
+            raise KeyError(name)
+        return gid
+
+    def get(self, name: str, default: Optional[int] = None) -> Optional[int]:
+        gid = self._index.gid(name)
+        return default if gid < 0 else gid
+
+    def __contains__(self, name: str) -> bool:
+        return self._index.gid(name) >= 0
+
+    def __len__(self) -> int:
+        return len(self._index)
+
+    def keys(self) -> Iterator[str]:
+        for gid in range(len(self._index)):
+            yield self._index.name(gid)
+
+    def __iter__(self) -> Iterator[str]:
+        return self.keys()
+
+    def items(self) -> Iterator[Tuple[str, int]]:
+        for gid in range(len(self._index)):
+            yield self._index.name(gid), gid
+
+    def values(self) -> Iterator[int]:
+        return iter(range(len(self._index)))
+
+
+class _GidToNameView:
+    """Gid_2_pinName facade over a PinNameIndex"""
+
+    def __init__(self, index: PinNameIndex):
+        self._index = index
+
+    def __getitem__(self, gid: int) -> str:
+        if gid < 0 or gid >= len(self._index):
+            raise KeyError(gid)
+        return self._index.name(gid)
+
+    def get(self, gid: int, default: Optional[str] = None) -> Optional[str]:
+        if gid < 0 or gid >= len(self._index):
+            return default
+        return self._index.name(gid)
+
+    def __contains__(self, gid: int) -> bool:
+        return 0 <= gid < len(self._index)
+
+    def __len__(self) -> int:
+        return len(self._index)
+
+    def keys(self) -> Iterator[int]:
+        return iter(range(len(self._index)))
+
+    def __iter__(self) -> Iterator[int]:
+        return self.keys()
+
+    def items(self) -> Iterator[Tuple[int, str]]:
+        for gid in range(len(self._index)):
+            yield gid, self._index.name(gid)
+
+    def values(self) -> Iterator[str]:
+        for gid in range(len(self._index)):
+            yield self._index.name(gid)
+
+
+class PinNameService:
+    """
+    Persistent pin-name -> stable-id table shared across runs
+
+    Run-local gids are assigned in parse order, so any netlist edit
+    shifts them and cross-run tooling falls back to string joins. The
+    service keeps one append-only id space per design in a tensor
+    bundle (the same packed arena + offsets layout as PinNameIndex):
+    a name keeps its id forever, new names append at the end, and ids
+    of removed pins are never reused. load_tensor_bundle mmaps the
+    file, so concurrent INSTA processes analyzing the same block share
+    the table pages instead of each holding a copy. With the
+    gid -> stable lut from assign(), cross-run diffs and snapshot
+    deltas become array gathers.
+    """
+
+    def __init__(self, file_path: str):
+        self.file_path = file_path
+        self._index: Optional[PinNameIndex] = None
+        self._appended: List[str] = []
+        self._appended_2_id: dict = {}
+        if os.path.exists(file_path):
+            from ..io.serialization import load_tensor_bundle
+            bundle = load_tensor_bundle(file_path)
+            if bundle is not None:
+                self._index = PinNameIndex(
+                    bundle['arena'], bundle['offsets'], bundle['sorted_gids'])
+
+    def __len__(self) -> int:
+        base = len(self._index) if self._index is not None else 0
+        return base + len(self._appended)
+
+    def assign(self, names: List[str]) -> torch.Tensor:
+        """
+        Stable ids for a batch of names, appending any new ones
+
+        Returns an int64 tensor aligned with names. Existing names
+        resolve through the mmap index (binary search, no per-name heap
+        string); unseen names get the next free ids in encounter order.
+        """
+        base = len(self._index) if self._index is not None else 0
+        ids = torch.empty(len(names), dtype=torch.int64)
+        for row, name in enumerate(names):
+            stable = self._index.gid(name) if self._index is not None else -1
+            if stable < 0:
+                stable = self._appended_2_id.get(name)
+                if stable is None:
+                    stable = base + len(self._appended)
+                    self._appended_2_id[name] = stable
+                    self._appended.append(name)
+            ids[row] = stable
+        return ids
+
+    def save(self) -> bool:
+        """
+        Persist the table if new names were appended; ids never move
+
+        Rewriting re-packs the arena with the appended names at the
+        tail, so every previously issued id resolves to the same name
+        in the new file.
+        """
+        if not self._appended:
+            return False
+        from ..io.serialization import save_tensor_bundle
+        names = ([self._index.name(i) for i in range(len(self._index))]
+                 if self._index is not None else []) + self._appended
+        index = PinNameIndex.from_names(names)
+        save_tensor_bundle(
+            {'arena': index.arena, 'offsets': index.offsets,
+             'sorted_gids': index.sorted_gids},
+            self.file_path, meta={'num_names': len(names)})
+        self._index = index
+        self._appended = []
+        self._appended_2_id = {}
+        return True
@@ -12,8 +12,52 @@
 # @brief pybind kernel controller of statistical and differentiable arrival propagation
 
 
+import os
+import importlib
 import torch
-import installed_ops.sta_compute_arrival.sta_compute_arrival_cuda as compute_arrival
+
+# The shipped binary is compiled for sm_80 and runs on newer silicon
+# through the driver's PTX JIT, untuned. Deployments with a source
+# build for their architecture (e.g. an sm_90 fat binary) point
+# INSTA_COMPUTE_ARRIVAL_EXT at that module and everything below
+# dispatches to it unchanged — the pybind surface is the contract.
+_EXT_MODULE = os.environ.get(
+    'INSTA_COMPUTE_ARRIVAL_EXT',
+    'installed_ops.sta_compute_arrival.sta_compute_arrival_cuda')
+
+# The extension requires CUDA 11.8 on the host; CPU-only machines
+# (regression farms) fall back to the vectorized torch kernels in
+# compute_arrival_cpu for the eval sweep
+try:
+    compute_arrival = importlib.import_module(_EXT_MODULE)
+    HAS_CUDA_EXTENSION = True
+except ImportError:
+    compute_arrival = None
+    HAS_CUDA_EXTENSION = False
+    print(f'[compute_arrival] {_EXT_MODULE} unavailable, '
+          'using the CPU fallback kernels')
+
+if HAS_CUDA_EXTENSION and 'INSTA_COMPUTE_ARRIVAL_EXT' not in os.environ \
+        and torch.cuda.is_available():
+    _capability = torch.cuda.get_device_capability()
+    if _capability >= (9, 0):
+        print(f'[compute_arrival] device is sm_{_capability[0]}{_capability[1]} '
+              'but the stock extension targets sm_80 (PTX JIT, untuned); '
+              'set INSTA_COMPUTE_ARRIVAL_EXT to an arch-tuned build for '
+              'full top-K merge bandwidth')
+
+
+# When True, a full device synchronize is issued after every kernel
+# invocation (debug only). The default keeps the forward sweep fully
+# stream-async: every output-pin level is enqueued on the current stream and
+# the host only blocks when WNS/TNS (or another result) is actually read.
+_SYNC_AFTER_KERNEL = False
+
+
+def set_kernel_sync(enable: bool) -> None:
+    """Enable/disable the per-kernel device synchronize (debugging aid)"""
+    global _SYNC_AFTER_KERNEL
+    _SYNC_AFTER_KERNEL = enable
 
 
 class ComputeArrivalPOCV():
@@ -26,7 +70,25 @@ class ComputeArrivalPOCV():
                 p_indices, p_mapping,
                 valid_sps,
                 topK,
-                float_dtype):
+                float_dtype,
+                deterministic=False):
+
+        # CPU tensors (or hosts without the extension) take the
+        # vectorized torch path; same contract, level-batched ops.
+        # Deterministic mode takes it on GPU too — the fused kernel's
+        # atomic top-K merge can reorder tied candidates run to run,
+        # while the torch path's stable sort cannot.
+        if deterministic or not HAS_CUDA_EXTENSION or not p_rise_means.is_cuda:
+            from .compute_arrival_cpu import compute_rise_fall_arrival_pocv_cpu
+            return compute_rise_fall_arrival_pocv_cpu(
+                    p_rise_means, p_rise_stds, p_rise_sps,
+                    p_fall_means, p_fall_stds, p_fall_sps,
+                    c_rise_means, c_rise_stds, c_rise_sigmas,
+                    c_fall_means, c_fall_stds, c_fall_sigmas,
+                    duplicated_senses, node_start_idx, sigmas,
+                    p_indices, p_mapping,
+                    valid_sps,
+                    topK)
 
         if float_dtype == torch.float32:
             (rise_means, rise_stds, rise_sps,
@@ -54,11 +116,77 @@ class ComputeArrivalPOCV():
                              topK)
 
 
-        torch.cuda.synchronize()
+        if _SYNC_AFTER_KERNEL:
+            torch.cuda.synchronize()
         return (rise_means, rise_stds, rise_sps,
                 fall_means, fall_stds, fall_sps )
 
 
+# Fused input-pin (net-arc) level kernel. Older sta_compute_arrival_cuda
+# builds do not export it, so callers must check HAS_FUSED_NET_ARC and fall
+# back to the eager torch path in timing/cuda_ops.py.
+HAS_FUSED_NET_ARC = HAS_CUDA_EXTENSION and \
+    hasattr(compute_arrival, 'compute_net_arc_arrival_pocv')
+
+
+class ComputeNetArcArrivalPOCV():
+    @staticmethod
+    def forward(Gid_2_rise_arrival, Gid_2_rise_arrival_mean, Gid_2_rise_arrival_std, Gid_2_rise_startpoints,
+                Gid_2_fall_arrival, Gid_2_fall_arrival_mean, Gid_2_fall_arrival_std, Gid_2_fall_startpoints,
+                rise_means, rise_stds, fall_means, fall_stds,
+                c_indices, p_indices, sigmas, topK):
+        """
+        One-pass gather/compute/scatter over a net-arc level: reads the
+        parent rows via p_indices, adds the arc mean, RSS-combines the stds,
+        and scatters mean/std/arrival/startpoints for both rise and fall
+        into the Gid tensors in a single kernel (replaces ~16 torch ops)
+        """
+        compute_arrival.compute_net_arc_arrival_pocv(
+                Gid_2_rise_arrival, Gid_2_rise_arrival_mean, Gid_2_rise_arrival_std, Gid_2_rise_startpoints,
+                Gid_2_fall_arrival, Gid_2_fall_arrival_mean, Gid_2_fall_arrival_std, Gid_2_fall_startpoints,
+                rise_means, rise_stds, fall_means, fall_stds,
+                c_indices, p_indices, sigmas, topK)
+        if _SYNC_AFTER_KERNEL:
+            torch.cuda.synchronize()
+
+
+# Persistent whole-graph propagation kernel (grid-sync between levels).
+# Like the fused net-arc path, availability depends on the installed
+# extension build; callers must check HAS_PERSISTENT_PROPAGATE.
+HAS_PERSISTENT_PROPAGATE = HAS_CUDA_EXTENSION and \
+    hasattr(compute_arrival, 'persistent_arrival_propagate_pocv')
+
+
+class ComputeArrivalPersistent():
+    @staticmethod
+    def forward(sp_mean_tensor, sp_std_tensor,
+                Gid_2_rise_arrival, Gid_2_rise_arrival_mean, Gid_2_rise_arrival_std, Gid_2_rise_startpoints,
+                Gid_2_fall_arrival, Gid_2_fall_arrival_mean, Gid_2_fall_arrival_std, Gid_2_fall_startpoints,
+                flat_collaterals, sigmas, valid_sps, topK):
+        """
+        Single resident kernel that walks every level of the flattened
+        collateral buffers on-device, grid-syncing between levels. Host
+        dispatch cost becomes a single launch regardless of graph depth,
+        which is what dominates incremental calls with few nodes per level
+        """
+        compute_arrival.persistent_arrival_propagate_pocv(
+                sp_mean_tensor, sp_std_tensor,
+                Gid_2_rise_arrival, Gid_2_rise_arrival_mean, Gid_2_rise_arrival_std, Gid_2_rise_startpoints,
+                Gid_2_fall_arrival, Gid_2_fall_arrival_mean, Gid_2_fall_arrival_std, Gid_2_fall_startpoints,
+                flat_collaterals['level_kinds'],
+                flat_collaterals['level_offsets'],
+                flat_collaterals['node_indices'],
+                flat_collaterals['parent_indices'],
+                flat_collaterals['arc_rise_means'], flat_collaterals['arc_rise_stds'],
+                flat_collaterals['arc_fall_means'], flat_collaterals['arc_fall_stds'],
+                flat_collaterals['arc_senses'],
+                flat_collaterals['node_start_end'],
+                flat_collaterals['p_mappings'],
+                sigmas, valid_sps, topK)
+        if _SYNC_AFTER_KERNEL:
+            torch.cuda.synchronize()
+
+
 class ComputeArrivalPOCVWithGrad(torch.autograd.Function):
     @staticmethod
     def forward(ctx,
@@ -97,7 +225,8 @@ class ComputeArrivalPOCVWithGrad(torch.autograd.Function):
         #print(f'rise_mean_grad max: {rise_mean_grads.max()}, min: {rise_mean_grads.min()}')
         #print(f'fall_mean_grad max: {fall_mean_grads.max()}, min: {fall_mean_grads.min()}')
 
-        torch.cuda.synchronize()
+        if _SYNC_AFTER_KERNEL:
+            torch.cuda.synchronize()
         return (rise_means, rise_stds, rise_sps, rise_sigmas,
                 fall_means, fall_stds, fall_sps, fall_sigmas)
 
@@ -0,0 +1,321 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file installed_ops/sta_compute_arrival/compute_arrival_cpu.py
+# @brief vectorized torch fallback for the output-pin arrival kernel
+
+import torch
+
+# Upper bound on candidate rows reduced per segment in one pass. Without
+# it a single giant-fanin node dictates the padded width every other node
+# in its level is scattered into; see _reduce_topk.
+_SEGMENT_TILE_ROWS = 64
+
+# Largest K the streaming accumulator scan handles; matches the K range
+# where a per-thread candidate list stays register-resident in the
+# warp-level kernels this path mirrors
+_STREAM_SCAN_MAX_K = 32
+
+
+def _bitonic_clean_desc(arr, means, stds, sps):
+    """
+    Sort a per-run bitonic sequence descending via compare-exchange stages
+
+    arr is [..., k] with k a power of two and every row bitonic (the shape
+    the tournament merge below produces). log2(k) stages of distance-j
+    compare-exchanges restore descending order; the payload planes swap on
+    the same mask so each record moves as a unit.
+    """
+    k = arr.size(-1)
+    j = k // 2
+    while j >= 1:
+        shape = arr.shape[:-1] + (k // (2 * j), 2, j)
+        pairs = arr.reshape(shape)
+        take = pairs[..., 0, :] >= pairs[..., 1, :]
+
+        def _exchange(plane):
+            halves = plane.reshape(shape)
+            hi, lo = halves[..., 0, :], halves[..., 1, :]
+            return torch.stack((torch.where(take, hi, lo),
+                                torch.where(take, lo, hi)), dim=-2).reshape(plane.shape)
+
+        means = _exchange(means)
+        stds = _exchange(stds)
+        sps = _exchange(sps)
+        arr = _exchange(arr)
+        j //= 2
+    return arr, means, stds, sps
+
+
+def _tournament_topk_merge(arr, means, stds, sps):
+    """
+    Merge sorted candidate runs to one sorted top-k run per node
+
+    arr is [nodes, R, k]: R runs (power of two, -inf padded) each sorted
+    descending. Each round pairs runs and keeps, per lane, the larger of
+    A[i] and B[k-1-i] — for two sorted runs that max-sequence is exactly
+    the top-k of their union and is bitonic, so one clean pass re-sorts
+    it. log2(R) rounds replace the R*k-wide sort of the dense path with
+    elementwise work on halving tensors, the torch rendering of the
+    odd-even/bitonic merge networks warp-level top-k kernels use.
+    """
+    while arr.size(1) > 1:
+        a_arr, b_arr = arr[:, 0::2], arr[:, 1::2].flip(-1)
+        take = a_arr >= b_arr
+        arr = torch.where(take, a_arr, b_arr)
+        means = torch.where(take, means[:, 0::2], means[:, 1::2].flip(-1))
+        stds = torch.where(take, stds[:, 0::2], stds[:, 1::2].flip(-1))
+        sps = torch.where(take, sps[:, 0::2], sps[:, 1::2].flip(-1))
+        arr, means, stds, sps = _bitonic_clean_desc(arr, means, stds, sps)
+    return arr.squeeze(1), means.squeeze(1), stds.squeeze(1), sps.squeeze(1)
+
+
+def _streaming_topk_scan(arr, means, stds, sps, pass_segs, pass_intra,
+                         num_segs, fanin):
+    """
+    Sequential-accumulator top-k: one resident sorted run per segment
+
+    The tournament path scatters every candidate row into a padded
+    [segs, runs, k] tensor before merging, so a ragged level pays the
+    widest segment's footprint for every node. Here each segment keeps a
+    single sorted k-run accumulator and the rounds walk the fanin
+    positions in order, two-way bitonic-merging round r's rows into
+    their segments' accumulators — the torch rendering of a
+    register-resident candidate list that scans its parent segment and
+    writes back once at the end. A round only touches segments that
+    still have rows at that position, so traffic follows the real row
+    count instead of segs * max_fanin.
+    """
+    k = arr.size(1)
+    device = arr.device
+    acc_arr = torch.full((num_segs, k), float('-inf'), dtype=arr.dtype,
+                         device=device)
+    acc_means = torch.zeros(num_segs, k, dtype=means.dtype, device=device)
+    acc_stds = torch.zeros(num_segs, k, dtype=stds.dtype, device=device)
+    acc_sps = torch.full((num_segs, k), -1, dtype=sps.dtype, device=device)
+    for r in range(fanin):
+        rows = (pass_intra == r).nonzero(as_tuple=True)[0]
+        if rows.numel() == 0:
+            # intra positions are dense per segment, so an empty round
+            # means every later round is empty too
+            break
+        idx = pass_segs[rows]
+        a_arr = acc_arr[idx]
+        b_arr = arr[rows].flip(-1)
+        take = a_arr >= b_arr
+        m_arr = torch.where(take, a_arr, b_arr)
+        m_means = torch.where(take, acc_means[idx], means[rows].flip(-1))
+        m_stds = torch.where(take, acc_stds[idx], stds[rows].flip(-1))
+        m_sps = torch.where(take, acc_sps[idx], sps[rows].flip(-1))
+        m_arr, m_means, m_stds, m_sps = _bitonic_clean_desc(
+            m_arr, m_means, m_stds, m_sps)
+        acc_arr.index_copy_(0, idx, m_arr)
+        acc_means.index_copy_(0, idx, m_means)
+        acc_stds.index_copy_(0, idx, m_stds)
+        acc_sps.index_copy_(0, idx, m_sps)
+    return acc_arr, acc_means, acc_stds, acc_sps
+
+
+def compute_rise_fall_arrival_pocv_cpu(
+        p_rise_means, p_rise_stds, p_rise_sps,
+        p_fall_means, p_fall_stds, p_fall_sps,
+        c_rise_means, c_rise_stds, c_rise_sigmas,
+        c_fall_means, c_fall_stds, c_fall_sigmas,
+        duplicated_senses, node_start_idx, sigmas,
+        p_indices, p_mapping,
+        valid_sps,
+        topK):
+    """
+    Torch-native equivalent of compute_rise_fall_arrival_pocv
+
+    Same contract and numerics as the CUDA kernel: per output node, every
+    (parent candidate x cell arc) pair forms mean + RSS-std candidates
+    with unate sense swaps, and the top-K by mean + sigma*std survive.
+    Everything is batched tensor ops over the whole level — the ragged
+    per-node grouping becomes one dense [nodes, max_fanin*K] scatter, and
+    for power-of-two K the selection is a tournament of bitonic merges
+    over the sorted per-parent runs (see _tournament_topk_merge) instead
+    of one max_fanin*K-wide stable sort — so the inner loops vectorize
+    and multithread through torch's intra-op pool rather than a Python
+    walk.
+
+    Two roles: CPU-only hosts (regression farms without the prebuilt
+    CUDA 11.8 extension) run it for correlation checks, and it is the
+    deterministic mode on GPU — the stable sort breaks arrival ties by
+    candidate position, so repeated runs produce bit-identical top-K
+    orderings, unlike the fused kernel's reduction-order-dependent ties.
+    """
+    device = p_rise_means.device
+    sigma = sigmas.reshape(-1)[0]
+    flat_planes = p_rise_means.dim() == 1
+
+    def _as_k(plane):
+        return plane.unsqueeze(1) if flat_planes else plane
+
+    pm = p_mapping.to(torch.int64)[p_indices.to(torch.int64)]
+    neg = duplicated_senses.to(torch.bool).unsqueeze(1)
+
+    boundaries = node_start_idx.to(torch.int64)
+    counts = boundaries[1:] - boundaries[:-1]
+    num_nodes = counts.numel()
+    num_rows = int(boundaries[-1])
+    seg_ids = torch.repeat_interleave(
+        torch.arange(num_nodes, dtype=torch.int64, device=device), counts)
+    intra = torch.arange(num_rows, dtype=torch.int64, device=device) \
+        - boundaries[:-1][seg_ids]
+    max_fanin = int(counts.max()) if num_nodes else 0
+
+    # The merge-network path wants full power-of-two runs; anything else
+    # (K=1, odd K, single-parent levels) takes the dense sort below
+    use_merge_network = (not flat_planes and topK > 1 and
+                         (topK & (topK - 1)) == 0 and max_fanin > 1)
+
+    def _reduce_pass(arr, means, stds, sps, pass_segs, pass_intra,
+                     num_segs, fanin):
+        """
+        One segmented top-K pass: candidate rows -> per-segment sorted runs
+
+        arr/means/stds/sps are [rows, k] with pass_segs/pass_intra placing
+        each row in its segment (at most fanin rows per segment). The
+        tournament branch expects rows already sorted descending — callers
+        guarantee it — while the dense branch is the stable width-fanin*k
+        sort with no ordering requirement.
+        """
+        k_in = arr.size(1)
+
+        if use_merge_network and k_in == topK:
+            num_runs = 1 << max(fanin - 1, 0).bit_length()
+            # When k is register-sized and the power-of-two padding
+            # dwarfs the real rows (ragged fanin distributions), the
+            # streaming accumulator scan beats the padded tournament
+            if topK <= _STREAM_SCAN_MAX_K and \
+                    num_segs * num_runs > 2 * arr.size(0):
+                return _streaming_topk_scan(
+                    arr, means, stds, sps, pass_segs, pass_intra,
+                    num_segs, fanin)
+            runs_arrivals = torch.full((num_segs, num_runs, k_in), float('-inf'),
+                                       dtype=arr.dtype, device=device)
+            runs_means = torch.zeros(num_segs, num_runs, k_in,
+                                     dtype=means.dtype, device=device)
+            runs_stds = torch.zeros(num_segs, num_runs, k_in,
+                                    dtype=stds.dtype, device=device)
+            runs_sps = torch.full((num_segs, num_runs, k_in), -1,
+                                  dtype=sps.dtype, device=device)
+            runs_arrivals[pass_segs, pass_intra] = arr
+            runs_means[pass_segs, pass_intra] = means
+            runs_stds[pass_segs, pass_intra] = stds
+            runs_sps[pass_segs, pass_intra] = sps
+
+            return _tournament_topk_merge(
+                runs_arrivals, runs_means, runs_stds, runs_sps)
+
+        cols = (pass_intra * k_in).unsqueeze(1) + \
+            torch.arange(k_in, dtype=torch.int64, device=device).unsqueeze(0)
+        width = fanin * k_in
+        dense_arrivals = torch.full((num_segs, width), float('-inf'),
+                                    dtype=arr.dtype, device=device)
+        dense_means = torch.zeros(num_segs, width, dtype=means.dtype,
+                                  device=device)
+        dense_stds = torch.zeros(num_segs, width, dtype=stds.dtype,
+                                 device=device)
+        dense_sps = torch.full((num_segs, width), -1, dtype=sps.dtype,
+                               device=device)
+        rows = pass_segs.unsqueeze(1).expand_as(cols)
+        dense_arrivals[rows, cols] = arr
+        dense_means[rows, cols] = means
+        dense_stds[rows, cols] = stds
+        dense_sps[rows, cols] = sps
+
+        # stable sort: equal arrivals keep candidate order, so ties are
+        # broken identically run to run
+        order = torch.sort(dense_arrivals, dim=1, descending=True,
+                           stable=True).indices
+        top_idx = order[:, :topK]
+        return (dense_arrivals.gather(1, top_idx),
+                dense_means.gather(1, top_idx),
+                dense_stds.gather(1, top_idx),
+                dense_sps.gather(1, top_idx))
+
+    def _reduce_topk(arr, means, stds, sps):
+        """
+        Segmented top-K over the flattened candidate stream, load-balanced
+
+        Segments wider than _SEGMENT_TILE_ROWS are split into fixed-size
+        tiles of virtual segments so a single giant-fanin node (10k+ fanin
+        clock gates) no longer sets the dense width / run count the whole
+        level pads to. Each pass reduces every tile to one sorted top-K
+        run; the per-tile winners then become the rows of the next pass
+        until each node is covered by a single segment.
+        """
+        pass_segs, pass_intra = seg_ids, intra
+        pass_counts, fanin = counts, max_fanin
+        while fanin > _SEGMENT_TILE_ROWS:
+            tiles = (pass_counts + _SEGMENT_TILE_ROWS - 1) // _SEGMENT_TILE_ROWS
+            tile_base = torch.cumsum(tiles, 0) - tiles
+            vsegs = tile_base[pass_segs] + pass_intra // _SEGMENT_TILE_ROWS
+            vintra = pass_intra % _SEGMENT_TILE_ROWS
+            num_vsegs = int(tiles.sum())
+            arr, means, stds, sps = _reduce_pass(
+                arr, means, stds, sps, vsegs, vintra,
+                num_vsegs, _SEGMENT_TILE_ROWS)
+            # Tile winners become the rows of the next pass, owned by the
+            # segments the tiles were carved from
+            owner = torch.repeat_interleave(
+                torch.arange(pass_counts.numel(), dtype=torch.int64,
+                             device=device), tiles)
+            pass_intra = torch.arange(num_vsegs, dtype=torch.int64,
+                                      device=device) - tile_base[owner]
+            pass_segs = owner
+            pass_counts = tiles
+            fanin = int(tiles.max()) if tiles.numel() else 0
+        return _reduce_pass(arr, means, stds, sps, pass_segs, pass_intra,
+                            num_nodes, fanin)
+
+    def _merge(src_means, src_stds, src_sps, arc_means, arc_stds):
+        cand_means = src_means + arc_means.unsqueeze(1)
+        cand_stds = torch.sqrt(src_stds * src_stds +
+                               (arc_stds * arc_stds).unsqueeze(1))
+        cand_arrivals = cand_means + sigma * cand_stds
+
+        if use_merge_network and cand_means.size(1) == topK:
+            # Parent runs arrive sorted from the previous level's top-K
+            # selection; the scalar arc RSS can reorder near-ties, so a
+            # cheap K-wide stable re-sort per run restores strict order
+            # before the tournament passes (still far narrower than the
+            # dense sort it replaces)
+            run_order = torch.sort(cand_arrivals, dim=1, descending=True,
+                                   stable=True).indices
+            cand_arrivals = cand_arrivals.gather(1, run_order)
+            cand_means = cand_means.gather(1, run_order)
+            cand_stds = cand_stds.gather(1, run_order)
+            src_sps = src_sps.gather(1, run_order)
+
+        _, out_means, out_stds, out_sps = _reduce_topk(
+            cand_arrivals, cand_means, cand_stds, src_sps)
+        if flat_planes:
+            out_means = out_means.squeeze(1)
+            out_stds = out_stds.squeeze(1)
+            out_sps = out_sps.squeeze(1)
+        return out_means, out_stds, out_sps
+
+    rise_src_means = torch.where(neg, _as_k(p_fall_means)[pm], _as_k(p_rise_means)[pm])
+    rise_src_stds = torch.where(neg, _as_k(p_fall_stds)[pm], _as_k(p_rise_stds)[pm])
+    rise_src_sps = torch.where(neg, _as_k(p_fall_sps)[pm], _as_k(p_rise_sps)[pm])
+    fall_src_means = torch.where(neg, _as_k(p_rise_means)[pm], _as_k(p_fall_means)[pm])
+    fall_src_stds = torch.where(neg, _as_k(p_rise_stds)[pm], _as_k(p_fall_stds)[pm])
+    fall_src_sps = torch.where(neg, _as_k(p_rise_sps)[pm], _as_k(p_fall_sps)[pm])
+
+    rise_means, rise_stds, rise_sps = _merge(
+        rise_src_means, rise_src_stds, rise_src_sps, c_rise_means, c_rise_stds)
+    fall_means, fall_stds, fall_sps = _merge(
+        fall_src_means, fall_src_stds, fall_src_sps, c_fall_means, c_fall_stds)
+
+    return (rise_means, rise_stds, rise_sps,
+            fall_means, fall_stds, fall_sps)
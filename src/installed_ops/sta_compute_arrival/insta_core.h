@@ -0,0 +1,120 @@
+/* Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ *
+ * @author Yi-Chen Lu
+ * @file installed_ops/sta_compute_arrival/insta_core.h
+ * @brief C API of the standalone propagation core
+ *
+ * This header is the language-neutral contract for driving the level
+ * sweep, incremental updates and the slack reduction without a Python
+ * interpreter in the call path. The implementation links the same
+ * kernels the pybind11 extension in this directory wraps; Python is one
+ * client of this API among several (a router integration calls it
+ * directly), and per-call overhead is a plain function call plus kernel
+ * launches — no GIL, no tensor boxing.
+ *
+ * Input interchange is the flattened core snapshot written by
+ * INSTA.do_export_core_snapshot: a tensor bundle (io/serialization.py)
+ * whose layout is stable and trivially parseable from C:
+ *
+ *   bytes 0..7    magic "INSTABN1"
+ *   bytes 8..15   little-endian u64 JSON header length
+ *   bytes 16..    JSON header: {"version", "schema", "data_bytes",
+ *                 "meta", "tensors": {name: {dtype, shape, offset}}}
+ *   byte  4096    start of raw tensor data; each tensor lives at
+ *                 4096 + offset, offsets are 64-byte aligned
+ *
+ * The snapshot carries the flattened level schedule (level_kinds,
+ * level_offsets, node_indices, parent_indices, the concatenated arc
+ * delay tables, arc_senses, node_start_end, p_mappings — the same
+ * buffers the persistent kernel consumes), the startpoint mean/std
+ * planes, the startpoint/endpoint gid lists and the endpoint required
+ * times; meta records max_gid, topK, the float dtype and the level
+ * count. Arc positions in the concatenated tables are the patch
+ * handles for incremental updates and are stable for the lifetime of
+ * the snapshot.
+ */
+
+#ifndef INSTA_CORE_H
+#define INSTA_CORE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opaque propagation core: owns the device copies of the snapshot
+ * buffers, the arrival/slack planes and the CUDA stream it runs on.
+ * Handles are not thread-safe; use one per thread or fence externally. */
+typedef struct insta_core insta_core_t;
+
+typedef enum insta_core_status {
+    INSTA_CORE_OK = 0,
+    INSTA_CORE_ERR_IO = 1,          /* snapshot unreadable or bad magic   */
+    INSTA_CORE_ERR_FORMAT = 2,      /* header parse / missing tensor      */
+    INSTA_CORE_ERR_CUDA = 3,        /* device allocation or launch failed */
+    INSTA_CORE_ERR_ARGUMENT = 4     /* bad handle, index out of range     */
+} insta_core_status_t;
+
+/* Map a core snapshot and stage it onto the given CUDA device.
+ * device_ordinal < 0 selects the current device. The file mapping is
+ * released once staging completes; the snapshot file may be replaced
+ * afterwards (exports publish via atomic rename). */
+insta_core_status_t insta_core_load(const char *snapshot_path,
+                                    int device_ordinal,
+                                    insta_core_t **out_core);
+
+/* Full level sweep at the given POCV guard-band (sigma = 0 propagates
+ * means only). Asynchronous: work is enqueued on the core's stream and
+ * only the result readers below synchronize. */
+insta_core_status_t insta_core_propagate(insta_core_t *core, float sigma);
+
+/* Scatter new delays into the flat arc tables. arc_positions indexes
+ * the concatenated arc tables of the snapshot (the exporter's loc maps
+ * translate arc names to positions); each row of the four delay arrays
+ * is (rise_mean, rise_std, fall_mean, fall_std) for the matching
+ * position. Patches alone do not re-propagate. */
+insta_core_status_t insta_core_patch_arcs(insta_core_t *core,
+                                          const int64_t *arc_positions,
+                                          const float *rise_means,
+                                          const float *rise_stds,
+                                          const float *fall_means,
+                                          const float *fall_stds,
+                                          int64_t count);
+
+/* Re-sweep only the levels at or below the shallowest patched arc since
+ * the last propagation; arrivals elsewhere stay valid. Falls back to a
+ * full sweep when no propagation has run yet. */
+insta_core_status_t insta_core_propagate_incremental(insta_core_t *core,
+                                                     float sigma);
+
+/* Number of endpoints in the snapshot's dest list (the row count of the
+ * slack readers below). */
+int64_t insta_core_num_endpoints(const insta_core_t *core);
+
+/* Copy the per-endpoint worst slacks (min of rise/fall, ordered as the
+ * snapshot's endpoint list) into caller memory and return WNS/TNS.
+ * Any output pointer may be NULL to skip it. Synchronizes the core's
+ * stream — this is the one blocking call of a propagate/read cycle. */
+insta_core_status_t insta_core_endpoint_slacks(insta_core_t *core,
+                                               float *slacks_out,
+                                               float *wns_out,
+                                               float *tns_out);
+
+insta_core_status_t insta_core_free(insta_core_t *core);
+
+/* Static description of a status code; never fails. */
+const char *insta_core_status_string(insta_core_status_t status);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* INSTA_CORE_H */
@@ -18,7 +18,11 @@ from .parsers import (
     read_sp_file,
     read_ep_file,
     read_clock_latency_rpt,
-    read_pocvm_file
+    read_pocvm_file,
+    convert_input_to_snapshot,
+    convert_inputs_to_snapshots,
+    PinInterner,
+    ArcColumns
 )
 
 from .serialization import (
@@ -0,0 +1,70 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file io/interop.py
+# @brief zero-copy tensor sharing (DLPack capsules, CUDA IPC handles)
+
+import torch
+from typing import Any, Dict, Tuple
+
+
+def to_dlpack_capsule(tensor: torch.Tensor) -> Any:
+    """
+    Wrap a device tensor as a DLPack capsule for an in-process consumer
+
+    The capsule aliases the tensor's storage — no copy — and is consumed
+    exactly once (DLPack ownership transfers on import). The producer
+    must keep the source tensor alive until the consumer is done, and
+    the consumer sees whatever the next propagation writes, so hand out
+    fresh capsules per iteration rather than caching them.
+    """
+    return torch.utils.dlpack.to_dlpack(tensor.detach())
+
+
+def to_cuda_ipc_handle(tensor: torch.Tensor) -> Tuple[Any, tuple]:
+    """
+    Export a CUDA tensor as a picklable IPC handle for another process
+
+    Uses torch's own reduction machinery (cudaIpcGetMemHandle under the
+    hood): the returned (rebuild_fn, args) pair pickles across a socket
+    or shared file and rebuilds in the peer as a tensor mapping the same
+    device memory. Same aliasing rules as DLPack — the owning process
+    must outlive the mapping, and rewrites are visible to the peer.
+    """
+    assert tensor.is_cuda, 'CUDA IPC export requires a device tensor'
+    from torch.multiprocessing.reductions import reduce_tensor
+    return reduce_tensor(tensor.detach())
+
+
+def from_cuda_ipc_handle(handle: Tuple[Any, tuple]) -> torch.Tensor:
+    """Rebuild a tensor from a to_cuda_ipc_handle export (consumer side)"""
+    rebuild_fn, args = handle
+    return rebuild_fn(*args)
+
+
+def export_tensor_map(tensors: Dict[str, torch.Tensor],
+                      kind: str = 'dlpack') -> Dict[str, Any]:
+    """
+    Export a name->tensor map as DLPack capsules or CUDA IPC handles
+
+    kind='dlpack' for a co-resident consumer in the same process (e.g. a
+    placer importing via torch/cupy from_dlpack); kind='cuda_ipc' for a
+    separate process. Non-CUDA tensors are skipped under cuda_ipc.
+    """
+    assert kind in ('dlpack', 'cuda_ipc'), f'unsupported export kind: {kind}'
+    exported = {}
+    for name, tensor in tensors.items():
+        if tensor is None:
+            continue
+        if kind == 'dlpack':
+            exported[name] = to_dlpack_capsule(tensor)
+        elif tensor.is_cuda:
+            exported[name] = to_cuda_ipc_handle(tensor)
+    return exported
@@ -14,7 +14,11 @@
 import os
 import math
 import glob
+import time
+import threading
 import collections
+import concurrent.futures
+import functools
 from typing import Dict, List, Set, Tuple, Optional, Union, Any
 
 import polars as pl
@@ -24,6 +28,268 @@ import gc
 # Use absolute imports without src prefix
 from .serialization import save_pickle, load_pickle
 
+# Binary columnar snapshots tried (in order) next to each input CSV
+_SNAPSHOT_EXTS = ['.parquet', '.arrow']
+
+
+def _resolve_input_table(file_path: str) -> str:
+    """Prefer a sibling binary snapshot over the CSV with the same stem"""
+    stem = os.path.splitext(file_path)[0]
+    for ext in _SNAPSHOT_EXTS:
+        candidate = stem + ext
+        if os.path.exists(candidate):
+            return candidate
+    return file_path
+
+
+def _read_input_table(file_path: str) -> pl.DataFrame:
+    """
+    Read an input table, preferring the binary columnar snapshot
+
+    CSVs are parsed with infer_schema_length=0 (all columns as strings,
+    which the downstream filters expect); parquet/arrow snapshots skip the
+    text parse entirely and come back straight from the column buffers.
+    Pin-name columns stored as dictionary-encoded categoricals are cast
+    back to utf8 so the string filters behave identically.
+    """
+    resolved = _resolve_input_table(file_path)
+    if resolved == file_path:
+        return pl.read_csv(file_path, infer_schema_length=0)
+
+    if resolved.endswith('.parquet'):
+        df = pl.read_parquet(resolved)
+    else:
+        df = pl.read_ipc(resolved, memory_map=True)
+    print(f'[input snapshot] loaded {os.path.basename(resolved)} instead of the CSV')
+
+    categorical = [name for name, dtype in df.schema.items() if dtype == pl.Categorical]
+    if categorical:
+        df = df.with_columns([pl.col(name).cast(pl.Utf8) for name in categorical])
+    return df
+
+
+def _scan_input_table(file_path: str) -> pl.LazyFrame:
+    """
+    Lazy counterpart of _read_input_table for the streaming parse path
+
+    Nothing is materialized here; the caller composes its filters and
+    aggregations on the LazyFrame and collects with the streaming engine,
+    which processes the file in row-group chunks with bounded memory
+    instead of holding the whole arc table at once.
+    """
+    resolved = _resolve_input_table(file_path)
+    if resolved.endswith('.parquet'):
+        return pl.scan_parquet(resolved)
+    if resolved.endswith('.arrow'):
+        return pl.scan_ipc(resolved)
+    return pl.scan_csv(resolved, infer_schema_length=0)
+
+
+def convert_input_to_snapshot(file_path: str, fmt: str = 'parquet') -> str:
+    """
+    Convert one input CSV to a binary columnar snapshot
+
+    The snapshot keeps the CSV's all-string schema so the downstream
+    filters behave identically, but dictionary-encodes the pin-name
+    columns: each full name is interned once in the file instead of being
+    re-tokenized from text on every cold start.
+
+    Args:
+        file_path: Path to the input CSV file
+        fmt: 'parquet' or 'arrow' (Arrow IPC, mmap-loadable)
+
+    Returns:
+        Path of the snapshot written next to the CSV
+    """
+    df = pl.read_csv(file_path, infer_schema_length=0)
+    pin_columns = [name for name in df.columns
+                   if 'full_name' in name or name in ('sp_name', 'ep_name')]
+    if pin_columns:
+        df = df.with_columns([pl.col(name).cast(pl.Categorical) for name in pin_columns])
+
+    out_path = os.path.splitext(file_path)[0] + ('.parquet' if fmt == 'parquet' else '.arrow')
+    if fmt == 'parquet':
+        df.write_parquet(out_path)
+    else:
+        df.write_ipc(out_path)
+    print(f'[input snapshot] wrote {out_path} ({df.shape[0]} rows)')
+    return out_path
+
+
+def convert_inputs_to_snapshots(input_dir: str, fmt: str = 'parquet') -> List[str]:
+    """Convert every input CSV in a directory; returns the snapshot paths"""
+    written = []
+    for csv_path in sorted(glob.glob(os.path.join(input_dir, '*.csv'))):
+        written.append(convert_input_to_snapshot(csv_path, fmt=fmt))
+    return written
+
+
+_SENSE_2_CODE = {'positive_unate': 0, 'negative_unate': 1, 'rising_edge': 2, 'falling_edge': 3}
+_CODE_2_SENSE = {code: sense for sense, code in _SENSE_2_CODE.items()}
+
+
+class PinInterner:
+    """
+    Bidirectional pin-name <-> integer id table
+
+    Shared between the cell- and net-arc tables so both index the same id
+    space; each full name is stored exactly once regardless of how many
+    arcs reference it.
+    """
+
+    def __init__(self):
+        self.name_2_id: Dict[str, int] = {}
+        self.id_2_name: List[str] = []
+        # Taken only on the miss path, so concurrent parses (the cell- and
+        # net-arc readers overlap in the parallel initialization) assign
+        # each new name exactly one id; hits stay lock-free
+        self._lock = threading.Lock()
+
+    def __getstate__(self):
+        state = self.__dict__.copy()
+        del state['_lock']
+        return state
+
+    def __setstate__(self, state):
+        self.__dict__.update(state)
+        self._lock = threading.Lock()
+
+    def intern(self, name: str) -> int:
+        pin_id = self.name_2_id.get(name)
+        if pin_id is None:
+            with self._lock:
+                pin_id = self.name_2_id.get(name)
+                if pin_id is None:
+                    pin_id = len(self.id_2_name)
+                    self.id_2_name.append(name)
+                    self.name_2_id[name] = pin_id
+        return pin_id
+
+    def intern_series(self, names) -> torch.Tensor:
+        """
+        Intern a polars series of names into an int64 id tensor
+
+        Vectorized categorical encoding: the distinct names come out of
+        polars' native engine, only genuinely new ones take the intern
+        lock (once per batch instead of once per row), and the per-row
+        encoding is a single replace_strict evaluated over the arrow
+        buffers — no Python dict probe per arc endpoint. The result
+        wraps the encoded column's buffer directly.
+        """
+        uniq = names.unique().to_list()
+        missing = [name for name in uniq if name not in self.name_2_id]
+        if missing:
+            with self._lock:
+                for name in missing:
+                    if name not in self.name_2_id:
+                        self.name_2_id[name] = len(self.id_2_name)
+                        self.id_2_name.append(name)
+        mapping = {name: self.name_2_id[name] for name in uniq}
+        encoded = names.replace_strict(mapping, return_dtype=pl.Int64)
+        return torch.from_numpy(encoded.to_numpy())
+
+
+class ArcColumns:
+    """
+    Columnar arc table with dict-compatible access
+
+    Holds src/dst pin ids over a PinInterner, sense codes (cell arcs
+    only) and the delay columns as flat tensors — a handful of arrays
+    instead of tens of GB of per-arc Python tuples. The mapping protocol
+    the dict consumers (build_timing_graph, precompute_collaterals)
+    already use is implemented on top: keys are the original pin-name
+    tuples and values the variation tuples, both decoded row-by-row on
+    demand. Random access builds an int-keyed row index lazily on first
+    lookup.
+    """
+
+    def __init__(
+        self,
+        interner: PinInterner,
+        src_ids: torch.Tensor,
+        dst_ids: torch.Tensor,
+        senses: Optional[torch.Tensor],
+        delays: torch.Tensor,
+        is_pocv: bool
+    ):
+        # delays: [num_arcs, 4] = (rise_mean, rise_std, fall_mean, fall_std)
+        # for POCV, [num_arcs, 2] = (rise_mean, fall_mean) otherwise
+        self.interner = interner
+        self.src_ids = src_ids
+        self.dst_ids = dst_ids
+        self.senses = senses
+        self.delays = delays
+        self.is_pocv = is_pocv
+        self._key_2_row = None
+
+    def _ensure_index(self):
+        if self._key_2_row is not None:
+            return
+        src = self.src_ids.tolist()
+        dst = self.dst_ids.tolist()
+        if self.senses is not None:
+            codes = self.senses.tolist()
+            self._key_2_row = {key: row for row, key in enumerate(zip(src, dst, codes))}
+        else:
+            self._key_2_row = {key: row for row, key in enumerate(zip(src, dst))}
+
+    def _row_key(self, key) -> Optional[Tuple]:
+        src_id = self.interner.name_2_id.get(key[0])
+        dst_id = self.interner.name_2_id.get(key[1])
+        if src_id is None or dst_id is None:
+            return None
+        if self.senses is not None:
+            code = _SENSE_2_CODE.get(key[2])
+            return None if code is None else (src_id, dst_id, code)
+        return (src_id, dst_id)
+
+    def __len__(self) -> int:
+        return self.src_ids.numel()
+
+    def __contains__(self, key) -> bool:
+        self._ensure_index()
+        row_key = self._row_key(key)
+        return row_key is not None and row_key in self._key_2_row
+
+    def __getitem__(self, key) -> Tuple:
+        self._ensure_index()
+        row_key = self._row_key(key)
+        if row_key is None or row_key not in self._key_2_row:
+            raise KeyError(key)
+        return tuple(self.delays[self._key_2_row[row_key]].tolist())
+
+    def __setitem__(self, key, values):
+        """Overwrite an existing arc's delay row (used by input diffing)"""
+        self._ensure_index()
+        row_key = self._row_key(key)
+        if row_key is None or row_key not in self._key_2_row:
+            raise KeyError(key)
+        self.delays[self._key_2_row[row_key]] = torch.tensor(values, dtype=self.delays.dtype)
+
+    def get(self, key, default=None):
+        return self[key] if key in self else default
+
+    def keys(self):
+        id_2_name = self.interner.id_2_name
+        src = self.src_ids.tolist()
+        dst = self.dst_ids.tolist()
+        if self.senses is not None:
+            for src_id, dst_id, code in zip(src, dst, self.senses.tolist()):
+                yield (id_2_name[src_id], id_2_name[dst_id], _CODE_2_SENSE[code])
+        else:
+            for src_id, dst_id in zip(src, dst):
+                yield (id_2_name[src_id], id_2_name[dst_id])
+
+    def __iter__(self):
+        return self.keys()
+
+    def values(self):
+        for row in self.delays.tolist():
+            yield tuple(row)
+
+    def items(self):
+        return zip(self.keys(), self.values())
+
 
 def read_cell_libcell_file(
     file_path: str,
@@ -107,8 +373,8 @@ def read_no_timing_pin_file(
     # Initialize return values
     notiming_pins = set()
 
-    # Check if file exists
-    if not os.path.exists(file_path):
+    # Check if file exists (CSV or binary snapshot)
+    if not os.path.exists(_resolve_input_table(file_path)):
         print(f'[read noTiming warning] cannot find file {file_path}')
         return notiming_pins, True  # Not an error, just empty set
 
@@ -121,7 +387,7 @@ def read_no_timing_pin_file(
 
     # Read file with Polars
     try:
-        df = pl.read_csv(file_path, infer_schema_length=0)
+        df = _read_input_table(file_path)
         notiming_pins = set(df['full_name'])
 
         # Save results
@@ -156,8 +422,8 @@ def read_valid_pin_file(
     # Initialize return values
     valid_pins = set()
 
-    # Check if file exists
-    if not os.path.exists(file_path):
+    # Check if file exists (CSV or binary snapshot)
+    if not os.path.exists(_resolve_input_table(file_path)):
         print(f'[read valid pin file] error: cannot find file {file_path}')
         return valid_pins, False
 
@@ -170,7 +436,7 @@ def read_valid_pin_file(
 
     # Read file with Polars
     try:
-        df = pl.read_csv(file_path, infer_schema_length=0)
+        df = _read_input_table(file_path)
         valid_pins = set(df['full_name'])
 
         # Save results
@@ -192,23 +458,27 @@ def _is_column_empty(df: pl.DataFrame, column_name: str) -> bool:
 
 
 def _filter_arc_dataframe(
-    df: pl.DataFrame,
+    df: Union[pl.DataFrame, pl.LazyFrame],
     mode: str = 'net',
-    scale: float = 1.0
-) -> Tuple[pl.DataFrame, bool]:
+    scale: float = 1.0,
+    has_variation: Optional[bool] = None
+) -> Tuple[Union[pl.DataFrame, pl.LazyFrame], bool]:
     """
     Process timing arc dataframe based on format (standard or POCV)
 
     Args:
-        df: Input dataframe
+        df: Input dataframe (eager or lazy)
         mode: 'cell' or 'net'
         scale: Scaling factor for delays
+        has_variation: Pre-decided POCV format flag; required for lazy
+            frames, where the emptiness probe cannot run in place
 
     Returns:
         Tuple of (processed_dataframe, is_pocv)
     """
     # Check if this is a POCV dataframe
-    has_variation = not _is_column_empty(df, 'variation_delay_max_rise.mean')
+    if has_variation is None:
+        has_variation = not _is_column_empty(df, 'variation_delay_max_rise.mean')
 
     if not has_variation:
         # Standard timing format
@@ -367,12 +637,254 @@ def _extract_cell_arc_variations(
     return variations
 
 
+def _float_columns_to_tensor(df: pl.DataFrame, columns: List[str],
+                             scale: float) -> torch.Tensor:
+    """
+    Pack delay columns into one [rows, C] float32 tensor via the arrow
+    buffers
+
+    Each column is cast inside polars and wrapped with from_numpy; the
+    values never round-trip through a Python float list. The stack is
+    the single copy, and the scale divide runs once over the packed
+    tensor.
+    """
+    packed = torch.stack(
+        [torch.from_numpy(df[col].cast(pl.Float32).to_numpy())
+         for col in columns],
+        dim=1
+    )
+    return packed / scale if scale != 1.0 else packed
+
+
+def _extract_cell_arc_columns(
+    df: pl.DataFrame,
+    is_pocv: bool,
+    scale: float,
+    interner: PinInterner
+) -> ArcColumns:
+    """
+    Columnar counterpart of _extract_cell_arc_variations
+
+    Performs the same worst-corner selection per (from, to, sense) arc,
+    but entirely inside polars; the surviving rows are then interned and
+    packed into flat tensors without materializing per-arc Python tuples.
+    """
+    keys = ["from_pin.full_name", "to_pin.full_name", "sense"]
+    if is_pocv:
+        agg = df.group_by(keys).agg(
+            pl.col('variation_delay_max_rise.mean').sort_by('corner_rise_delay').last().alias('rise_mean'),
+            pl.col('variation_delay_max_rise.std_dev').sort_by('corner_rise_delay').last().alias('rise_std'),
+            pl.col('variation_delay_max_fall.mean').sort_by('corner_fall_delay').last().alias('fall_mean'),
+            pl.col('variation_delay_max_fall.std_dev').sort_by('corner_fall_delay').last().alias('fall_std')
+        )
+        delay_cols = ['rise_mean', 'rise_std', 'fall_mean', 'fall_std']
+    else:
+        agg = df.group_by(keys).agg(
+            pl.max("delay_max_rise").alias('rise_mean'),
+            pl.max("delay_max_fall").alias('fall_mean')
+        )
+        delay_cols = ['rise_mean', 'fall_mean']
+
+    if isinstance(agg, pl.LazyFrame):
+        # Streaming collect: the scan/filter/group-by pipeline runs in
+        # row-group chunks, so only the aggregated arcs are ever resident
+        agg = agg.collect(streaming=True)
+
+    src_ids = interner.intern_series(agg['from_pin.full_name'])
+    dst_ids = interner.intern_series(agg['to_pin.full_name'])
+    senses = torch.from_numpy(
+        agg['sense'].replace_strict(_SENSE_2_CODE, return_dtype=pl.Int8)
+                    .to_numpy())
+    delays = _float_columns_to_tensor(agg, delay_cols, scale)
+    return ArcColumns(interner, src_ids, dst_ids, senses, delays, is_pocv)
+
+
+def _find_arc_shards(file_path: str) -> List[str]:
+    """
+    Discover shard files for one arc table
+
+    The input generator can emit e.g. cell_arcs.csv as
+    cell_arcs.shard00.csv .. cell_arcs.shardNN.csv; shards are matched by
+    the '<stem>.shard*' pattern and returned in name order. Each shard
+    path goes through the usual snapshot resolution, so per-shard
+    parquet/arrow snapshots are honored too.
+    """
+    stem = os.path.splitext(file_path)[0]
+    shard_stems = sorted({os.path.splitext(p)[0]
+                          for p in glob.glob(stem + '.shard*')})
+    return [s + '.csv' for s in shard_stems]
+
+
+def _parse_arc_shard(shard_path: str, mode: str, scale: float):
+    """
+    Process-pool worker: one shard end to end with a local interner
+
+    Runs the full text parse, filter and worst-corner aggregation on its
+    shard, interning names into a shard-local PinInterner (no shared
+    state, no locks across processes). POCV shards also carry their
+    per-arc corner-delay maxima so the parent can resolve arcs whose
+    corners were split across shards. Returns picklable pieces:
+    (ArcColumns, corner maxima [rows, 2] or None, is_pocv).
+    """
+    df = _read_input_table(shard_path)
+    if mode == 'cell':
+        df = df.filter(pl.col('sense').is_in(list(_SENSE_2_CODE)))
+    df, is_pocv = _filter_arc_dataframe(df, mode=mode, scale=scale)
+
+    keys = ['from_pin.full_name', 'to_pin.full_name']
+    if mode == 'cell':
+        keys.append('sense')
+    if is_pocv:
+        # Same worst-corner selection as _extract_*_arc_columns, with the
+        # winning corner delays kept alongside for the cross-shard merge
+        agg = df.group_by(keys).agg(
+            pl.col('variation_delay_max_rise.mean').sort_by('corner_rise_delay').last().alias('rise_mean'),
+            pl.col('variation_delay_max_rise.std_dev').sort_by('corner_rise_delay').last().alias('rise_std'),
+            pl.col('variation_delay_max_fall.mean').sort_by('corner_fall_delay').last().alias('fall_mean'),
+            pl.col('variation_delay_max_fall.std_dev').sort_by('corner_fall_delay').last().alias('fall_std'),
+            pl.max('corner_rise_delay').alias('corner_rise'),
+            pl.max('corner_fall_delay').alias('corner_fall')
+        )
+        delay_cols = ['rise_mean', 'rise_std', 'fall_mean', 'fall_std']
+        corners = _float_columns_to_tensor(agg, ['corner_rise', 'corner_fall'], 1.0)
+    else:
+        agg = df.group_by(keys).agg(
+            pl.max('delay_max_rise').alias('rise_mean'),
+            pl.max('delay_max_fall').alias('fall_mean')
+        )
+        delay_cols = ['rise_mean', 'fall_mean']
+        corners = None
+
+    interner = PinInterner()
+    src_ids = interner.intern_series(agg['from_pin.full_name'])
+    dst_ids = interner.intern_series(agg['to_pin.full_name'])
+    senses = None
+    if mode == 'cell':
+        senses = torch.from_numpy(
+            agg['sense'].replace_strict(_SENSE_2_CODE, return_dtype=pl.Int8)
+                        .to_numpy())
+    delays = _float_columns_to_tensor(agg, delay_cols, scale)
+    columns = ArcColumns(interner, src_ids, dst_ids, senses, delays, is_pocv)
+    return columns, corners, is_pocv
+
+
+def _merge_arc_shards(
+    shard_results: List[Tuple[ArcColumns, Optional[torch.Tensor], bool]],
+    mode: str,
+    interner: PinInterner
+) -> ArcColumns:
+    """
+    Merge per-shard columnar chunks into one ArcColumns
+
+    Each shard's local intern table folds into the shared interner (one
+    Python pass over the shard's unique pins, not its arcs) and its id
+    columns remap through the resulting lookup tensor; the columns then
+    concatenate. Arcs whose rows landed in several shards are resolved
+    exactly as the single-file aggregation would have: per rise/fall
+    pair the row with the largest corner delay wins (POCV), or the
+    delays max out elementwise (standard format).
+    """
+    is_pocv = shard_results[0][2]
+    assert all(r[2] == is_pocv for r in shard_results), \
+        'arc shards disagree on POCV format'
+
+    src_parts, dst_parts, sense_parts, delay_parts, corner_parts = \
+        [], [], [], [], []
+    for columns, corners, _ in shard_results:
+        lut = torch.tensor(
+            [interner.intern(name) for name in columns.interner.id_2_name],
+            dtype=torch.int64)
+        src_parts.append(lut[columns.src_ids])
+        dst_parts.append(lut[columns.dst_ids])
+        if columns.senses is not None:
+            sense_parts.append(columns.senses)
+        delay_parts.append(columns.delays)
+        if corners is not None:
+            corner_parts.append(corners)
+
+    src = torch.cat(src_parts)
+    dst = torch.cat(dst_parts)
+    senses = torch.cat(sense_parts) if sense_parts else None
+    delays = torch.cat(delay_parts)
+    corners = torch.cat(corner_parts) if corner_parts else None
+
+    num_pins = len(interner.id_2_name)
+    key = src * num_pins + dst
+    if senses is not None:
+        key = key * 4 + senses.to(torch.int64)
+    uniq, inverse = torch.unique(key, return_inverse=True)
+    if uniq.numel() == key.numel():
+        return ArcColumns(interner, src, dst, senses, delays, is_pocv)
+
+    # Cross-shard duplicates: pick one representative row per arc for the
+    # id columns (first occurrence, deterministic), then resolve delays
+    num_rows = key.numel()
+    num_arcs = uniq.numel()
+    row_idx = torch.arange(num_rows, dtype=torch.int64)
+    rep = torch.full((num_arcs,), num_rows, dtype=torch.int64)
+    rep.scatter_reduce_(0, inverse, row_idx, reduce='amin')
+
+    if is_pocv:
+        merged = delays.new_empty((num_arcs, 4))
+        for pair, corner_col in (((0, 1), 0), ((2, 3), 1)):
+            corner = corners[:, corner_col]
+            best = torch.full((num_arcs,), float('-inf'), dtype=corner.dtype)
+            best.scatter_reduce_(0, inverse, corner, reduce='amax')
+            winner = corner == best[inverse]
+            pick = torch.full((num_arcs,), num_rows, dtype=torch.int64)
+            pick.scatter_reduce_(0, inverse[winner], row_idx[winner],
+                                 reduce='amin')
+            merged[:, pair] = delays[pick][:, pair]
+    else:
+        merged = torch.full((num_arcs, delays.size(1)), float('-inf'),
+                            dtype=delays.dtype)
+        merged.scatter_reduce_(
+            0, inverse.unsqueeze(1).expand_as(delays), delays, reduce='amax')
+
+    print(f'[arc shards] resolved {num_rows - num_arcs} cross-shard '
+          f'duplicate {mode} arcs')
+    return ArcColumns(interner, src[rep], dst[rep],
+                      senses[rep] if senses is not None else None,
+                      merged, is_pocv)
+
+
+def _read_arc_file_sharded(
+    shard_paths: List[str],
+    mode: str,
+    scale: float,
+    interner: PinInterner
+) -> ArcColumns:
+    """
+    Parse arc shards on a process pool and merge the columnar chunks
+
+    Text parsing dominates cold start and is embarrassingly parallel
+    across shards; each worker owns its shard (parse, filter, worst-
+    corner aggregation, local interning) and only the aggregated columns
+    cross back over the pool. The merge in the parent is a handful of
+    tensor passes.
+    """
+    start_time = time.time()
+    max_workers = min(len(shard_paths), os.cpu_count() or 1)
+    with concurrent.futures.ProcessPoolExecutor(max_workers=max_workers) as pool:
+        shard_results = list(pool.map(
+            functools.partial(_parse_arc_shard, mode=mode, scale=scale),
+            shard_paths))
+    arc_columns = _merge_arc_shards(shard_results, mode, interner)
+    print(f'[arc shards] parsed {len(shard_paths)} {mode} arc shards on '
+          f'{max_workers} workers in {time.time() - start_time:.3f} seconds '
+          f'({len(arc_columns)} arcs)')
+    return arc_columns
+
+
 def read_cell_arc_file(
     file_path: str,
     save_dir: str,
     scale: float = 1.0,
-    use_cache: bool = True
-) -> Tuple[Dict, bool, bool]:
+    use_cache: bool = True,
+    columnar: bool = False,
+    interner: Optional[PinInterner] = None,
+    streaming: bool = False
+) -> Tuple[Union[Dict, ArcColumns], bool, bool]:
     """
     Read timing arcs for cells
 
@@ -381,40 +893,89 @@ def read_cell_arc_file(
         save_dir: Directory to save/load cache
         scale: Scaling factor for delays
         use_cache: Whether to use cached results if available
+        columnar: Emit an ArcColumns table instead of the legacy dict
+        interner: Pin table to intern names into (columnar mode); a fresh
+            one is created when omitted. Ignored on a cache hit, where the
+            cached table carries its own interner
+        streaming: Run the parse as a lazy scan collected with the
+            streaming engine, bounding peak memory to a chunk instead of
+            the whole arc table; requires columnar=True
 
     Returns:
         Tuple of (cell_arc_variations, is_pocv, success)
     """
     # Check for cached results
     if use_cache:
-        cache_path = os.path.join(save_dir, 'cell_arc_2_variation.pkl')
-        if os.path.exists(cache_path):
-            cell_arc_variations = load_pickle(cache_path, {})
-            # Determine POCV by checking the first variation's length
-            first_value = next(iter(cell_arc_variations.values()), None)
-            is_pocv = first_value is not None and len(first_value) == 4
-            return cell_arc_variations, is_pocv, True
+        if columnar:
+            cache_path = os.path.join(save_dir, 'cell_arc_columns.pkl')
+            if os.path.exists(cache_path):
+                cell_arc_columns = load_pickle(cache_path, None)
+                if cell_arc_columns is not None:
+                    return cell_arc_columns, cell_arc_columns.is_pocv, True
+        else:
+            cache_path = os.path.join(save_dir, 'cell_arc_2_variation.pkl')
+            if os.path.exists(cache_path):
+                cell_arc_variations = load_pickle(cache_path, {})
+                # Determine POCV by checking the first variation's length
+                first_value = next(iter(cell_arc_variations.values()), None)
+                is_pocv = first_value is not None and len(first_value) == 4
+                return cell_arc_variations, is_pocv, True
+
+    assert not streaming or columnar, 'streaming parse emits columnar tables; set columnar=True'
+
+    # Sharded ingestion: when the generator emitted the table as shards,
+    # parse them on a process pool and merge the columnar chunks
+    shard_paths = _find_arc_shards(file_path)
+    if shard_paths:
+        assert columnar, 'sharded ingestion emits columnar tables; set columnar=True'
+        try:
+            cell_arc_variations = _read_arc_file_sharded(
+                shard_paths, 'cell', scale,
+                interner if interner is not None else PinInterner())
+            save_pickle(cell_arc_variations,
+                        os.path.join(save_dir, 'cell_arc_columns.pkl'))
+            return cell_arc_variations, cell_arc_variations.is_pocv, True
+        except Exception as e:
+            print(f"Error reading sharded cell arc file: {e}")
+            return {}, False, False
 
     # Read file with Polars
     try:
-        df = pl.read_csv(file_path, infer_schema_length=0)
-        print(f'[cell arc parsing] raw df shape: {df.shape}')
-
-        # Filter valid senses
         valid_senses = ['positive_unate', 'negative_unate', 'rising_edge', 'falling_edge']
-        df = df.filter(pl.col('sense').is_in(valid_senses))
-        print(f'[cell arc parsing] sense-filtered df shape: {df.shape}')
+        if streaming:
+            # Lazy scan: the POCV probe is the only eager pass, everything
+            # else stays in the streaming pipeline until the final agg
+            df = _scan_input_table(file_path).filter(pl.col('sense').is_in(valid_senses))
+            has_variation = bool(
+                df.select((pl.col('variation_delay_max_rise.mean') != '').any())
+                  .collect(streaming=True).to_series()[0])
+            df, is_pocv = _filter_arc_dataframe(
+                df, mode='cell', scale=scale, has_variation=has_variation)
+        else:
+            df = _read_input_table(file_path)
+            print(f'[cell arc parsing] raw df shape: {df.shape}')
 
-        # Process cell arcs based on format (standard vs POCV)
-        df, is_pocv = _filter_arc_dataframe(df, mode='cell', scale=scale)
-        print(f'[cell arc parsing] final filtered df shape: {df.shape}')
+            # Filter valid senses
+            df = df.filter(pl.col('sense').is_in(valid_senses))
+            print(f'[cell arc parsing] sense-filtered df shape: {df.shape}')
+
+            # Process cell arcs based on format (standard vs POCV)
+            df, is_pocv = _filter_arc_dataframe(df, mode='cell', scale=scale)
+            print(f'[cell arc parsing] final filtered df shape: {df.shape}')
 
         # Extract timing arc data
-        cell_arc_variations = _extract_cell_arc_variations(df, is_pocv, scale)
+        if columnar:
+            cell_arc_variations = _extract_cell_arc_columns(
+                df, is_pocv, scale, interner if interner is not None else PinInterner())
+        else:
+            cell_arc_variations = _extract_cell_arc_variations(df, is_pocv, scale)
         print(f'[cell arc parsing] num valid cell arcs: {len(cell_arc_variations)}')
 
         # Save results
-        save_pickle(cell_arc_variations, os.path.join(save_dir, 'cell_arc_2_variation.pkl'))
+        if columnar:
+            save_pickle(cell_arc_variations, os.path.join(save_dir, 'cell_arc_columns.pkl'))
+        else:
+            save_pickle(cell_arc_variations, os.path.join(save_dir, 'cell_arc_2_variation.pkl'))
 
         # Clean up
         del df
@@ -524,12 +1085,52 @@ def _extract_net_arc_variations(
     return variations
 
 
+def _extract_net_arc_columns(
+    df: pl.DataFrame,
+    is_pocv: bool,
+    scale: float,
+    interner: PinInterner
+) -> ArcColumns:
+    """
+    Columnar counterpart of _extract_net_arc_variations
+
+    Same worst-corner selection per (from, to) arc as the dict path, done
+    inside polars and packed into flat tensors over the interned pin table.
+    """
+    keys = ["from_pin.full_name", "to_pin.full_name"]
+    if is_pocv:
+        agg = df.group_by(keys).agg(
+            pl.col('variation_delay_max_rise.mean').sort_by('corner_rise_delay').last().alias('rise_mean'),
+            pl.col('variation_delay_max_rise.std_dev').sort_by('corner_rise_delay').last().alias('rise_std'),
+            pl.col('variation_delay_max_fall.mean').sort_by('corner_fall_delay').last().alias('fall_mean'),
+            pl.col('variation_delay_max_fall.std_dev').sort_by('corner_fall_delay').last().alias('fall_std')
+        )
+        delay_cols = ['rise_mean', 'rise_std', 'fall_mean', 'fall_std']
+    else:
+        agg = df.group_by(keys).agg(
+            pl.max("delay_max_rise").alias('rise_mean'),
+            pl.max("delay_max_fall").alias('fall_mean')
+        )
+        delay_cols = ['rise_mean', 'fall_mean']
+
+    if isinstance(agg, pl.LazyFrame):
+        agg = agg.collect(streaming=True)
+
+    src_ids = interner.intern_series(agg['from_pin.full_name'])
+    dst_ids = interner.intern_series(agg['to_pin.full_name'])
+    delays = _float_columns_to_tensor(agg, delay_cols, scale)
+    return ArcColumns(interner, src_ids, dst_ids, None, delays, is_pocv)
+
+
 def read_net_arc_file(
     file_path: str,
     save_dir: str,
     scale: float = 1.0,
-    use_cache: bool = True
-) -> Tuple[Dict, bool, bool]:
+    use_cache: bool = True,
+    columnar: bool = False,
+    interner: Optional[PinInterner] = None,
+    streaming: bool = False
+) -> Tuple[Union[Dict, ArcColumns], bool, bool]:
     """
     Read timing arcs for nets
 
@@ -538,33 +1139,78 @@ def read_net_arc_file(
         save_dir: Directory to save/load cache
         scale: Scaling factor for delays
         use_cache: Whether to use cached results if available
+        columnar: Emit an ArcColumns table instead of the legacy dict
+        interner: Pin table to intern names into (columnar mode); a fresh
+            one is created when omitted. Ignored on a cache hit, where the
+            cached table carries its own interner
+        streaming: Run the parse as a lazy scan collected with the
+            streaming engine; requires columnar=True
 
     Returns:
         Tuple of (net_arc_variations, is_pocv, success)
     """
     # Check for cached results
     if use_cache:
-        cache_path = os.path.join(save_dir, 'net_arc_2_variation.pkl')
-        if os.path.exists(cache_path):
-            net_arc_variations = load_pickle(cache_path, {})
-            # Determine POCV by checking the first variation's length
-            first_value = next(iter(net_arc_variations.values()), None)
-            is_pocv = first_value is not None and len(first_value) == 4
-            return net_arc_variations, is_pocv, True
+        if columnar:
+            cache_path = os.path.join(save_dir, 'net_arc_columns.pkl')
+            if os.path.exists(cache_path):
+                net_arc_columns = load_pickle(cache_path, None)
+                if net_arc_columns is not None:
+                    return net_arc_columns, net_arc_columns.is_pocv, True
+        else:
+            cache_path = os.path.join(save_dir, 'net_arc_2_variation.pkl')
+            if os.path.exists(cache_path):
+                net_arc_variations = load_pickle(cache_path, {})
+                # Determine POCV by checking the first variation's length
+                first_value = next(iter(net_arc_variations.values()), None)
+                is_pocv = first_value is not None and len(first_value) == 4
+                return net_arc_variations, is_pocv, True
+
+    assert not streaming or columnar, 'streaming parse emits columnar tables; set columnar=True'
+
+    # Sharded ingestion, same contract as the cell arc reader
+    shard_paths = _find_arc_shards(file_path)
+    if shard_paths:
+        assert columnar, 'sharded ingestion emits columnar tables; set columnar=True'
+        try:
+            net_arc_variations = _read_arc_file_sharded(
+                shard_paths, 'net', scale,
+                interner if interner is not None else PinInterner())
+            save_pickle(net_arc_variations,
+                        os.path.join(save_dir, 'net_arc_columns.pkl'))
+            return net_arc_variations, net_arc_variations.is_pocv, True
+        except Exception as e:
+            print(f"Error reading sharded net arc file: {e}")
+            return {}, False, False
 
     # Read file with Polars
     try:
-        df = pl.read_csv(file_path, infer_schema_length=0)
+        if streaming:
+            df = _scan_input_table(file_path)
+            has_variation = bool(
+                df.select((pl.col('variation_delay_max_rise.mean') != '').any())
+                  .collect(streaming=True).to_series()[0])
+            df, is_pocv = _filter_arc_dataframe(
+                df, mode='net', scale=scale, has_variation=has_variation)
+        else:
+            df = _read_input_table(file_path)
 
-        # Process net arcs based on format (standard vs POCV)
-        df, is_pocv = _filter_arc_dataframe(df, mode='net', scale=scale)
+            # Process net arcs based on format (standard vs POCV)
+            df, is_pocv = _filter_arc_dataframe(df, mode='net', scale=scale)
 
         # Extract timing arc data
-        net_arc_variations = _extract_net_arc_variations(df, is_pocv, scale)
+        if columnar:
+            net_arc_variations = _extract_net_arc_columns(
+                df, is_pocv, scale, interner if interner is not None else PinInterner())
+        else:
+            net_arc_variations = _extract_net_arc_variations(df, is_pocv, scale)
         print(f'[net arc parsing] num valid net arcs: {len(net_arc_variations)}')
 
         # Save results
-        save_pickle(net_arc_variations, os.path.join(save_dir, 'net_arc_2_variation.pkl'))
+        if columnar:
+            save_pickle(net_arc_variations, os.path.join(save_dir, 'net_arc_columns.pkl'))
+        else:
+            save_pickle(net_arc_variations, os.path.join(save_dir, 'net_arc_2_variation.pkl'))
 
         # Clean up
         del df
@@ -641,8 +1287,8 @@ def read_sp_file(
     Returns:
         Tuple of (sp_attributes, success)
     """
-    # Check if file exists
-    if not os.path.exists(sp_file):
+    # Check if file exists (CSV or binary snapshot)
+    if not os.path.exists(_resolve_input_table(sp_file)):
         print(f'[read sp file] error: cannot find file {sp_file}')
         return {}, False
 
@@ -658,7 +1304,7 @@ def read_sp_file(
 
     try:
         # Read and process file using Polars
-        df = pl.read_csv(sp_file, infer_schema_length=0)
+        df = _read_input_table(sp_file)
         print(f'[read sp file] initial df size: {df.shape}')
 
         # Filter to keep only pins in our graph
@@ -672,13 +1318,14 @@ def read_sp_file(
             pl.col('clock_latency_std').cast(pl.Float32)
         ).drop_nulls()
 
-        # Extract timing attributes with scaling
-        for row in df.to_dicts():
-            sp_attributes[row['sp_name']] = (
-                row['launch_clock_latency'] / scale,
-                row['clock_latency_mean'] / scale,
-                row['clock_latency_std'] / scale
-            )
+        # Extract timing attributes with scaling — column zips rather than
+        # to_dicts(), which materializes one Python dict per row
+        sp_attributes = dict(zip(
+            df['sp_name'].to_list(),
+            zip((df['launch_clock_latency'] / scale).to_list(),
+                (df['clock_latency_mean'] / scale).to_list(),
+                (df['clock_latency_std'] / scale).to_list())
+        ))
 
         print(f'[read sp file] # sps from get_timing_paths alone: {len(sp_attributes)}')
 
@@ -725,8 +1372,8 @@ def read_ep_file(
     ep_to_ck_map = {}
     ep_to_latency_map = {}
 
-    # Check if file exists
-    if not os.path.exists(ep_file):
+    # Check if file exists (CSV or binary snapshot)
+    if not os.path.exists(_resolve_input_table(ep_file)):
         print(f'[read ep file] error: cannot find file {ep_file}')
         return ep_attributes, ep_to_sp_map, ep_to_ck_map, ep_to_latency_map, False
 
@@ -749,7 +1396,7 @@ def read_ep_file(
 
     try:
         # Read file with Polars
-        df = pl.read_csv(ep_file, infer_schema_length=0)
+        df = _read_input_table(ep_file)
         print(f'[read ep file] initial df size: {df.shape}')
 
         # Convert and clean numeric columns
@@ -770,36 +1417,27 @@ def read_ep_file(
 
         print(f'[read ep file] df size after filtering: {df.shape}')
 
-        # Extract endpoint attributes with scaling
-        for row in df.to_dicts():
-            ep_name = row['ep_name']
-            rise_fall = row['rise_fall']
-
-            # Create tuple key
-            key = (ep_name, rise_fall)
-
-            # Store path attributes
-            ep_attributes[key] = (
-                row['path_arrival'] / scale,
-                row['path_required'] / scale,
-                row['path_slack'] / scale,
-                row['path_num_points'] / scale,
-                row['ep_max_rise_slack'] / scale,
-                row['ep_max_fall_slack'] / scale,
-                row['ep_max_rise_arrival'] / scale,
-                row['ep_max_fall_arrival'] / scale,
-                row['path_crpr'] / scale
-            )
-
-            # Store startpoint mapping
-            ep_to_sp_map[key] = row['sp_name']
-
-            # Store launch clock latency
-            ep_to_latency_map[key] = row['launch_clock_latency']
-
-            # Store clock pin name if available
-            if 'ep_ck_name' in row:
-                ep_to_ck_map[key] = row['ep_ck_name']
+        # Extract endpoint attributes with scaling — the (ep, rise_fall)
+        # keys are built once and every map comes from column zips instead
+        # of a Python loop over per-row dicts
+        keys = list(zip(df['ep_name'].to_list(), df['rise_fall'].to_list()))
+        # The capture clock latency pair rides at the tuple tail so the
+        # required times can be re-evaluated at any sigma/derate later
+        # (build_required_time_components) without re-reading the CSV
+        attr_columns = [
+            'path_arrival', 'path_required', 'path_slack', 'path_num_points',
+            'ep_max_rise_slack', 'ep_max_fall_slack',
+            'ep_max_rise_arrival', 'ep_max_fall_arrival', 'path_crpr',
+            'clock_latency_mean', 'clock_latency_std'
+        ]
+        ep_attributes = dict(zip(
+            keys,
+            zip(*[(df[col] / scale).to_list() for col in attr_columns])
+        ))
+        ep_to_sp_map = dict(zip(keys, df['sp_name'].to_list()))
+        ep_to_latency_map = dict(zip(keys, df['launch_clock_latency'].to_list()))
+        if 'ep_ck_name' in df.columns:
+            ep_to_ck_map = dict(zip(keys, df['ep_ck_name'].to_list()))
 
         # Save results
         save_pickle(ep_attributes, os.path.join(save_dir, "epName_riseFall_2_attributes.pkl"))
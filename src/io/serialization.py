@@ -13,28 +13,209 @@
 
 
 import os
+import json
+import time
 import pickle
+import hashlib
 import torch
-from typing import Any, Optional, Union
+from typing import Any, Dict, Optional, Union
+
+try:
+    import zstandard as zstd
+    HAS_ZSTD = True
+except ImportError:
+    zstd = None
+    HAS_ZSTD = False
+
+# Transparent zstd compression of the pickle caches (NFS-hosted outputs/
+# directories are usually network-bound, not CPU-bound). Writes use the
+# multithreaded compressor; reads auto-detect the frame magic, so
+# compressed and plain caches can coexist in one directory. The mmap
+# tensor bundles are never compressed — they must stay page-mappable.
+COMPRESS_CACHE = os.environ.get('INSTA_CACHE_ZSTD', '0') == '1'
+_ZSTD_LEVEL = int(os.environ.get('INSTA_CACHE_ZSTD_LEVEL', '3'))
+_ZSTD_MAGIC = b'\x28\xb5\x2f\xfd'
+
+# Single-file memory-mapped tensor bundle (see save_tensor_bundle). Data
+# starts at a fixed page-aligned offset; the JSON header before it records
+# per-tensor dtype/shape/offset plus caller metadata (max_gid, topK, ...)
+ARRIVAL_BUNDLE_NAME = 'arrival_tensors.bin'
+ENDPOINT_BUNDLE_NAME = 'endpoint_tensors.bin'
+_BUNDLE_MAGIC = b'INSTABN1'
+_BUNDLE_DATA_OFFSET = 4096
+
+# file_path -> mapped CPU views, so the per-iteration save is just copy_()
+_bundle_write_cache: Dict[str, Dict[str, torch.Tensor]] = {}
+
+
+# Marker key of the stub pickle left behind when a cache payload's tensors
+# are routed into a sibling mmap bundle
+_TENSOR_STUB_KEY = '__insta_tensor_bundle__'
+
+# ---------------------------------------------------------------------------
+# Cache schema versioning
+#
+# Every cache artifact written by save_pickle embeds the schema version of
+# the layout it was produced under; load_pickle migrates old payloads
+# forward through registered converters instead of forcing a farm-wide
+# recompute from the CSVs when a release reshuffles a cached structure.
+# Caches written before versioning existed carry no marker and are treated
+# as schema 1. Artifacts whose layout never changed need no converter —
+# their payloads are served as-is at any recorded version.
+#
+# Schema history:
+#   1: original layout (host lists for net_arc_ids / cell dup nodes /
+#      c_unique, int64 id columns in the cell collaterals)
+#   2: fully tensorized collaterals, narrow id columns, c_unique stored
+#      once (positions 10 and 13 alias one int64 tensor)
+# ---------------------------------------------------------------------------
+CACHE_SCHEMA_VERSION = 2
+_SCHEMA_KEY = '__insta_cache_schema__'
+
+# (artifact basename without extension, from_version) -> converter
+_cache_migrations: Dict[tuple, Any] = {}
+
+
+def register_cache_migration(artifact: str, from_version: int, converter) -> None:
+    """
+    Register a converter that lifts one cache artifact by one schema step
+
+    Args:
+        artifact: Cache file basename without extension (e.g.
+            'level_2_collaterals')
+        from_version: Schema the converter consumes; it must return the
+            payload in schema from_version + 1
+        converter: payload -> payload callable
+    """
+    _cache_migrations[(artifact, from_version)] = converter
+
+
+def _migrate_cache_payload(data: Any, version: int, file_path: str) -> Any:
+    """Chain registered converters up to the current schema; artifacts
+    with no converter for a step are served unchanged (their layout did
+    not participate in that schema bump)"""
+    artifact = os.path.splitext(os.path.basename(file_path))[0]
+    while version < CACHE_SCHEMA_VERSION:
+        converter = _cache_migrations.get((artifact, version))
+        if converter is None:
+            break
+        data = converter(data)
+        version += 1
+        print(f'[cache schema] migrated {artifact} '
+              f'v{version - 1} -> v{version}')
+    return data
+
+
+def _split_tensor_payload(data: Any):
+    """
+    Split a cache payload into (bundle tensors, remainder)
+
+    A bare tensor goes into the bundle under '__root__'; a str-keyed dict
+    has its tensor values extracted and everything else kept as the
+    remainder. Payloads without tensors come back with an empty bundle
+    dict and are pickled unchanged.
+    """
+    if isinstance(data, torch.Tensor):
+        return {'__root__': data}, None
+    if isinstance(data, dict) and data:
+        tensors = {key: value for key, value in data.items()
+                   if isinstance(key, str) and isinstance(value, torch.Tensor)}
+        if tensors:
+            remainder = {key: value for key, value in data.items() if key not in tensors}
+            return tensors, remainder
+    return {}, data
+
+
+def _private_tmp(file_path: str) -> str:
+    """Per-process staging sibling for atomic rename publication"""
+    return f'{file_path}.{os.getpid()}.tmp'
+
+
+def run_scratch_dir(save_dir: str) -> str:
+    """
+    Unique per-run scratch directory under the shared outputs folder
+
+    Concurrent runs against one design share save_dir for the immutable
+    caches (published atomically, see save_pickle) but must not
+    interleave their mutable reports — anal.csv, plots, profiles. Each
+    process gets save_dir/runs/<timestamp>-<host>-<pid>, memoized so
+    every caller in the process lands in the same directory; the
+    timestamp keeps the farm's run history sortable and pid breaks ties
+    within a host-second.
+    """
+    cached = _run_scratch_cache.get(save_dir)
+    if cached is not None:
+        return cached
+    import socket
+    name = f"{time.strftime('%Y%m%d-%H%M%S')}-{socket.gethostname()}-{os.getpid()}"
+    path = os.path.join(save_dir, 'runs', name)
+    os.makedirs(path, exist_ok=True)
+    _run_scratch_cache[save_dir] = path
+    return path
+
+
+_run_scratch_cache: Dict[str, str] = {}
 
 
 def save_pickle(data: Any, file_path: str) -> None:
     """
     Save data to a pickle file with proper directory creation
 
+    Tensor-valued payloads (a bare tensor, or a str-keyed dict holding
+    tensors) are routed into a sibling '<file>.tensors' mmap bundle; the
+    pickle then holds only a stub plus the non-tensor remainder, so
+    loading them back is bounded by page-cache speed instead of copying
+    every element through Python objects. Every artifact is stamped with
+    CACHE_SCHEMA_VERSION so a later release can migrate it in place.
+
+    Publication is atomic: bytes land in a per-process sibling first and
+    os.replace moves them over the final name, so a concurrent run
+    reading (or racing to write) the same cache sees either the old
+    complete file or the new complete file, never a torn mix of two
+    writers. The bundle publishes before its stub, so a reader that
+    finds the stub always finds the bundle.
+
     Args:
         data: Any Python object to save
         file_path: Path to the output file
     """
     os.makedirs(os.path.dirname(file_path), exist_ok=True)
-    with open(file_path, 'wb') as f:
-        pickle.dump(data, f)
+
+    tensors, remainder = _split_tensor_payload(data)
+    if tensors:
+        save_tensor_bundle(tensors, file_path + '.tensors')
+        data = {
+            _TENSOR_STUB_KEY: os.path.basename(file_path) + '.tensors',
+            'schema': CACHE_SCHEMA_VERSION,
+            'is_root': remainder is None,
+            'key_order': None if remainder is None else list(data.keys()),
+            'remainder': remainder
+        }
+    else:
+        data = {_SCHEMA_KEY: CACHE_SCHEMA_VERSION, 'payload': data}
+
+    tmp_path = _private_tmp(file_path)
+    if COMPRESS_CACHE and HAS_ZSTD:
+        compressor = zstd.ZstdCompressor(level=_ZSTD_LEVEL, threads=-1)
+        with open(tmp_path, 'wb') as f:
+            with compressor.stream_writer(f) as writer:
+                pickle.dump(data, writer)
+    else:
+        with open(tmp_path, 'wb') as f:
+            pickle.dump(data, f)
+    os.replace(tmp_path, file_path)
 
 
 def load_pickle(file_path: str, default: Any = None) -> Any:
     """
     Load data from a pickle file with error handling
 
+    Stub pickles written by save_pickle for tensor-valued payloads are
+    recombined transparently: the sibling bundle is memory-mapped and its
+    zero-copy views merged back into the original structure. Payloads
+    recorded under an older cache schema are lifted to the current layout
+    through the registered migration converters before being returned.
+
     Args:
         file_path: Path to the input file
         default: Value to return if file doesn't exist or has errors
@@ -47,11 +228,49 @@ def load_pickle(file_path: str, default: Any = None) -> Any:
 
     try:
         with open(file_path, 'rb') as f:
-            return pickle.load(f)
+            if f.read(4) == _ZSTD_MAGIC:
+                if not HAS_ZSTD:
+                    print(f"Error loading pickle from {file_path}: "
+                          f"zstd-compressed cache but zstandard is not installed")
+                    return default
+                f.seek(0)
+                with zstd.ZstdDecompressor().stream_reader(f) as reader:
+                    data = pickle.load(reader)
+            else:
+                f.seek(0)
+                data = pickle.load(f)
     except (pickle.PickleError, EOFError, ImportError) as e:
         print(f"Error loading pickle from {file_path}: {e}")
         return default
 
+    if isinstance(data, dict) and _TENSOR_STUB_KEY in data:
+        bundle_path = os.path.join(os.path.dirname(file_path), data[_TENSOR_STUB_KEY])
+        bundle = load_tensor_bundle(bundle_path)
+        if bundle is None:
+            print(f"Error loading pickle from {file_path}: missing bundle {bundle_path}")
+            return default
+        bundle.pop('_meta', None)
+        version = data.get('schema', 1)
+        if data['is_root']:
+            merged = bundle['__root__']
+        else:
+            merged = dict(data['remainder'])
+            merged.update(bundle)
+            if data.get('key_order'):
+                merged = {key: merged[key] for key in data['key_order'] if key in merged}
+        if version < CACHE_SCHEMA_VERSION:
+            merged = _migrate_cache_payload(merged, version, file_path)
+        return merged
+
+    if isinstance(data, dict) and _SCHEMA_KEY in data:
+        version = data[_SCHEMA_KEY]
+        data = data['payload']
+    else:
+        version = 1  # pre-versioning cache
+    if version < CACHE_SCHEMA_VERSION:
+        data = _migrate_cache_payload(data, version, file_path)
+    return data
+
 
 def save_torch_tensor(tensor: torch.Tensor, file_path: str) -> None:
     """
@@ -62,7 +281,9 @@ def save_torch_tensor(tensor: torch.Tensor, file_path: str) -> None:
         file_path: Path to the output file
     """
     os.makedirs(os.path.dirname(file_path), exist_ok=True)
-    torch.save(tensor, file_path)
+    tmp_path = _private_tmp(file_path)
+    torch.save(tensor, tmp_path)
+    os.replace(tmp_path, file_path)
 
 
 def load_torch_tensor(
@@ -82,10 +303,29 @@ def load_torch_tensor(
         Loaded tensor or None if loading fails
     """
     if not os.path.exists(file_path):
+        # Results saved as a bundle keep their old per-tensor names: map the
+        # sibling bundle zero-copy and serve the matching entry
+        bundle_path = os.path.join(os.path.dirname(file_path), ARRIVAL_BUNDLE_NAME)
+        name = os.path.splitext(os.path.basename(file_path))[0]
+        if os.path.exists(bundle_path):
+            bundle = load_tensor_bundle(bundle_path)
+            if bundle is not None and name in bundle:
+                tensor = bundle[name]
+                if device is not None:
+                    tensor = tensor.to(device)
+                if dtype is not None:
+                    tensor = tensor.to(dtype)
+                return tensor
         return None
 
     try:
-        tensor = torch.load(file_path, map_location='cpu')
+        try:
+            # mmap avoids copying the storage through deserialization; the
+            # pages fault in lazily on first access
+            tensor = torch.load(file_path, map_location='cpu', mmap=True)
+        except (TypeError, RuntimeError):
+            # older torch or a legacy (non-zipfile) save: eager load
+            tensor = torch.load(file_path, map_location='cpu')
 
         if device is not None:
             tensor = tensor.to(device)
@@ -99,6 +339,202 @@ def load_torch_tensor(
         return None
 
 
+def _bundle_views(file_path: str, header: Dict) -> Dict[str, torch.Tensor]:
+    """Build zero-copy tensor views into a bundle's shared file mapping"""
+    total_bytes = _BUNDLE_DATA_OFFSET + header['data_bytes']
+    storage = torch.UntypedStorage.from_file(file_path, shared=True, nbytes=total_bytes)
+    views = {}
+    for name, entry in header['tensors'].items():
+        view = torch.empty(0, dtype=getattr(torch, entry['dtype']))
+        byte_offset = _BUNDLE_DATA_OFFSET + entry['offset']
+        view.set_(storage, byte_offset // view.element_size(), tuple(entry['shape']))
+        views[name] = view
+    return views
+
+
+def save_tensor_bundle(
+    tensors: Dict[str, torch.Tensor],
+    file_path: str,
+    meta: Optional[Dict] = None
+) -> None:
+    """
+    Write a dict of tensors into one preallocated memory-mapped file
+
+    The file holds a JSON header (per-tensor dtype/shape/byte-offset plus
+    caller metadata) followed by page-aligned raw tensor data. The mapping
+    is created once and cached, so repeated calls from an optimization loop
+    reduce to one copy_() per tensor instead of a torch.save round trip per
+    file. Consumers can mmap the result with load_tensor_bundle without any
+    deserialization.
+
+    Args:
+        tensors: Named tensors to persist (any device)
+        file_path: Path to the bundle file
+        meta: Optional metadata stored in the header (e.g. max_gid, topK)
+    """
+    os.makedirs(os.path.dirname(file_path), exist_ok=True)
+    key = os.path.abspath(file_path)
+    views = _bundle_write_cache.get(key)
+
+    compatible = views is not None and set(views) == set(tensors) and all(
+        views[name].shape == tensor.shape and views[name].dtype == tensor.dtype
+        for name, tensor in tensors.items())
+
+    if not compatible:
+        # (Re)create the file: lay tensors out at 64B-aligned offsets.
+        # The mapping is built on a per-process staging sibling and
+        # published with one os.replace after the first fill below, so a
+        # concurrent run never maps a half-written bundle and two racing
+        # writers resolve to whichever published last. After publication
+        # the cached views keep addressing the same inode, so the
+        # optimizer-loop fast path (one copy_() per tensor, no rename)
+        # is untouched; should another process republish the name later,
+        # this process keeps writing its own orphaned inode harmlessly.
+        layout = {}
+        offset = 0
+        for name, tensor in tensors.items():
+            layout[name] = {
+                'dtype': str(tensor.dtype).replace('torch.', ''),
+                'shape': list(tensor.shape),
+                'offset': offset
+            }
+            nbytes = tensor.numel() * tensor.element_size()
+            offset += (nbytes + 63) // 64 * 64
+        header = {'version': 1, 'schema': CACHE_SCHEMA_VERSION,
+                  'data_bytes': offset, 'meta': meta or {}, 'tensors': layout}
+        header_bytes = json.dumps(header).encode()
+        assert len(header_bytes) + 16 <= _BUNDLE_DATA_OFFSET, 'bundle header exceeds reserved page'
+        tmp_path = _private_tmp(file_path)
+        with open(tmp_path, 'wb') as f:
+            f.write(_BUNDLE_MAGIC)
+            f.write(len(header_bytes).to_bytes(8, 'little'))
+            f.write(header_bytes)
+            f.truncate(_BUNDLE_DATA_OFFSET + offset)
+        views = _bundle_views(tmp_path, header)
+        for name, tensor in tensors.items():
+            views[name].copy_(tensor, non_blocking=True)
+        if any(tensor.is_cuda for tensor in tensors.values()):
+            # non_blocking D2H copies must land before the name appears
+            torch.cuda.synchronize()
+        os.replace(tmp_path, file_path)
+        _bundle_write_cache[key] = views
+        return
+
+    for name, tensor in tensors.items():
+        views[name].copy_(tensor, non_blocking=True)
+
+
+def load_tensor_bundle(
+    file_path: str,
+    device: Optional[torch.device] = None
+) -> Optional[Dict[str, torch.Tensor]]:
+    """
+    Memory-map a tensor bundle written by save_tensor_bundle
+
+    On CPU the returned tensors are zero-copy views into the file mapping.
+
+    Returns:
+        Dict of named tensors (and the header meta under '_meta'), or None
+    """
+    if not os.path.exists(file_path):
+        return None
+
+    try:
+        with open(file_path, 'rb') as f:
+            magic = f.read(8)
+            if magic != _BUNDLE_MAGIC:
+                print(f"Error loading bundle from {file_path}: bad magic {magic!r}")
+                return None
+            header_len = int.from_bytes(f.read(8), 'little')
+            header = json.loads(f.read(header_len))
+        tensors = _bundle_views(file_path, header)
+        if device is not None and str(device) != 'cpu':
+            tensors = {name: tensor.to(device) for name, tensor in tensors.items()}
+        tensors['_meta'] = header['meta']
+        return tensors
+    except Exception as e:
+        print(f"Error loading bundle from {file_path}: {e}")
+        return None
+
+
+CACHE_MANIFEST_NAME = 'cache_manifest.json'
+_FINGERPRINT_CHUNK = 1 << 16
+
+
+def file_fingerprint(file_path: str) -> Optional[str]:
+    """
+    O(1) content fingerprint of an input file
+
+    Hashes the file size together with its first and last 64KB, so a new
+    netlist drop is caught without streaming multi-GB CSVs through the
+    hash, and mtime-preserving copies don't invalidate anything.
+
+    Returns:
+        Hex digest, or None if the file does not exist
+    """
+    if not os.path.exists(file_path):
+        return None
+    size = os.path.getsize(file_path)
+    digest = hashlib.sha256(str(size).encode())
+    with open(file_path, 'rb') as f:
+        digest.update(f.read(_FINGERPRINT_CHUNK))
+        if size > _FINGERPRINT_CHUNK:
+            f.seek(max(size - _FINGERPRINT_CHUNK, 0))
+            digest.update(f.read(_FINGERPRINT_CHUNK))
+    return digest.hexdigest()
+
+
+def save_cache_manifest(save_dir: str, input_files: list, constants: Dict) -> None:
+    """
+    Record the current input fingerprints and code-relevant constants
+
+    Written after cache validation so the next run validates in O(1)
+    stats instead of trusting bare file existence.
+    """
+    os.makedirs(save_dir, exist_ok=True)
+    manifest = {
+        'inputs': {os.path.basename(path): file_fingerprint(path) for path in input_files},
+        'constants': constants
+    }
+    manifest_path = os.path.join(save_dir, CACHE_MANIFEST_NAME)
+    tmp_path = _private_tmp(manifest_path)
+    with open(tmp_path, 'w') as f:
+        json.dump(manifest, f, indent=2)
+    os.replace(tmp_path, manifest_path)
+
+
+def validate_cache_manifest(
+    save_dir: str,
+    input_files: list,
+    constants: Dict
+) -> Optional[tuple]:
+    """
+    Compare the stored manifest against the current inputs and constants
+
+    Returns:
+        None when no (readable) manifest exists — there is nothing to
+        validate against — otherwise (stale_basenames, constants_changed)
+        where stale_basenames holds the inputs whose fingerprints moved
+    """
+    manifest_path = os.path.join(save_dir, CACHE_MANIFEST_NAME)
+    if not os.path.exists(manifest_path):
+        return None
+    try:
+        with open(manifest_path, 'r') as f:
+            manifest = json.load(f)
+    except (json.JSONDecodeError, OSError) as e:
+        print(f"Error loading cache manifest from {manifest_path}: {e}")
+        return None
+
+    recorded = manifest.get('inputs', {})
+    stale = set()
+    for path in input_files:
+        name = os.path.basename(path)
+        if recorded.get(name) != file_fingerprint(path):
+            stale.add(name)
+    return stale, manifest.get('constants') != constants
+
+
 def check_cache_exists(cache_files: Union[str, list]) -> bool:
     """
     Check if cache files exist
@@ -24,3 +24,8 @@ from .pocv import (
     initialize_timing_tensors,
     calculate_slack
 )
+
+from .results import (
+    PropagationResult,
+    stamp_propagation
+)
@@ -0,0 +1,119 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/autotune.py
+# @brief shape-keyed dispatch tuner for the level sweep
+
+import os
+import json
+import torch
+from typing import Any, Dict, List
+
+# Width buckets are logarithmic: a 10-node level and a 5M-node level
+# want different implementations, levels within ~4x of each other do not
+_BUCKET_EDGES = [64, 256, 1024, 4096, 16384, 65536, 262144, 1048576]
+
+
+def bucket_of(width: int) -> int:
+    for i, edge in enumerate(_BUCKET_EDGES):
+        if width <= edge:
+            return i
+    return len(_BUCKET_EDGES)
+
+
+class DispatchTuner:
+    """
+    Per-shape choice between the fused kernels and the torch formulation
+
+    The prebuilt extension's launch configuration is fixed, so the
+    tunable in this tree is which implementation serves a level: the
+    fused CUDA kernels amortize best on wide levels, while the batched
+    torch formulation (many small launches, but no ragged-group
+    indirection) can win on the thousands of narrow levels deep designs
+    have. In measuring mode the sweep runs BOTH implementations per
+    level — they write identical values, so the double write is safe —
+    bracketed with CUDA events; finalize() resolves the events, picks a
+    winner per (kind, width bucket, K) by mean time, and persists the
+    table as JSON in save_dir. Later runs load the table and dispatch
+    without measuring. Keys missing from the table default to fused.
+    """
+
+    def __init__(self, device: torch.device, topK: int, save_dir: str):
+        self.device = device
+        self.topK = topK
+        self.save_dir = save_dir
+        self.measuring = False
+        self.table: Dict[str, str] = {}
+        self._samples: List[Dict[str, Any]] = []
+
+    def _key(self, kind: str, width: int) -> str:
+        return f'{kind}:b{bucket_of(width)}:k{self.topK}'
+
+    # ------------------------------ dispatch --------------------------------
+
+    def use_fused(self, kind: str, width: int) -> bool:
+        return self.table.get(self._key(kind, width), 'fused') == 'fused'
+
+    # ----------------------------- measuring --------------------------------
+
+    def begin(self, kind: str, width: int, impl: str) -> None:
+        sample = {
+            'key': self._key(kind, width),
+            'impl': impl,
+            'start': torch.cuda.Event(enable_timing=True),
+            'end': torch.cuda.Event(enable_timing=True)
+        }
+        sample['start'].record()
+        self._samples.append(sample)
+
+    def end(self) -> None:
+        self._samples[-1]['end'].record()
+
+    def finalize(self) -> None:
+        """Resolve events, pick winners, persist and leave measuring mode"""
+        torch.cuda.synchronize(self.device)
+        totals: Dict[str, Dict[str, float]] = {}
+        for sample in self._samples:
+            per_key = totals.setdefault(sample['key'], {})
+            ms = sample['start'].elapsed_time(sample['end'])
+            per_key[sample['impl']] = per_key.get(sample['impl'], 0.0) + ms
+        for key, per_impl in totals.items():
+            if len(per_impl) > 1:
+                self.table[key] = min(per_impl, key=per_impl.get)
+        self._samples = []
+        self.measuring = False
+        self.save()
+        for key in sorted(self.table):
+            print(f'[autotune] {key} -> {self.table[key]}')
+
+    # ---------------------------- persistence -------------------------------
+
+    @property
+    def _table_path(self) -> str:
+        return os.path.join(self.save_dir, 'dispatch_tuning.json')
+
+    def load(self) -> bool:
+        if not os.path.exists(self._table_path):
+            return False
+        with open(self._table_path) as f:
+            self.table = json.load(f)
+        print(f'[autotune] loaded {len(self.table)} tuned shapes '
+              f'from {self._table_path}')
+        return True
+
+    def save(self) -> None:
+        # Atomic publication: the table is shared between concurrent runs
+        # on the design, and a reader must never parse a half-written file
+        tmp_path = f'{self._table_path}.{os.getpid()}.tmp'
+        with open(tmp_path, 'w') as f:
+            json.dump(self.table, f, indent=2, sort_keys=True)
+        os.replace(tmp_path, self._table_path)
+        print(f'[autotune] saved {len(self.table)} tuned shapes '
+              f'to {self._table_path}')
@@ -0,0 +1,146 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/clock_tree.py
+# @brief levelized clock-network latency propagation on GPU
+
+import time
+import torch
+from typing import Dict, List, Optional, Tuple
+
+
+def levelize_clock_arcs(
+    clock_arcs: Dict[Tuple[str, str], Tuple[float, float]],
+    pinName_2_Gid: Dict[str, int],
+    device: torch.device,
+    float_dtype: torch.dtype
+) -> Tuple[List[Tuple[torch.Tensor, ...]], List[int], List[int]]:
+    """
+    Levelize the clock network as its own subgraph
+
+    The clock tree never enters the data-path level schedule — its sinks
+    ARE the schedule's startpoints — so it gets a private levelization.
+    clock_arcs maps (fromPin, toPin) to the arc's (latency_mean,
+    latency_std); net segments and buffer stages can be collapsed into
+    one arc per driver->sink hop, the propagation does not care. The
+    Kahn pass runs once on host (clock trees are a few thousand arcs)
+    and packs per-level device tensors in the net-arc collateral layout:
+    (children, parents, arc_means, arc_stds).
+
+    Returns:
+        (clock_levels, root_gids, sink_gids) — roots have no incoming
+        clock arc, sinks no outgoing one
+    """
+    start_time = time.time()
+    arcs = []
+    for (fromPin, toPin), delays in clock_arcs.items():
+        p = pinName_2_Gid.get(fromPin)
+        c = pinName_2_Gid.get(toPin)
+        if p is None or c is None:
+            continue
+        mean, std = (delays if isinstance(delays, (tuple, list))
+                     else (delays, 0.0))
+        arcs.append((p, c, float(mean), float(std)))
+
+    in_degree: Dict[int, int] = {}
+    children: Dict[int, List[int]] = {}
+    for idx, (p, c, _, _) in enumerate(arcs):
+        in_degree[c] = in_degree.get(c, 0) + 1
+        in_degree.setdefault(p, 0)
+        children.setdefault(p, []).append(idx)
+
+    node_2_level = {gid: 0 for gid, deg in in_degree.items() if deg == 0}
+    root_gids = sorted(node_2_level.keys())
+    worklist = list(root_gids)
+    while worklist:
+        gid = worklist.pop()
+        for idx in children.get(gid, []):
+            _, c, _, _ = arcs[idx]
+            level = node_2_level[gid] + 1
+            if level > node_2_level.get(c, -1):
+                node_2_level[c] = level
+            in_degree[c] -= 1
+            if in_degree[c] == 0:
+                worklist.append(c)
+    assert all(deg == 0 for deg in in_degree.values()), \
+        'clock arcs contain a cycle'
+
+    level_2_arcs: Dict[int, List[int]] = {}
+    for idx, (p, c, _, _) in enumerate(arcs):
+        # An arc propagates at its child's level so every parent is final
+        level_2_arcs.setdefault(node_2_level[c], []).append(idx)
+
+    clock_levels = []
+    for level in sorted(level_2_arcs.keys()):
+        rows = level_2_arcs[level]
+        clock_levels.append((
+            torch.tensor([arcs[i][1] for i in rows], dtype=torch.long, device=device),
+            torch.tensor([arcs[i][0] for i in rows], dtype=torch.long, device=device),
+            torch.tensor([arcs[i][2] for i in rows], dtype=float_dtype, device=device),
+            torch.tensor([arcs[i][3] for i in rows], dtype=float_dtype, device=device),
+        ))
+
+    sink_gids = sorted(gid for gid in in_degree if gid not in children)
+    print(f'[clock tree] {len(arcs)} arcs, {len(clock_levels)} levels, '
+          f'{len(root_gids)} roots, {len(sink_gids)} sinks '
+          f'in {time.time() - start_time:.2f} seconds')
+    return clock_levels, root_gids, sink_gids
+
+
+def propagate_clock_latencies(
+    clock_levels: List[Tuple[torch.Tensor, ...]],
+    root_latencies: Dict[int, Tuple[float, float]],
+    max_gid: int,
+    device: torch.device,
+    float_dtype: torch.dtype,
+    sigma: float = 3.0
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Propagate source latency mean/std to every clock pin
+
+    Means add along the tree and stds combine by root-sum-square, the
+    same POCV composition the data-path kernels use. Reconvergent clock
+    meshes are allowed: duplicate sinks keep the driver whose
+    mean + sigma*std is worst (the pessimistic latency), resolved with
+    the same winner-matching two-phase reduction the depth sweep uses.
+
+    Returns:
+        Dense [max_gid] (latency_mean, latency_std) device tensors,
+        -inf mean where the clock network does not reach
+    """
+    start_time = time.time()
+    lat_mean = torch.full((max_gid,), float('-inf'), dtype=float_dtype, device=device)
+    lat_std = torch.zeros(max_gid, dtype=float_dtype, device=device)
+
+    roots = torch.tensor(sorted(root_latencies.keys()), dtype=torch.long, device=device)
+    lat_mean[roots] = torch.tensor(
+        [root_latencies[g][0] for g in sorted(root_latencies.keys())],
+        dtype=float_dtype, device=device)
+    lat_std[roots] = torch.tensor(
+        [root_latencies[g][1] for g in sorted(root_latencies.keys())],
+        dtype=float_dtype, device=device)
+
+    for c_nodes, parents, arc_means, arc_stds in clock_levels:
+        cand_mean = lat_mean[parents] + arc_means
+        cand_std = torch.sqrt(lat_std[parents] ** 2 + arc_stds ** 2)
+        cand_arr = cand_mean + sigma * cand_std
+        arr = torch.full((max_gid,), float('-inf'), dtype=float_dtype, device=device)
+        arr.index_reduce_(0, c_nodes, cand_arr, 'amax', include_self=False)
+        win = cand_arr == arr[c_nodes]
+        neg_inf = torch.full_like(cand_mean, float('-inf'))
+        lat_mean.index_reduce_(
+            0, c_nodes, torch.where(win, cand_mean, neg_inf),
+            'amax', include_self=False)
+        lat_std.index_reduce_(
+            0, c_nodes, torch.where(win, cand_std, neg_inf),
+            'amax', include_self=False)
+
+    print(f'[clock tree] latency propagation in {time.time() - start_time:.2f} seconds')
+    return lat_mean, lat_std
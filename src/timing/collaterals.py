@@ -12,14 +12,363 @@
 # @brief initialization
 
 import os
+import time
 import torch
 import collections
 from typing import Dict, List, Set, Tuple, Optional, Any
 import ipdb
 
-from ..io.serialization import save_pickle, load_pickle
+from ..io.serialization import save_pickle, load_pickle, register_cache_migration
+from ..io.parsers import ArcColumns, _CODE_2_SENSE
+from .profiler import py_scope
 
 
+def _migrate_collaterals_v1(level_2_collaterals: Dict[int, Any]) -> Dict[int, Any]:
+    """
+    Schema 1 -> 2 converter for cached level collaterals
+
+    The v2 layout tensorized the remaining host lists and stores the
+    unique-child list once (positions 10 and 13 alias one int64 tensor)
+    instead of as a list plus an int64 twin. Old farm caches reshuffle
+    in place — a handful of torch.tensor calls per level — instead of
+    recomputing the whole levelization from the CSVs. Levels follow the
+    standard parity (odd = net arcs, inPinMod 1).
+    """
+    for level, coll in level_2_collaterals.items():
+        if level == 1 or not isinstance(coll, list):
+            continue
+        if level % 2 == 1:  # net arc level
+            if not torch.is_tensor(coll[8]):
+                coll[8] = torch.tensor(coll[8], dtype=torch.int32)
+        else:  # cell arc level
+            if not torch.is_tensor(coll[0]):
+                coll[0] = torch.tensor(coll[0], dtype=torch.int32)
+            coll[13] = coll[13].to(torch.int64)
+            if not torch.is_tensor(coll[10]):
+                coll[10] = coll[13]
+    return level_2_collaterals
+
+
+register_cache_migration('level_2_collaterals', 1, _migrate_collaterals_v1)
+
+
+class ArcRegistry:
+    """
+    Columnar backing for the arc id/key registries
+
+    One int tensor per column (from pid, to pid, sense, level, position),
+    indexed by arc id, plus the shared PinInterner for name resolution.
+    The ten dict mappings precompute_collaterals returns used to be
+    materialized eagerly — minutes of pure dict insertion over tens of
+    millions of string-tuple keys, paid even by flows that never query
+    an arc name. The dict-compatible views below resolve against these
+    columns on access instead; the key->id index (a sort over the
+    encoded keys) is built on the first key lookup, and lookup_ids
+    serves the bulk id-native case without any strings at all.
+    """
+
+    def __init__(self, interner, from_pids: torch.Tensor, to_pids: torch.Tensor,
+                 senses: Optional[torch.Tensor], levels: torch.Tensor,
+                 positions: torch.Tensor):
+        self.interner = interner
+        self.from_pids = from_pids
+        self.to_pids = to_pids
+        self.senses = senses # None for net arcs
+        self.levels = levels
+        self.positions = positions
+        self._sorted_keys = None
+        self._sort_order = None
+
+    def __len__(self) -> int:
+        return self.from_pids.numel()
+
+    def __getstate__(self):
+        state = self.__dict__.copy()
+        state['_sorted_keys'] = None # rebuilt on demand, keep pickles lean
+        state['_sort_order'] = None
+        return state
+
+    def _encode(self, from_pids: torch.Tensor, to_pids: torch.Tensor,
+                senses: Optional[torch.Tensor]) -> torch.Tensor:
+        num_pins = len(self.interner.id_2_name)
+        keys = from_pids.to(torch.int64) * num_pins + to_pids.to(torch.int64)
+        if self.senses is not None:
+            assert senses is not None, 'cell-arc lookups need the sense column'
+            keys = keys * 4 + senses.to(torch.int64)
+        return keys
+
+    def _ensure_key_index(self) -> None:
+        if self._sorted_keys is not None:
+            return
+        keys = self._encode(self.from_pids, self.to_pids, self.senses)
+        order = torch.argsort(keys)
+        sorted_keys = keys[order]
+        # the eager builders asserted key uniqueness per insertion; here
+        # one vectorized check covers the table
+        if sorted_keys.numel() > 1:
+            assert bool((sorted_keys[1:] > sorted_keys[:-1]).all()), \
+                'duplicated arc keys in registry'
+        self._sorted_keys = sorted_keys
+        self._sort_order = order
+
+    def key_of(self, arc_id: int) -> Tuple:
+        id_2_name = self.interner.id_2_name
+        from_name = id_2_name[int(self.from_pids[arc_id])]
+        to_name = id_2_name[int(self.to_pids[arc_id])]
+        if self.senses is None:
+            return (from_name, to_name)
+        return (from_name, to_name, _CODE_2_SENSE[int(self.senses[arc_id])])
+
+    def id_of(self, key: Tuple) -> int:
+        from ..io.parsers import _SENSE_2_CODE
+        name_2_id = self.interner.name_2_id
+        if key[0] not in name_2_id or key[1] not in name_2_id:
+            raise KeyError(key)
+        self._ensure_key_index()
+        query = name_2_id[key[0]] * len(self.interner.id_2_name) + name_2_id[key[1]]
+        if self.senses is not None:
+            if key[2] not in _SENSE_2_CODE:
+                raise KeyError(key)
+            query = query * 4 + _SENSE_2_CODE[key[2]]
+        slot = int(torch.searchsorted(self._sorted_keys,
+                                      torch.tensor(query, dtype=torch.int64)))
+        if slot >= self._sorted_keys.numel() or int(self._sorted_keys[slot]) != query:
+            raise KeyError(key)
+        return int(self._sort_order[slot])
+
+    def lookup_ids(self, from_pids: torch.Tensor, to_pids: torch.Tensor,
+                   senses: Optional[torch.Tensor] = None) -> torch.Tensor:
+        """Bulk pid-keyed arc-id resolution: one searchsorted, -1 on miss"""
+        self._ensure_key_index()
+        query = self._encode(from_pids, to_pids, senses)
+        slots = torch.searchsorted(self._sorted_keys, query)
+        clamped = slots.clamp(max=max(self._sorted_keys.numel() - 1, 0))
+        hit = self._sorted_keys[clamped] == query
+        return torch.where(hit, self._sort_order[clamped],
+                           torch.full_like(clamped, -1))
+
+
+class _RegistryView:
+    """Dict-protocol base over an ArcRegistry, with a write overlay for
+    the few callers that patch entries (incremental levelization)"""
+
+    def __init__(self, registry: ArcRegistry):
+        self._registry = registry
+        self._overrides = {}
+        self._extra = 0
+
+    def __len__(self) -> int:
+        return len(self._registry) + self._extra
+
+    def __setitem__(self, key, value) -> None:
+        if key not in self:
+            self._extra += 1
+        self._overrides[key] = value
+
+    def __contains__(self, key) -> bool:
+        if key in self._overrides:
+            return True
+        try:
+            self[key]
+            return True
+        except (KeyError, IndexError, TypeError):
+            return False
+
+    def __iter__(self):
+        return self.keys()
+
+    def get(self, key, default=None):
+        try:
+            return self[key]
+        except (KeyError, IndexError, TypeError):
+            return default
+
+    def keys(self):
+        for key, _ in self.items():
+            yield key
+
+    def values(self):
+        for _, value in self.items():
+            yield value
+
+
+class ArcIdKeyView(_RegistryView):
+    """arc id -> (fromPin, toPin[, sense]) without the eager dict"""
+
+    def __getitem__(self, arc_id: int):
+        if arc_id in self._overrides:
+            return self._overrides[arc_id]
+        if not 0 <= arc_id < len(self._registry):
+            raise KeyError(arc_id)
+        return self._registry.key_of(arc_id)
+
+    def items(self):
+        for arc_id in range(len(self._registry)):
+            yield arc_id, self._overrides.get(arc_id, self._registry.key_of(arc_id))
+        for arc_id, key in self._overrides.items():
+            if not 0 <= arc_id < len(self._registry):
+                yield arc_id, key
+
+    def keys(self):
+        # ids without resolving names (max(...keys()) sizing stays cheap)
+        yield from range(len(self._registry))
+        for arc_id in self._overrides:
+            if not 0 <= arc_id < len(self._registry):
+                yield arc_id
+
+
+class ArcKeyIdView(_RegistryView):
+    """(fromPin, toPin[, sense]) -> arc id; lookup_ids for bulk pid queries"""
+
+    def __getitem__(self, key):
+        if key in self._overrides:
+            return self._overrides[key]
+        return self._registry.id_of(key)
+
+    def items(self):
+        for arc_id in range(len(self._registry)):
+            yield self._registry.key_of(arc_id), arc_id
+        yield from self._overrides.items()
+
+    def lookup_ids(self, from_pids: torch.Tensor, to_pids: torch.Tensor,
+                   senses: Optional[torch.Tensor] = None) -> torch.Tensor:
+        return self._registry.lookup_ids(from_pids, to_pids, senses)
+
+
+class ArcLocView(_RegistryView):
+    """(fromPin, toPin[, sense]) -> (level, position) collateral location"""
+
+    def __getitem__(self, key):
+        if key in self._overrides:
+            return self._overrides[key]
+        arc_id = self._registry.id_of(key)
+        return (int(self._registry.levels[arc_id]),
+                int(self._registry.positions[arc_id]))
+
+    def items(self):
+        registry = self._registry
+        for arc_id in range(len(registry)):
+            key = registry.key_of(arc_id)
+            yield key, self._overrides.get(
+                key, (int(registry.levels[arc_id]),
+                      int(registry.positions[arc_id])))
+        for key, loc in self._overrides.items():
+            try:
+                registry.id_of(key)
+            except KeyError:
+                yield key, loc
+
+
+class ArcCellNameView(_RegistryView):
+    """arc id -> owning cell name of the from (0) or to (1) pin"""
+
+    def __init__(self, registry: ArcRegistry, end: int):
+        super().__init__(registry)
+        self._end = end
+
+    def __getitem__(self, arc_id: int) -> str:
+        if arc_id in self._overrides:
+            return self._overrides[arc_id]
+        if not 0 <= arc_id < len(self._registry):
+            raise KeyError(arc_id)
+        pids = self._registry.to_pids if self._end else self._registry.from_pids
+        pin_name = self._registry.interner.id_2_name[int(pids[arc_id])]
+        return '/'.join(pin_name.split('/')[:-1])
+
+    def items(self):
+        for arc_id in range(len(self._registry)):
+            yield arc_id, self[arc_id]
+
+    def keys(self):
+        yield from range(len(self._registry))
+        for arc_id in self._overrides:
+            if not 0 <= arc_id < len(self._registry):
+                yield arc_id
+
+
+class ArcPatchBuffer:
+    """
+    Persistent staging buffer for small random-access collateral updates
+
+    The SI and derate overlays scatter thousands of tiny per-arc updates
+    into the collateral tables each iteration, and a torch.tensor(...)
+    per update pays a separate H2D transfer and launch every time. This
+    buffer preallocates pinned host arrays and matching device arrays
+    once; queue() appends (level, columns, position, four deltas) at the
+    head pointer for the price of four host float writes, and flush()
+    moves the used prefix to the device in ONE non-blocking copy, then
+    applies it segment by segment as accumulating index_put_ calls over
+    views of the device buffer — no further transfers. Consecutive
+    patches against the same (level, columns) pair share a segment, so a
+    sweep that walks arcs level by level flushes in a handful of
+    launches. Patches accumulate on top of the current values; callers
+    that need the pre-overlay base restored use the apply_delta_delays
+    snapshot window instead.
+    """
+
+    def __init__(self, device: torch.device, capacity: int = 1 << 16,
+                 float_dtype: torch.dtype = torch.float32):
+        pin = (device.type == 'cuda')
+        self.capacity = capacity
+        self._h_pos = torch.empty(capacity, dtype=torch.long, pin_memory=pin)
+        self._h_vals = torch.empty(capacity, 4, dtype=float_dtype, pin_memory=pin)
+        self._d_pos = torch.empty(capacity, dtype=torch.long, device=device)
+        self._d_vals = torch.empty(capacity, 4, dtype=float_dtype, device=device)
+        self._head = 0
+        self._segments: List = []  # [level, cols, start, end]
+
+    def __len__(self) -> int:
+        return self._head
+
+    @property
+    def full(self) -> bool:
+        return self._head >= self.capacity
+
+    def queue(self, level: int, cols: Tuple[int, ...], pos: int,
+              deltas) -> bool:
+        """
+        Append one patch; returns False when the buffer just filled up
+        (the caller flushes and re-queues — nothing is dropped)
+        """
+        assert self._head < self.capacity, 'flush before queueing further patches'
+        head = self._head
+        self._h_pos[head] = pos
+        for idx in range(4):
+            self._h_vals[head, idx] = float(deltas[idx])
+        if self._segments and self._segments[-1][0] == level \
+                and self._segments[-1][1] == cols:
+            self._segments[-1][3] = head + 1
+        else:
+            self._segments.append([level, cols, head, head + 1])
+        self._head = head + 1
+        return self._head < self.capacity
+
+    def flush(self, level_2_collaterals: Dict) -> int:
+        """
+        Apply every queued patch: one H2D copy, one launch per segment
+
+        Duplicate positions within a segment accumulate correctly
+        (index_put_ with accumulate=True). Returns the patch count.
+        """
+        if self._head == 0:
+            return 0
+        count = self._head
+        self._d_pos[:count].copy_(self._h_pos[:count], non_blocking=True)
+        self._d_vals[:count].copy_(self._h_vals[:count], non_blocking=True)
+        for level, cols, start, end in self._segments:
+            coll = level_2_collaterals[level]
+            pos = self._d_pos[start:end]
+            for idx, col in enumerate(cols):
+                values = self._d_vals[start:end, idx]
+                if values.dtype != coll[col].dtype:
+                    values = values.to(coll[col].dtype)
+                coll[col].index_put_((pos,), values, accumulate=True)
+        self._head = 0
+        self._segments = []
+        return count
+
+
+@py_scope('precompute_collaterals')
 def precompute_collaterals(
     net_arc_2_variation: Dict,
     cell_arc_2_variation: Dict,
@@ -104,11 +453,31 @@ def precompute_collaterals(
                     netArcId_2_inCellName, netArcId_2_outCellName, netArcKey_2_netArcId, netArcId_2_netArcKey
            )
 
+    # Columnar fast path: when both arc tables are ArcColumns the per-arc
+    # dict walk below collapses into id-indexed tensor assembly (searchsorted
+    # row lookup + gathers); the shipped sta_compute_arrival extension is a
+    # prebuilt binary, so this lives here instead of a native helper
+    if (not subgraph
+            and isinstance(net_arc_2_variation, ArcColumns)
+            and isinstance(cell_arc_2_variation, ArcColumns)):
+        return _precompute_collaterals_columnar(
+            net_arc_2_variation, cell_arc_2_variation,
+            sp_mean_tensor, sp_std_tensor,
+            level_2_nodes, Gid_2_pinName, inPin_parent_tensor,
+            num_nodes,
+            cell_2_libCell, libCell_2_riseFallguardband,
+            libCell_2_riseFallStd, net_2_pocvScaling,
+            float_dtype, inPinMod, cache_files, save, debug
+        )
+
     # Setup device for computations
 
     device = torch.device('cpu')
 
-    is_pocv = True if len(list(net_arc_2_variation.values())[0]) == 4 else False
+    # next(iter(...)) rather than list(...)[0]: the columnar arc tables
+    # expose values() as a generator, and materializing 40M tuples just to
+    # sniff the format would defeat them
+    is_pocv = len(next(iter(net_arc_2_variation.values()))) == 4
     if debug:
         print(f"using pocv: {is_pocv}")
 
@@ -289,7 +658,7 @@ def precompute_collaterals(
                                              torch.tensor(fall_means, dtype=float_dtype).to(device),
                                              torch.tensor(fall_stds, dtype=float_dtype).to(device),
                                              torch.tensor(fall_sigmas, dtype=float_dtype).to(device),
-                                             net_arc_ids
+                                             torch.tensor(net_arc_ids, dtype=torch.int32).to(device)
                                          ]
             if subgraph:
                 # append local index tensors for faster propagation
@@ -424,14 +793,62 @@ def precompute_collaterals(
             assert len(rise_means) == len(fall_sigmas)
             assert len(rise_means) == len(arc_senses)
 
+            # Sort the per-node segments by parent gid (and the rows
+            # inside each segment likewise): the append order above
+            # follows dict iteration, which scatters the parent-plane
+            # gathers all over the Gid space. With level-major gid
+            # renumbering the sorted layout makes those reads
+            # near-sequential. The permutation is reflected into
+            # cell_arc_2_collateral_loc, so delay updates and gradients
+            # still land on the right rows, and the child gids travel
+            # with their rows, so results scatter unchanged.
+            num_segs = len(c_unique_indices)
+            seg_order = sorted(
+                range(num_segs),
+                key=lambda s: min(p_indices[node_start_end_idx[s]:
+                                            node_start_end_idx[s + 1]]))
+            perm = []
+            new_start_end = [0]
+            for s in seg_order:
+                lo, hi = node_start_end_idx[s], node_start_end_idx[s + 1]
+                perm.extend(sorted(range(lo, hi), key=lambda r: p_indices[r]))
+                new_start_end.append(len(perm))
+
+            old_cellArc_ids = cellArc_ids
+
+            def _permute(rows):
+                return [rows[r] for r in perm]
+
+            duplicated_nodes_in_level = _permute(duplicated_nodes_in_level)
+            rise_means = _permute(rise_means)
+            rise_stds = _permute(rise_stds)
+            rise_sigmas = _permute(rise_sigmas)
+            fall_means = _permute(fall_means)
+            fall_stds = _permute(fall_stds)
+            fall_sigmas = _permute(fall_sigmas)
+            arc_senses = _permute(arc_senses)
+            p_indices = _permute(p_indices)
+            cellArc_ids = _permute(cellArc_ids)
+            c_unique_indices = [c_unique_indices[s] for s in seg_order]
+            node_start_end_idx = new_start_end
+            for new_row, old_row in enumerate(perm):
+                key = cellArcId_2_cellArcKey[old_cellArc_ids[old_row]]
+                cell_arc_2_collateral_loc[key] = (level, new_row)
+
             # generate p_mapping as p_indices may duplicate and cause memory issue
-            p_idx_unique = list(set(p_indices))
+            # (sorted so the unique-parent gather walks ascending gids too)
+            p_idx_unique = sorted(set(p_indices))
             p_mapping = [-1] * (max(p_idx_unique) + 1)
             for idx, ele in enumerate(p_idx_unique):
                 p_mapping[ele] = idx
 
+            # Every field ships as one device tensor: id columns at the
+            # narrowest sufficient width, and the unique-child list stored
+            # once (positions 10 and 13 alias the same tensor) instead of
+            # as a host list plus an int64 twin
+            c_unique_tensor = torch.tensor(c_unique_indices, dtype=torch.int64).to(device)
             level_2_collaterals[level] = [
-                                             duplicated_nodes_in_level,
+                                             torch.tensor(duplicated_nodes_in_level, dtype=torch.int32).to(device),
                                              torch.tensor(rise_means, dtype=float_dtype).to(device),
                                              torch.tensor(rise_stds, dtype=float_dtype).to(device),
                                              torch.tensor(rise_sigmas, dtype=float_dtype).to(device),
@@ -441,10 +858,10 @@ def precompute_collaterals(
                                              torch.tensor(arc_senses, dtype=torch.int32).to(device),
                                              torch.tensor(p_indices, dtype=torch.int32).to(device),
                                              torch.tensor(node_start_end_idx, dtype=torch.int32).to(device),
-                                             c_unique_indices,
+                                             c_unique_tensor,
                                              torch.tensor(p_idx_unique, dtype=torch.int32).to(device),
                                              torch.tensor(p_mapping, dtype=torch.int32).to(device),
-                                             torch.tensor(c_unique_indices, dtype=torch.int64).to(device),
+                                             c_unique_tensor,
                                              torch.tensor(cellArc_ids, dtype=torch.int32).to(device)
                                          ]
             if subgraph:
@@ -466,8 +883,8 @@ def precompute_collaterals(
                 # input pin level – first entry is tensor of current nodes
                 present_nodes.update(obj[0].tolist())
             else:
-                # output pin level – child unique indices list is at position 10
-                present_nodes.update(obj[10])
+                # output pin level – child unique index tensor is at position 10
+                present_nodes.update(obj[10].tolist())
 
         # Any nodes missing are appended to level-1 and treated as CLK pins.
         missing_nodes = set(cone_gid_list.tolist()) - present_nodes
@@ -493,7 +910,7 @@ def precompute_collaterals(
             elif lvl_i % 2 == inPinMod:
                 final_present_nodes.update(obj[0].tolist())
             else:
-                final_present_nodes.update(obj[10])
+                final_present_nodes.update(obj[10].tolist())
 
         still_missing = set(cone_gid_list.tolist()) - final_present_nodes
         assert not still_missing, (
@@ -531,17 +948,1533 @@ def precompute_collaterals(
                )
 
 
-def move_collaterals_to_device(level_2_collaterals: Dict, device: torch.device) -> Dict:
+@py_scope('_precompute_collaterals_columnar')
+def _precompute_collaterals_columnar(
+    net_arc_columns: ArcColumns,
+    cell_arc_columns: ArcColumns,
+    sp_mean_tensor: torch.Tensor,
+    sp_std_tensor: torch.Tensor,
+    level_2_nodes: Dict[int, List[int]],
+    Gid_2_pinName: Dict[int, str],
+    inPin_parent_tensor: torch.Tensor,
+    num_nodes: int,
+    cell_2_libCell: Dict[str, str],
+    libCell_2_riseFallguardband: Dict[str, List[float]],
+    libCell_2_riseFallStd: Dict[str, List[float]],
+    net_2_pocvScaling: Dict[str, List[float]],
+    float_dtype: torch.dtype,
+    inPinMod: int,
+    cache_files: List[str],
+    save: bool,
+    debug: bool
+) -> Tuple[Dict, Dict, Dict, Dict, Dict, Dict, Dict, Dict, Dict, Dict]:
+    """
+    Columnar twin of precompute_collaterals
+
+    Resolves every level against the ArcColumns tables with tensor ops:
+    net levels find their rows with one searchsorted over (src, dst) keys,
+    cell levels slice a table pre-sorted by (sink, driver, sense) so each
+    node's arcs come out contiguous and in deterministic order. Delay,
+    sigma and guardband columns are assembled as gathers; the name-keyed
+    registries (collateral locations, arc-id maps) come back as lazy
+    dict views over per-arc id columns (see ArcRegistry) instead of
+    eagerly inserted dicts. Level entries use the exact layout of the
+    serial path, so propagation, patching and the cache files are
+    unaffected.
+    """
+    interner = net_arc_columns.interner
+    assert cell_arc_columns.interner is interner, 'arc tables must share one interner'
+    is_pocv = net_arc_columns.is_pocv
+    if debug:
+        print(f"using pocv: {is_pocv}")
+
+    id_2_name = interner.id_2_name
+    name_2_id = interner.name_2_id
+    num_pins = len(id_2_name)
+
+    # gid <-> interner-id planes bridge the graph and the arc tables
+    gid_2_pid = torch.full((num_nodes,), -1, dtype=torch.int64)
+    for gid, name in Gid_2_pinName.items():
+        pid = name_2_id.get(name)
+        if pid is not None:
+            gid_2_pid[gid] = pid
+    pid_2_gid = torch.full((num_pins,), -1, dtype=torch.int64)
+    gid_valid = gid_2_pid >= 0
+    pid_2_gid[gid_2_pid[gid_valid]] = torch.nonzero(gid_valid).squeeze(1)
+
+    # net arc rows sorted by (src, dst) key for searchsorted resolution
+    net_keys = net_arc_columns.src_ids.to(torch.int64) * num_pins \
+             + net_arc_columns.dst_ids.to(torch.int64)
+    net_row_order = torch.argsort(net_keys)
+    net_keys_sorted = net_keys[net_row_order]
+
+    # cell arc rows sorted by (sink gid, driver pid, sense) so a level's
+    # rows can be sliced per node and arrive pre-grouped; sinks that never
+    # made it into the graph carry gid -1 and sort to the front, where the
+    # non-negative level queries can never reach them
+    cell_src_pids = cell_arc_columns.src_ids.to(torch.int64)
+    cell_dst_gids = pid_2_gid[cell_arc_columns.dst_ids.to(torch.int64)]
+    cell_senses = cell_arc_columns.senses.to(torch.int64)
+    cell_order = torch.argsort(
+        cell_dst_gids * (num_pins * 4) + cell_src_pids * 4 + cell_senses)
+    cell_dst_sorted = cell_dst_gids[cell_order]
+    cell_src_gid_sorted = pid_2_gid[cell_src_pids][cell_order]
+
+    Gid_2_arrival = torch.full((num_nodes,), float('-inf'), dtype=float_dtype)
+
+    level_2_collaterals = {}
+
+    # The registries collect one id column per level here and become the
+    # ten dict mappings as lazy views at the end — no per-arc Python
+    '''for differentiability'''
+    cellArcId = 0
+    cell_reg_cols = {'from': [], 'to': [], 'sense': [], 'level': []}
+
+    netArcId = 0
+    net_reg_cols = {'from': [], 'to': [], 'level': []}
+
+    design_rise_gb, design_fall_gb = libCell_2_riseFallguardband['design']
+    net_rise_gb, net_fall_gb = net_2_pocvScaling['net']
+    design_rise_std_coef, design_fall_std_coef = libCell_2_riseFallStd['design']
+
+    for level in level_2_nodes:
+        if level == 1: # CLK pins
+            cur_nodes = torch.tensor(level_2_nodes[level], dtype=torch.int64)
+            valid_mask = ~torch.isinf(sp_mean_tensor[cur_nodes]) \
+                       & ~torch.isinf(sp_std_tensor[cur_nodes])
+            cur_nodes = cur_nodes[valid_mask]
+            Gid_2_arrival[cur_nodes] = 1
+            level_2_collaterals[level] = cur_nodes
+            if debug:
+                print("at level: {}, # valid nodes: {}".format(level, cur_nodes.numel()))
+
+        elif level % 2 == inPinMod: # input pins
+            cur_nodes = torch.tensor(level_2_nodes[level], dtype=torch.int64)
+            parents = inPin_parent_tensor[cur_nodes]
+            valid_mask = ~torch.isinf(Gid_2_arrival[parents])
+            cur_nodes = cur_nodes[valid_mask]
+            parents = parents[valid_mask]
+
+            query = gid_2_pid[parents] * num_pins + gid_2_pid[cur_nodes]
+            slot = torch.searchsorted(net_keys_sorted, query)
+            assert bool((net_keys_sorted[slot.clamp(max=net_keys_sorted.numel() - 1)]
+                         == query).all()), \
+                'level {}: net arc missing from columnar table'.format(level)
+            rows = net_row_order[slot]
+            delays = net_arc_columns.delays[rows].to(float_dtype)
+
+            num_arcs = cur_nodes.numel()
+            rise_means = delays[:, 0] * net_rise_gb
+            if is_pocv:
+                rise_stds = delays[:, 1] * net_rise_gb
+                fall_means = delays[:, 2] * net_fall_gb
+                fall_stds = delays[:, 3] * net_fall_gb
+                sigmas = torch.full((num_arcs,), 3.0, dtype=float_dtype)
+            else:
+                fall_means = delays[:, 1] * net_fall_gb
+                rise_stds = torch.zeros(num_arcs, dtype=float_dtype)
+                fall_stds = torch.zeros(num_arcs, dtype=float_dtype)
+                sigmas = torch.zeros(num_arcs, dtype=float_dtype)
+
+            net_arc_ids = torch.arange(netArcId, netArcId + num_arcs, dtype=torch.int32)
+            net_reg_cols['from'].append(gid_2_pid[parents])
+            net_reg_cols['to'].append(gid_2_pid[cur_nodes])
+            net_reg_cols['level'].append(
+                torch.full((num_arcs,), level, dtype=torch.int32))
+            netArcId += num_arcs
+
+            level_2_collaterals[level] = [
+                                             cur_nodes,
+                                             parents,
+                                             rise_means,
+                                             rise_stds,
+                                             sigmas.clone(),
+                                             fall_means,
+                                             fall_stds,
+                                             sigmas,
+                                             net_arc_ids
+                                         ]
+            Gid_2_arrival[cur_nodes] = 1
+            if debug:
+                print("at level: {}, # valid nodes: {}".format(level, num_arcs))
+
+        else: # output pins
+            cur_t = torch.tensor(level_2_nodes[level], dtype=torch.int64)
+
+            # ragged gather of each node's slice of the sorted arc table
+            lo = torch.searchsorted(cell_dst_sorted, cur_t)
+            hi = torch.searchsorted(cell_dst_sorted, cur_t, right=True)
+            counts = hi - lo
+            starts = torch.cumsum(counts, dim=0) - counts
+            intra = torch.arange(int(counts.sum())) - torch.repeat_interleave(starts, counts)
+            slots = torch.repeat_interleave(lo, counts) + intra
+            row_pos = torch.repeat_interleave(
+                torch.arange(cur_t.numel(), dtype=torch.int64), counts)
+
+            # keep only arcs whose driver has arrived; the mask preserves
+            # the per-node grouping established by the sort
+            keep = ~torch.isinf(Gid_2_arrival[cell_src_gid_sorted[slots].clamp(min=0)]) \
+                 & (cell_src_gid_sorted[slots] >= 0)
+            slots = slots[keep]
+            row_pos = row_pos[keep]
+            assert slots.numel() > 0, "at level: {}, no valid nodes".format(level)
+
+            rows = cell_order[slots]
+            row_nodes = cell_dst_sorted[slots]
+            row_parents = cell_src_gid_sorted[slots]
+            row_sense_codes = cell_senses[rows]
+
+            # Sense-class sort within each node's segment: sequential
+            # levels mix unate and edge arcs, and the kernels branch on
+            # the sense per row, so interleaved classes cost warp
+            # divergence. A stable composite-key sort keeps the per-node
+            # grouping (node_start_end is unchanged) while making each
+            # segment — and runs of adjacent single-sense nodes —
+            # sense-homogeneous tiles. The candidate set per node is
+            # identical; only the in-segment order moves.
+            order = torch.argsort(row_pos * 4 + row_sense_codes.to(torch.int64),
+                                  stable=True)
+            rows = rows[order]
+            row_nodes = row_nodes[order]
+            row_parents = row_parents[order]
+            row_sense_codes = row_sense_codes[order]
+            row_pos = row_pos[order]
+
+            valid_counts = torch.bincount(row_pos, minlength=cur_t.numel())
+            present = valid_counts > 0
+            c_unique_t = cur_t[present]
+            node_start_end = torch.zeros(c_unique_t.numel() + 1, dtype=torch.int32)
+            node_start_end[1:] = torch.cumsum(valid_counts[present], dim=0).to(torch.int32)
+
+            # per-node guardbands and std coefficients, gathered per row
+            rise_gb_node = torch.full((cur_t.numel(),), design_rise_gb, dtype=float_dtype)
+            fall_gb_node = torch.full((cur_t.numel(),), design_fall_gb, dtype=float_dtype)
+            rise_coef_node = torch.full((cur_t.numel(),), design_rise_std_coef, dtype=float_dtype)
+            fall_coef_node = torch.full((cur_t.numel(),), design_fall_std_coef, dtype=float_dtype)
+            if cell_2_libCell:
+                for idx, node in enumerate(level_2_nodes[level]):
+                    cellName = '/'.join(Gid_2_pinName[node].split('/')[:-1])
+                    libCell = cell_2_libCell[cellName].split('/')[-1]
+                    if libCell in libCell_2_riseFallguardband:
+                        rise_gb_node[idx], fall_gb_node[idx] = libCell_2_riseFallguardband[libCell]
+                    if libCell in libCell_2_riseFallStd:
+                        rise_coef_node[idx], fall_coef_node[idx] = libCell_2_riseFallStd[libCell]
+
+            rise_gb = rise_gb_node[row_pos]
+            fall_gb = fall_gb_node[row_pos]
+            delays = cell_arc_columns.delays[rows].to(float_dtype)
+            rise_means = delays[:, 0] * rise_gb
+            if is_pocv:
+                rise_stds = delays[:, 1] * rise_coef_node[row_pos] * rise_gb
+                fall_means = delays[:, 2] * fall_gb
+                fall_stds = delays[:, 3] * fall_coef_node[row_pos] * fall_gb
+                sigmas = torch.full((rows.numel(),), 3.0, dtype=float_dtype)
+            else:
+                fall_means = delays[:, 1] * fall_gb
+                rise_stds = torch.zeros(rows.numel(), dtype=float_dtype)
+                fall_stds = torch.zeros(rows.numel(), dtype=float_dtype)
+                sigmas = torch.zeros(rows.numel(), dtype=float_dtype)
+            arc_senses = (row_sense_codes == 1).to(torch.int32)
+
+            # generate p_mapping as p_indices may duplicate and cause memory issue
+            p_idx_unique_t = torch.unique(row_parents)
+            p_mapping = torch.full((int(p_idx_unique_t[-1].item()) + 1,), -1, dtype=torch.int32)
+            p_mapping[p_idx_unique_t] = torch.arange(p_idx_unique_t.numel(), dtype=torch.int32)
+
+            cellArc_ids = torch.arange(cellArcId, cellArcId + rows.numel(),
+                                       dtype=torch.int32)
+            cell_reg_cols['from'].append(cell_src_pids[rows])
+            cell_reg_cols['to'].append(cell_arc_columns.dst_ids[rows].to(torch.int64))
+            cell_reg_cols['sense'].append(row_sense_codes)
+            cell_reg_cols['level'].append(
+                torch.full((rows.numel(),), level, dtype=torch.int32))
+            cellArcId += rows.numel()
+
+            level_2_collaterals[level] = [
+                                             row_nodes.to(torch.int32),
+                                             rise_means,
+                                             rise_stds,
+                                             sigmas.clone(),
+                                             fall_means,
+                                             fall_stds,
+                                             sigmas,
+                                             arc_senses,
+                                             row_parents.to(torch.int32),
+                                             node_start_end,
+                                             c_unique_t,
+                                             p_idx_unique_t.to(torch.int32),
+                                             p_mapping,
+                                             c_unique_t,
+                                             cellArc_ids
+                                         ]
+            Gid_2_arrival[c_unique_t] = 1
+            if debug:
+                print("at level: {}, # valid nodes: {}".format(level, c_unique_t.numel()))
+
+    def _registry(cols, with_sense):
+        def _cat(chunks, dtype):
+            return torch.cat(chunks) if chunks \
+                else torch.empty(0, dtype=dtype)
+        levels = _cat(cols['level'], torch.int32)
+        positions = _cat([torch.arange(chunk.numel(), dtype=torch.int32)
+                          for chunk in cols['level']], torch.int32)
+        return ArcRegistry(
+            interner,
+            _cat(cols['from'], torch.int64),
+            _cat(cols['to'], torch.int64),
+            _cat(cols['sense'], torch.int64) if with_sense else None,
+            levels, positions
+        )
+
+    net_registry = _registry(net_reg_cols, with_sense=False)
+    cell_registry = _registry(cell_reg_cols, with_sense=True)
+    net_arc_2_collateral_loc = ArcLocView(net_registry)
+    cell_arc_2_collateral_loc = ArcLocView(cell_registry)
+    netArcKey_2_netArcId = ArcKeyIdView(net_registry)
+    netArcId_2_netArcKey = ArcIdKeyView(net_registry)
+    netArcId_2_inCellName = ArcCellNameView(net_registry, 0)
+    netArcId_2_outCellName = ArcCellNameView(net_registry, 1)
+    cellArcKey_2_cellArcId = ArcKeyIdView(cell_registry)
+    cellArcId_2_cellArcKey = ArcIdKeyView(cell_registry)
+    cellArcId_2_cellName = ArcCellNameView(cell_registry, 1)
+
+    if save:
+        print('saving precomputed collaterals...')
+        save_pickle(level_2_collaterals, cache_files[0])
+        save_pickle(net_arc_2_collateral_loc, cache_files[1])
+        save_pickle(cell_arc_2_collateral_loc, cache_files[2])
+        save_pickle(cellArcId_2_cellName, cache_files[3])
+        save_pickle(cellArcKey_2_cellArcId, cache_files[4])
+        save_pickle(cellArcId_2_cellArcKey, cache_files[5])
+        save_pickle(netArcId_2_inCellName, cache_files[6])
+        save_pickle(netArcId_2_outCellName, cache_files[7])
+        save_pickle(netArcKey_2_netArcId, cache_files[8])
+        save_pickle(netArcId_2_netArcKey, cache_files[9])
+
+    return (
+            level_2_collaterals,
+            net_arc_2_collateral_loc, cell_arc_2_collateral_loc,
+            cellArcId_2_cellName, cellArcKey_2_cellArcId, cellArcId_2_cellArcKey,
+            netArcId_2_inCellName, netArcId_2_outCellName, netArcKey_2_netArcId, netArcId_2_netArcKey
+           )
+
+
+def extract_cone_collaterals(
+    level_2_collaterals: Dict[int, Any],
+    cone_gid_list: torch.Tensor,
+    max_gid: int,
+    device: torch.device,
+    netArcId_2_netArcKey: Optional[Dict] = None,
+    cellArcId_2_cellArcKey: Optional[Dict] = None,
+    inPinMod: int = 1
+) -> Tuple[Dict[int, Any], Dict, Dict]:
+    """
+    Carve a cone's ready-to-run collaterals out of the full-graph tables
+
+    precompute_collaterals(subgraph=True) re-runs the Python per-node
+    assembly for every cone, so cone preparation costs seconds while cone
+    propagation costs milliseconds. Once the full-graph collaterals are
+    prepared, a cone's collateral is pure filtering: net-arc rows survive
+    when both endpoints are cone members, cell-arc rows likewise with the
+    per-node segment boundaries rebuilt from the surviving row counts —
+    all tensor ops on device. Cone nodes no kept arc produces are seeded
+    at level 1, mirroring the coverage patch of the subgraph assembly,
+    and every level carries the local-index tail fields
+    propagate_subgraph_collateral expects (positions -2/-1), resolved by
+    searchsorted on the sorted cone gid list.
+
+    The cone-local loc maps (for ConeCollateralCache.patch_delays) are
+    rebuilt from the surviving rows' arc-id columns when the id-to-key
+    dicts are given; pass None for both to skip that host-side walk.
+
+    Args:
+        level_2_collaterals: Full-graph prepared collaterals (unscheduled
+            layout — run before schedule_level_launches)
+        cone_gid_list: Sorted int64 member gids of the cone
+        max_gid: Maximum node ID in the graph
+        device: Device holding the prepared collaterals
+
+    Returns:
+        Tuple of (cone level_2_collaterals, net_arc_2_collateral_loc,
+        cell_arc_2_collateral_loc) for the cone
+    """
+    start_time = time.time()
+    cone_gid_list = cone_gid_list.to(device=device, dtype=torch.int64)
+    cone_mask = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    cone_mask[cone_gid_list] = True
+    produced = torch.zeros(max_gid, dtype=torch.bool, device=device)
+
+    def _local(gids):
+        return torch.searchsorted(cone_gid_list, gids.to(torch.int64)).to(torch.int32)
+
+    cone_lvl2: Dict[int, Any] = {1: None}  # placeholder keeps level order
+    for level in sorted(level_2_collaterals):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        assert not (isinstance(coll, tuple) and coll[0] == 'chunks'), \
+            'extract cones before schedule_level_launches'
+        if level % 2 == inPinMod:  # input pins: one row per net arc sink
+            cur, parents = coll[0], coll[1]
+            keep = cone_mask[cur] & cone_mask[parents]
+            if not keep.any():
+                continue
+            cur_k = cur[keep]
+            par_k = parents[keep]
+            cone_lvl2[level] = [cur_k, par_k] \
+                + [coll[i][keep] for i in range(2, 8)] \
+                + [coll[8][keep], _local(cur_k), _local(par_k)]
+            produced[cur_k] = True
+        else:  # output pins: rows grouped per unique output node
+            dup_nodes = coll[0].to(torch.int64)
+            row_keep = cone_mask[dup_nodes] & cone_mask[coll[8].to(torch.int64)]
+            if not row_keep.any():
+                continue
+            boundaries = coll[9].to(torch.int64)
+            counts = boundaries[1:] - boundaries[:-1]
+            child_of_row = torch.repeat_interleave(
+                torch.arange(counts.numel(), dtype=torch.int64, device=device), counts)
+            kept_counts = torch.bincount(child_of_row[row_keep],
+                                         minlength=counts.numel())
+            present = kept_counts > 0
+            new_boundaries = torch.zeros(int(present.sum().item()) + 1,
+                                         dtype=torch.int32, device=device)
+            new_boundaries[1:] = kept_counts[present].cumsum(0).to(torch.int32)
+            new_c_unique = coll[13][present]
+
+            new_p_indices = coll[8][row_keep]
+            p_idx_unique = torch.unique(new_p_indices)
+            p_mapping = torch.full((int(p_idx_unique.max().item()) + 1,), -1,
+                                   dtype=torch.int32, device=device)
+            p_mapping[p_idx_unique.to(torch.int64)] = torch.arange(
+                p_idx_unique.numel(), dtype=torch.int32, device=device)
+
+            cone_lvl2[level] = [coll[0][row_keep]] \
+                + [coll[i][row_keep] for i in range(1, 8)] \
+                + [new_p_indices, new_boundaries,
+                   new_c_unique, p_idx_unique.to(torch.int32), p_mapping,
+                   new_c_unique, coll[14][row_keep],
+                   _local(p_idx_unique), _local(new_c_unique)]
+            produced[new_c_unique] = True
+
+    # Cone members nothing produces become level-1 seeds — the same role
+    # the subgraph assembly's dangling-node coverage patch fills
+    cone_lvl2[1] = cone_gid_list[~produced[cone_gid_list]]
+
+    net_loc: Dict = {}
+    cell_loc: Dict = {}
+    if netArcId_2_netArcKey is not None and cellArcId_2_cellArcKey is not None:
+        for level, coll in cone_lvl2.items():
+            if level == 1:
+                continue
+            if level % 2 == inPinMod:
+                for row, arc_id in enumerate(coll[8].tolist()):
+                    net_loc[netArcId_2_netArcKey[arc_id]] = (level, row)
+            else:
+                for row, arc_id in enumerate(coll[14].tolist()):
+                    cell_loc[cellArcId_2_cellArcKey[arc_id]] = (level, row)
+
+    print(f'[cone extract] {cone_gid_list.numel()} nodes, '
+          f'{len(cone_lvl2) - 1} levels in {time.time() - start_time:.3f} seconds')
+    return cone_lvl2, net_loc, cell_loc
+
+
+def stack_corner_collaterals(
+    corner_collaterals: List[Dict[int, Any]],
+    inPinMod: int = 1
+) -> Dict[int, Any]:
+    """
+    Stack per-corner delay columns into one scenario-batched table
+
+    All corners share the graph and the levelization, so their level
+    entries differ only in the delay columns; those become [rows, S]
+    stacks (S = number of corners) while indices, senses and segment
+    bounds are taken from the first corner. The result feeds
+    cuda_corner_batched_propagate, which sweeps every corner in lockstep.
+
+    Args:
+        corner_collaterals: One level_2_collaterals per corner, each from
+            precompute_collaterals over that corner's variation tables
+        inPinMod: Input pin levelization modulo
+
+    Returns:
+        level_2_collaterals with corner-stacked delay columns
+    """
+    assert corner_collaterals, 'need at least one corner'
+    base = corner_collaterals[0]
+    net_cols = (2, 3, 5, 6)
+    cell_cols = (1, 2, 4, 5)
+    stacked = {}
+    for level, entry in base.items():
+        if level == 1:
+            stacked[level] = entry
+            continue
+        assert not (isinstance(entry, tuple) and entry[0] == 'chunks'), \
+            'stack corners before schedule_level_launches'
+        cols = net_cols if level % 2 == inPinMod else cell_cols
+        merged = list(entry)
+        for col in cols:
+            columns = [corner[level][col] for corner in corner_collaterals]
+            assert all(c.numel() == columns[0].numel() for c in columns), \
+                f'level {level}: corners disagree on arc count'
+            merged[col] = torch.stack(columns, dim=1)
+        stacked[level] = merged
+    return stacked
+
+
+def patch_collateral_delays(
+    level_2_collaterals: Dict[int, Any],
+    net_arc_2_collateral_loc: Dict,
+    cell_arc_2_collateral_loc: Dict,
+    changed_arcs: Dict
+) -> int:
+    """
+    Scatter new delay tuples straight into prepared collateral tables
+
+    changed_arcs maps an arc key — (fromPin, toPin) for net arcs,
+    (fromPin, toPin, sense) for cell arcs — to its new
+    (rise_mean, rise_std, fall_mean, fall_std). Positions come from the
+    *_collateral_loc maps, so a delay-only update never re-runs
+    precompute_collaterals.
+
+    Returns:
+        Number of arcs patched
+    """
+    patched = 0
+    for arc_key, (rise_mean, rise_std, fall_mean, fall_std) in changed_arcs.items():
+        if arc_key in net_arc_2_collateral_loc:
+            level, pos = net_arc_2_collateral_loc[arc_key]
+            coll = level_2_collaterals[level]
+            # Scheduled giant levels hold their rows in node-disjoint
+            # chunks (schedule_level_launches); walk to the chunk that
+            # owns the global position
+            if isinstance(coll, tuple) and coll[0] == 'chunks':
+                for chunk in coll[1]:
+                    if pos < chunk[2].numel():
+                        coll = chunk
+                        break
+                    pos -= chunk[2].numel()
+            coll[2][pos] = rise_mean
+            coll[3][pos] = rise_std
+            coll[5][pos] = fall_mean
+            coll[6][pos] = fall_std
+        elif arc_key in cell_arc_2_collateral_loc:
+            level, pos = cell_arc_2_collateral_loc[arc_key]
+            coll = level_2_collaterals[level]
+            coll[1][pos] = rise_mean
+            coll[2][pos] = rise_std
+            coll[4][pos] = fall_mean
+            coll[5][pos] = fall_std
+        else:
+            continue
+        patched += 1
+    return patched
+
+
+def schedule_level_launches(
+    level_2_collaterals: Dict[int, Any],
+    tiny_level_rows: int = 2048,
+    giant_level_rows: int = 1 << 21,
+    num_chunks: int = 2,
+    inPinMod: int = 1
+) -> Tuple[Dict[int, Any], Dict[int, Tuple[int, int]]]:
+    """
+    Rebalance the per-level launch schedule for GPU occupancy
+
+    Level width is heavily skewed: thousands of sub-1k levels each pay a
+    full launch while a handful of multi-million-row levels dominate one
+    SM wave at a time. Two transforms, both dependency-checked:
+
+    - Tiny net-arc levels are fused into the closest earlier tiny net
+      level whose launch they can join: a candidate merges only if none
+      of its parent reads hit a node written by the levels between (the
+      fused launch gathers all parents before scattering). Fused rows
+      keep distinct sink nodes, so the combined index_copy_ stays
+      race-free.
+    - Giant net-arc levels are split into node-disjoint row chunks that
+      the sweep may overlap on separate streams — rows of one level never
+      feed each other, so intra-level chunks are fully independent.
+
+    Cell-arc levels are left untouched: their per-level unique/mapping
+    index arrays don't concatenate or slice without re-tensorizing.
+    The scheduled dict targets the eager sweep; the persistent-kernel and
+    streaming paths consume the unscheduled layout.
+
+    Args:
+        level_2_collaterals: Prepared collaterals (modified copies returned)
+        tiny_level_rows: Net levels at or under this row count may fuse
+        giant_level_rows: Net levels above this row count are chunked
+        num_chunks: Chunk count for giant levels
+        inPinMod: Input pin levelization modulo
+
+    Returns:
+        Tuple of (scheduled collaterals dict, level_moves) where
+        level_moves maps a fused-away level to its (anchor_level,
+        row_offset) for collateral-loc rewriting
+    """
+    scheduled = {level: level_2_collaterals[level]
+                 for level in sorted(level_2_collaterals)}
+    level_moves = {}
+
+    # Fuse runs of tiny net levels whose reads clear the launch reorder
+    anchor = None
+    written = None
+    merged = 0
+    for level in sorted(level_2_collaterals):
+        if level == 1:
+            continue
+        coll = scheduled.get(level)
+        if level % 2 != inPinMod:
+            # Cell level: its outputs become reorder hazards for any
+            # later candidate joining the current group
+            if anchor is not None:
+                written = torch.cat([written, coll[0].to(torch.int64).flatten()])
+            continue
+        rows = coll[0].numel()
+        if rows > tiny_level_rows:
+            anchor = None
+            continue
+        if anchor is None:
+            anchor = level
+            written = coll[0].to(torch.int64).flatten().clone()
+            continue
+        reads = coll[1].to(torch.int64).flatten()
+        if bool(torch.isin(reads, written).any()):
+            # Depends on the group; it starts the next one instead
+            anchor = level
+            written = coll[0].to(torch.int64).flatten().clone()
+            continue
+        anchor_coll = scheduled[anchor]
+        level_moves[level] = (anchor, anchor_coll[0].numel())
+        # net_arc_ids is a tensor in the normalized layout; legacy pickled
+        # caches may still carry it as a host list
+        fused_ids = anchor_coll[8] + coll[8] if isinstance(anchor_coll[8], list) \
+            else torch.cat([anchor_coll[8], coll[8]])
+        scheduled[anchor] = [torch.cat([anchor_coll[i], coll[i]]) for i in range(8)] \
+            + [fused_ids]
+        written = torch.cat([written, coll[0].to(torch.int64).flatten()])
+        del scheduled[level]
+        merged += 1
+
+    # Chunk giant net levels for dual-stream overlap
+    split = 0
+    for level in list(scheduled):
+        if level == 1 or level % 2 != inPinMod:
+            continue
+        coll = scheduled[level]
+        rows = coll[0].numel()
+        if rows <= giant_level_rows:
+            continue
+        bounds = [rows * i // num_chunks for i in range(num_chunks + 1)]
+        chunks = [
+            [t[bounds[i]:bounds[i + 1]] for t in coll[:8]]
+            + [coll[8][bounds[i]:bounds[i + 1]]]
+            for i in range(num_chunks)
+        ]
+        scheduled[level] = ('chunks', chunks)
+        split += 1
+
+    print(f'[level schedule] {merged} tiny net levels fused, '
+          f'{split} giant net levels split into {num_chunks} chunks; '
+          f'{len(scheduled)} launches (was {len(level_2_collaterals)})')
+    return {level: scheduled[level] for level in sorted(scheduled)}, level_moves
+
+
+def fuse_stage_schedule(
+    level_2_collaterals: Dict[int, Any],
+    max_gid: int,
+    dest_nodes=None,
+    keep_gids=None,
+    inPinMod: int = 1
+) -> Tuple[Dict[int, Any], Dict[str, int]]:
+    """
+    Fold net arcs into their consuming cell levels, halving sweep depth
+
+    The alternating net/cell level convention pays two launches per
+    logic stage, and for deep designs (and incremental cones) launch
+    depth — not width — bounds latency. Every input pin has exactly one
+    driving net arc, and a net arc is a plain delay add ahead of the
+    cell merge, so it folds exactly: each cell-arc row's delay columns
+    absorb its parent input pin's net delay (the fall net delay into the
+    rise column on negative-unate rows — the swap reads the opposite
+    polarity of the in-pin arrival, which carries the opposite net
+    delay), stds combine by RSS (associative, so hypot(net, cell) then
+    RSS with the parent plane equals the two-step chain), the sigma
+    columns pass through (they carry the per-arc sigma multiplier, not a
+    spread), and the row's parent becomes the DRIVER output pin. Rows
+    whose parent is a level-1 seed (no net arc behind it) keep their
+    original parent and delays.
+
+    Net levels then shrink to residual rows whose loads must still be
+    materialized — endpoints, keep_gids, and loads no cell level
+    consumes — and empty ones disappear. Cell levels keep their level
+    numbers and the even/odd convention, so the sweep, the fused
+    kernels, and the compaction planner consume the fused dict
+    unchanged; drivers always sit at strictly lower levels than the
+    input pins they replace, so ordering is preserved.
+
+    The fused dict is a derived artifact like the scheduled one:
+    arc-loc patching and arc gradients keep addressing the base
+    collaterals (a folded column mixes two arcs), so rebuild after ECOs.
+
+    Returns:
+        (fused collaterals dict, stats dict)
+    """
+    start_time = time.time()
+
+    def _net_tables(entry):
+        if isinstance(entry, tuple) and len(entry) == 2 \
+                and entry[0] == 'chunks':
+            return entry[1]
+        return [entry]
+
+    # Pass 1: the global in-pin -> (driver, net delay) maps. One scatter
+    # per net level; each load pin has a single driver so later levels
+    # never overwrite earlier ones.
+    device = None
+    driver_of = None
+    net_cols = None  # rise_mean, rise_std, fall_mean, fall_std
+    consumed = None
+    for level in sorted(level_2_collaterals):
+        if level == 1:
+            continue
+        entry = level_2_collaterals[level]
+        if level % 2 == inPinMod:
+            for coll in _net_tables(entry):
+                loads = coll[0].to(torch.int64)
+                if device is None:
+                    device = loads.device
+                    driver_of = torch.full((max_gid,), -1,
+                                           dtype=torch.int64, device=device)
+                    net_cols = [torch.zeros(max_gid, dtype=coll[2].dtype,
+                                            device=device) for _ in range(4)]
+                    consumed = torch.zeros(max_gid, dtype=torch.bool,
+                                           device=device)
+                driver_of[loads] = coll[1].to(torch.int64)
+                for slot, col in enumerate((2, 3, 5, 6)):
+                    net_cols[slot][loads] = coll[col]
+        else:
+            if consumed is None:
+                device = entry[8].device
+                driver_of = torch.full((max_gid,), -1, dtype=torch.int64,
+                                       device=device)
+                net_cols = [torch.zeros(max_gid, dtype=entry[1].dtype,
+                                        device=device) for _ in range(4)]
+                consumed = torch.zeros(max_gid, dtype=torch.bool,
+                                       device=device)
+            consumed[entry[8].to(torch.int64)] = True
+
+    assert driver_of is not None, 'no arc levels to fuse'
+    keep = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    if dest_nodes:
+        keep[torch.tensor(list(dest_nodes), dtype=torch.int64,
+                          device=device)] = True
+    if keep_gids is not None:
+        keep[keep_gids.to(device).to(torch.int64)] = True
+
+    net_rm, net_rs, net_fm, net_fs = net_cols
+    fused = {}
+    folded_rows = 0
+    residual_rows = 0
+    for level in sorted(level_2_collaterals):
+        entry = level_2_collaterals[level]
+        if level == 1:
+            fused[level] = entry
+            continue
+        if level % 2 == inPinMod:
+            # Residual net rows only: loads the cell levels will not
+            # re-derive from their drivers
+            tables = _net_tables(entry)
+            kept = []
+            for coll in tables:
+                loads = coll[0].to(torch.int64)
+                mask = keep[loads] | ~consumed[loads]
+                if bool(mask.any()):
+                    kept.append([col[mask] for col in coll])
+            if kept:
+                merged = [torch.cat([coll[i] for coll in kept])
+                          for i in range(len(kept[0]))]
+                fused[level] = merged
+                residual_rows += merged[0].numel()
+            continue
+        # Cell level: fold the parent net delays into the arc columns and
+        # reparent the rows onto the drivers
+        parents = entry[8].to(torch.int64)
+        has_net = driver_of[parents] >= 0
+        swap = entry[7].to(torch.bool)
+        folded_rows += int(has_net.sum())
+
+        def _fold_mean(cell_col, straight, crossed):
+            add = torch.where(swap, crossed[parents], straight[parents])
+            return cell_col + torch.where(has_net, add,
+                                          torch.zeros_like(add))
+
+        def _fold_rss(cell_col, straight, crossed):
+            net = torch.where(swap, crossed[parents], straight[parents])
+            return torch.where(has_net, torch.hypot(cell_col, net),
+                               cell_col)
+
+        new_p = torch.where(has_net, driver_of[parents], parents)
+        p_idx_unique = torch.unique(new_p)
+        p_mapping = torch.full((int(p_idx_unique.max()) + 1,), -1,
+                               dtype=entry[12].dtype, device=device)
+        p_mapping[p_idx_unique] = torch.arange(
+            p_idx_unique.numel(), dtype=entry[12].dtype, device=device)
+        fused[level] = [
+            entry[0],
+            _fold_mean(entry[1], net_rm, net_fm),
+            _fold_rss(entry[2], net_rs, net_fs),
+            entry[3],
+            _fold_mean(entry[4], net_fm, net_rm),
+            _fold_rss(entry[5], net_fs, net_rs),
+            entry[6],
+            entry[7],
+            new_p.to(entry[8].dtype),
+            entry[9],
+            entry[10],
+            p_idx_unique.to(entry[11].dtype),
+            p_mapping,
+            entry[13],
+            entry[14],
+        ]
+
+    stats = {'levels': len(fused),
+             'base_levels': len(level_2_collaterals),
+             'folded_rows': folded_rows,
+             'residual_net_rows': residual_rows}
+    print(f'[fused schedule] {len(fused)} levels '
+          f'(was {len(level_2_collaterals)}), {folded_rows} net folds, '
+          f'{residual_rows} residual net rows, '
+          f'{time.time() - start_time:.2f}s')
+    return fused, stats
+
+
+class _TensorPool:
+    """
+    Content-addressed pool sharing bit-identical collateral tensors
+
+    Repeated tiles (memory banks, datapath slices) produce cone
+    collateral columns that are byte-for-byte identical across
+    instances — delays always, index columns too once the cone is in
+    its local id space. intern() returns one canonical tensor per
+    distinct content, refcounted so release() can drop it when the last
+    instance referencing it is evicted. Fingerprints hash the raw host
+    bytes; dtype and shape ride in the key so a collision would also
+    need matching layout.
+    """
+
+    def __init__(self):
+        self._canonical: Dict[Tuple, List] = {}  # key -> [tensor, refcount]
+
+    @staticmethod
+    def _fingerprint(tensor: torch.Tensor) -> Tuple:
+        import hashlib
+        payload = tensor.detach().cpu().contiguous().numpy().tobytes()
+        return (str(tensor.dtype), tuple(tensor.shape),
+                hashlib.sha1(payload).hexdigest())
+
+    def intern(self, tensor: torch.Tensor) -> Tuple[torch.Tensor, Tuple, bool]:
+        """(canonical, key, is_new); bumps the refcount"""
+        key = self._fingerprint(tensor)
+        entry = self._canonical.get(key)
+        if entry is None:
+            self._canonical[key] = [tensor, 1]
+            return tensor, key, True
+        entry[1] += 1
+        return entry[0], key, False
+
+    def release(self, key: Tuple) -> int:
+        """Drop one reference; returns the bytes freed (0 if still shared)"""
+        entry = self._canonical[key]
+        entry[1] -= 1
+        if entry[1] == 0:
+            tensor = entry[0]
+            del self._canonical[key]
+            return tensor.numel() * tensor.element_size()
+        return 0
+
+
+class ConeCollateralCache:
+    """
+    LRU cache of prepared cone collaterals for repeated what-if regions
+
+    Optimizers re-query the same physical regions over and over, and every
+    query otherwise pays precompute_collaterals(subgraph=True) again from
+    Python dicts. Entries are keyed by the frozen cone root set and hold
+    the full subgraph tuple (collaterals on device plus the loc maps);
+    least-recently-used entries are evicted once the cached tensor bytes
+    exceed the memory budget. When only delays changed inside a cached
+    cone, patch_delays updates the tables in place via the loc maps, so a
+    cache hit makes the what-if query a pure kernel launch.
+
+    With dedup (default on), inserted tensors are interned in a
+    content-addressed pool, so the thousands of structurally identical
+    tiles a bank-heavy design queries share one canonical copy of each
+    collateral column; only the per-instance maps stay per-entry.
+    Budget accounting charges each canonical copy once, letting 4-6x
+    more distinct regions stay resident. Deduplicated entries must not
+    be patched in place (patch_delays refuses): a patch would write
+    through the shared canonical into every sibling instance.
+    """
+
+    def __init__(self, memory_budget_gb: float = 4.0, dedup: bool = True):
+        self._entries = collections.OrderedDict()  # roots key -> (tuple, nbytes, pool keys)
+        self._bytes = 0
+        self._budget_bytes = memory_budget_gb * (1 << 30)
+        self._pool = _TensorPool() if dedup else None
+        self.dedup_hits = 0
+        self.hits = 0
+        self.misses = 0
+
+    @staticmethod
+    def _key(roots) -> frozenset:
+        return frozenset(int(r) for r in roots)
+
+    @staticmethod
+    def _tuple_bytes(subgraph_tuple) -> int:
+        nbytes = 0
+        for objects in subgraph_tuple[0].values():
+            for obj in (objects if isinstance(objects, list) else [objects]):
+                if isinstance(obj, torch.Tensor):
+                    nbytes += obj.numel() * obj.element_size()
+        return nbytes
+
+    def get(self, roots):
+        """Return the cached subgraph tuple for a root set, or None"""
+        key = self._key(roots)
+        entry = self._entries.get(key)
+        if entry is None:
+            self.misses += 1
+            return None
+        self._entries.move_to_end(key)
+        self.hits += 1
+        return entry[0]
+
+    def _intern_tuple(self, subgraph_tuple):
+        """
+        Share identical collateral tensors through the pool
+
+        Returns (tuple with canonical tensors, retained bytes, pool
+        keys). Bytes count only canonicals this entry created — shared
+        columns are charged to whichever entry brought them in.
+        """
+        pool_keys = []
+        nbytes = 0
+        shared = 0
+        deduped = {}
+        for level, objects in subgraph_tuple[0].items():
+            if not isinstance(objects, list):
+                if isinstance(objects, torch.Tensor):
+                    canonical, pool_key, is_new = self._pool.intern(objects)
+                    pool_keys.append(pool_key)
+                    if is_new:
+                        nbytes += canonical.numel() * canonical.element_size()
+                    else:
+                        shared += 1
+                    objects = canonical
+                deduped[level] = objects
+                continue
+            fields = []
+            for obj in objects:
+                if isinstance(obj, torch.Tensor):
+                    canonical, pool_key, is_new = self._pool.intern(obj)
+                    pool_keys.append(pool_key)
+                    if is_new:
+                        nbytes += canonical.numel() * canonical.element_size()
+                    else:
+                        shared += 1
+                    obj = canonical
+                fields.append(obj)
+            deduped[level] = fields
+        self.dedup_hits += shared
+        return (deduped,) + tuple(subgraph_tuple[1:]), nbytes, pool_keys
+
+    def _drop(self, key) -> None:
+        _, nbytes, pool_keys = self._entries.pop(key)
+        # pooled bytes leave the budget only when the LAST instance
+        # referencing a canonical copy goes; nbytes covers the
+        # non-pooled remainder
+        self._bytes -= nbytes
+        if self._pool is not None:
+            for pool_key in pool_keys:
+                self._bytes -= self._pool.release(pool_key)
+
+    def put(self, roots, subgraph_tuple) -> None:
+        """Insert a prepared cone, evicting LRU entries past the budget"""
+        key = self._key(roots)
+        if key in self._entries:
+            self._drop(key)
+        if self._pool is not None:
+            subgraph_tuple, new_bytes, pool_keys = self._intern_tuple(subgraph_tuple)
+            self._entries[key] = (subgraph_tuple, 0, pool_keys)
+            self._bytes += new_bytes
+        else:
+            nbytes = self._tuple_bytes(subgraph_tuple)
+            self._entries[key] = (subgraph_tuple, nbytes, [])
+            self._bytes += nbytes
+        while self._bytes > self._budget_bytes and len(self._entries) > 1:
+            oldest = next(iter(self._entries))
+            self._drop(oldest)
+
+    def patch_delays(self, roots, changed_arcs) -> int:
+        """
+        In-place delay update for a cached cone (no recompute)
+
+        Deduplicated entries are dropped instead of patched: their
+        columns may be canonical copies shared with sibling instances,
+        and a patch would write through into every one of them. The
+        caller recomputes the cone as on any other miss.
+        """
+        key = self._key(roots)
+        if key not in self._entries:
+            return 0
+        if self._pool is not None:
+            self._drop(key)
+            return 0
+        subgraph_tuple = self.get(roots)
+        return patch_collateral_delays(
+            subgraph_tuple[0], subgraph_tuple[1], subgraph_tuple[2], changed_arcs)
+
+
+def build_streaming_transfer_plan(
+    level_2_collaterals: Dict[int, Any],
+    level_costs_ms: Optional[Dict[int, float]] = None,
+    memory_ceiling_gb: float = 4.0,
+    pcie_gbps: float = 24.0
+) -> Dict[str, Any]:
+    """
+    Static prefetch schedule for the out-of-core streaming sweep
+
+    The level sequence never changes between propagations, so a plan
+    built once beats the loader's reactive fixed-depth lookahead: with
+    per-level collateral bytes (measured here) and kernel costs (from a
+    LevelProfiler report's level -> ms rows; row counts stand in when no
+    profile exists yet), every level's upload is scheduled at the
+    earliest sweep position the memory ceiling admits. The resulting
+    timeline is simulated against the copy-stream bandwidth, so the plan
+    reports exactly which levels stall — if 'stall_ms' is zero the
+    transfers provably hide behind compute at the given ceiling.
+
+    Returns:
+        Plan dict: 'prefetch_at' (level -> levels whose upload to issue
+        there), 'issue_at', 'stall_ms', 'stalled_levels',
+        'max_resident_bytes', 'total_compute_ms', 'total_transfer_ms'
+    """
+    levels = sorted(level for level in level_2_collaterals if level != 1)
+
+    def _level_bytes(level):
+        total = 0
+        for obj in level_2_collaterals[level]:
+            if isinstance(obj, torch.Tensor):
+                total += obj.numel() * obj.element_size()
+        return total
+
+    level_bytes = {level: _level_bytes(level) for level in levels}
+    if level_costs_ms is None:
+        # No profile yet: kernel time scales with rows closely enough
+        # for scheduling purposes (refine with a LevelProfiler run)
+        level_costs_ms = {
+            level: max(level_2_collaterals[level][0].numel()
+                       if isinstance(level_2_collaterals[level][0], torch.Tensor)
+                       else len(level_2_collaterals[level][0]), 1) * 1e-4
+            for level in levels}
+
+    ceiling = int(memory_ceiling_gb * (1 << 30))
+    num_slots = len(levels)
+    resident = [0] * num_slots  # bytes resident while slot s computes
+    issue_at = {}
+    issue_slot = 0
+    for slot, level in enumerate(levels):
+        size = level_bytes[level]
+        assert size <= ceiling, \
+            f'level {level} alone ({size >> 20} MB) exceeds the memory ceiling'
+        # Earliest slot (monotonic: copies issue in level order) whose
+        # whole residency window [candidate, slot] stays under ceiling
+        candidate = max(issue_slot, 0)
+        while candidate < slot and \
+                max(resident[candidate:slot + 1]) + size > ceiling:
+            candidate += 1
+        issue_slot = candidate
+        issue_at[level] = levels[candidate]
+        for s in range(candidate, slot + 1):
+            resident[s] += size
+
+    # Simulate the copy stream against the compute timeline
+    compute_start = {}
+    cursor = 0.0
+    for level in levels:
+        compute_start[level] = cursor
+        cursor += level_costs_ms[level]
+    bytes_per_ms = pcie_gbps * (1 << 30) / 1e3
+    copy_cursor = 0.0
+    stall_ms = 0.0
+    stalled_levels = []
+    for level in levels:
+        copy_start = max(copy_cursor, compute_start[issue_at[level]])
+        copy_end = copy_start + level_bytes[level] / bytes_per_ms
+        copy_cursor = copy_end
+        stall = copy_end - (compute_start[level] + stall_ms)
+        if stall > 0:
+            stall_ms += stall
+            stalled_levels.append(level)
+
+    prefetch_at: Dict[int, list] = {}
+    for level, issue_level in issue_at.items():
+        prefetch_at.setdefault(issue_level, []).append(level)
+    plan = {
+        'prefetch_at': prefetch_at,
+        'issue_at': issue_at,
+        'stall_ms': stall_ms,
+        'stalled_levels': stalled_levels,
+        'max_resident_bytes': max(resident) if resident else 0,
+        'total_compute_ms': cursor,
+        'total_transfer_ms': sum(level_bytes[l] for l in levels) / bytes_per_ms,
+    }
+    print(f'[transfer plan] {num_slots} levels, '
+          f'{plan["total_transfer_ms"]:.1f}ms transfer under '
+          f'{plan["total_compute_ms"]:.1f}ms compute, '
+          f'max resident {plan["max_resident_bytes"] >> 20}MB, '
+          f'stalls {stall_ms:.1f}ms on {len(stalled_levels)} levels')
+    return plan
+
+
+class StreamingCollateralLoader:
+    """
+    Double-buffered host-to-device streamer for level collaterals
+
+    For designs whose collaterals do not fit on the GPU, the tables stay in
+    host (pinned) memory and each level is uploaded on a dedicated copy
+    stream while the previous level computes. Levelization gives the exact
+    lifetime of every table: level L's collaterals are consumed only by
+    level L, so slots behind the sweep front are evicted immediately,
+    keeping at most prefetch_depth+1 levels resident. Arrival results live
+    in the dense Gid planes and are unaffected; pair with the topK/dtype
+    budget in clear_timing_cache when those dominate.
+    """
+
+    def __init__(self, level_2_collaterals: Dict[int, Any], device: torch.device,
+                 prefetch_depth: int = 2, plan: Optional[Dict[str, Any]] = None):
+        # plan: a build_streaming_transfer_plan schedule; when given, its
+        # earliest-admissible issue points replace the fixed lookahead
+        self.host_collaterals = level_2_collaterals
+        self.device = device
+        self.prefetch_depth = prefetch_depth
+        self.plan = plan
+        self.levels = sorted(level_2_collaterals.keys())
+        self._level_2_order = {level: i for i, level in enumerate(self.levels)}
+        self.copy_stream = torch.cuda.Stream(device=device)
+        self._slots = {}  # level -> (device collaterals, ready event)
+
+    def _upload(self, obj):
+        if isinstance(obj, list):
+            obj = torch.tensor(obj, dtype=torch.int64)
+        if not isinstance(obj, torch.Tensor) or obj.device == self.device:
+            return obj
+        if not obj.is_pinned():
+            obj = obj.pin_memory()
+        return obj.to(self.device, non_blocking=True)
+
+    def prefetch(self, level: int) -> None:
+        """Queue the H2D copies for one level on the copy stream"""
+        if level in self._slots or level not in self.host_collaterals:
+            return
+        objects = self.host_collaterals[level]
+        with torch.cuda.stream(self.copy_stream):
+            if isinstance(objects, torch.Tensor):
+                moved = self._upload(objects)
+            else:
+                # Aliased fields (cell positions 10/13) upload once
+                uploaded = {}
+                moved = []
+                for obj in objects:
+                    if id(obj) not in uploaded:
+                        uploaded[id(obj)] = self._upload(obj)
+                    moved.append(uploaded[id(obj)])
+            event = torch.cuda.Event()
+            event.record(self.copy_stream)
+        self._slots[level] = (moved, event)
+
+    def get(self, level: int) -> Any:
+        """
+        Return the device-resident collaterals for one level, kicking off
+        the next prefetch_depth uploads and evicting consumed levels
+        """
+        if level not in self._slots:
+            self.prefetch(level)
+        moved, event = self._slots[level]
+        torch.cuda.current_stream(self.device).wait_event(event)
+        order = self._level_2_order[level]
+        if self.plan is not None:
+            for upcoming in self.plan['prefetch_at'].get(level, []):
+                self.prefetch(upcoming)
+        else:
+            for upcoming in self.levels[order + 1: order + 1 + self.prefetch_depth]:
+                self.prefetch(upcoming)
+        for consumed in [l for l in self._slots if l < level]:
+            del self._slots[consumed]
+        return moved
+
+
+# Field layouts of the per-level collateral lists (see the positional
+# unpacking in cuda_ops.py). The SoA container keys everything by these
+# names so consumers stop depending on list positions.
+_SP_FIELDS = ['sp_nodes']
+_NET_ARC_FIELDS = [
+    'c_indices', 'p_indices',
+    'rise_means', 'rise_stds', 'rise_sigmas',
+    'fall_means', 'fall_stds', 'fall_sigmas',
+    'net_arc_ids'
+]
+_CELL_ARC_FIELDS = [
+    'dup_indices',
+    'rise_means', 'rise_stds', 'rise_sigmas',
+    'fall_means', 'fall_stds', 'fall_sigmas',
+    'senses', 'p_indices', 'node_start_end',
+    'c_unique_list', 'p_idx_unique', 'p_mapping',
+    'c_unique_indices', 'cellArc_ids'
+]
+
+
+class CollateralSoA:
+    """
+    Flattened structure-of-arrays collateral container
+
+    Instead of a dict of per-level lists holding 9-17 heterogeneous
+    tensors/lists each, every field is stored as ONE concatenated tensor
+    plus a per-level offset table. Benefits: a single H2D copy per field,
+    stable (CUDA-Graph-friendly) device addresses, named field access
+    instead of fragile positional indexing, and far fewer small
+    allocations. as_level_dict() rebuilds the legacy positional layout as
+    zero-copy views for the existing propagation loop.
+    """
+
+    def __init__(self):
+        self.fields: Dict[str, torch.Tensor] = {}
+        self.offsets: Dict[str, Dict[int, Tuple[int, int]]] = {}
+        self.shapes: Dict[str, Dict[int, Tuple[int, ...]]] = {}
+        self.level_kinds: Dict[int, int] = {}   # 0=startpoint, 1=net arc, 2=cell arc
+
+    @classmethod
+    def from_level_dict(cls, level_2_collaterals: Dict[int, Any], inPinMod: int = 1) -> 'CollateralSoA':
+        """Build the SoA container from the legacy dict-of-lists format"""
+        soa = cls()
+        pieces = collections.defaultdict(list)
+        running = collections.defaultdict(int)
+
+        def push(name, level, obj):
+            if isinstance(obj, list):
+                obj = torch.tensor(obj, dtype=torch.int64)
+            obj = obj.contiguous()
+            pieces[name].append(obj.view(-1))
+            soa.offsets.setdefault(name, {})[level] = (running[name], running[name] + obj.numel())
+            soa.shapes.setdefault(name, {})[level] = tuple(obj.shape)
+            running[name] += obj.numel()
+
+        for level, objects in level_2_collaterals.items():
+            if level == 1:
+                soa.level_kinds[level] = 0
+                push('sp_nodes', level, objects)
+            elif level % 2 == inPinMod:
+                soa.level_kinds[level] = 1
+                for name, obj in zip(_NET_ARC_FIELDS, objects):
+                    push(name, level, obj)
+            else:
+                soa.level_kinds[level] = 2
+                for name, obj in zip(_CELL_ARC_FIELDS, objects):
+                    push(name, level, obj)
+
+        for name, chunks in pieces.items():
+            soa.fields[name] = torch.cat(chunks)
+        return soa
+
+    def to(self, device: torch.device, non_blocking: bool = True) -> 'CollateralSoA':
+        """One transfer per field (each field is a single flat tensor)"""
+        for name, tensor in self.fields.items():
+            if tensor.device != device:
+                staged = tensor.pin_memory() if str(device) != 'cpu' and not tensor.is_pinned() else tensor
+                self.fields[name] = staged.to(device, non_blocking=non_blocking)
+        return self
+
+    def level_view(self, level: int, name: str) -> torch.Tensor:
+        """Zero-copy view of one field's slice for one level"""
+        start, end = self.offsets[name][level]
+        return self.fields[name][start:end].view(self.shapes[name][level])
+
+    def as_level_dict(self) -> Dict[int, Any]:
+        """
+        Rebuild the legacy positional dict-of-lists as views into the flat
+        buffers, so cuda_arrival_propagate_pocv can consume the SoA
+        container unchanged
+        """
+        level_2_collaterals = {}
+        for level, kind in self.level_kinds.items():
+            if kind == 0:
+                level_2_collaterals[level] = self.level_view(level, 'sp_nodes')
+            else:
+                names = _NET_ARC_FIELDS if kind == 1 else _CELL_ARC_FIELDS
+                level_2_collaterals[level] = [self.level_view(level, name) for name in names]
+        return level_2_collaterals
+
+
+def cast_collaterals_dtype(level_2_collaterals: Dict, float_dtype: torch.dtype) -> Dict:
+    """
+    Cast the floating-point collateral tables to a new precision in place
+
+    Index/sense tensors keep their integer dtypes; only the delay/std/sigma
+    tables change. Used when switching the engine between fp32 and bf16
+    without re-running precompute_collaterals.
+    """
+    for level, objects in level_2_collaterals.items():
+        if level == 1:
+            continue
+        for idx, obj in enumerate(objects):
+            if isinstance(obj, torch.Tensor) and obj.is_floating_point():
+                objects[idx] = obj.to(float_dtype)
+    return level_2_collaterals
+
+
+def cast_collaterals_dtype_policy(
+    level_2_collaterals: Dict,
+    depth_fraction: float = 0.8,
+    trunk_dtype: torch.dtype = torch.bfloat16,
+    endpoint_dtype: torch.dtype = torch.float32
+) -> Dict:
+    """
+    Per-level storage precision: half trunk, full near endpoints
+
+    Arrival error concentrates in the last levels before the endpoints
+    while the trunk tolerates bf16, so the all-or-nothing
+    cast_collaterals_dtype leaves accuracy on the table. Levels below
+    depth_fraction of the schedule store their delay/std/sigma tables in
+    trunk_dtype and the rest keep endpoint_dtype; the sweeps already
+    dequantize one level at a time back to the compute dtype, which is
+    the casting gather at the transition. Run with float_dtype fp32 for
+    the intended trade: trunk tables halve while the arithmetic and the
+    endpoint-adjacent tables stay exact.
+    """
+    levels = sorted(level for level in level_2_collaterals if level != 1)
+    cutoff_idx = int(len(levels) * depth_fraction)
+    cutoff = levels[cutoff_idx] if cutoff_idx < len(levels) else levels[-1] + 1
+    trunk_levels = 0
+    for level in levels:
+        target = trunk_dtype if level < cutoff else endpoint_dtype
+        objects = level_2_collaterals[level]
+        for idx, obj in enumerate(objects):
+            if isinstance(obj, torch.Tensor) and obj.is_floating_point():
+                objects[idx] = obj.to(target)
+        trunk_levels += level < cutoff
+    print(f'[dtype policy] {trunk_levels} trunk levels -> {trunk_dtype}, '
+          f'{len(levels) - trunk_levels} endpoint levels -> {endpoint_dtype} '
+          f'(cutoff level {cutoff})')
+    return level_2_collaterals
+
+
+# Cache of flattened collateral buffers, keyed by the identity of the
+# level_2_collaterals dict they were built from (rebuilt on new collaterals)
+_flattened_collateral_cache = {}
+
+
+@py_scope('flatten_level_collaterals')
+def flatten_level_collaterals(
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Pack the per-level collateral lists into flat device buffers for the
+    persistent whole-graph propagation kernel
+
+    The per-level Python dispatch in cuda_arrival_propagate_pocv costs one
+    host round trip per level; the persistent kernel instead walks these
+    concatenated buffers on-device, using the offset tables to find each
+    level's slice and grid-syncing between levels.
+
+    Args:
+        level_2_collaterals: Precomputed timing collaterals by level
+        device: Target device for the packed buffers
+        inPinMod: Input pin levelization modulo
+
+    Returns:
+        Dictionary of flat tensors: level kinds (0=startpoint, 1=net arc,
+        2=cell arc), per-stream offset tables, concatenated node/parent
+        indices, arc delay tables, senses, start/end and parent mappings
+    """
+    cached = _flattened_collateral_cache.get(id(level_2_collaterals))
+    if cached is not None:
+        return cached
+
+    level_kinds = []
+    node_offsets = [0]
+    arc_offsets = [0]
+    se_offsets = [0]
+    pmap_offsets = [0]
+
+    node_indices = []
+    parent_indices = []
+    arc_rise_means, arc_rise_stds = [], []
+    arc_fall_means, arc_fall_stds = [], []
+    arc_senses = []
+    node_start_end = []
+    p_mappings = []
+
+    empty_i32 = torch.empty(0, dtype=torch.int32)
+
+    for level in level_2_collaterals:
+        coll = level_2_collaterals[level]
+        if level == 1:
+            level_kinds.append(0)
+            node_indices.append(coll.to(torch.int32).cpu())
+            parent_indices.append(empty_i32)
+        elif level % 2 == inPinMod:
+            level_kinds.append(1)
+            node_indices.append(coll[0].to(torch.int32).cpu())
+            parent_indices.append(coll[1].to(torch.int32).cpu())
+            arc_rise_means.append(coll[2].cpu())
+            arc_rise_stds.append(coll[3].cpu())
+            arc_fall_means.append(coll[5].cpu())
+            arc_fall_stds.append(coll[6].cpu())
+        else:
+            level_kinds.append(2)
+            node_indices.append(coll[13].to(torch.int32).cpu())
+            parent_indices.append(coll[8].to(torch.int32).cpu())
+            arc_rise_means.append(coll[1].cpu())
+            arc_rise_stds.append(coll[2].cpu())
+            arc_fall_means.append(coll[4].cpu())
+            arc_fall_stds.append(coll[5].cpu())
+            arc_senses.append(coll[7].to(torch.int32).cpu())
+            node_start_end.append(coll[9].to(torch.int32).cpu())
+            p_mappings.append(coll[12].to(torch.int32).cpu())
+
+        node_offsets.append(node_offsets[-1] + node_indices[-1].numel())
+        arc_offsets.append(arc_offsets[-1] + (arc_rise_means[-1].numel() if level != 1 else 0))
+        se_offsets.append(se_offsets[-1] + (node_start_end[-1].numel() if level_kinds[-1] == 2 else 0))
+        pmap_offsets.append(pmap_offsets[-1] + (p_mappings[-1].numel() if level_kinds[-1] == 2 else 0))
+
+    flat = {
+        'level_kinds': torch.tensor(level_kinds, dtype=torch.int32),
+        'level_offsets': torch.stack([
+            torch.tensor(node_offsets, dtype=torch.int64),
+            torch.tensor(arc_offsets, dtype=torch.int64),
+            torch.tensor(se_offsets, dtype=torch.int64),
+            torch.tensor(pmap_offsets, dtype=torch.int64),
+        ]),
+        'node_indices': torch.cat(node_indices),
+        'parent_indices': torch.cat(parent_indices),
+        'arc_rise_means': torch.cat(arc_rise_means),
+        'arc_rise_stds': torch.cat(arc_rise_stds),
+        'arc_fall_means': torch.cat(arc_fall_means),
+        'arc_fall_stds': torch.cat(arc_fall_stds),
+        'arc_senses': torch.cat(arc_senses),
+        'node_start_end': torch.cat(node_start_end),
+        'p_mappings': torch.cat(p_mappings),
+    }
+    flat = {k: v.to(device) for k, v in flat.items()}
+
+    _flattened_collateral_cache[id(level_2_collaterals)] = flat
+    return flat
+
+
+@py_scope('move_collaterals_to_device')
+def move_collaterals_to_device(
+    level_2_collaterals: Dict,
+    device: torch.device,
+    use_pinned_staging: bool = True
+) -> Dict:
     """
     Move precomputed collaterals to a specified device
 
+    With use_pinned_staging (the default on CUDA devices), all per-level
+    tensors of a given dtype are packed into one pinned host buffer and
+    shipped with a single async H2D copy, and the device-side collaterals
+    become offset views into the transferred buffer. This replaces
+    thousands of small synchronous pageable copies with a few large
+    overlappable ones, and gives every level a stable base address (which
+    the CUDA Graph and out-of-core streaming paths rely on).
+
     Args:
         level_2_collaterals: Dictionary of collaterals by level
         device: Target device (CPU or CUDA)
+        use_pinned_staging: Stage through pinned memory with async copies
 
     Returns:
         Dictionary of collaterals moved to device
     """
+    from .memory import track
+
+    # Tagged so an OOM here (the single largest allocation burst of a
+    # run) is attributed to the collateral tables, not just traced
+    with track('collaterals'):
+        if str(device) == 'cpu' or not use_pinned_staging:
+            return _move_collaterals_to_device_eager(level_2_collaterals, device)
+        return _move_collaterals_pinned(level_2_collaterals, device)
+
+
+def _move_collaterals_pinned(level_2_collaterals: Dict, device: torch.device) -> Dict:
+    """Pinned-staging transfer path of move_collaterals_to_device"""
+    # --- pass 1: normalize lists and assign per-dtype offsets -------------
+    entries = []  # (level, idx_or_None, tensor, dtype, offset)
+    offsets = collections.defaultdict(int)
+
+    def register(level, idx, tensor):
+        dtype = tensor.dtype
+        entries.append((level, idx, tensor.contiguous(), dtype, offsets[dtype]))
+        offsets[dtype] += tensor.numel()
+
+    passthrough = {}
+    aliases = {}   # (level, idx) -> (level, idx) sharing one transfer
+    seen_tensors = {}
+    for level, objects in level_2_collaterals.items():
+        if level == 1:
+            register(level, None, objects)
+            continue
+        for idx, obj in enumerate(objects):
+            if isinstance(obj, torch.Tensor):
+                # Deduplicated fields (e.g. the unique-child tensor at
+                # cell positions 10 and 13) ship once and alias on device
+                if id(obj) in seen_tensors:
+                    aliases[(level, idx)] = seen_tensors[id(obj)]
+                else:
+                    seen_tensors[id(obj)] = (level, idx)
+                    register(level, idx, obj)
+            elif isinstance(obj, list) and obj and isinstance(obj[0], int):
+                register(level, idx, torch.tensor(obj))
+            else:
+                passthrough[(level, idx)] = obj
+
+    # --- pass 2: pack into pinned buffers, one async copy per dtype -------
+    device_buffers = {}
+    for dtype, total in offsets.items():
+        staging = torch.empty(total, dtype=dtype, pin_memory=True)
+        for level, idx, tensor, t_dtype, offset in entries:
+            if t_dtype == dtype:
+                staging[offset:offset + tensor.numel()].copy_(tensor.reshape(-1))
+        device_buffers[dtype] = staging.to(device, non_blocking=True)
+
+    # --- pass 3: rebuild the dict with device views -----------------------
+    new_level_2_collaterals = {}
+    views = {}
+    for level, idx, tensor, dtype, offset in entries:
+        views[(level, idx)] = device_buffers[dtype][offset:offset + tensor.numel()].view(tensor.shape)
+
+    for level, objects in level_2_collaterals.items():
+        if level == 1:
+            new_level_2_collaterals[level] = views[(level, None)]
+            continue
+        new_objects = []
+        for idx in range(len(objects)):
+            if (level, idx) in views:
+                new_objects.append(views[(level, idx)])
+            elif (level, idx) in aliases:
+                new_objects.append(views[aliases[(level, idx)]])
+            else:
+                new_objects.append(passthrough[(level, idx)])
+        new_level_2_collaterals[level] = new_objects
+
+    return new_level_2_collaterals
+
+
+def _move_collaterals_to_device_eager(level_2_collaterals: Dict, device: torch.device) -> Dict:
+    """Legacy per-tensor transfer (CPU target or pinned staging disabled)"""
     new_level_2_collaterals = {}
 
     for level, objects in level_2_collaterals.items():
@@ -549,11 +2482,15 @@ def move_collaterals_to_device(level_2_collaterals: Dict, device: torch.device)
             # Level 1 collaterals are just a single tensor
             new_level_2_collaterals[level] = objects.to(device)
         else:
-            # Other levels have a list of objects
+            # Other levels have a list of objects. Deduplicated fields
+            # (aliased tensor objects) move once and stay aliased.
+            moved = {}
             new_objects = []
             for obj in objects:
                 if isinstance(obj, torch.Tensor):
-                    new_objects.append(obj.to(device))
+                    if id(obj) not in moved:
+                        moved[id(obj)] = obj.to(device)
+                    new_objects.append(moved[id(obj)])
                 elif isinstance(obj, list) and isinstance(obj[0], int):
                     # Convert lists of integers to tensors where appropriate
                     new_objects.append(torch.tensor(obj, device=device))
@@ -0,0 +1,263 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/delay_model.py
+# @brief on-GPU load-dependent cell delay recomputation (NLDM-lite)
+
+import os
+import time
+import torch
+from typing import Any, Dict, Optional, Tuple
+
+
+class NldmDelayModel:
+    """
+    Per-libcell slew x load delay lookup tables resident on device
+
+    A placement change alters net caps, and refreshing cell_arcs.csv
+    through extraction plus the reference tool costs hours per loop. The
+    model here is deliberately coarse — one 2D (input slew, output load)
+    grid per libcell for each of rise/fall mean and std, bilinearly
+    interpolated with clamping at the grid edges — but it evaluates
+    entirely on device for every cell arc at once, so a load update flows
+    into the collaterals without leaving INSTA.
+
+    Tables load from a CSV with one grid point per row:
+        libCellName,slew,load,rise_mean,rise_std,fall_mean,fall_std
+    with optional output-slew columns rise_slew,fall_slew (and
+    rise_slew_std,fall_slew_std) that feed the slew propagation sweep.
+    Every libcell must supply a full slew x load grid; grids of differing
+    shapes are padded by edge replication (the clamped interpolation never
+    reads the padding as real data).
+    """
+
+    def __init__(self, libcell_names, slew_axes, load_axes, tables, device,
+                 slew_tables=None):
+        # slew_axes [C, S], load_axes [C, L] ascending per row;
+        # tables [C, 4, S, L] as (rise_mean, rise_std, fall_mean, fall_std);
+        # slew_tables, when present, [C, 4, S, L] as
+        # (rise_slew, rise_slew_std, fall_slew, fall_slew_std)
+        self.libcell_2_id = {name: idx for idx, name in enumerate(libcell_names)}
+        self.slew_axes = slew_axes.to(device)
+        self.load_axes = load_axes.to(device)
+        self.tables = tables.to(device)
+        self.slew_tables = slew_tables.to(device) if slew_tables is not None else None
+        self.device = device
+
+    @property
+    def has_slew_tables(self) -> bool:
+        return self.slew_tables is not None
+
+    @staticmethod
+    def from_csv(table_file: str, device: torch.device) -> Optional['NldmDelayModel']:
+        if not os.path.exists(table_file):
+            print(f'[delay model] error: cannot find table file {table_file}')
+            return None
+
+        import polars as pl
+
+        start_time = time.time()
+        df = pl.read_csv(table_file).sort(['libCellName', 'slew', 'load'])
+        names = df['libCellName'].unique(maintain_order=True).to_list()
+
+        delay_cols = ['rise_mean', 'rise_std', 'fall_mean', 'fall_std']
+        has_slew = 'rise_slew' in df.columns and 'fall_slew' in df.columns
+        slew_cols = []
+        if has_slew:
+            if 'rise_slew_std' not in df.columns:
+                df = df.with_columns(pl.lit(0.0).alias('rise_slew_std'),
+                                     pl.lit(0.0).alias('fall_slew_std'))
+            slew_cols = ['rise_slew', 'rise_slew_std',
+                         'fall_slew', 'fall_slew_std']
+
+        grids = []
+        max_s = max_l = 0
+        for name in names:
+            cell = df.filter(pl.col('libCellName') == name)
+            slews = cell['slew'].unique(maintain_order=True).to_list()
+            loads = cell['load'].unique(maintain_order=True).to_list()
+            assert cell.height == len(slews) * len(loads), \
+                f'libcell {name}: table is not a full slew x load grid'
+            values = torch.tensor(
+                cell.select(delay_cols + slew_cols).to_numpy(),
+                dtype=torch.float32)
+            grid = values.reshape(len(slews), len(loads), -1).permute(2, 0, 1)
+            grids.append((torch.tensor(slews, dtype=torch.float32),
+                          torch.tensor(loads, dtype=torch.float32), grid))
+            max_s = max(max_s, len(slews))
+            max_l = max(max_l, len(loads))
+
+        num_planes = len(delay_cols) + len(slew_cols)
+        slew_axes = torch.empty(len(names), max_s, dtype=torch.float32)
+        load_axes = torch.empty(len(names), max_l, dtype=torch.float32)
+        tables = torch.empty(len(names), num_planes, max_s, max_l,
+                             dtype=torch.float32)
+        for idx, (slews, loads, grid) in enumerate(grids):
+            s, l = slews.numel(), loads.numel()
+            # Edge replication keeps the padded rows sorted and harmless
+            # under clamped interpolation
+            slew_axes[idx, :s] = slews
+            slew_axes[idx, s:] = slews[-1]
+            load_axes[idx, :l] = loads
+            load_axes[idx, l:] = loads[-1]
+            tables[idx, :, :s, :l] = grid
+            tables[idx, :, s:, :l] = grid[:, -1:, :]
+            tables[idx, :, :, l:] = tables[idx, :, :, l - 1:l]
+
+        slew_tables = tables[:, 4:] if has_slew else None
+        print(f'[delay model] {len(names)} libcells '
+              f'({max_s}x{max_l} grids'
+              f'{", with output-slew tables" if has_slew else ""}) '
+              f'in {time.time() - start_time:.2f} seconds')
+        return NldmDelayModel(names, slew_axes, load_axes, tables[:, :4],
+                              device, slew_tables=slew_tables)
+
+    def _axis_interp(self, axes: torch.Tensor, x: torch.Tensor):
+        """Per-row bracketing indices and clamped fraction on [C_sel, A] axes"""
+        hi = torch.searchsorted(axes.contiguous(), x.unsqueeze(1)).squeeze(1)
+        hi = hi.clamp(1, axes.size(1) - 1)
+        lo = hi - 1
+        x0 = axes.gather(1, lo.unsqueeze(1)).squeeze(1)
+        x1 = axes.gather(1, hi.unsqueeze(1)).squeeze(1)
+        frac = ((x - x0) / (x1 - x0).clamp_min(1e-12)).clamp(0.0, 1.0)
+        return lo, hi, frac
+
+    def lookup(self, libcell_ids: torch.Tensor, slews: torch.Tensor,
+               loads: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        """
+        Batched bilinear delay lookup
+
+        libcell_ids/slews/loads are [N] aligned vectors; returns four [N]
+        float32 vectors (rise_mean, rise_std, fall_mean, fall_std). All
+        gathers and the interpolation run on device.
+        """
+        return self._interpolate(self.tables, libcell_ids, slews, loads)
+
+    def lookup_slew(self, libcell_ids: torch.Tensor, slews: torch.Tensor,
+                    loads: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        """
+        Batched bilinear output-slew lookup; returns
+        (rise_slew, rise_slew_std, fall_slew, fall_slew_std) [N] vectors
+        """
+        assert self.slew_tables is not None, \
+            'delay model table file carried no rise_slew/fall_slew columns'
+        return self._interpolate(self.slew_tables, libcell_ids, slews, loads)
+
+    def _interpolate(self, tables: torch.Tensor, libcell_ids: torch.Tensor,
+                     slews: torch.Tensor,
+                     loads: torch.Tensor) -> Tuple[torch.Tensor, ...]:
+        ids = libcell_ids.to(torch.long)
+        s_lo, s_hi, s_frac = self._axis_interp(self.slew_axes[ids],
+                                               slews.to(torch.float32))
+        l_lo, l_hi, l_frac = self._axis_interp(self.load_axes[ids],
+                                               loads.to(torch.float32))
+
+        num_loads = tables.size(3)
+        flat = tables[ids].reshape(ids.numel(), 4, -1)
+
+        def _corner(s_idx, l_idx):
+            loc = (s_idx * num_loads + l_idx).view(-1, 1, 1).expand(-1, 4, 1)
+            return flat.gather(2, loc).squeeze(2)  # [N, 4]
+
+        s_frac = s_frac.unsqueeze(1)
+        l_frac = l_frac.unsqueeze(1)
+        values = (_corner(s_lo, l_lo) * (1 - s_frac) * (1 - l_frac) +
+                  _corner(s_hi, l_lo) * s_frac * (1 - l_frac) +
+                  _corner(s_lo, l_hi) * (1 - s_frac) * l_frac +
+                  _corner(s_hi, l_hi) * s_frac * l_frac)
+        return values[:, 0], values[:, 1], values[:, 2], values[:, 3]
+
+
+def build_cell_arc_delay_index(
+    cell_arc_2_collateral_loc: Dict,
+    cellName_2_orgLibCell: Dict[str, str],
+    pinName_2_Gid: Dict[str, int],
+    libcell_2_id: Dict[str, int],
+    device: torch.device
+) -> Dict[int, Tuple[torch.Tensor, torch.Tensor, torch.Tensor]]:
+    """
+    One-time map from cell-arc collateral rows to model inputs
+
+    Walks cell_arc_2_collateral_loc (string keys, host) once and emits
+    per-level device tensors: the collateral row positions, the arc's
+    libcell id in the model, and the gid of the driving output pin whose
+    net load keys the lookup. Arcs whose cell or libcell is unknown to
+    the model are skipped (their parsed delays stay untouched), matching
+    how patch_collateral_delays ignores unknown keys.
+    """
+    per_level: Dict[int, Tuple[list, list, list]] = {}
+    skipped = 0
+    for (fromPin, toPin, _sense), (level, pos) in cell_arc_2_collateral_loc.items():
+        cellName = '/'.join(toPin.split('/')[:-1])
+        libCell = cellName_2_orgLibCell.get(cellName, '').split('/')[-1]
+        libcell_id = libcell_2_id.get(libCell)
+        gid = pinName_2_Gid.get(toPin)
+        if libcell_id is None or gid is None:
+            skipped += 1
+            continue
+        rows, ids, gids = per_level.setdefault(level, ([], [], []))
+        rows.append(pos)
+        ids.append(libcell_id)
+        gids.append(gid)
+
+    index = {}
+    for level, (rows, ids, gids) in per_level.items():
+        index[level] = (torch.tensor(rows, dtype=torch.long, device=device),
+                        torch.tensor(ids, dtype=torch.long, device=device),
+                        torch.tensor(gids, dtype=torch.long, device=device))
+    covered = sum(rows.numel() for rows, _, _ in index.values())
+    print(f'[delay model] index covers {covered} cell arcs '
+          f'({skipped} without tables)')
+    return index
+
+
+def recompute_cell_arc_delays(
+    level_2_collaterals: Dict[int, Any],
+    delay_index: Dict[int, Tuple[torch.Tensor, torch.Tensor, torch.Tensor]],
+    model: NldmDelayModel,
+    gid_2_load: torch.Tensor,
+    gid_2_slew: Optional[torch.Tensor] = None,
+    nominal_slew: float = 0.05
+) -> int:
+    """
+    Refresh cell-arc mean/std columns from per-net loads, on device
+
+    gid_2_load is a dense [max_gid] tensor of the load seen at each
+    driving output pin (placement supplies it after every move). Slews
+    come from gid_2_slew when a slew propagation has produced one (see
+    the slew planes) and fall back to a nominal value otherwise — the
+    coarse mode that still beats an hours-long extraction round trip.
+    Updates scatter straight into the prepared collateral columns via
+    index_copy_, so the next sweep consumes them with no rebuild.
+
+    Returns:
+        Number of cell arcs recomputed
+    """
+    start_time = time.time()
+    updated = 0
+    for level, (rows, libcell_ids, driver_gids) in delay_index.items():
+        coll = level_2_collaterals[level]
+        loads = gid_2_load[driver_gids]
+        if gid_2_slew is not None:
+            slews = gid_2_slew[driver_gids]
+        else:
+            slews = torch.full_like(loads, nominal_slew)
+        rise_mean, rise_std, fall_mean, fall_std = model.lookup(
+            libcell_ids, slews, loads)
+        float_dtype = coll[1].dtype
+        coll[1].index_copy_(0, rows, rise_mean.to(float_dtype))
+        coll[2].index_copy_(0, rows, rise_std.to(float_dtype))
+        coll[4].index_copy_(0, rows, fall_mean.to(float_dtype))
+        coll[5].index_copy_(0, rows, fall_std.to(float_dtype))
+        updated += rows.numel()
+
+    print(f'[delay model] recomputed {updated} cell arcs '
+          f'in {time.time() - start_time:.2f} seconds')
+    return updated
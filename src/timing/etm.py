@@ -0,0 +1,139 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/etm.py
+# @brief interface-timing (ETM-style) block abstraction for top-level runs
+
+import os
+import time
+import torch
+from typing import Dict, Iterable, List, Optional, Tuple
+
+
+def extract_interface_timing(
+    timing_tensors: Dict[str, torch.Tensor],
+    pinName_2_Gid: Dict[str, int],
+    Gid_2_pinName: Dict[int, str],
+    boundary_in_pins: Iterable[str],
+    boundary_out_pins: Iterable[str],
+    max_gid: int,
+    sigma: float = 3.0
+) -> Dict[Tuple[str, str], Tuple[float, float, float, float]]:
+    """
+    Distill an analyzed block into boundary input -> output arcs
+
+    The topK candidate planes already carry per-candidate startpoint
+    tracking (Gid_2_rise/fall_startpoints), so after one eval sweep the
+    attribution is a gather: for every boundary output, each candidate
+    whose recorded startpoint is a boundary input yields a through-block
+    path. Means subtract the input's seed arrival and stds decompose by
+    root-sum-square (path_std^2 = arrival_std^2 - seed_std^2, clamped),
+    inverting the composition the sweep applied. Per (input, output)
+    pair the worst mean + sigma*std path survives. Inputs that never
+    appear in an output's topK are dominated at that output by more than
+    the full candidate spread and are dropped — raise topK on the block
+    run if interface coverage matters more than memory.
+
+    Returns:
+        (from_pin, to_pin) -> (rise_mean, rise_std, fall_mean, fall_std)
+    """
+    start_time = time.time()
+    in_gids = [pinName_2_Gid[p] for p in boundary_in_pins if p in pinName_2_Gid]
+    out_gids = [pinName_2_Gid[p] for p in boundary_out_pins if p in pinName_2_Gid]
+    assert in_gids and out_gids, 'no boundary pins map to graph pins'
+
+    device = timing_tensors['Gid_2_rise_arrival_mean'].device
+    is_boundary_in = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    is_boundary_in[torch.tensor(in_gids, dtype=torch.long, device=device)] = True
+    outs = torch.tensor(out_gids, dtype=torch.long, device=device)
+    sp_mean = timing_tensors['sp_mean_tensor'].to(device)
+    sp_std = timing_tensors['sp_std_tensor'].to(device)
+
+    interface_arcs: Dict[Tuple[str, str], List[Optional[Tuple[float, float]]]] = {}
+    for polarity, slot in (('rise', 0), ('fall', 1)):
+        means = timing_tensors[f'Gid_2_{polarity}_arrival_mean'][outs]
+        stds = timing_tensors[f'Gid_2_{polarity}_arrival_std'][outs]
+        sps = timing_tensors[f'Gid_2_{polarity}_startpoints'][outs].to(torch.long)
+        if means.dim() == 1:  # K=1 flat planes
+            means, stds, sps = (means.unsqueeze(1), stds.unsqueeze(1),
+                                sps.unsqueeze(1))
+        valid = (sps >= 0) & torch.isfinite(means)
+        keep = valid & is_boundary_in[sps.clamp(min=0)]
+
+        seed_mean = sp_mean[sps.clamp(min=0)].to(torch.float32)
+        seed_std = sp_std[sps.clamp(min=0)].to(torch.float32)
+        path_mean = means.to(torch.float32) - seed_mean
+        path_std = torch.sqrt(
+            (stds.to(torch.float32) ** 2 - seed_std ** 2).clamp_min(0.0))
+        score = path_mean + sigma * path_std
+
+        rows, cols = torch.nonzero(keep, as_tuple=True)
+        entries = zip(rows.tolist(), sps[rows, cols].tolist(),
+                      path_mean[rows, cols].tolist(),
+                      path_std[rows, cols].tolist(),
+                      score[rows, cols].tolist())
+        for out_row, sp_gid, mean, std, arc_score in entries:
+            key = (Gid_2_pinName[sp_gid], Gid_2_pinName[out_gids[out_row]])
+            record = interface_arcs.setdefault(key, [None, None])
+            if record[slot] is None or arc_score > record[slot][0]:
+                record[slot] = (arc_score, mean, std)
+
+    result = {}
+    for key, (rise, fall) in interface_arcs.items():
+        # A pair seen in only one polarity mirrors it into the other:
+        # better a symmetric pessimistic arc than a hole in the model
+        rise = rise or fall
+        fall = fall or rise
+        result[key] = (rise[1], rise[2], fall[1], fall[2])
+
+    print(f'[etm] {len(result)} interface arcs from {len(in_gids)} inputs x '
+          f'{len(out_gids)} outputs in {time.time() - start_time:.2f} seconds')
+    return result
+
+
+def write_interface_arcs(
+    interface_arcs: Dict[Tuple[str, str], Tuple[float, float, float, float]],
+    file_path: str,
+    scale: float = 1.0
+) -> int:
+    """
+    Export interface arcs in the cell_arcs.csv POCV input schema
+
+    The emitted file is a regular insta_inputs arc table — a top-level
+    instance ingests it through read_cell_arc_file with no special
+    casing, modeling each characterized block as one cell whose
+    boundary pins carry the distilled through-block arcs.
+    """
+    import polars as pl
+
+    rows = {
+        'from_pin.full_name': [], 'to_pin.full_name': [], 'sense': [],
+        'delay_max_rise': [], 'delay_max_fall': [],
+        'variation_delay_max_rise.mean': [],
+        'variation_delay_max_rise.std_dev': [],
+        'variation_delay_max_fall.mean': [],
+        'variation_delay_max_fall.std_dev': [],
+    }
+    for (from_pin, to_pin), (rise_mean, rise_std,
+                             fall_mean, fall_std) in interface_arcs.items():
+        rows['from_pin.full_name'].append(from_pin)
+        rows['to_pin.full_name'].append(to_pin)
+        rows['sense'].append('positive_unate')
+        rows['delay_max_rise'].append((rise_mean + 3.0 * rise_std) * scale)
+        rows['delay_max_fall'].append((fall_mean + 3.0 * fall_std) * scale)
+        rows['variation_delay_max_rise.mean'].append(rise_mean * scale)
+        rows['variation_delay_max_rise.std_dev'].append(rise_std * scale)
+        rows['variation_delay_max_fall.mean'].append(fall_mean * scale)
+        rows['variation_delay_max_fall.std_dev'].append(fall_std * scale)
+
+    os.makedirs(os.path.dirname(os.path.abspath(file_path)), exist_ok=True)
+    pl.DataFrame(rows).write_csv(file_path)
+    print(f'[etm] wrote {len(interface_arcs)} arcs to {file_path}')
+    return len(interface_arcs)
@@ -0,0 +1,191 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/exceptions.py
+# @brief False-path / multicycle exceptions compiled into tag planes
+
+import time
+import torch
+from typing import Dict, List, Optional, Sequence, Tuple, Any
+
+# one compiled batch packs its tags into a single int64 bitset plane
+MAX_TAGS_PER_BATCH = 64
+
+
+def compile_exceptions(
+    exceptions: List[Dict[str, Any]],
+    cone_selector,
+    max_gid: int,
+    num_hops: int,
+    period: float = 1.0,
+    device: Optional[torch.device] = None
+) -> Dict[str, torch.Tensor]:
+    """
+    Resolve -from/-through/-to exception specs into per-node tag masks
+
+    Each exception becomes one tag. Its node mask is the classic
+    STA resolution against the CSR graph: forward reach of the -from
+    set, intersected with backward reach of the -to set, intersected
+    (when -through pins are given) with nodes that can see a through
+    pin in either direction. A node carries the tag iff it can lie on
+    a matching path, so the mask is exact for from/to and the standard
+    conservative approximation for through chains.
+
+    Args:
+        exceptions: Dicts with 'type' ('false_path' or 'multicycle'),
+            'from'/'through'/'to' gid sequences (each optional, empty
+            means unconstrained) and 'multiplier' for multicycle
+        cone_selector: ConeSelector over the design CSR adjacency
+        max_gid: Graph size
+        num_hops: Reachability hop bound (the level count; expansion
+            early-exits once frontiers empty)
+        period: Clock period for multicycle required-time credits
+
+    Returns:
+        Dict with 'node_masks' / 'from_masks' (bool [max_gid, T]) and
+        'adjustments' (float [T]): required-time credit per tag, +inf
+        for false paths, (multiplier-1)*period for multicycle
+    """
+    assert len(exceptions) <= MAX_TAGS_PER_BATCH, \
+        f'compile at most {MAX_TAGS_PER_BATCH} exceptions per batch'
+    num_tags = len(exceptions)
+    node_masks = torch.zeros(max_gid, num_tags, dtype=torch.bool)
+    from_masks = torch.zeros(max_gid, num_tags, dtype=torch.bool)
+    adjustments = torch.zeros(num_tags, dtype=torch.float32)
+
+    for tag, exc in enumerate(exceptions):
+        from_gids = list(exc.get('from', ()))
+        through_gids = list(exc.get('through', ()))
+        to_gids = list(exc.get('to', ()))
+
+        if from_gids:
+            mask = cone_selector.expand(from_gids, num_hops, 'forward').cpu()
+            from_masks[from_gids, tag] = True
+        else:
+            mask = torch.ones(max_gid, dtype=torch.bool)
+            from_masks[:, tag] = True
+        if to_gids:
+            mask &= cone_selector.expand(to_gids, num_hops, 'backward').cpu()
+        if through_gids:
+            mask &= (cone_selector.expand(through_gids, num_hops, 'forward').cpu()
+                     | cone_selector.expand(through_gids, num_hops, 'backward').cpu())
+        node_masks[:, tag] = mask
+        from_masks[:, tag] &= mask
+
+        if exc['type'] == 'false_path':
+            adjustments[tag] = float('inf')
+        elif exc['type'] == 'multicycle':
+            adjustments[tag] = (exc['multiplier'] - 1) * period
+        else:
+            raise ValueError(f"unknown exception type: {exc['type']}")
+
+    if device is not None:
+        node_masks = node_masks.to(device)
+        from_masks = from_masks.to(device)
+        adjustments = adjustments.to(device)
+    return {
+        'node_masks': node_masks,
+        'from_masks': from_masks,
+        'adjustments': adjustments,
+    }
+
+
+def propagate_exception_tags(
+    level_2_collaterals: Dict[int, Any],
+    compiled: Dict[str, torch.Tensor],
+    max_gid: int,
+    device: torch.device,
+    inPinMod: int = 1
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Sweep the compiled tags forward along the level schedule
+
+    A pin ends up tagged iff some startpoint-to-pin prefix stays inside
+    the exception's node mask the whole way, which is exactly "this pin
+    lies on a live path of the exception". The sweep is one gather and
+    one amax scatter per level, vectorized across all tags: scatter
+    reductions have no bitwise OR, so each tag rides its own uint8 lane
+    and the lanes pack into the int64 bitset plane at the end.
+
+    Returns:
+        (tag_lanes uint8 [max_gid, T], Gid_2_exception_tags int64
+        [max_gid] with bit t set where tag t is live)
+    """
+    start_time = time.time()
+    num_tags = compiled['adjustments'].numel()
+    node_lanes = compiled['node_masks'].to(device).to(torch.uint8)
+    tags = torch.zeros(max_gid, num_tags, dtype=torch.uint8, device=device)
+
+    for level in sorted(level_2_collaterals.keys()):
+        coll = level_2_collaterals[level]
+        if level == 1:
+            sps = coll.to(device=device, dtype=torch.int64)
+            tags[sps] = compiled['from_masks'].to(device)[sps].to(torch.uint8)
+        elif level % 2 == inPinMod:  # net arcs
+            children = coll[0].to(device=device, dtype=torch.int64)
+            parents = coll[1].to(device=device, dtype=torch.int64)
+            cand = tags[parents] * node_lanes[children]
+            tags.index_reduce_(0, children, cand, 'amax')
+        else:  # cell arcs
+            children = coll[0]
+            if not torch.is_tensor(children):
+                children = torch.tensor(children, dtype=torch.int64)
+            children = children.to(device=device, dtype=torch.int64)
+            parents = coll[8].to(device=device, dtype=torch.int64)
+            cand = tags[parents] * node_lanes[children]
+            tags.index_reduce_(0, children, cand, 'amax')
+
+    weights = (torch.ones(num_tags, dtype=torch.int64, device=device)
+               << torch.arange(num_tags, dtype=torch.int64, device=device))
+    packed = (tags.to(torch.int64) * weights).sum(dim=1)
+    print(f'[exceptions] propagated {num_tags} tags in '
+          f'{time.time() - start_time:.3f} seconds')
+    return tags, packed
+
+
+def exception_required_credits(
+    tag_lanes: torch.Tensor,
+    compiled: Dict[str, torch.Tensor],
+    timing_tensors: Dict[str, torch.Tensor]
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Per-endpoint required-time credits from the live exception tags
+
+    A tag relaxes an endpoint edge only when the endpoint is live for
+    the tag AND the edge's tracked worst startpoint sits in the tag's
+    -from set — the startpoint planes the propagation already maintains
+    pin the credit to the path the slack actually reports, instead of
+    crediting any endpoint some excepted path merely reaches. Credits
+    combine by max: a false path (+inf) dominates any multicycle.
+
+    Returns:
+        (rise_credit, fall_credit): [num_endpoints] tensors aligned
+        with dest_node_tensor, >= 0, to add to the required times
+    """
+    device = tag_lanes.device
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    adjustments = compiled['adjustments'].to(device)
+    from_masks = compiled['from_masks'].to(device)
+
+    ep_tags = tag_lanes[dest].bool()  # [E, T]
+
+    credits = []
+    for plane in ('Gid_2_rise_startpoints', 'Gid_2_fall_startpoints'):
+        sps = timing_tensors[plane][dest]
+        if sps.ndim > 1:
+            sps = sps[:, 0]
+        sps = sps.to(torch.long)
+        valid_sp = sps >= 0
+        applicable = ep_tags & from_masks[sps.clamp(min=0)] \
+            & valid_sp.unsqueeze(1)
+        credit = torch.where(applicable, adjustments.unsqueeze(0),
+                             torch.zeros_like(adjustments).unsqueeze(0))
+        credits.append(credit.amax(dim=1))
+    return credits[0], credits[1]
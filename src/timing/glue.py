@@ -0,0 +1,207 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/glue.py
+# @brief compile-friendly elementwise glue between the custom kernels
+
+import torch
+from typing import Callable, Dict
+
+# The eager-mode math between the custom kernels — the net-arc level
+# chain, the endpoint slack reduction, the CPPR candidate scan — is a
+# handful of elementwise ops each, and inductor can fuse every chain
+# into one kernel. Each function below has no data-dependent Python
+# control flow (shape/dtype decisions stay at the call sites, where they
+# are static per level), so torch.compile can capture it whole. Most are
+# pure in their tensor arguments; the *_epilogue chains additionally
+# index_copy_ into the arrival planes they are passed — keeping the
+# scatter inside the captured region lets inductor fuse compute and
+# scatter, so the per-level cur_* temporaries never reach global memory.
+# Call sites dispatch through glue(name); by default that is the eager
+# function itself, and enable_compiled_glue swaps in
+# torch.compile-wrapped versions with graceful fallback to eager on any
+# compilation or runtime failure.
+
+_glue_fns: Dict[str, Callable] = {}
+_active: Dict[str, Callable] = {}
+
+
+def _glue_fn(name: str):
+    def register(fn):
+        _glue_fns[name] = fn
+        _active[name] = fn
+        return fn
+    return register
+
+
+def glue(name: str) -> Callable:
+    """The active (eager or compiled) implementation of one glue chain"""
+    return _active[name]
+
+
+@_glue_fn('net_arc_pocv')
+def _net_arc_pocv(p_mean, p_std, arc_mean, arc_std,
+                  sigma: float, acc_dtype, out_dtype):
+    """
+    One polarity of the net-arc level: delay add, RSS std update, sigma
+    corner. The std accumulates in acc_dtype (fp32 under half-precision
+    sweeps). sigma is a Python float and therefore a compile-time
+    constant — a sigma sweep recompiles once per value, which is the
+    trade for keeping the chain a single fused kernel.
+    """
+    cur_mean = arc_mean + p_mean
+    cur_std = torch.sqrt(torch.pow(p_std.to(acc_dtype), 2)
+                         + torch.pow(arc_std.to(acc_dtype), 2)).to(out_dtype)
+    return cur_mean, cur_std, torch.add(cur_mean, cur_std, alpha=sigma)
+
+
+@_glue_fn('net_arc_epilogue')
+def _net_arc_epilogue(plane_mean, plane_std, plane_arrival,
+                      p_mean, p_std, arc_mean, arc_std,
+                      c_idx, sigma: float, acc_dtype, out_dtype):
+    """
+    net_arc_pocv with the plane scatters inside the captured region:
+    the three cur_* results exist only to land at c_idx, so compiled
+    this is one gather-compute-scatter kernel per polarity instead of a
+    compute chain plus three index_copy_ launches, and eager it costs
+    exactly what the two-step form did.
+    """
+    cur_mean = arc_mean + p_mean
+    cur_std = torch.sqrt(torch.pow(p_std.to(acc_dtype), 2)
+                         + torch.pow(arc_std.to(acc_dtype), 2)).to(out_dtype)
+    plane_mean.index_copy_(0, c_idx, cur_mean)
+    plane_std.index_copy_(0, c_idx, cur_std)
+    plane_arrival.index_copy_(0, c_idx,
+                              torch.add(cur_mean, cur_std, alpha=sigma))
+
+
+@_glue_fn('net_arc_fast_epilogue')
+def _net_arc_fast_epilogue(pair_mean, pair_std, pair_arrival,
+                           arc_means, arc_stds, p_idx, c_idx,
+                           sigma: float):
+    """
+    The 2-wide net fast path as one captured region: gather the parent
+    pair rows, apply the delay add / RSS update on the gathered copies,
+    scatter to the child rows. Eager this mirrors the in-place sequence
+    it replaced; compiled, the gathered copies are fused away.
+    """
+    cur_means = pair_mean.index_select(1, p_idx).add_(arc_means)
+    cur_stds = pair_std.index_select(1, p_idx).hypot_(arc_stds)
+    pair_mean.index_copy_(1, c_idx, cur_means)
+    pair_std.index_copy_(1, c_idx, cur_stds)
+    pair_arrival.index_copy_(1, c_idx,
+                             torch.add(cur_means, cur_stds, alpha=sigma))
+
+
+@_glue_fn('cell_arc_epilogue')
+def _cell_arc_epilogue(plane_rise_mean, plane_rise_std, plane_rise_arrival,
+                       plane_fall_mean, plane_fall_std, plane_fall_arrival,
+                       cur_rise_means, cur_rise_stds,
+                       cur_fall_means, cur_fall_stds,
+                       c_idx, sigma_tensor):
+    """
+    Cell-level plane epilogue: the sigma-corner addcmuls (reading the
+    runtime device scalar, so sigma sweeps do not recompile) and the six
+    value scatters in one captured region — the arrival corners are
+    fused into their scatters and the six launches coalesce.
+    """
+    plane_rise_mean.index_copy_(0, c_idx, cur_rise_means)
+    plane_rise_std.index_copy_(0, c_idx, cur_rise_stds)
+    plane_fall_mean.index_copy_(0, c_idx, cur_fall_means)
+    plane_fall_std.index_copy_(0, c_idx, cur_fall_stds)
+    plane_rise_arrival.index_copy_(
+        0, c_idx, torch.addcmul(cur_rise_means, cur_rise_stds, sigma_tensor))
+    plane_fall_arrival.index_copy_(
+        0, c_idx, torch.addcmul(cur_fall_means, cur_fall_stds, sigma_tensor))
+
+
+@_glue_fn('endpoint_slack')
+def _endpoint_slack(ep_rise_arrival, ep_fall_arrival,
+                    rise_required, fall_required):
+    """Endpoint slack components plus the negative-masked WNS/TNS
+    reduction, all device-side"""
+    ep_rise_slack = rise_required - ep_rise_arrival
+    ep_fall_slack = fall_required - ep_fall_arrival
+    ep_slack = torch.minimum(ep_rise_slack, ep_fall_slack)
+    negative = (ep_slack < 0) & torch.isfinite(ep_slack)
+    masked = torch.where(negative, ep_slack, torch.zeros_like(ep_slack))
+    return ep_rise_slack, ep_fall_slack, ep_slack, \
+        masked.min(), masked.to(torch.float32).sum()
+
+
+@_glue_fn('cppr_candidate')
+def _cppr_candidate(ep_rise_rows, ep_fall_rows,
+                    ep_rise_arrival, ep_fall_arrival,
+                    ep_rise_sps, ep_fall_sps,
+                    golden_rise, golden_fall,
+                    rise_required, fall_required):
+    """Golden-startpoint candidate scan over the [E, K] arrival rows and
+    the corrected-slack reduction (see calculate_slack_fused)"""
+    rise_match = ep_rise_sps == golden_rise.unsqueeze(1)
+    fall_match = ep_fall_sps == golden_fall.unsqueeze(1)
+    rise_take = (golden_rise >= 0) & rise_match.any(dim=1)
+    fall_take = (golden_fall >= 0) & fall_match.any(dim=1)
+    rise_slot = torch.argmax(rise_match.to(torch.int8), dim=1)
+    fall_slot = torch.argmax(fall_match.to(torch.int8), dim=1)
+    corr_rise = torch.where(
+        rise_take,
+        ep_rise_rows.gather(1, rise_slot.unsqueeze(1)).squeeze(1),
+        ep_rise_arrival)
+    corr_fall = torch.where(
+        fall_take,
+        ep_fall_rows.gather(1, fall_slot.unsqueeze(1)).squeeze(1),
+        ep_fall_arrival)
+    ep_cppr_slack = torch.minimum(rise_required - corr_rise,
+                                  fall_required - corr_fall)
+    negative = (ep_cppr_slack < 0) & torch.isfinite(ep_cppr_slack)
+    masked = torch.where(negative, ep_cppr_slack,
+                         torch.zeros_like(ep_cppr_slack))
+    return ep_cppr_slack, masked.min(), masked.to(torch.float32).sum()
+
+
+def _guarded(name: str, compiled: Callable, eager: Callable) -> Callable:
+    """First runtime failure of a compiled chain demotes it to eager for
+    the rest of the process (inductor errors surface at first call, not
+    at wrap time)"""
+    def call(*args, **kwargs):
+        try:
+            return compiled(*args, **kwargs)
+        except Exception as e:
+            print(f'[compile glue] {name} fell back to eager: {e}')
+            _active[name] = eager
+            return eager(*args, **kwargs)
+    return call
+
+
+def enable_compiled_glue(enable: bool = True) -> bool:
+    """
+    Swap the glue chains for torch.compile-wrapped versions (or back)
+
+    dynamic=False: the propagation calls each chain once per level with
+    that level's fixed shapes, so per-shape specialization is exactly
+    what we want. Returns whether compiled dispatch is active; any
+    failure (old torch, missing inductor backend) leaves the eager
+    functions in place.
+    """
+    if not enable:
+        _active.update(_glue_fns)
+        return False
+    compiler = getattr(torch, 'compile', None)
+    if compiler is None:
+        print('[compile glue] torch.compile unavailable, staying eager')
+        return False
+    try:
+        for name, fn in _glue_fns.items():
+            _active[name] = _guarded(name, compiler(fn, dynamic=False), fn)
+    except Exception as e:
+        print(f'[compile glue] compilation setup failed, staying eager: {e}')
+        _active.update(_glue_fns)
+        return False
+    return True
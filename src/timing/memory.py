@@ -0,0 +1,405 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/memory.py
+# @brief per-subsystem GPU memory accounting for OOM triage
+
+import os
+import contextlib
+import torch
+from typing import Any, Dict, List, Optional
+
+# Accounting is opt-in (INSTA_MEM=1 or MemoryTracker.enable()): each
+# tagged region snapshots torch.cuda.memory_stats at its boundaries,
+# which is a host call we do not want inside the sweep by default
+_ENABLED = os.environ.get('INSTA_MEM', '0') not in ('', '0', 'false', 'False')
+
+# Strict allocation checking (INSTA_STRICT_ALLOC=1 or
+# enable_strict_alloc()): the steady-state propagation path promises no
+# allocator churn, and regressions there only show up as p95 latency
+# jumps when caching-allocator misses start landing under fragmentation.
+# The guard below turns such a regression into an immediate failure that
+# names the phase (and, when the allocator's history recorder is
+# available, the allocating stack).
+_STRICT_ALLOC = os.environ.get('INSTA_STRICT_ALLOC', '0') \
+    not in ('', '0', 'false', 'False')
+
+
+class MemoryTracker:
+    """
+    Attribute GPU memory to subsystems so an OOM names its culprit
+
+    Allocation sites tag themselves with track('collaterals'),
+    track('arrival planes'), track('cppr tables'), ... Each tagged
+    region snapshots torch.cuda.memory_stats at entry and exit and
+    records, per subsystem: the net bytes retained across the region
+    (what the structure holds onto), the allocator high-water mark
+    reached inside it, and the reserved-minus-allocated gap at exit
+    (fragmentation — memory the caching allocator holds but cannot
+    serve the failing request from). Regions nest; retained bytes are
+    attributed to the innermost tag.
+
+    When a tagged region dies with torch.cuda.OutOfMemoryError the
+    per-subsystem watermark table is printed before the exception
+    propagates, so the farm log of an OOM run shows which structure
+    consumed what instead of a bare allocator traceback.
+    """
+
+    def __init__(self, device: Optional[torch.device] = None):
+        self.device = device
+        self.subsystems: Dict[str, Dict[str, Any]] = {}
+        self._stack: List[str] = []
+
+    # ------------------------------ snapshots -------------------------------
+
+    def _usable(self) -> bool:
+        return torch.cuda.is_available() and \
+            (self.device is None or str(self.device).startswith('cuda'))
+
+    def _stats(self) -> Dict[str, int]:
+        stats = torch.cuda.memory_stats(self.device)
+        return {
+            'allocated': stats.get('allocated_bytes.all.current', 0),
+            'reserved': stats.get('reserved_bytes.all.current', 0),
+            'peak': stats.get('allocated_bytes.all.peak', 0)
+        }
+
+    # ------------------------------- tagging --------------------------------
+
+    @contextlib.contextmanager
+    def track(self, subsystem: str):
+        if not (_ENABLED and self._usable()):
+            yield
+            return
+        entry = self._stats()
+        self._stack.append(subsystem)
+        try:
+            yield
+        except torch.cuda.OutOfMemoryError:
+            self.print_table(oom_in=subsystem)
+            raise
+        finally:
+            self._stack.pop()
+        exit_ = self._stats()
+        record = self.subsystems.setdefault(subsystem, {
+            'retained': 0, 'watermark': 0, 'fragmentation': 0, 'events': 0
+        })
+        record['retained'] += exit_['allocated'] - entry['allocated']
+        record['watermark'] = max(record['watermark'], exit_['peak'])
+        record['fragmentation'] = exit_['reserved'] - exit_['allocated']
+        record['events'] += 1
+
+    # ------------------------------ reporting -------------------------------
+
+    def print_table(self, oom_in: Optional[str] = None) -> None:
+        """Per-subsystem watermark table; called automatically on OOM"""
+        if oom_in is not None:
+            nesting = ' > '.join(self._stack) or oom_in
+            print(f'[memory tracker] CUDA OOM inside: {nesting}')
+        print(f"[memory tracker] {'subsystem':<24} {'retained':>10} "
+              f"{'watermark':>10} {'fragment':>10} {'events':>7}")
+        for name in sorted(self.subsystems,
+                           key=lambda n: -self.subsystems[n]['retained']):
+            record = self.subsystems[name]
+            print(f"[memory tracker] {name:<24} "
+                  f"{record['retained'] / 1e9:>8.2f}GB "
+                  f"{record['watermark'] / 1e9:>8.2f}GB "
+                  f"{record['fragmentation'] / 1e9:>8.2f}GB "
+                  f"{record['events']:>7}")
+        if self._usable():
+            stats = self._stats()
+            print(f"[memory tracker] allocator now: "
+                  f"{stats['allocated'] / 1e9:.2f}GB allocated, "
+                  f"{stats['reserved'] / 1e9:.2f}GB reserved, "
+                  f"{stats['peak'] / 1e9:.2f}GB peak")
+
+    def report(self) -> Dict[str, Dict[str, Any]]:
+        return {name: dict(record)
+                for name, record in self.subsystems.items()}
+
+
+class AllocationGuard:
+    """
+    Fail fast when a supposedly allocation-free phase hits the allocator
+
+    The eval hot path (PropagationContext.run) is written so repeated
+    calls reuse every tensor: we keep regressing that promise with
+    innocuous-looking edits (a torch.tensor([sigma]) per call, a fresh
+    cur_rise_* temporary) and only notice when p95 latency jumps from
+    caching-allocator misses under fragmentation. Each guarded phase
+    snapshots the torch.cuda.memory_stats allocation counters at its
+    boundaries; the first strict run records each phase's steady-state
+    counts as its baseline (torch-formulated phases like the fused slack
+    legitimately allocate a fixed set of temporaries that the caching
+    allocator serves from cache), and any later run that exceeds the
+    baseline — or that maps a new cudaMalloc segment at all — raises
+    immediately instead of silently degrading.
+
+    When the allocator's history recorder is available
+    (torch.cuda.memory._record_memory_history) the error also carries
+    the stacks of the most recent allocations, so the offending call
+    site is in the traceback rather than reconstructed from a profile.
+    """
+
+    def __init__(self, device: Optional[torch.device] = None):
+        self.device = device
+        self._baselines: Dict[str, Dict[str, int]] = {}
+        self._recording = False
+
+    def _usable(self) -> bool:
+        return _STRICT_ALLOC and torch.cuda.is_available() and \
+            (self.device is None or str(self.device).startswith('cuda'))
+
+    def _counters(self) -> Dict[str, int]:
+        stats = torch.cuda.memory_stats(self.device)
+        return {
+            'allocations': stats.get('allocation.all.allocated', 0),
+            'segments': stats.get('segment.all.allocated', 0),
+            'retries': stats.get('num_alloc_retries', 0)
+        }
+
+    def _start_recording(self) -> None:
+        """Arm the allocator's stack recorder if this torch has it; the
+        API is private and its signature has moved, so probe both"""
+        if self._recording:
+            return
+        recorder = getattr(torch.cuda.memory, '_record_memory_history', None)
+        if recorder is None:
+            return
+        try:
+            recorder(max_entries=100000)
+        except TypeError:
+            try:
+                recorder(True)
+            except Exception:
+                return
+        except Exception:
+            return
+        self._recording = True
+
+    def _recent_alloc_stacks(self, limit: int = 3) -> List[str]:
+        """Stacks of the newest recorded allocations, newest first"""
+        if not self._recording:
+            return []
+        try:
+            snapshot = torch.cuda.memory._snapshot(self.device)
+        except Exception:
+            return []
+        stacks = []
+        for trace in snapshot.get('device_traces', []):
+            for event in reversed(trace):
+                if event.get('action') not in ('alloc', 'segment_alloc'):
+                    continue
+                frames = [f"{fr.get('filename', '?')}:{fr.get('line', 0)} "
+                          f"{fr.get('name', '?')}"
+                          for fr in event.get('frames', [])]
+                stacks.append('\n    '.join(frames) or '<no frames recorded>')
+                if len(stacks) >= limit:
+                    return stacks
+        return stacks
+
+    @contextlib.contextmanager
+    def watch(self, phase: str):
+        """
+        Guard one phase of the hot path
+
+        First strict pass over a phase calibrates its baseline; later
+        passes must not allocate beyond it. New cudaMalloc segments are
+        never tolerated after calibration — those are exactly the
+        fragmentation-driven cache misses the strict mode exists to
+        catch.
+        """
+        if not self._usable():
+            yield
+            return
+        self._start_recording()
+        entry = self._counters()
+        yield
+        exit_ = self._counters()
+        delta = {key: exit_[key] - entry[key] for key in entry}
+        baseline = self._baselines.get(phase)
+        if baseline is None:
+            self._baselines[phase] = delta
+            return
+        if delta['allocations'] <= baseline['allocations'] and \
+                delta['segments'] <= 0 and delta['retries'] <= 0:
+            return
+        lines = [
+            f"[strict alloc] phase '{phase}' regressed its steady state: "
+            f"{delta['allocations']} block allocations "
+            f"(baseline {baseline['allocations']}), "
+            f"{delta['segments']} new segments, "
+            f"{delta['retries']} alloc retries"
+        ]
+        for index, stack in enumerate(self._recent_alloc_stacks()):
+            lines.append(f'[strict alloc] recent allocation #{index}:'
+                         f'\n    {stack}')
+        raise RuntimeError('\n'.join(lines))
+
+
+def enable_strict_alloc() -> None:
+    """Turn strict allocation checking on programmatically (equivalent
+    to INSTA_STRICT_ALLOC=1); takes effect on the next guarded run"""
+    global _STRICT_ALLOC
+    _STRICT_ALLOC = True
+
+
+def strict_alloc_enabled() -> bool:
+    return _STRICT_ALLOC
+
+
+# One tracker per process: allocation sites live in modules with no
+# handle to the INSTA instance (collateral movement, slack kernels), so
+# they tag through this accessor the same way NVTX ranges are global
+_tracker: Optional[MemoryTracker] = None
+
+
+def get_memory_tracker() -> MemoryTracker:
+    global _tracker
+    if _tracker is None:
+        _tracker = MemoryTracker()
+    return _tracker
+
+
+def enable(device: Optional[torch.device] = None) -> MemoryTracker:
+    """Turn accounting on programmatically (equivalent to INSTA_MEM=1)"""
+    global _ENABLED
+    _ENABLED = True
+    tracker = get_memory_tracker()
+    if device is not None:
+        tracker.device = device
+    return tracker
+
+
+def track(subsystem: str):
+    """Module-level shorthand: with track('collaterals'): ..."""
+    return get_memory_tracker().track(subsystem)
+
+
+# --------------------------- capacity planning ----------------------------
+
+# Host bytes per parsed row, calibrated against init_profile.json RSS
+# deltas on mid-size designs and rounded up — the cost of an optimistic
+# estimate is an OOM an hour into initialization, the cost of a
+# pessimistic one is a design binned to a bigger machine
+_HOST_BYTES_PER_CELL_ARC = 620
+_HOST_BYTES_PER_NET_ARC = 450
+_HOST_BYTES_PER_PIN = 260
+# Graph build roughly doubles the pin-keyed footprint (adjacency dicts,
+# level maps) on top of the parse-stage structures
+_HOST_GRAPH_BYTES_PER_PIN = 400
+
+# Device collateral bytes per arc in the v2 flattened layout: net arcs
+# carry two int64 index columns, six delay columns and an int32 id;
+# cell arcs add sense, dup and parent-mapping columns
+_DEVICE_BYTES_PER_NET_ARC = 2 * 8 + 6 * 4 + 4
+_DEVICE_BYTES_PER_CELL_ARC = 3 * 8 + 6 * 4 + 2 * 4 + 4
+
+# Mirrors the plane lists in clear_timing_cache; kept as counts so the
+# estimator needs no tensors to exist
+_NUM_FLOAT_PLANES = 7
+_NUM_INT_PLANES = 2
+
+
+def estimate_capacity(input_dir: str, topk: int,
+                      float_dtype: torch.dtype = torch.float32) -> Dict[str, int]:
+    """
+    Predict peak memory from input-file row counts, before any parsing
+
+    polars lazy scans give the row counts of the arc and pin files
+    without materializing them, so this costs seconds even on inputs
+    whose full parse takes an hour. Returns the counts plus three byte
+    estimates: peak host RSS across the initialization stages, device
+    collateral residency, and the arrival-plane arena for the
+    configured K and dtype. The numbers are deliberately conservative;
+    they exist to fail (or downgrade) BEFORE work is wasted, and to let
+    farm scheduling bin designs to machine classes.
+    """
+    import polars as pl
+
+    def _rows(name: str) -> int:
+        path = os.path.join(input_dir, name)
+        if not os.path.exists(path):
+            return 0
+        return int(pl.scan_csv(path).select(pl.len()).collect().item())
+
+    cell_arcs = _rows('cell_arcs.csv')
+    net_arcs = _rows('net_arcs.csv')
+    pins = _rows('all_between_sp_ep_pins.csv')
+    if pins == 0:
+        # No pin-filter file: every arc endpoint may be a distinct pin
+        pins = cell_arcs + net_arcs
+
+    dtype_bytes = torch.finfo(float_dtype).bits // 8
+    plane_bytes = pins * topk * (_NUM_FLOAT_PLANES * dtype_bytes +
+                                 _NUM_INT_PLANES * 4)
+    collateral_bytes = (net_arcs * _DEVICE_BYTES_PER_NET_ARC +
+                        cell_arcs * _DEVICE_BYTES_PER_CELL_ARC)
+    parse_bytes = (cell_arcs * _HOST_BYTES_PER_CELL_ARC +
+                   net_arcs * _HOST_BYTES_PER_NET_ARC +
+                   pins * _HOST_BYTES_PER_PIN)
+    peak_host_bytes = parse_bytes + pins * _HOST_GRAPH_BYTES_PER_PIN
+
+    return {
+        'cell_arcs': cell_arcs, 'net_arcs': net_arcs, 'pins': pins,
+        'topk': topk, 'dtype_bytes': dtype_bytes,
+        'plane_bytes': plane_bytes,
+        'collateral_bytes': collateral_bytes,
+        'peak_host_bytes': peak_host_bytes,
+        'peak_device_bytes': plane_bytes + collateral_bytes,
+    }
+
+
+def plan_capacity(estimate: Dict[str, int],
+                  gpu_budget_bytes: Optional[int],
+                  host_budget_bytes: Optional[int],
+                  supported_topk: List[int]) -> Dict[str, Any]:
+    """
+    Fit an estimate into the budgets by degrading precision, then K
+
+    Applies the same degradation ladder clear_timing_cache uses at
+    allocation time — bfloat16 planes first, then halving K down to 1 —
+    but ahead of initialization, so the run never starts in a shape
+    that cannot finish. Returns the (possibly adjusted) topk and plane
+    dtype, a fits flag, and human-readable reasons for every downgrade.
+    Host pressure cannot be traded against K, so a host overrun only
+    yields a reason recommending out-of-core parsing or a bigger class.
+    """
+    topk = estimate['topk']
+    dtype_bytes = estimate['dtype_bytes']
+    pins = estimate['pins']
+    reasons: List[str] = []
+
+    def plane_bytes(k, db):
+        return pins * k * (_NUM_FLOAT_PLANES * db + _NUM_INT_PLANES * 4)
+
+    fits = True
+    if gpu_budget_bytes is not None:
+        device = lambda: plane_bytes(topk, dtype_bytes) + estimate['collateral_bytes']
+        if device() > gpu_budget_bytes and dtype_bytes > 2:
+            dtype_bytes = 2
+            reasons.append('device over budget: dropping planes to bfloat16')
+        while device() > gpu_budget_bytes and topk > 1:
+            topk = max(k for k in supported_topk if k < topk)
+            reasons.append(f'device over budget: reducing topK to {topk}')
+        if device() > gpu_budget_bytes:
+            fits = False
+            reasons.append('device over budget even at bfloat16/K=1: '
+                           'shard the design or use a larger GPU class')
+
+    if host_budget_bytes is not None and \
+            estimate['peak_host_bytes'] > host_budget_bytes:
+        fits = False
+        reasons.append('host over budget: enable streaming parse / '
+                       'out-of-core collaterals or bin to a larger host class')
+
+    return {'fits': fits, 'topk': topk,
+            'plane_dtype': torch.bfloat16 if dtype_bytes == 2 else torch.float32,
+            'reasons': reasons}
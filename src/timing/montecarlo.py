@@ -0,0 +1,150 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/montecarlo.py
+# @brief Monte-Carlo sampled SSTA over cone collaterals
+
+import torch
+from typing import Dict, List, Optional, Sequence, Tuple, Any
+
+
+def mc_propagate_subgraph(
+    level_2_collaterals: Dict[int, Any],
+    cone_gid_list: torch.Tensor,
+    sp_mean_tensor: torch.Tensor,
+    sp_std_tensor: torch.Tensor,
+    num_samples: int = 512,
+    seed: Optional[int] = None,
+    inPinMod: int = 1,
+    device: Optional[torch.device] = None,
+    float_dtype: torch.dtype = torch.float32
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Sample-parallel Monte-Carlo arrival propagation over one cone
+
+    The POCV sweep keeps each pin as mean + sigma*std of its worst path,
+    which Gaussian-approximates the max of correlated paths. Here every
+    arc (and startpoint) draws num_samples independent N(mean, std)
+    delays once, and the level sweep takes hard per-sample maxima, so
+    endpoint arrivals come out as empirical distributions. The trailing
+    sample dimension rides the same local-index collaterals as
+    propagate_subgraph_collateral; memory is |cone| * S floats per
+    transition plane, which is why this runs on selected cones rather
+    than the full graph. Sampling is fp32 regardless of the propagation
+    dtype so tail quantiles stay meaningful.
+
+    Args:
+        level_2_collaterals: Per-cone collaterals (precompute_collaterals
+            subgraph mode, with the appended local index tensors)
+        cone_gid_list: Sorted global gids of the cone (local index order)
+        sp_mean_tensor/sp_std_tensor: Full-chip startpoint tensors
+        num_samples: Samples per arc (S)
+        seed: Optional generator seed for reproducible draws
+
+    Returns:
+        (rise_samples, fall_samples): [|cone|, S] local arrival planes
+    """
+    if device is None:
+        device = cone_gid_list.device
+    cone_gid_list = cone_gid_list.to(device)
+    generator = torch.Generator(device=device)
+    if seed is not None:
+        generator.manual_seed(seed)
+
+    num_local = cone_gid_list.numel()
+    rise_arr = torch.full((num_local, num_samples), float('-inf'),
+                          dtype=float_dtype, device=device)
+    fall_arr = torch.full((num_local, num_samples), float('-inf'),
+                          dtype=float_dtype, device=device)
+
+    def _sample(means, stds):
+        means = means.to(device=device, dtype=float_dtype)
+        stds = stds.to(device=device, dtype=float_dtype)
+        eps = torch.randn(means.numel(), num_samples, generator=generator,
+                          device=device, dtype=float_dtype)
+        return means.unsqueeze(1) + stds.unsqueeze(1) * eps
+
+    for level in sorted(level_2_collaterals.keys()):
+        coll = level_2_collaterals[level]
+        if level == 1:
+            lvl1_nodes = coll.to(device)
+            local_idx = torch.searchsorted(cone_gid_list, lvl1_nodes)
+            means = sp_mean_tensor[lvl1_nodes.cpu()].to(device)
+            stds = sp_std_tensor[lvl1_nodes.cpu()].to(device)
+            # dangling pins promoted to level 1 carry -inf constraints;
+            # they start at zero like the deterministic subgraph sweep
+            invalid = torch.isinf(means)
+            means = torch.where(invalid, torch.zeros_like(means), means)
+            stds = torch.where(invalid, torch.zeros_like(stds), stds)
+            samples = _sample(means, stds)
+            rise_arr[local_idx] = samples
+            fall_arr[local_idx] = samples
+        elif level % 2 == inPinMod:  # input pins
+            cur_local = coll[-2].to(device=device, dtype=torch.int64)
+            parent_local = coll[-1].to(device=device, dtype=torch.int64)
+            rise_delays = _sample(coll[2], coll[3])
+            fall_delays = _sample(coll[5], coll[6])
+            rise_arr.index_reduce_(0, cur_local, rise_arr[parent_local] + rise_delays, 'amax')
+            fall_arr.index_reduce_(0, cur_local, fall_arr[parent_local] + fall_delays, 'amax')
+        else:  # output pins
+            dup_nodes = coll[0]
+            if not torch.is_tensor(dup_nodes):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.int64)
+            dup_local = torch.searchsorted(
+                cone_gid_list, dup_nodes.to(device=device, dtype=torch.int64))
+            pm = coll[12].to(device=device, dtype=torch.int64)[
+                coll[8].to(device=device, dtype=torch.int64)]
+            parent_local = coll[15].to(device=device, dtype=torch.int64)[pm]
+            # positive senses: in-rise drives out-rise; negative: swapped
+            sense_mask = (coll[7].to(device) == 0).unsqueeze(1)
+            in_rise = rise_arr[parent_local]
+            in_fall = fall_arr[parent_local]
+            src_rise = torch.where(sense_mask, in_rise, in_fall)
+            src_fall = torch.where(sense_mask, in_fall, in_rise)
+            rise_delays = _sample(coll[1], coll[2])
+            fall_delays = _sample(coll[4], coll[5])
+            rise_arr.index_reduce_(0, dup_local, src_rise + rise_delays, 'amax')
+            fall_arr.index_reduce_(0, dup_local, src_fall + fall_delays, 'amax')
+
+    return rise_arr, fall_arr
+
+
+def mc_endpoint_quantiles(
+    rise_samples: torch.Tensor,
+    fall_samples: torch.Tensor,
+    cone_gid_list: torch.Tensor,
+    endpoint_globals: Sequence[int],
+    quantiles: Sequence[float] = (0.5, 0.95, 0.997)
+) -> Dict[int, Dict[float, float]]:
+    """
+    Empirical arrival quantiles per endpoint from the sampled planes
+
+    Args:
+        rise_samples/fall_samples: [|cone|, S] from mc_propagate_subgraph
+        cone_gid_list: Sorted global gids of the cone
+        endpoint_globals: Global gids to report
+        quantiles: Probabilities to evaluate (0.997 ~ the 3-sigma point)
+
+    Returns:
+        Mapping from endpoint gid to {quantile: arrival}
+    """
+    device = rise_samples.device
+    ep_tensor = torch.tensor(list(endpoint_globals), dtype=torch.int64, device=device)
+    local = torch.searchsorted(cone_gid_list.to(device), ep_tensor)
+    samples = torch.maximum(rise_samples[local], fall_samples[local])  # [E, S]
+    q_tensor = torch.tensor(list(quantiles), dtype=torch.float32, device=device)
+    values = torch.quantile(samples.to(torch.float32), q_tensor, dim=1)  # [Q, E]
+    values = values.cpu()
+
+    results = {}
+    for ep_idx, gid in enumerate(ep_tensor.tolist()):
+        results[gid] = {float(q): float(values[q_idx, ep_idx])
+                        for q_idx, q in enumerate(quantiles)}
+    return results
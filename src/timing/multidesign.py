@@ -0,0 +1,148 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/multidesign.py
+# @brief parallel multi-design propagation batched on one GPU
+
+import time
+import torch
+from typing import Any, Dict, List, Optional, Tuple
+
+from .propagation import clear_timing_cache, propagate_arrival_times
+
+
+class MultiDesignScheduler:
+    """
+    Batch several initialized designs through one GPU context
+
+    Small-block regressions run each design in its own process, so each
+    pays its own CUDA context and the device serializes between them —
+    one block's levels rarely fill an SM wave. Hosting the designs in a
+    single process already shares the loaded kernel modules; this
+    scheduler adds per-design streams and submits the whole level sweep
+    of every design back-to-back without a host sync in between (the
+    fused slack reduction keeps WNS/TNS as device scalars), so the
+    hardware scheduler interleaves design B's small levels into the SMs
+    a wide level of design A leaves idle. Submission goes largest design
+    first: its wide levels anchor the occupancy and the small blocks
+    backfill.
+
+    Designs must live on the same device; each keeps its own collaterals
+    and timing tensors, nothing is shared between them but the context
+    and kernel code.
+    """
+
+    def __init__(self, instas: List[Any]):
+        assert instas, 'need at least one initialized design'
+        self.device = instas[0].device
+        for insta in instas:
+            assert insta.device == self.device, \
+                'all batched designs must live on the same device'
+            assert insta.level_2_collaterals, \
+                f'design {insta.design_name} is not initialized'
+        self.instas = instas
+        self.use_streams = self.device.type == 'cuda'
+        self.streams = [torch.cuda.Stream(device=self.device)
+                        for _ in instas] if self.use_streams else [None] * len(instas)
+        # Largest first: total collateral rows is a good proxy for the
+        # sweep's device time
+        self._order = sorted(
+            range(len(instas)),
+            key=lambda idx: -self._total_rows(instas[idx].level_2_collaterals))
+
+    @staticmethod
+    def _total_rows(level_2_collaterals: Dict[int, Any]) -> int:
+        rows = 0
+        for level, coll in level_2_collaterals.items():
+            if level == 1:
+                continue
+            first = coll[0]
+            if isinstance(first, torch.Tensor):
+                rows += first.numel()
+        return rows
+
+    def propagate_all(self, sigma: float = 3.0) -> Dict[str, Tuple[float, float]]:
+        """
+        One eval sweep per design, overlapped across the design streams
+
+        Submits clear + level sweep + fused slack for every design on
+        its stream, synchronizes once at the end, and only then reads
+        the WNS/TNS scalars back. Results land on each design
+        (insta.timing_tensors / insta.wns / insta.tns) exactly as a
+        standalone do_eval_propagation would leave them.
+
+        Returns:
+            design_name -> (wns, tns)
+        """
+        start_time = time.time()
+        device_scalars = {}
+        for idx in self._order:
+            insta = self.instas[idx]
+            stream = self.streams[idx]
+            ctx = torch.cuda.stream(stream) if stream is not None \
+                else _NullContext()
+            with ctx:
+                insta.timing_tensors = clear_timing_cache(
+                    insta.max_Gid,
+                    insta.topK,
+                    insta.device,
+                    insta.float_dtype,
+                    insta.sp_mean_tensor,
+                    insta.sp_std_tensor,
+                    insta.ep_rise_required_truth,
+                    insta.ep_fall_required_truth,
+                    insta.epName_riseFall_2_spName,
+                    insta.pinName_2_Gid,
+                    insta.source_nodes,
+                    insta.dest_nodes,
+                    insta.timing_tensors
+                )
+                # fused_slack keeps wns/tns on device: a .item() here
+                # would stall submission of every later design
+                insta.timing_tensors, wns, tns = propagate_arrival_times(
+                    insta.timing_tensors,
+                    insta.level_2_collaterals,
+                    insta.inPin_parent_tensor,
+                    insta.device,
+                    insta.max_Gid,
+                    insta.float_dtype,
+                    sigma=sigma,
+                    topk=insta.topK,
+                    fused_slack=True,
+                    tuner=insta._dispatch_tuner
+                )
+                device_scalars[idx] = (wns, tns)
+
+        if self.use_streams:
+            for stream in self.streams:
+                stream.synchronize()
+
+        results = {}
+        for idx, (wns, tns) in device_scalars.items():
+            insta = self.instas[idx]
+            insta.wns = wns.item() if isinstance(wns, torch.Tensor) else wns
+            insta.tns = tns.item() if isinstance(tns, torch.Tensor) else tns
+            results[insta.design_name] = (insta.wns, insta.tns)
+
+        print(f'[multi design] {len(self.instas)} designs in '
+              f'{time.time() - start_time:.2f} seconds')
+        for name, (wns, tns) in results.items():
+            print(f'[multi design]   {name}: wns {wns}, tns {tns}')
+        return results
+
+
+class _NullContext:
+    """Stand-in stream context for CPU-only runs (sequential fallback)"""
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        return False
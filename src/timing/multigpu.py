@@ -0,0 +1,214 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/multigpu.py
+# @brief multi-GPU level-synchronous propagation with boundary exchange
+
+import time
+import torch
+from typing import Dict, List, Optional, Tuple, Any
+
+from .propagation import build_dirty_subset_collaterals
+from .collaterals import move_collaterals_to_device
+from .cuda_ops import cuda_arrival_propagate_pocv
+
+
+class MultiGpuPropagator:
+    """
+    Level-synchronous arrival propagation partitioned across GPUs
+
+    Nodes are split into contiguous Gid blocks, one per device (Gids are
+    assigned in pin-creation order, so cells of the same region tend to
+    land in the same block — a cheap stand-in for a real min-cut that
+    keeps the boundary sets small in practice). Each device holds its own
+    full-size Gid planes but only computes the collateral rows whose
+    destination node it owns; before a level launches, the parent rows
+    that live on another device are fetched with peer index copies, so
+    the per-level traffic is exactly the boundary-crossing arrivals.
+    Partitioning and the per-level exchange plans are built once and
+    reused across propagations. K=1 screening semantics (the full topK
+    candidate tracking stays on the single-device path).
+    """
+
+    def __init__(
+        self,
+        level_2_collaterals: Dict[int, Any],
+        devices: List[torch.device],
+        max_gid: int,
+        float_dtype: torch.dtype,
+        inPinMod: int = 1
+    ):
+        assert len(devices) >= 2, 'multi-GPU propagation needs at least two devices'
+        self.devices = [torch.device(d) for d in devices]
+        self.max_gid = max_gid
+        self.float_dtype = float_dtype
+        self.inPinMod = inPinMod
+        num_devices = len(self.devices)
+        self.block_size = (max_gid + num_devices - 1) // num_devices
+
+        for level, entry in level_2_collaterals.items():
+            assert not (isinstance(entry, tuple) and len(entry) == 2
+                        and entry[0] == 'chunks'), \
+                'partition collaterals before schedule_level_launches'
+
+        self.levels = sorted(level_2_collaterals.keys())
+        start_time = time.time()
+
+        # Per-device row subsets: reuse the dirty-cone row filter with an
+        # ownership mask, then ship each subset to its device
+        self.device_subsets = []
+        sample = next(iter(level_2_collaterals.values()))
+        mask_device = sample.device if torch.is_tensor(sample) else torch.device('cpu')
+        for dev_idx, device in enumerate(self.devices):
+            mask = torch.zeros(max_gid, dtype=torch.bool, device=mask_device)
+            lo, hi = self._owned_range(dev_idx)
+            mask[lo:hi] = True
+            subset = build_dirty_subset_collaterals(
+                level_2_collaterals, mask, inPinMod=inPinMod)
+            subset[1] = level_2_collaterals[1]  # level 1 replicated everywhere
+            self.device_subsets.append(move_collaterals_to_device(subset, device))
+
+        # Per-level exchange plan: (src_dev, dst_dev, gids_on_src,
+        # gids_on_dst) entries for the parent rows a device reads but
+        # does not own
+        self.exchange_plan: Dict[int, List[Tuple[int, int, torch.Tensor, torch.Tensor]]] = {}
+        for dev_idx, subset in enumerate(self.device_subsets):
+            for level, coll in subset.items():
+                # level-2 parents are startpoints, which are replicated
+                if level <= 2:
+                    continue
+                if level % 2 == inPinMod:
+                    parents = coll[1]
+                else:
+                    parents = coll[11]
+                parents = torch.unique(parents.to(torch.int64))
+                owners = torch.clamp(parents // self.block_size, max=num_devices - 1)
+                for src_idx in range(num_devices):
+                    if src_idx == dev_idx:
+                        continue
+                    gids = parents[owners == src_idx]
+                    if gids.numel():
+                        # keep both device copies of the index so replays
+                        # are pure peer copies with no host round trips
+                        self.exchange_plan.setdefault(level, []).append(
+                            (src_idx, dev_idx,
+                             gids.to(self.devices[src_idx]),
+                             gids.to(self.devices[dev_idx])))
+
+        num_boundary = sum(g.numel() for plans in self.exchange_plan.values()
+                           for _, _, g, _ in plans)
+        print(f'[multi-gpu] partitioned over {num_devices} devices in '
+              f'{time.time() - start_time:.2f}s, boundary rows: {num_boundary}')
+
+    def _owned_range(self, dev_idx: int) -> Tuple[int, int]:
+        lo = dev_idx * self.block_size
+        return lo, min(lo + self.block_size, self.max_gid)
+
+    def _make_planes(self, device: torch.device) -> Dict[str, torch.Tensor]:
+        float_plane = lambda: torch.full((self.max_gid,), float('-inf'),
+                                         dtype=self.float_dtype, device=device)
+        int_plane = lambda: torch.full((self.max_gid,), -1,
+                                       dtype=torch.int32, device=device)
+        return {
+            'Gid_2_rise_arrival': float_plane(),
+            'Gid_2_rise_arrival_mean': float_plane(),
+            'Gid_2_rise_arrival_std': float_plane(),
+            'Gid_2_rise_startpoints': int_plane(),
+            'Gid_2_fall_arrival': float_plane(),
+            'Gid_2_fall_arrival_mean': float_plane(),
+            'Gid_2_fall_arrival_std': float_plane(),
+            'Gid_2_fall_startpoints': int_plane(),
+        }
+
+    _PLANE_NAMES = (
+        'Gid_2_rise_arrival', 'Gid_2_rise_arrival_mean',
+        'Gid_2_rise_arrival_std', 'Gid_2_rise_startpoints',
+        'Gid_2_fall_arrival', 'Gid_2_fall_arrival_mean',
+        'Gid_2_fall_arrival_std', 'Gid_2_fall_startpoints',
+    )
+
+    def propagate(
+        self,
+        sp_mean_tensor: torch.Tensor,
+        sp_std_tensor: torch.Tensor,
+        inPin_parent_tensor: torch.Tensor,
+        valid_sps: torch.Tensor,
+        sigma: float = 3.0,
+        log: bool = False
+    ) -> Dict[str, torch.Tensor]:
+        """
+        One full sweep; returns merged Gid planes on the first device
+
+        Level 1 initializes on every device (startpoint data is tiny), so
+        only inner levels exchange. Per level: fetch boundary parent rows
+        from their owners, then launch each device's row subset; devices
+        run concurrently per level since the kernels are issued from the
+        host without intervening syncs.
+        """
+        start_time = time.time()
+        device_planes = [self._make_planes(device) for device in self.devices]
+        per_device = []
+        for device in self.devices:
+            per_device.append({
+                'sp_mean': sp_mean_tensor.to(device),
+                'sp_std': sp_std_tensor.to(device),
+                'inPin_parent': inPin_parent_tensor.to(device),
+                'valid_sps': valid_sps.to(device),
+            })
+
+        for level in self.levels:
+            # Boundary exchange: pull remote parent rows before compute
+            for src_idx, dst_idx, src_gids, dst_gids in self.exchange_plan.get(level, []):
+                for name in self._PLANE_NAMES:
+                    values = device_planes[src_idx][name][src_gids]
+                    device_planes[dst_idx][name].index_copy_(
+                        0, dst_gids, values.to(self.devices[dst_idx], non_blocking=True))
+
+            for dev_idx, device in enumerate(self.devices):
+                subset = self.device_subsets[dev_idx]
+                if level not in subset:
+                    continue
+                planes = device_planes[dev_idx]
+                aux = per_device[dev_idx]
+                cuda_arrival_propagate_pocv(
+                    aux['sp_mean'],
+                    aux['sp_std'],
+                    {level: subset[level]},
+                    aux['inPin_parent'],
+                    device,
+                    self.max_gid,
+                    planes['Gid_2_rise_arrival'],
+                    planes['Gid_2_rise_arrival_mean'],
+                    planes['Gid_2_rise_arrival_std'],
+                    planes['Gid_2_rise_startpoints'],
+                    planes['Gid_2_fall_arrival'],
+                    planes['Gid_2_fall_arrival_mean'],
+                    planes['Gid_2_fall_arrival_std'],
+                    planes['Gid_2_fall_startpoints'],
+                    self.float_dtype,
+                    aux['valid_sps'],
+                    sigma=sigma,
+                    log=False,
+                    topK=1
+                )
+            if log:
+                print(f'[multi-gpu] level {level} done')
+
+        # Merge: each device's owned block slides into the primary planes
+        primary = device_planes[0]
+        for dev_idx in range(1, len(self.devices)):
+            lo, hi = self._owned_range(dev_idx)
+            for name in self._PLANE_NAMES:
+                primary[name][lo:hi] = \
+                    device_planes[dev_idx][name][lo:hi].to(self.devices[0])
+
+        print(f'[multi-gpu] propagation over {len(self.devices)} devices '
+              f'completed in {time.time() - start_time:.2f}s')
+        return primary
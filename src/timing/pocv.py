@@ -16,6 +16,7 @@ import torch
 from typing import Dict, List, Set, Tuple, Optional, Union, Any
 
 from ..io.serialization import save_pickle, load_pickle, save_torch_tensor, load_torch_tensor
+from .glue import glue
 
 
 def initialize_timing_tensors(
@@ -181,6 +182,99 @@ def initialize_timing_tensors(
     )
 
 
+def build_required_time_components(
+    ep_attributes: Dict[Tuple[str, str], Tuple],
+    pin_to_id_map: Dict[str, int],
+    max_gid: int,
+    float_dtype: torch.dtype,
+    signoff_sigma: float = 3.0,
+    device: Optional[torch.device] = None
+) -> Dict[str, torch.Tensor]:
+    """
+    Split the baked endpoint required times into sigma-independent parts
+
+    The ep CSV reports one required time per endpoint, computed at the
+    signoff sigma: required = base + capture_mean - sigma * capture_std,
+    where base lumps clock period, setup and fixed adjustments (the
+    generator does not report those separately) and capture_mean/std is
+    the capture clock latency POCV pair carried in the same row. With
+    the capture pair kept as its own tensors, base is recovered exactly
+    as required - capture_mean + signoff_sigma * capture_std, and
+    recompute_required_times can re-evaluate the planes for any
+    sigma/derate without regenerating ep_attributes.csv.
+
+    Endpoints parsed before the capture columns were cached (older
+    epName_riseFall_2_attributes pickles carry 9-tuples) get a zero
+    capture pair: their required time stays at the baked value for every
+    sigma, and the count is reported once.
+
+    Returns:
+        Dict of [max_gid] tensors: rise_base / fall_base (-inf off the
+        endpoint rows) and rise/fall_capture_mean / _capture_std
+    """
+    planes = {name: torch.full((max_gid,), 0.0, dtype=float_dtype)
+              for name in ('rise_capture_mean', 'rise_capture_std',
+                           'fall_capture_mean', 'fall_capture_std')}
+    planes['rise_base'] = torch.full((max_gid,), float('-inf'), dtype=float_dtype)
+    planes['fall_base'] = torch.full((max_gid,), float('-inf'), dtype=float_dtype)
+
+    legacy_rows = 0
+    for (epName, rise_fall), ep_attrs in ep_attributes.items():
+        if epName not in pin_to_id_map:
+            continue
+        epId = pin_to_id_map[epName]
+        required = ep_attrs[1]
+        if len(ep_attrs) > 10:
+            capture_mean, capture_std = ep_attrs[9], ep_attrs[10]
+        else:
+            capture_mean, capture_std = 0.0, 0.0
+            legacy_rows += 1
+        base = required - capture_mean + signoff_sigma * capture_std
+        prefix = 'rise' if rise_fall == 'rise' else 'fall'
+        planes[f'{prefix}_base'][epId] = base
+        planes[f'{prefix}_capture_mean'][epId] = capture_mean
+        planes[f'{prefix}_capture_std'][epId] = capture_std
+
+    if legacy_rows:
+        print(f'[required components] {legacy_rows} endpoint rows lack '
+              f'capture latency columns (stale ep cache?); their required '
+              f'times stay fixed across sigma')
+    if device is not None:
+        planes = {name: plane.to(device) for name, plane in planes.items()}
+    return planes
+
+
+def recompute_required_times(
+    components: Dict[str, torch.Tensor],
+    sigma: float,
+    derate: float = 1.0,
+    out_rise: Optional[torch.Tensor] = None,
+    out_fall: Optional[torch.Tensor] = None
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Re-evaluate the endpoint required planes for a sigma/derate setting
+
+    One fused elementwise pass over the component tensors on whatever
+    device they live on — microseconds on GPU, no CSV regeneration, no
+    host round trip. derate scales the whole capture latency term
+    (mean and std together), matching how clock derate experiments are
+    specified. Pass out_rise/out_fall to refresh existing planes in
+    place (e.g. the ep_*_required_truth tensors, or endpoint-gathered
+    rows), otherwise fresh tensors come back.
+    """
+    rise = components['rise_base'] + derate * (
+        components['rise_capture_mean'] - sigma * components['rise_capture_std'])
+    fall = components['fall_base'] + derate * (
+        components['fall_capture_mean'] - sigma * components['fall_capture_std'])
+    if out_rise is not None:
+        out_rise.copy_(rise)
+        rise = out_rise
+    if out_fall is not None:
+        out_fall.copy_(fall)
+        fall = out_fall
+    return rise, fall
+
+
 def calculate_slack(
     rise_slack: torch.Tensor,
     fall_slack: torch.Tensor,
@@ -201,8 +295,8 @@ def calculate_slack(
         overall_slack: Tensor to store overall slack values
         rise_arrival: Rise arrival times
         fall_arrival: Fall arrival times
-        rise_required: Rise required times for endpoints
-        fall_required: Fall required times for endpoints
+        rise_required: Rise required times, endpoint-indexed (aligned with dest_nodes)
+        fall_required: Fall required times, endpoint-indexed (aligned with dest_nodes)
         dest_nodes: Tensor of destination node IDs
         topk: Number of paths to track per endpoint
     """
@@ -213,22 +307,22 @@ def calculate_slack(
         # Calculate rise slack
         if rise_arrival.ndim > 1:
             # Use first path for slack calculation
-            rise_slack[dest_nodes] = rise_required[dest_nodes] - rise_arrival[dest_nodes][:, 0]
+            rise_slack[dest_nodes] = rise_required - rise_arrival[dest_nodes][:, 0]
         else:
             # Handle case where rise_arrival has been reshaped to 1D
-            rise_slack[dest_nodes] = rise_required[dest_nodes] - rise_arrival[dest_nodes]
+            rise_slack[dest_nodes] = rise_required - rise_arrival[dest_nodes]
 
         # Calculate fall slack
         if fall_arrival.ndim > 1:
             # Use first path for slack calculation
-            fall_slack[dest_nodes] = fall_required[dest_nodes] - fall_arrival[dest_nodes][:, 0]
+            fall_slack[dest_nodes] = fall_required - fall_arrival[dest_nodes][:, 0]
         else:
             # Handle case where fall_arrival has been reshaped to 1D
-            fall_slack[dest_nodes] = fall_required[dest_nodes] - fall_arrival[dest_nodes]
+            fall_slack[dest_nodes] = fall_required - fall_arrival[dest_nodes]
     else:
         # For 1D tensors, indexing is straightforward
-        rise_slack[dest_nodes] = rise_required[dest_nodes] - rise_arrival[dest_nodes]
-        fall_slack[dest_nodes] = fall_required[dest_nodes] - fall_arrival[dest_nodes]
+        rise_slack[dest_nodes] = rise_required - rise_arrival[dest_nodes]
+        fall_slack[dest_nodes] = fall_required - fall_arrival[dest_nodes]
 
     # Fix inf values
     rise_mask = torch.isinf(rise_slack[dest_nodes])
@@ -258,6 +352,233 @@ def calculate_slack(
     return wns, tns
 
 
+def calculate_slack_fused(
+    rise_slack: torch.Tensor,
+    fall_slack: torch.Tensor,
+    overall_slack: torch.Tensor,
+    rise_arrival: torch.Tensor,
+    fall_arrival: torch.Tensor,
+    rise_required: torch.Tensor,
+    fall_required: torch.Tensor,
+    dest_nodes: torch.Tensor,
+    topk: int = 1,
+    cppr_tensors: Optional[Dict[str, torch.Tensor]] = None,
+    rise_startpoints: Optional[torch.Tensor] = None,
+    fall_startpoints: Optional[torch.Tensor] = None,
+    cppr_slack_out: Optional[torch.Tensor] = None
+):
+    """
+    Endpoint slack + WNS/TNS in one endpoint-indexed pass, no host syncs
+
+    Unlike calculate_slack this never calls .item() or prints, so nothing
+    forces the stream to drain: WNS/TNS come back as device scalars and the
+    optimizer loop decides when to read them. rise/fall_required arrive
+    endpoint-indexed (aligned with dest_nodes), so the only gathers are the
+    two arrival reads and the full Gid planes are only written via the
+    index_copy_ scatters.
+
+    With cppr_tensors (and the startpoint planes) supplied, common-point
+    credit is fused into the same pass: the golden-startpoint candidate
+    scan reuses the [E, K] arrival rows this function already gathered,
+    corrected slacks scatter into cppr_slack_out, and the return grows to
+    (wns, tns, cppr_wns, cppr_tns) — all still device scalars, so
+    corrected and uncorrected slacks come out of one sweep over
+    dest_nodes instead of a separate host phase. The correction stays
+    differentiable (gather/where over the arrivals), so optimizers can
+    descend on the corrected TNS directly.
+    """
+    dest = dest_nodes.to(torch.long)
+
+    ep_rise_rows = rise_arrival[dest]
+    ep_fall_rows = fall_arrival[dest]
+    ep_rise_arrival = ep_rise_rows
+    ep_fall_arrival = ep_fall_rows
+    if topk > 1 and ep_rise_arrival.ndim > 1:
+        ep_rise_arrival = ep_rise_arrival[:, 0]
+        ep_fall_arrival = ep_fall_arrival[:, 0]
+
+    # The elementwise chains dispatch through the glue registry (see
+    # timing/glue.py); the gathers, scatters and the static K branching
+    # stay here
+    ep_rise_slack, ep_fall_slack, ep_slack, wns, tns = glue('endpoint_slack')(
+        ep_rise_arrival, ep_fall_arrival, rise_required, fall_required)
+
+    rise_slack.index_copy_(0, dest, ep_rise_slack)
+    fall_slack.index_copy_(0, dest, ep_fall_slack)
+    overall_slack.index_copy_(0, dest, ep_slack)
+
+    if cppr_tensors is None:
+        return wns, tns
+
+    golden_rise = cppr_tensors['golden_rise_sp'][dest]
+    golden_fall = cppr_tensors['golden_fall_sp'][dest]
+    if topk > 1 and ep_rise_rows.ndim > 1 \
+            and rise_startpoints is not None and fall_startpoints is not None:
+        ep_cppr_slack, cppr_wns, cppr_tns = glue('cppr_candidate')(
+            ep_rise_rows, ep_fall_rows, ep_rise_arrival, ep_fall_arrival,
+            rise_startpoints[dest], fall_startpoints[dest],
+            golden_rise, golden_fall, rise_required, fall_required)
+    else:
+        # No candidate list to search at K=1; corrected == uncorrected
+        ep_cppr_slack, cppr_wns, cppr_tns = ep_slack, wns, tns
+
+    if cppr_slack_out is not None:
+        cppr_slack_out.index_copy_(0, dest, ep_cppr_slack)
+
+    return wns, tns, cppr_wns, cppr_tns
+
+
+def calculate_group_slack(
+    overall_slack: torch.Tensor,
+    dest_nodes: torch.Tensor,
+    group_ids: torch.Tensor,
+    num_groups: int
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Per-group WNS/TNS vectors via segmented reductions, no host syncs
+
+    group_ids assigns each entry of dest_nodes to a clock/path group
+    (see INSTA.do_group_slack_analysis). The per-group totals are one
+    index_add_ and one scatter amin over the endpoint slack gather —
+    the full-plane download and pandas groupby this replaces scaled
+    with endpoint count, this scales with group count. Negative-only
+    masking uses zero as the identity (masked slacks are <= 0), so
+    groups with no violation report 0.0 WNS/TNS.
+
+    Returns:
+        (group_wns [num_groups], group_tns [num_groups]) device vectors
+    """
+    dest = dest_nodes.to(torch.long)
+    ep_slack = overall_slack[dest].to(torch.float32)
+    negative = (ep_slack < 0) & torch.isfinite(ep_slack)
+    masked = torch.where(negative, ep_slack, torch.zeros_like(ep_slack))
+
+    group_ids = group_ids.to(torch.long).to(masked.device)
+    group_tns = torch.zeros(num_groups, dtype=torch.float32, device=masked.device)
+    group_tns.index_add_(0, group_ids, masked)
+    group_wns = torch.zeros(num_groups, dtype=torch.float32, device=masked.device)
+    group_wns.scatter_reduce_(0, group_ids, masked, reduce='amin', include_self=True)
+
+    return group_wns, group_tns
+
+
+def slack_distribution_stats(
+    overall_slack: torch.Tensor,
+    dest_node_tensor: Optional[torch.Tensor] = None,
+    bin_width: float = 0.03,
+    percentiles: Tuple[float, ...] = (1.0, 5.0, 25.0, 50.0, 75.0, 95.0, 99.0)
+) -> Dict[str, Any]:
+    """
+    Endpoint slack histogram and percentiles, reduced on device
+
+    Hauling the full endpoint slack vector to host for numpy binning
+    costs more than propagation at millions of endpoints; here the
+    gather over Gid_2_slack[dest_node_tensor], the fixed-bin histogram
+    (histc) and the quantiles all run on device, and only a few
+    thousand counters plus a handful of scalars cross PCIe.
+
+    Returns:
+        Dict with 'counts'/'bin_edges' (host lists), 'percentiles'
+        ({'p50': ...}), 'num_endpoints', 'num_violating', 'min', 'max'
+    """
+    slack = overall_slack
+    if dest_node_tensor is not None:
+        slack = overall_slack[dest_node_tensor.to(torch.long)]
+    slack = slack.reshape(-1).to(torch.float32)
+    slack = slack[torch.isfinite(slack)]
+
+    if slack.numel() == 0:
+        return {'num_endpoints': 0, 'num_violating': 0, 'min': 0.0, 'max': 0.0,
+                'counts': [], 'bin_edges': [], 'percentiles': {}}
+
+    # One small D2H for the extrema (histc needs host-side bounds)
+    lo, hi = slack.min().item(), slack.max().item()
+    num_bins = max(10, int((hi - lo) / bin_width)) if hi > lo else 10
+    counts = torch.histc(slack, bins=num_bins, min=lo, max=hi)
+    fractions = torch.tensor([p / 100.0 for p in percentiles],
+                             dtype=torch.float32, device=slack.device)
+    quantiles = torch.quantile(slack, fractions)
+    num_violating = (slack < 0).sum()
+
+    return {
+        'num_endpoints': int(slack.numel()),
+        'num_violating': int(num_violating.item()),
+        'min': lo,
+        'max': hi,
+        'counts': counts.to(torch.int64).cpu().tolist(),
+        'bin_edges': torch.linspace(lo, hi, num_bins + 1).tolist(),
+        'percentiles': {f'p{p:g}': value
+                        for p, value in zip(percentiles,
+                                            quantiles.cpu().tolist())}
+    }
+
+
+def multi_sigma_endpoint_slacks(
+    timing_tensors: Dict[str, torch.Tensor],
+    sigmas: Tuple[float, ...] = (0.0, 1.5, 3.0)
+) -> Dict[str, torch.Tensor]:
+    """
+    Endpoint slacks at several sigma levels from one K-candidate sweep
+
+    Mean/std propagation is sigma-independent; sigma only enters when
+    candidates are scored as mean + sigma*std. One propagation therefore
+    serves every signoff sigma by re-scoring the K kept endpoint
+    candidates per level — [num_endpoints, K] elementwise work instead of
+    a full re-propagation per sigma. This is the shared-K approximation:
+    the merge kept the top-K by the sweep's anchor sigma, so a sigma is
+    exact whenever its critical candidate survived that cut; at K=256
+    mis-ranked candidates beyond the cut are far off-critical.
+
+    Returns:
+        {'sigmas': [S], 'rise_slack'/'fall_slack'/'slack': [S, E],
+         'wns'/'tns': [S]} — all device tensors, no host syncs
+    """
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    rise_means = timing_tensors['Gid_2_rise_arrival_mean'][dest]
+    rise_stds = timing_tensors['Gid_2_rise_arrival_std'][dest]
+    fall_means = timing_tensors['Gid_2_fall_arrival_mean'][dest]
+    fall_stds = timing_tensors['Gid_2_fall_arrival_std'][dest]
+    if rise_means.dim() == 1:
+        rise_means = rise_means.unsqueeze(1)
+        rise_stds = rise_stds.unsqueeze(1)
+        fall_means = fall_means.unsqueeze(1)
+        fall_stds = fall_stds.unsqueeze(1)
+
+    # Unfilled candidate slots carry -inf stds from the arena reset;
+    # zero them so sigma=0 doesn't produce 0 * -inf = nan (the -inf mean
+    # already keeps those slots from ever winning the max)
+    rise_stds = torch.where(torch.isfinite(rise_stds), rise_stds,
+                            torch.zeros_like(rise_stds))
+    fall_stds = torch.where(torch.isfinite(fall_stds), fall_stds,
+                            torch.zeros_like(fall_stds))
+
+    sigma_vec = torch.tensor(list(sigmas), dtype=torch.float32,
+                             device=rise_means.device).reshape(-1, 1, 1)
+    # [S, E, K] candidate arrivals; worst candidate per sigma wins
+    rise_arrivals = (rise_means.to(torch.float32).unsqueeze(0) +
+                     sigma_vec * rise_stds.to(torch.float32).unsqueeze(0)).amax(dim=2)
+    fall_arrivals = (fall_means.to(torch.float32).unsqueeze(0) +
+                     sigma_vec * fall_stds.to(torch.float32).unsqueeze(0)).amax(dim=2)
+
+    rise_slack = timing_tensors['ep_rise_required'].to(torch.float32) - rise_arrivals
+    fall_slack = timing_tensors['ep_fall_required'].to(torch.float32) - fall_arrivals
+    slack = torch.minimum(rise_slack, fall_slack)
+
+    negative = (slack < 0) & torch.isfinite(slack)
+    masked = torch.where(negative, slack, torch.zeros_like(slack))
+    tns = masked.sum(dim=1)
+    wns = masked.amin(dim=1)
+
+    return {
+        'sigmas': sigma_vec.reshape(-1),
+        'rise_slack': rise_slack,
+        'fall_slack': fall_slack,
+        'slack': slack,
+        'wns': wns,
+        'tns': tns,
+    }
+
+
 def process_crpr_data(
     crpr_file: str,
     pin_to_id_map: Dict[str, int],
@@ -434,64 +755,907 @@ def apply_cppr_correction(
     return temporal_metadata
 
 
+def build_cppr_metadata(
+    epName_riseFall_2_spName: Dict[Tuple[str, str], str],
+    pinName_2_Gid: Dict[str, int],
+    dest_nodes,
+    Gid_2_pinName
+) -> Dict[str, torch.Tensor]:
+    """
+    One-time tensorization of the endpoint/golden-startpoint maps the
+    host CPPR correction needs
+
+    apply_cppr_correction used to redo these string-keyed dict lookups
+    over every endpoint on every plotting call. The single pass here
+    (at initialization) filters to endpoints with both rise and fall
+    signoff entries and packs their gids and golden startpoint gids as
+    CPU tensors; apply_cppr_correction_tensorized then consumes only
+    tensors.
+
+    Returns:
+        Dict with 'ep_gids', 'golden_rise_sp', 'golden_fall_sp'
+        (aligned int64 CPU tensors, -1 for unknown startpoints)
+    """
+    ep_gids, golden_rise, golden_fall = [], [], []
+    for gid in dest_nodes:
+        epName = Gid_2_pinName[gid]
+        rise_sp = epName_riseFall_2_spName.get((epName, 'rise'))
+        fall_sp = epName_riseFall_2_spName.get((epName, 'fall'))
+        if rise_sp is None or fall_sp is None:
+            continue
+        ep_gids.append(gid)
+        golden_rise.append(pinName_2_Gid.get(rise_sp, -1))
+        golden_fall.append(pinName_2_Gid.get(fall_sp, -1))
+
+    return {
+        'ep_gids': torch.tensor(ep_gids, dtype=torch.long),
+        'golden_rise_sp': torch.tensor(golden_rise, dtype=torch.long),
+        'golden_fall_sp': torch.tensor(golden_fall, dtype=torch.long),
+    }
+
+
+def apply_cppr_correction_tensorized(
+    timing_tensors,
+    cppr_metadata: Dict[str, torch.Tensor],
+    Gid_2_pinName,
+    topK,
+    ep_rise_depth_truth,
+    ep_rise_slack_truth,
+    ep_rise_arrival_truth,
+    ep_fall_depth_truth,
+    ep_fall_slack_truth,
+    ep_fall_arrival_truth,
+    to_filter=False
+):
+    """
+    CPPR correction over pre-tensorized metadata, vectorized across
+    endpoints
+
+    Matches apply_cppr_correction result for result, but the
+    per-endpoint Python loop with .item() reads and string compares
+    becomes batched gathers: polarity selection, golden-startpoint
+    mismatch detection and the topK candidate scan are each one tensor
+    op over all endpoints. Names are resolved only for the final
+    output columns.
+    """
+    ep = cppr_metadata['ep_gids']
+    golden_rise = cppr_metadata['golden_rise_sp']
+    golden_fall = cppr_metadata['golden_fall_sp']
+
+    rise_req = timing_tensors['rise_required'][ep].to(torch.float32)
+    fall_req = timing_tensors['fall_required'][ep].to(torch.float32)
+    rise_sps = timing_tensors['rise_startpoints'][ep].to(torch.long)
+    fall_sps = timing_tensors['fall_startpoints'][ep].to(torch.long)
+    rise_arrs = timing_tensors['rise_arrival'][ep].to(torch.float32)
+    fall_arrs = timing_tensors['fall_arrival'][ep].to(torch.float32)
+    if rise_arrs.ndim == 1:
+        rise_arrs, fall_arrs = rise_arrs.unsqueeze(1), fall_arrs.unsqueeze(1)
+        rise_sps, fall_sps = rise_sps.unsqueeze(1), fall_sps.unsqueeze(1)
+
+    rise_slack = rise_req - rise_arrs[:, 0]
+    fall_slack = fall_req - fall_arrs[:, 0]
+    is_rise = rise_slack < fall_slack
+
+    golden = torch.where(is_rise, golden_rise, golden_fall)
+    cand_sps = torch.where(is_rise.unsqueeze(1), rise_sps, fall_sps)
+    cand_arrs = torch.where(is_rise.unsqueeze(1), rise_arrs, fall_arrs)
+
+    mismatch = cand_sps[:, 0] != golden
+    match = cand_sps == golden.unsqueeze(1)
+    found = match.any(dim=1)
+    first_match = match.to(torch.int8).argmax(dim=1)
+    corrected = cand_arrs.gather(1, first_match.unsqueeze(1)).squeeze(1)
+
+    use_correction = mismatch & found
+    pred_arrivals = torch.where(use_correction, corrected, cand_arrs[:, 0])
+    chosen_sp = torch.where(use_correction, golden, cand_sps[:, 0])
+
+    keep = torch.ones_like(mismatch)
+    if to_filter and topK > 1:
+        keep = ~(mismatch & ~found)
+
+    cnt_mismatch = int(mismatch.sum())
+    cnt_found_crpr = int(use_correction.sum())
+
+    def polarity_select(rise_truth, fall_truth):
+        return torch.where(is_rise, rise_truth[ep].to(torch.float32),
+                           fall_truth[ep].to(torch.float32))[keep]
+
+    d_pins = ep[keep].tolist()
+    chosen = chosen_sp[keep].tolist()
+    temporal_metadata = {
+        'd_pins': d_pins,
+        'true_levels': polarity_select(ep_rise_depth_truth, ep_fall_depth_truth).tolist(),
+        'true_slacks': polarity_select(ep_rise_slack_truth, ep_fall_slack_truth).tolist(),
+        'true_requireds': torch.where(is_rise, rise_req, fall_req)[keep].tolist(),
+        'true_arrivals': polarity_select(ep_rise_arrival_truth, ep_fall_arrival_truth).tolist(),
+        'pred_arrivals': pred_arrivals[keep].tolist(),
+        'epNames': [Gid_2_pinName[gid] for gid in d_pins],
+        'spNames': [Gid_2_pinName[gid] if gid >= 0 else '' for gid in chosen],
+        'riseFalls': ['rise' if flag else 'fall'
+                      for flag in is_rise[keep].tolist()],
+    }
+
+    print(f'# of valid eps: {len(d_pins)}')
+    if cnt_mismatch:
+        print(f'# ep mismatch: {cnt_mismatch}, '
+              f'# corrected by topK crpr: {cnt_found_crpr}, '
+              f'rate: {cnt_found_crpr / cnt_mismatch:.2f}')
+    else:
+        print("no initial ep mismatch")
+
+    return temporal_metadata
+
+
+def build_cppr_tensors(
+    epName_riseFall_2_spName: Dict[Tuple[str, str], str],
+    pinName_2_Gid: Dict[str, int],
+    max_gid: int,
+    device: torch.device
+) -> Dict[str, torch.Tensor]:
+    """
+    Pre-tensorize the endpoint -> golden startpoint maps for GPU CPPR
+
+    Built once at initialization so the per-propagation CPPR credit lookup
+    can run entirely on device instead of the per-endpoint Python loop in
+    apply_cppr_correction.
+
+    Returns:
+        Dictionary with 'golden_rise_sp' / 'golden_fall_sp' tensors of shape
+        [max_gid] holding the signoff startpoint Gid per endpoint (-1 where
+        no golden startpoint is known)
+    """
+    golden_rise_sp = torch.full((max_gid,), -1, dtype=torch.int32)
+    golden_fall_sp = torch.full((max_gid,), -1, dtype=torch.int32)
+
+    for (epName, rise_fall), spName in epName_riseFall_2_spName.items():
+        if epName not in pinName_2_Gid or spName not in pinName_2_Gid:
+            continue
+        epId = pinName_2_Gid[epName]
+        spId = pinName_2_Gid[spName]
+        if rise_fall == 'rise':
+            golden_rise_sp[epId] = spId
+        else:
+            golden_fall_sp[epId] = spId
+
+    from .memory import track
+    with track('cppr tables'):
+        return {
+            'golden_rise_sp': golden_rise_sp.to(device),
+            'golden_fall_sp': golden_fall_sp.to(device),
+        }
+
+
+def apply_cppr_correction_gpu(
+    rise_arrival: torch.Tensor,
+    rise_startpoints: torch.Tensor,
+    fall_arrival: torch.Tensor,
+    fall_startpoints: torch.Tensor,
+    dest_node_tensor: torch.Tensor,
+    cppr_tensors: Dict[str, torch.Tensor],
+    topK: int
+) -> Dict[str, torch.Tensor]:
+    """
+    Device-side CPPR credit lookup and arrival correction
+
+    For every endpoint whose worst (slot-0) startpoint disagrees with the
+    signoff startpoint, scan its topK candidate list for the golden
+    startpoint and substitute that path's arrival. All ops stay on the
+    Gid_2_* tensors; nothing is copied to host.
+
+    Returns:
+        Dictionary with corrected 'rise_arrival'/'fall_arrival' per endpoint
+        (ordered as dest_node_tensor), the chosen startpoints, and mismatch /
+        correction counters as device scalars
+    """
+    dest = dest_node_tensor.to(torch.long)
+    golden_rise = cppr_tensors['golden_rise_sp'][dest]
+    golden_fall = cppr_tensors['golden_fall_sp'][dest]
+
+    if topK > 1:
+        ep_rise_sps = rise_startpoints[dest]           # [E, K]
+        ep_fall_sps = fall_startpoints[dest]
+        ep_rise_arrivals = rise_arrival[dest]          # [E, K]
+        ep_fall_arrivals = fall_arrival[dest]
+
+        rise_mismatch = (golden_rise >= 0) & (ep_rise_sps[:, 0] != golden_rise)
+        fall_mismatch = (golden_fall >= 0) & (ep_fall_sps[:, 0] != golden_fall)
+
+        rise_match = ep_rise_sps == golden_rise.unsqueeze(1)   # [E, K]
+        fall_match = ep_fall_sps == golden_fall.unsqueeze(1)
+        rise_found = rise_match.any(dim=1)
+        fall_found = fall_match.any(dim=1)
+        rise_slot = torch.argmax(rise_match.to(torch.int8), dim=1)
+        fall_slot = torch.argmax(fall_match.to(torch.int8), dim=1)
+
+        rise_corrected = rise_mismatch & rise_found
+        fall_corrected = fall_mismatch & fall_found
+
+        corrected_rise_arrival = torch.where(
+            rise_corrected,
+            ep_rise_arrivals.gather(1, rise_slot.unsqueeze(1)).squeeze(1),
+            ep_rise_arrivals[:, 0]
+        )
+        corrected_fall_arrival = torch.where(
+            fall_corrected,
+            ep_fall_arrivals.gather(1, fall_slot.unsqueeze(1)).squeeze(1),
+            ep_fall_arrivals[:, 0]
+        )
+        corrected_rise_sp = torch.where(rise_corrected, golden_rise, ep_rise_sps[:, 0])
+        corrected_fall_sp = torch.where(fall_corrected, golden_fall, ep_fall_sps[:, 0])
+
+        cnt_mismatch = (rise_mismatch | fall_mismatch).sum()
+        cnt_found_crpr = (rise_corrected | fall_corrected).sum()
+    else:
+        # No candidate list to search at K=1; report mismatches only
+        corrected_rise_arrival = rise_arrival[dest]
+        corrected_fall_arrival = fall_arrival[dest]
+        corrected_rise_sp = rise_startpoints[dest]
+        corrected_fall_sp = fall_startpoints[dest]
+        cnt_mismatch = (((golden_rise >= 0) & (corrected_rise_sp != golden_rise)) |
+                        ((golden_fall >= 0) & (corrected_fall_sp != golden_fall))).sum()
+        cnt_found_crpr = torch.zeros_like(cnt_mismatch)
+
+    return {
+        'rise_arrival': corrected_rise_arrival,
+        'fall_arrival': corrected_fall_arrival,
+        'rise_startpoints': corrected_rise_sp,
+        'fall_startpoints': corrected_fall_sp,
+        'cnt_mismatch': cnt_mismatch,
+        'cnt_found_crpr': cnt_found_crpr,
+    }
+
+
+def build_endpoint_clusters(
+    cppr_metadata: Dict[str, torch.Tensor],
+    ep_rise_required_truth: torch.Tensor,
+    ep_fall_required_truth: torch.Tensor,
+    ep_ck_ids: torch.Tensor,
+    bucket_width: float,
+    device: torch.device
+) -> Dict[str, torch.Tensor]:
+    """
+    Cluster endpoints that share a timing context, for gradient dedup
+
+    Endpoints of the same bus land on the same launch startpoint and
+    capture clock pin with near-identical required times; their TNS
+    gradients flow back through largely the same cone, so
+    differentiating all of them buys bandwidth, not information. The
+    cluster key is (golden rise sp, golden fall sp, capture ck pin,
+    required-time bucket of width bucket_width); one torch.unique over
+    the stacked key columns labels every endpoint, and the member with
+    the tightest required time represents its cluster (lowest index on
+    ties). Representatives carry their cluster sizes as weights so a
+    representative-only TNS reduction keeps full-design gradient
+    magnitude.
+
+    ep_ck_ids is an int64 column aligned with cppr_metadata['ep_gids']
+    (-1 where the capture pin is unknown); the caller enumerates the
+    clock pin names since this module never sees strings.
+
+    Returns:
+        Dict of device tensors: 'ep_gids' / 'cluster_ids' (aligned,
+        full endpoint set), 'rep_gids' / 'rep_weights' /
+        'rep_rise_required' / 'rep_fall_required' / 'cluster_sizes'
+        (aligned, one row per cluster)
+    """
+    ep = cppr_metadata['ep_gids']
+    rise_req = ep_rise_required_truth[ep].to(torch.float32)
+    fall_req = ep_fall_required_truth[ep].to(torch.float32)
+    required = torch.minimum(rise_req, fall_req)
+    finite = torch.isfinite(required)
+    bucket = torch.where(
+        finite, (required / bucket_width).floor(),
+        torch.full_like(required, -1.0)
+    ).to(torch.int64)
+
+    key = torch.stack([
+        cppr_metadata['golden_rise_sp'],
+        cppr_metadata['golden_fall_sp'],
+        ep_ck_ids,
+        bucket
+    ], dim=1)
+    unique_keys, cluster_ids = torch.unique(key, dim=0, return_inverse=True)
+    num_clusters = unique_keys.shape[0]
+    cluster_sizes = torch.bincount(cluster_ids, minlength=num_clusters)
+
+    # Representative: tightest required time wins, lowest index on ties
+    req_filled = torch.where(finite, required,
+                             torch.full_like(required, float('inf')))
+    min_req = torch.full((num_clusters,), float('inf')).scatter_reduce_(
+        0, cluster_ids, req_filled, reduce='amin', include_self=True)
+    is_min = req_filled == min_req[cluster_ids]
+    member_idx = torch.arange(ep.numel(), dtype=torch.int64)
+    rep_idx = torch.full((num_clusters,), ep.numel(), dtype=torch.int64)
+    rep_idx.scatter_reduce_(0, cluster_ids[is_min], member_idx[is_min],
+                            reduce='amin', include_self=True)
+
+    return {
+        'ep_gids': ep.to(device),
+        'cluster_ids': cluster_ids.to(device),
+        'rep_gids': ep[rep_idx].to(device),
+        'rep_weights': cluster_sizes.to(torch.float32).to(device),
+        'rep_rise_required': rise_req[rep_idx].to(device),
+        'rep_fall_required': fall_req[rep_idx].to(device),
+        'cluster_sizes': cluster_sizes.to(device),
+    }
+
+
+def build_groundtruth_device_tensors(
+    cppr_metadata: Dict[str, torch.Tensor],
+    ep_rise_arrival_truth: torch.Tensor,
+    ep_rise_required_truth: torch.Tensor,
+    ep_rise_slack_truth: torch.Tensor,
+    ep_rise_depth_truth: torch.Tensor,
+    ep_fall_arrival_truth: torch.Tensor,
+    ep_fall_required_truth: torch.Tensor,
+    ep_fall_slack_truth: torch.Tensor,
+    ep_fall_depth_truth: torch.Tensor,
+    device: torch.device
+) -> Dict[str, torch.Tensor]:
+    """
+    Endpoint-compact device copies of the signoff truth columns
+
+    The gid-indexed truth planes stay on host (the sweep never reads
+    them), but the comparison engine wants them per endpoint on device
+    on every call. One gather at the cppr_metadata endpoint rows packs
+    the eight truth columns endpoint-compact in float32 (they are
+    compared, never accumulated), moves them to device once, and
+    compare_to_groundtruth_gpu then never touches the host planes or
+    string-keyed attribute dicts again.
+
+    Returns:
+        Dict with 'ep_gids', 'golden_rise_sp', 'golden_fall_sp' (device
+        copies of the metadata tensors) and rise/fall arrival /
+        required / slack / depth '_truth' columns aligned with 'ep_gids'
+    """
+    ep = cppr_metadata['ep_gids']
+    columns = {
+        'rise_arrival_truth': ep_rise_arrival_truth,
+        'rise_required_truth': ep_rise_required_truth,
+        'rise_slack_truth': ep_rise_slack_truth,
+        'rise_depth_truth': ep_rise_depth_truth,
+        'fall_arrival_truth': ep_fall_arrival_truth,
+        'fall_required_truth': ep_fall_required_truth,
+        'fall_slack_truth': ep_fall_slack_truth,
+        'fall_depth_truth': ep_fall_depth_truth,
+    }
+
+    from .memory import track
+    with track('groundtruth tables'):
+        truth = {
+            'ep_gids': ep.to(device),
+            'golden_rise_sp': cppr_metadata['golden_rise_sp'].to(device),
+            'golden_fall_sp': cppr_metadata['golden_fall_sp'].to(device),
+        }
+        for name, plane in columns.items():
+            truth[name] = plane[ep].to(torch.float32).to(device)
+    return truth
+
+
+def compare_to_groundtruth_gpu(
+    rise_arrival: torch.Tensor,
+    rise_startpoints: torch.Tensor,
+    fall_arrival: torch.Tensor,
+    fall_startpoints: torch.Tensor,
+    groundtruth: Dict[str, torch.Tensor],
+    worst_n: int = 32
+) -> Dict[str, torch.Tensor]:
+    """
+    Truth-vs-prediction comparison entirely on device
+
+    Mirrors apply_cppr_correction_tensorized (polarity pick by the
+    worse predicted slack, golden-startpoint mismatch detection, topK
+    candidate substitution) but reads the propagated Gid planes
+    directly against the prebuilt truth columns: no snapshot, no host
+    join, no name resolution. Invalid rows (infinite truth or
+    prediction) are masked arithmetically rather than boolean-indexed,
+    so nothing here syncs — a tracking loop can call this every
+    iteration and read the scalars whenever convenient.
+
+    Returns:
+        Dict of device scalars ('pearson_r', 'mean_abs_err',
+        'max_abs_err', 'rms_err', 'true_wns'/'pred_wns',
+        'true_tns'/'pred_tns', 'cnt_mismatch', 'cnt_found_crpr',
+        'num_eps') plus the worst_n offender table ('worst_ep_gids',
+        'worst_true_slack', 'worst_pred_slack', 'worst_abs_err',
+        'worst_is_rise'), sorted by absolute slack error
+    """
+    ep = groundtruth['ep_gids']
+    rise_req = groundtruth['rise_required_truth']
+    fall_req = groundtruth['fall_required_truth']
+
+    rise_arrs = rise_arrival[ep].to(torch.float32)
+    fall_arrs = fall_arrival[ep].to(torch.float32)
+    rise_sps = rise_startpoints[ep].to(torch.long)
+    fall_sps = fall_startpoints[ep].to(torch.long)
+    if rise_arrs.ndim == 1:
+        rise_arrs, fall_arrs = rise_arrs.unsqueeze(1), fall_arrs.unsqueeze(1)
+        rise_sps, fall_sps = rise_sps.unsqueeze(1), fall_sps.unsqueeze(1)
+
+    is_rise = (rise_req - rise_arrs[:, 0]) < (fall_req - fall_arrs[:, 0])
+    golden = torch.where(is_rise, groundtruth['golden_rise_sp'],
+                         groundtruth['golden_fall_sp'])
+    cand_sps = torch.where(is_rise.unsqueeze(1), rise_sps, fall_sps)
+    cand_arrs = torch.where(is_rise.unsqueeze(1), rise_arrs, fall_arrs)
+
+    mismatch = cand_sps[:, 0] != golden
+    match = cand_sps == golden.unsqueeze(1)
+    found = match.any(dim=1)
+    first_match = match.to(torch.int8).argmax(dim=1)
+    corrected = cand_arrs.gather(1, first_match.unsqueeze(1)).squeeze(1)
+    use_correction = mismatch & found
+
+    required = torch.where(is_rise, rise_req, fall_req)
+    pred_arrival = torch.where(use_correction, corrected, cand_arrs[:, 0])
+    pred_slack = required - pred_arrival
+    true_slack = torch.where(is_rise, groundtruth['rise_slack_truth'],
+                             groundtruth['fall_slack_truth'])
+
+    valid = torch.isfinite(true_slack) & torch.isfinite(pred_slack)
+    zeros = torch.zeros_like(true_slack)
+    num_eps = valid.sum()
+    n = num_eps.to(torch.float32).clamp(min=1)
+
+    err = torch.where(valid, true_slack - pred_slack, zeros)
+    abs_err = err.abs()
+
+    # Pearson over the valid rows; invalid rows contribute zero to every
+    # sum, so only the means and counts need the mask
+    t = torch.where(valid, true_slack, zeros)
+    p = torch.where(valid, pred_slack, zeros)
+    t_centered = torch.where(valid, true_slack - t.sum() / n, zeros)
+    p_centered = torch.where(valid, pred_slack - p.sum() / n, zeros)
+    denom = (t_centered.square().sum() * p_centered.square().sum()).sqrt()
+    pearson_r = (t_centered * p_centered).sum() / denom.clamp(min=1e-12)
+
+    pos_inf = torch.full_like(true_slack, float('inf'))
+    true_masked = torch.where(valid, true_slack, pos_inf)
+    pred_masked = torch.where(valid, pred_slack, pos_inf)
+
+    k = min(worst_n, ep.numel())
+    worst_err, worst_idx = torch.topk(abs_err, k)
+
+    return {
+        'pearson_r': pearson_r,
+        'mean_abs_err': abs_err.sum() / n,
+        'max_abs_err': abs_err.max(),
+        'rms_err': (err.square().sum() / n).sqrt(),
+        'true_wns': true_masked.min(),
+        'pred_wns': pred_masked.min(),
+        'true_tns': torch.where(valid & (true_slack < 0), true_slack, zeros).sum(),
+        'pred_tns': torch.where(valid & (pred_slack < 0), pred_slack, zeros).sum(),
+        'cnt_mismatch': mismatch.sum(),
+        'cnt_found_crpr': use_correction.sum(),
+        'num_eps': num_eps,
+        'worst_ep_gids': ep[worst_idx],
+        'worst_true_slack': true_slack[worst_idx],
+        'worst_pred_slack': pred_slack[worst_idx],
+        'worst_abs_err': worst_err,
+        'worst_is_rise': is_rise[worst_idx],
+    }
+
+
 def extract_cellArc_grad(
     level_2_collaterals,
     cellArcId_2_cellArcKey,
     inPinMod=1
-) -> Dict[Tuple[str, str], List]:
-    cellArc_2_riseFallGrads = {}
+) -> torch.Tensor:
+    """
+    Collect cell-arc delay gradients into one flat device tensor
+
+    Scatters each output-pin level's rise/fall mean gradients by
+    cellArcId in a handful of tensor copies; no per-arc Python work and
+    no host round trip. Wrap the result in ArcPairGradView when dict-style
+    name access is needed.
+
+    Returns:
+        [num_cell_arcs, 2] tensor of (rise, fall) gradients, on the
+        device the collaterals live on
+    """
+    num_arcs = len(cellArcId_2_cellArcKey)
+    grads = None
     for level in level_2_collaterals:
         if level != 1 and level % 2 != inPinMod:
-            rise_means    = level_2_collaterals[level][1]
+            rise_means   = level_2_collaterals[level][1]
             assert rise_means.grad is not None, "objective not diff yet"
-            fall_means    = level_2_collaterals[level][4]
-            cell_arc_ids  = level_2_collaterals[level][-1]
-            non_zero_mask = (rise_means.grad != 0) | (fall_means.grad != 0)
-            for arc_id, rise_grad, fall_grad in zip(
-                    cell_arc_ids[non_zero_mask], rise_means.grad[non_zero_mask], fall_means.grad[non_zero_mask]):
-                fromPinName, toPinName, sense = cellArcId_2_cellArcKey[arc_id.item()]
-                cellArc_2_riseFallGrads[fromPinName, toPinName] = [ rise_grad.item(), fall_grad.item() ]
-    return cellArc_2_riseFallGrads
+            fall_means   = level_2_collaterals[level][4]
+            cell_arc_ids = level_2_collaterals[level][-1]
+            if grads is None:
+                grads = torch.zeros(num_arcs, 2, dtype=rise_means.dtype, device=rise_means.device)
+            ids = cell_arc_ids.to(torch.int64).to(rise_means.device)
+            grads[ids, 0] = rise_means.grad
+            grads[ids, 1] = fall_means.grad
+    if grads is None:
+        grads = torch.zeros(num_arcs, 2)
+    return grads
 
 
 def extract_netArc_grad(
     level_2_collaterals,
     netArcId_2_netArcKey,
     inPinMod=1
-) -> Dict[Tuple[str, str], List]:
-    netArc_2_riseFallGrads = {}
+) -> torch.Tensor:
+    """
+    Collect net-arc delay gradients into one flat device tensor
+
+    Same contract as extract_cellArc_grad, over the input-pin levels;
+    scheduled levels split into ('chunks', ...) tuples are walked
+    chunk by chunk.
+
+    Returns:
+        [num_net_arcs, 2] tensor of (rise, fall) gradients
+    """
+    num_arcs = len(netArcId_2_netArcKey)
+    grads = None
     for level in level_2_collaterals:
         if level != 1 and level % 2 == inPinMod:
-            rise_means  = level_2_collaterals[level][2]
-            fall_means  = level_2_collaterals[level][5]
-            net_arc_ids = level_2_collaterals[level][-1].to(torch.int32).to(rise_means.device)
-            non_zero_mask = (rise_means.grad != 0) | (fall_means.grad != 0)
-            for arc_id, rise_grad, fall_grad in zip(
-                net_arc_ids[non_zero_mask], rise_means.grad[non_zero_mask], fall_means.grad[non_zero_mask]):
-                netArc_2_riseFallGrads[netArcId_2_netArcKey[arc_id.item()]] = [rise_grad.item(), fall_grad.item()]
-    return netArc_2_riseFallGrads
+            entry = level_2_collaterals[level]
+            if isinstance(entry, tuple) and entry[0] == 'chunks':
+                chunks = entry[1]
+            else:
+                chunks = [entry]
+            for chunk in chunks:
+                rise_means  = chunk[2]
+                fall_means  = chunk[5]
+                net_arc_ids = chunk[-1]
+                if grads is None:
+                    grads = torch.zeros(num_arcs, 2, dtype=rise_means.dtype, device=rise_means.device)
+                if torch.is_tensor(net_arc_ids):
+                    ids = net_arc_ids.to(device=rise_means.device, dtype=torch.int64)
+                else:
+                    ids = torch.tensor(net_arc_ids, dtype=torch.int64, device=rise_means.device)
+                grads[ids, 0] = rise_means.grad
+                grads[ids, 1] = fall_means.grad
+    if grads is None:
+        grads = torch.zeros(num_arcs, 2)
+    return grads
+
+
+def collect_arc_delay_leaves(
+    level_2_collaterals,
+    inPinMod=1
+) -> List[Tuple[torch.Tensor, torch.Tensor, bool, bool]]:
+    """
+    Gather the arc-delay mean tensors a second-order sweep left as leaves
+
+    The legacy diff path (no ArcGradAccumulator) marks each level's
+    rise/fall mean columns with requires_grad_() in place, so after the
+    forward those cached collateral tensors ARE the autograd leaves.
+    Second-order callers hand them to torch.autograd.grad; scheduled
+    ('chunks', ...) levels are walked chunk by chunk.
+
+    Returns:
+        List of (leaf_tensor, arc_id_tensor, is_net, is_rise) tuples
+    """
+    leaves = []
+
+    def _push(tensor, arc_ids, is_net, is_rise):
+        if not tensor.requires_grad:
+            return
+        if torch.is_tensor(arc_ids):
+            ids = arc_ids.to(torch.int64).to(tensor.device)
+        else:
+            ids = torch.tensor(arc_ids, dtype=torch.int64, device=tensor.device)
+        leaves.append((tensor, ids, is_net, is_rise))
+
+    for level in level_2_collaterals:
+        if level == 1:
+            continue
+        entry = level_2_collaterals[level]
+        if level % 2 == inPinMod:
+            if isinstance(entry, tuple) and entry[0] == 'chunks':
+                chunks = entry[1]
+            else:
+                chunks = [entry]
+            for chunk in chunks:
+                _push(chunk[2], chunk[-1], True, True)
+                _push(chunk[5], chunk[-1], True, False)
+        else:
+            _push(entry[1], entry[14], False, True)
+            _push(entry[4], entry[14], False, False)
+    return leaves
+
+
+class ArcPairGradView:
+    """
+    Dict-compatible (fromPin, toPin) view over a flat arc-gradient tensor
+
+    Matches what the dict extractors used to return: only arcs with a
+    nonzero gradient are "present", cell-arc senses collapse onto the
+    pin pair, and values read back as [rise_grad, fall_grad] lists. The
+    name index and the host copy of the gradients are built on first
+    name access, so callers that consume the tensor never pay for them.
+    """
+
+    def __init__(self, grad_tensor: torch.Tensor, arcKey_2_arcId: Dict):
+        self._grads = grad_tensor
+        self._arcKey_2_arcId = arcKey_2_arcId
+        self._pair_2_id = None
+        self._grads_cpu = None
+        self._nonzero = None
+
+    def _ensure_index(self):
+        if self._pair_2_id is not None:
+            return
+        self._grads_cpu = self._grads.detach().cpu()
+        self._nonzero = (self._grads_cpu != 0).any(dim=1)
+        pair_2_id = {}
+        for key, arc_id in self._arcKey_2_arcId.items():
+            pair = (key[0], key[1])
+            # a nonzero sense of a cell arc wins the pair slot, like the
+            # last-nonzero-wins behavior of the old dict extractor
+            if pair not in pair_2_id or self._nonzero[arc_id]:
+                pair_2_id[pair] = arc_id
+        self._pair_2_id = pair_2_id
+
+    def __contains__(self, key) -> bool:
+        self._ensure_index()
+        arc_id = self._pair_2_id.get(key)
+        return arc_id is not None and bool(self._nonzero[arc_id])
+
+    def __getitem__(self, key) -> List[float]:
+        if key not in self:
+            raise KeyError(key)
+        arc_id = self._pair_2_id[key]
+        return [float(self._grads_cpu[arc_id, 0]), float(self._grads_cpu[arc_id, 1])]
+
+    def get(self, key, default=None):
+        return self[key] if key in self else default
+
+    def keys(self):
+        self._ensure_index()
+        for pair, arc_id in self._pair_2_id.items():
+            if self._nonzero[arc_id]:
+                yield pair
+
+    def __iter__(self):
+        return self.keys()
+
+    def values(self):
+        for pair in self.keys():
+            yield self[pair]
+
+    def items(self):
+        for pair in self.keys():
+            yield pair, self[pair]
+
+    def __len__(self) -> int:
+        return sum(1 for _ in self.keys())
 
 def extract_stage_grad(
-    outPin_set,
-    Gid_2_pinName,
-    Gid_2_children,
-    Gid_2_parents,
-    netArc_2_riseFallGrads,
-    cellArc_2_riseFallGrads
+    level_2_collaterals,
+    netArc_grad_tensor,
+    cellArc_grad_tensor,
+    num_nodes,
+    inPinMod=1
+) -> torch.Tensor:
+    """
+    Fold arc gradients into per-stage gradients with two scatter-adds
+
+    A stage rooted at an output pin owns the cell arcs driving that pin
+    and the net arcs fanning out of it. The collaterals already carry
+    both as gid columns — net levels their driver pins, cell levels
+    their sink pins — so the per-pin adjacency walk collapses into
+    index_add_ over the flat arc-gradient tensors.
+
+    Args:
+        level_2_collaterals: Precomputed level collaterals
+        netArc_grad_tensor: [num_net_arcs, 2] from extract_netArc_grad
+        cellArc_grad_tensor: [num_cell_arcs, 2] from extract_cellArc_grad
+        num_nodes: Maximum node ID in the graph
+
+    Returns:
+        [num_nodes, 2] tensor of (rise, fall) stage gradients indexed
+        by output-pin gid; non-output pins stay zero
+    """
+    stage_grads = torch.zeros(num_nodes, 2,
+                              dtype=netArc_grad_tensor.dtype,
+                              device=netArc_grad_tensor.device)
+    for level in level_2_collaterals:
+        if level == 1:
+            continue
+        entry = level_2_collaterals[level]
+        if level % 2 == inPinMod: # input pins: credit the driving output pin
+            if isinstance(entry, tuple) and entry[0] == 'chunks':
+                chunks = entry[1]
+            else:
+                chunks = [entry]
+            for chunk in chunks:
+                drivers = chunk[1].to(torch.int64).to(stage_grads.device)
+                ids = torch.tensor(chunk[-1], dtype=torch.int64, device=stage_grads.device)
+                stage_grads.index_add_(0, drivers, netArc_grad_tensor[ids])
+        else: # output pins: credit the pin itself
+            sinks = torch.tensor(entry[0], dtype=torch.int64, device=stage_grads.device)
+            ids = entry[-1].to(torch.int64).to(stage_grads.device)
+            stage_grads.index_add_(0, sinks, cellArc_grad_tensor[ids])
+    return stage_grads
+
+
+def reverse_blame_analysis(
+    level_2_collaterals,
+    endpoint_gids: torch.Tensor,
+    num_net_arcs: int,
+    num_cell_arcs: int,
+    num_nodes: int,
+    device: torch.device,
+    timing_tensors=None,
+    normalize: bool = True,
+    inPinMod: int = 1
 ):
-    outPinName_2_stageGrad = {}
-    for curPin in outPin_set:
-        curPinName = Gid_2_pinName[curPin]
-        grad = 0
-        for child in Gid_2_children[curPin]:
-            childName = Gid_2_pinName[child]
-            if (curPinName, childName) not in netArc_2_riseFallGrads: continue
-            grad += sum(netArc_2_riseFallGrads[curPinName, childName])
-        for inPin in Gid_2_parents[curPin]:
-            inPinName = Gid_2_pinName[inPin]
-            if (inPinName, curPinName) not in cellArc_2_riseFallGrads: continue
-            grad += sum(cellArc_2_riseFallGrads[inPinName, curPinName])
-        assert curPinName not in outPinName_2_stageGrad, f"repeating output pin: {curPinName}"
-        outPinName_2_stageGrad[curPinName] = grad
-    return outPinName_2_stageGrad
+    """
+    Device-side reverse-cone blame accumulation from selected endpoints
+
+    Walks the levelization backward from the endpoints, carrying a blame
+    weight per node: every arc driving a weighted sink absorbs the
+    sink's weight into its occurrence count and weight * worst-polarity
+    mean delay into its arrival contribution, then hands the weight to
+    its parent. Each level is a couple of gathers plus index_add_ over
+    the collateral rows — the per-pin Python BFS over Gid_2_parents this
+    replaces took minutes on the same cones.
+
+    Endpoints seed with their top-K path mass when the arrival planes
+    are available (rank k contributes 1/(k+1), so endpoints backed by
+    more recorded near-critical paths weigh heavier), else 1.0. With
+    normalize=True a sink splits its weight evenly across its incoming
+    cell arcs, so blame is a conserved mass and deep fan-in cones cannot
+    overflow; normalize=False keeps raw path-segment multiplicity.
+
+    Returns (net_count, net_contrib, cell_count, cell_contrib) flat
+    device tensors indexed by arc id.
+    """
+    node_weight = torch.zeros(num_nodes, dtype=torch.float32, device=device)
+
+    seed = torch.ones(endpoint_gids.numel(), dtype=torch.float32, device=device)
+    if timing_tensors is not None and 'Gid_2_rise_arrival' in timing_tensors:
+        rise = timing_tensors['Gid_2_rise_arrival']
+        fall = timing_tensors['Gid_2_fall_arrival']
+        if rise.dim() > 1 and rise.size(1) > 1:
+            rank_weight = 1.0 / (torch.arange(
+                rise.size(1), dtype=torch.float32, device=device) + 1.0)
+            seed = (torch.isfinite(rise[endpoint_gids]) * rank_weight).sum(dim=1) \
+                 + (torch.isfinite(fall[endpoint_gids]) * rank_weight).sum(dim=1)
+            seed = seed.clamp(min=1.0)
+    node_weight[endpoint_gids] = seed
+
+    net_count = torch.zeros(num_net_arcs, dtype=torch.float32, device=device)
+    net_contrib = torch.zeros(num_net_arcs, dtype=torch.float32, device=device)
+    cell_count = torch.zeros(num_cell_arcs, dtype=torch.float32, device=device)
+    cell_contrib = torch.zeros(num_cell_arcs, dtype=torch.float32, device=device)
+
+    def _blame_rows(sinks, parents, arc_ids, delays, count_out, contrib_out,
+                    split_fan_in):
+        weight = node_weight[sinks]
+        if split_fan_in:
+            fan_in = torch.zeros(num_nodes, dtype=torch.float32, device=device)
+            fan_in.index_add_(0, sinks, torch.ones_like(weight))
+            weight = weight / fan_in[sinks].clamp(min=1.0)
+        count_out.index_add_(0, arc_ids, weight)
+        contrib_out.index_add_(0, arc_ids, weight * delays)
+        node_weight.index_add_(0, parents, weight)
+
+    for level in sorted(level_2_collaterals.keys(), reverse=True):
+        if level == 1:
+            continue
+        entry = level_2_collaterals[level]
+        if level % 2 == inPinMod: # net arcs: one driver per input pin
+            chunks = entry[1] if isinstance(entry, tuple) and entry[0] == 'chunks' \
+                else [entry]
+            for chunk in chunks:
+                _blame_rows(
+                    chunk[0].to(torch.int64).to(device),
+                    chunk[1].to(torch.int64).to(device),
+                    chunk[8].to(torch.int64).to(device) if torch.is_tensor(chunk[8])
+                        else torch.tensor(chunk[8], dtype=torch.int64, device=device),
+                    torch.maximum(chunk[2], chunk[5]).to(torch.float32).to(device),
+                    net_count, net_contrib, split_fan_in=False)
+        else: # cell arcs: fan-in rows share the sink's weight
+            sinks = entry[0].to(torch.int64).to(device) if torch.is_tensor(entry[0]) \
+                else torch.tensor(entry[0], dtype=torch.int64, device=device)
+            _blame_rows(
+                sinks,
+                entry[8].to(torch.int64).to(device),
+                entry[14].to(torch.int64).to(device),
+                torch.maximum(entry[1], entry[4]).to(torch.float32).to(device),
+                cell_count, cell_contrib, split_fan_in=normalize)
+
+    return net_count, net_contrib, cell_count, cell_contrib
+
+
+class StageGradView:
+    """
+    Pin-name view over the stage-gradient tensor
+
+    Mirrors the dict the per-pin extractor used to produce: every output
+    pin is present and maps to its scalar rise+fall stage gradient. The
+    name index and the host copy are built on first access, so tensor
+    consumers never pay for them.
+    """
+
+    def __init__(self, stage_grad_tensor: torch.Tensor, outPin_set, Gid_2_pinName):
+        self._grads = stage_grad_tensor
+        self._outPin_set = outPin_set
+        self._Gid_2_pinName = Gid_2_pinName
+        self._name_2_gid = None
+        self._sums = None
+
+    def _ensure_index(self):
+        if self._name_2_gid is not None:
+            return
+        self._sums = self._grads.detach().sum(dim=1).cpu()
+        self._name_2_gid = {self._Gid_2_pinName[gid]: gid for gid in self._outPin_set}
+
+    def __contains__(self, key) -> bool:
+        self._ensure_index()
+        return key in self._name_2_gid
+
+    def __getitem__(self, key) -> float:
+        self._ensure_index()
+        return float(self._sums[self._name_2_gid[key]])
+
+    def get(self, key, default=None):
+        return self[key] if key in self else default
+
+    def keys(self):
+        self._ensure_index()
+        return self._name_2_gid.keys()
+
+    def __iter__(self):
+        return iter(self.keys())
+
+    def values(self):
+        for name in self.keys():
+            yield self[name]
+
+    def items(self):
+        for name in self.keys():
+            yield name, self[name]
+
+    def __len__(self) -> int:
+        self._ensure_index()
+        return len(self._name_2_gid)
+
+
+class TnsEstimator:
+    """
+    First-order TNS move scorer over the cached stage gradients
+
+    Linearizes TNS around the operating point of the last differentiable
+    propagation: a candidate move that shifts the delays of a set of
+    stages by delta scores as dot(stage_grad, delta), which is one
+    gather and one reduction — no propagation, no host round trip — so
+    a placer can pull ~1M scores per second off it.
+
+    The linearization decays as moves are committed: every applied move
+    shifts the real arrivals away from the point the gradients were
+    taken at. note_applied accumulates the absolute first-order TNS
+    drift of committed moves, and is_stale() flips once it crosses
+    drift_budget — at which point scores are guesswork and the caller
+    should run a true propagation plus do_extract_arc_grads and rebuild.
+    """
+
+    def __init__(self, stage_grad_tensor: torch.Tensor, drift_budget: float = 0.05):
+        # Summed over rise/fall: a sizing/placement move shifts both
+        # polarities of a stage together at this fidelity
+        self._grads = stage_grad_tensor.detach().sum(dim=1)
+        self.drift_budget = drift_budget
+        self._drift = 0.0
+
+    def estimate(self, gids: torch.Tensor, deltas: torch.Tensor) -> torch.Tensor:
+        """
+        Score one move ([M] deltas -> scalar) or N candidates sharing a
+        stage set ([M, N] deltas -> [N]), all device-side
+        """
+        grads = self._grads.index_select(0, gids)
+        if deltas.dim() == 1:
+            return torch.dot(grads, deltas.to(grads.dtype))
+        return (grads.unsqueeze(1) * deltas.to(grads.dtype)).sum(dim=0)
+
+    def note_applied(self, gids: torch.Tensor, deltas: torch.Tensor):
+        """Charge a committed move against the drift budget"""
+        grads = self._grads.index_select(0, gids)
+        self._drift += float((grads * deltas.to(grads.dtype)).abs().sum())
+
+    def is_stale(self) -> bool:
+        return self._drift > self.drift_budget
 
@@ -0,0 +1,332 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/profiler.py
+# @brief CUDA-event level profiler for the arrival sweep
+
+import os
+import time
+import functools
+import contextlib
+import torch
+from typing import Any, Dict, List, Optional
+
+# NVTX ranges are opt-in (INSTA_NVTX=1): they are free-ish under Nsight
+# but still a host call per range, and the per-level ranges would add
+# thousands of calls per propagation when nobody is tracing
+_NVTX_ENABLED = os.environ.get('INSTA_NVTX', '0') not in ('', '0', 'false', 'False')
+
+
+def nvtx_enabled() -> bool:
+    return _NVTX_ENABLED and torch.cuda.is_available()
+
+
+@contextlib.contextmanager
+def nvtx_range(name: str):
+    """
+    NVTX range for Nsight Systems attribution, no-op unless INSTA_NVTX=1
+
+    Wraps initialization stages, CPPR correction and gradient extraction
+    so profiles read as named stages instead of anonymous kernel soup.
+    """
+    if nvtx_enabled():
+        torch.cuda.nvtx.range_push(name)
+        try:
+            yield
+        finally:
+            torch.cuda.nvtx.range_pop()
+    else:
+        yield
+
+
+def nvtx_annotate(name: str):
+    """Decorator form of nvtx_range for whole methods"""
+    def wrap(fn):
+        @functools.wraps(fn)
+        def inner(*args, **kwargs):
+            with nvtx_range(name):
+                return fn(*args, **kwargs)
+        return inner
+    return wrap
+
+
+# Python-scope profiling is opt-in (INSTA_PYPROF=1): a surprising share
+# of wall time hides in INSTA's own orchestration (dict building, list
+# conversions, host merges) rather than kernels, and attributing it
+# should not require forking the code or attaching an external sampler
+_PYPROF_ENABLED = os.environ.get('INSTA_PYPROF', '0') not in ('', '0', 'false', 'False')
+
+
+class PyScopeProfiler:
+    """
+    Folded-stack wall profiler over the Python orchestration layer
+
+    The decorated entry points (initialization, collateral precompute,
+    the host-side merge paths, propagation drivers) form a scope stack;
+    each scope accumulates its self time — elapsed minus time spent in
+    nested decorated scopes — keyed by the full stack path. write()
+    emits the classic collapsed-stack format ('a;b;c <usec>' per line),
+    which flamegraph.pl and speedscope consume directly, so a slow run
+    turns into a flamegraph without re-running under py-spy. Scopes are
+    a perf_counter read and a dict update each, cheap enough to leave in
+    farm runs.
+    """
+
+    def __init__(self):
+        import threading
+        self._folded: Dict[str, float] = {}
+        self._lock = threading.Lock()
+        self._tls = threading.local()
+
+    @contextlib.contextmanager
+    def scope(self, name: str):
+        stack = getattr(self._tls, 'stack', None)
+        if stack is None:
+            stack = self._tls.stack = []
+        stack.append([name, time.perf_counter(), 0.0])
+        try:
+            yield
+        finally:
+            _, start, child_time = stack[-1]
+            elapsed = time.perf_counter() - start
+            key = ';'.join(frame[0] for frame in stack)
+            stack.pop()
+            if stack:
+                stack[-1][2] += elapsed
+            with self._lock:
+                self._folded[key] = self._folded.get(key, 0.0) \
+                    + (elapsed - child_time)
+
+    def write(self, save_dir: str, filename: str = 'py_profile.folded') -> Optional[str]:
+        with self._lock:
+            if not self._folded:
+                return None
+            lines = [f'{key} {int(self_time * 1e6)}'
+                     for key, self_time in sorted(self._folded.items())]
+        path = os.path.join(save_dir, filename)
+        with open(path, 'w') as f:
+            f.write('\n'.join(lines) + '\n')
+        print(f'[py profiler] wrote {path} ({len(lines)} stacks, '
+              f'flamegraph.pl/speedscope ready)')
+        return path
+
+
+_py_profiler = PyScopeProfiler()
+_py_profile_dir = '.'
+
+
+def py_scope(name: str):
+    """
+    Decorator marking a major orchestration function as a profiler scope
+
+    Returns the function untouched unless INSTA_PYPROF=1, so the hooks
+    cost nothing when nobody is profiling.
+    """
+    def wrap(fn):
+        if not _PYPROF_ENABLED:
+            return fn
+        @functools.wraps(fn)
+        def inner(*args, **kwargs):
+            with _py_profiler.scope(name):
+                return fn(*args, **kwargs)
+        return inner
+    return wrap
+
+
+def set_py_profile_dir(save_dir: str) -> None:
+    """Route the end-of-run folded-stack dump into the design's save_dir"""
+    global _py_profile_dir
+    _py_profile_dir = save_dir
+
+
+def write_py_profile(save_dir: Optional[str] = None) -> Optional[str]:
+    """Dump the collected scopes now (also runs automatically at exit)"""
+    return _py_profiler.write(save_dir or _py_profile_dir)
+
+
+if _PYPROF_ENABLED:
+    import atexit
+    atexit.register(lambda: _py_profiler.write(_py_profile_dir))
+
+
+def level_width(level: int, collaterals: Any, inPinMod: int = 1) -> int:
+    """Number of target nodes a level writes (its natural width metric)"""
+    if level == 1:
+        return len(collaterals)
+    if level % 2 == inPinMod:
+        return len(collaterals[0])
+    return len(collaterals[10])
+
+
+def level_bytes(collaterals: Any) -> int:
+    """
+    Rough gather traffic for a level: the bytes of its collateral
+    tables. Parent-plane reads come on top, but the tables dominate and
+    this needs no knowledge of topK or plane dtypes.
+    """
+    if isinstance(collaterals, torch.Tensor):
+        return collaterals.numel() * collaterals.element_size()
+    total = 0
+    for item in collaterals:
+        if torch.is_tensor(item):
+            total += item.numel() * item.element_size()
+    return total
+
+
+class InitProfiler:
+    """
+    Per-stage breakdown of do_initialization for cold-start triage
+
+    Each stage records wall time, the process peak RSS high-water mark
+    (ru_maxrss — monotone, so growth between stages attributes host
+    memory), peak GPU memory for the stage, and whatever row/object
+    counts the caller annotates (arcs parsed, nodes levelized, ...).
+    write() emits the summary as JSON into save_dir so farm runs can be
+    aggregated without scraping stage banners from logs. Stages also
+    push NVTX ranges, so one instrumentation serves both the JSON
+    report and Nsight traces.
+    """
+
+    def __init__(self, device=None):
+        self.device = device
+        self._use_cuda = device is not None and str(device).startswith('cuda') \
+            and torch.cuda.is_available()
+        self.stages: List[Dict[str, Any]] = []
+        self._t_start = time.perf_counter()
+
+    @staticmethod
+    def _peak_rss_gb() -> float:
+        import resource
+        # ru_maxrss is KB on Linux
+        return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1e6
+
+    @contextlib.contextmanager
+    def stage(self, name: str):
+        if self._use_cuda:
+            torch.cuda.reset_peak_memory_stats(self.device)
+        t0 = time.perf_counter()
+        with nvtx_range(f'init: {name}'):
+            yield
+        record = {
+            'name': name,
+            'wall_s': time.perf_counter() - t0,
+            'peak_rss_gb': self._peak_rss_gb(),
+            'peak_gpu_gb': (torch.cuda.max_memory_allocated(self.device) / 1e9
+                            if self._use_cuda else 0.0)
+        }
+        self.stages.append(record)
+
+    def annotate(self, **counts) -> None:
+        """Attach row/object counts to the most recent stage"""
+        if self.stages:
+            self.stages[-1].update(counts)
+
+    def write(self, save_dir: str, filename: str = 'init_profile.json') -> str:
+        import json
+        report = {
+            'total_s': time.perf_counter() - self._t_start,
+            'peak_rss_gb': self._peak_rss_gb(),
+            'stages': self.stages
+        }
+        path = os.path.join(save_dir, filename)
+        with open(path, 'w') as f:
+            json.dump(report, f, indent=2)
+        print(f'[init profiler] wrote {path} '
+              f"({report['total_s']:.2f}s total, "
+              f"{report['peak_rss_gb']:.2f}GB peak rss)")
+        return path
+
+
+class LevelProfiler:
+    """
+    Per-level timing of the arrival sweep without perturbing it
+
+    The time.time() prints this replaces force an implicit sync per
+    level (the host blocks on the enqueued kernels to read a meaningful
+    delta) and emit thousands of lines per propagation on deep designs.
+    Here each level brackets its work with torch.cuda.Events recorded
+    asynchronously on the current stream; nothing blocks until report()
+    is called after the run, when a single synchronize resolves every
+    event pair. On CPU devices the events degrade to perf_counter
+    deltas, which are exact there since the work is synchronous.
+
+    One profiler instance can span several propagations; records
+    accumulate until reset().
+    """
+
+    def __init__(self, device: torch.device):
+        self.device = device
+        self.use_events = str(device).startswith('cuda')
+        self._records: List[Dict[str, Any]] = []
+        self._open: Optional[Dict[str, Any]] = None
+
+    def reset(self) -> None:
+        self._records = []
+        self._open = None
+
+    def begin(self, level: int) -> None:
+        record = {'level': level}
+        if self.use_events:
+            record['start'] = torch.cuda.Event(enable_timing=True)
+            record['end'] = torch.cuda.Event(enable_timing=True)
+            record['start'].record()
+        else:
+            record['start'] = time.perf_counter()
+        self._open = record
+
+    def end(self, level: int, width: int, nbytes: int) -> None:
+        record = self._open
+        assert record is not None and record['level'] == level, \
+            'profiler end() without matching begin()'
+        if self.use_events:
+            record['end'].record()
+        else:
+            record['end'] = time.perf_counter()
+        record['width'] = width
+        record['bytes'] = nbytes
+        self._records.append(record)
+        self._open = None
+
+    def report(self) -> Dict[str, Any]:
+        """
+        Resolve all events (one synchronize) into per-level rows plus
+        totals. Each row: level, width, kernel ms, gather bytes.
+        Chunked levels contribute one row per chunk launch.
+        """
+        if self.use_events and self._records:
+            torch.cuda.synchronize(self.device)
+        levels = []
+        for record in self._records:
+            if self.use_events:
+                ms = record['start'].elapsed_time(record['end'])
+            else:
+                ms = (record['end'] - record['start']) * 1e3
+            levels.append({
+                'level': record['level'],
+                'width': record['width'],
+                'ms': ms,
+                'bytes': record['bytes']
+            })
+        total_ms = sum(row['ms'] for row in levels)
+        return {
+            'levels': levels,
+            'total_ms': total_ms,
+            'num_levels': len(levels)
+        }
+
+    def print_summary(self, top: int = 20) -> None:
+        """Totals plus the top-N straggler levels by kernel time"""
+        report = self.report()
+        print(f"[profiler] {report['num_levels']} level launches, "
+              f"{report['total_ms']:.2f} ms total")
+        stragglers = sorted(report['levels'], key=lambda row: -row['ms'])[:top]
+        for row in stragglers:
+            print(f"[profiler]   level {row['level']}: {row['ms']:.3f} ms, "
+                  f"width {row['width']}, {row['bytes'] / 1e6:.2f} MB tables")
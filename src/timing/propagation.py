@@ -17,8 +17,27 @@ import torch
 from typing import Dict, List, Set, Tuple, Optional, Union, Any
 from copy import deepcopy
 
-from .pocv import calculate_slack
-from .cuda_ops import cuda_arrival_propagate_pocv
+from ..io.serialization import save_tensor_bundle, ARRIVAL_BUNDLE_NAME, \
+    ENDPOINT_BUNDLE_NAME
+from .pocv import calculate_slack, calculate_slack_fused
+from .results import stamp_propagation
+from .memory import AllocationGuard
+from ..core.logger import log_debug, log_info, log_warn
+from .profiler import py_scope
+from .cuda_ops import (cuda_arrival_propagate_pocv, cuda_arrival_propagate_pocv_checkpointed,
+                       CudaGraphArrivalPropagator, ArcGradAccumulator)
+
+
+_PAIRED_PLANE_NAMES = ('_paired_arrival', '_paired_mean', '_paired_std',
+                       '_paired_startpoints')
+
+
+def _paired_plane_views(timing_tensors: Dict[str, torch.Tensor]
+                        ) -> Optional[Dict[str, torch.Tensor]]:
+    """2-wide rise/fall views for the eager sweep; None on legacy caches"""
+    if '_paired_mean' not in timing_tensors:
+        return None
+    return {name: timing_tensors[name] for name in _PAIRED_PLANE_NAMES}
 
 
 def clear_timing_cache(
@@ -35,7 +54,8 @@ def clear_timing_cache(
     source_nodes: Set[int],
     dest_nodes: Set[int],
     existing_tensors: Optional[Dict[str, torch.Tensor]] = None,
-    is_diff_prop: bool = False
+    is_diff_prop: bool = False,
+    memory_budget_gb: Optional[float] = None
 ) -> Dict[str, torch.Tensor]:
     """
     Initialize or clear timing propagation cache
@@ -57,74 +77,442 @@ def clear_timing_cache(
     Returns:
         Dictionary of initialized tensors
     """
-    print('Clearing timing cache...')
+    log_info('Clearing timing cache...')
     start_time = time.time()
 
-    # Use existing tensors if provided and topK matches
+    # One contiguous arena per dtype with views for the individual planes:
+    # a single allocation instead of ten, and resets become two memsets.
+    # Rise/fall siblings sit adjacent so each pair doubles as a 2-wide
+    # view (_paired_* below): the eager sweep gathers and scatters both
+    # polarities through one index read per site instead of two
+    float_planes = [
+        'Gid_2_rise_arrival', 'Gid_2_fall_arrival',
+        'Gid_2_rise_arrival_mean', 'Gid_2_fall_arrival_mean',
+        'Gid_2_rise_arrival_std', 'Gid_2_fall_arrival_std',
+        'Gid_2_max_arrival'
+    ]
+    # The combined 'Gid_2_startpoints' plane that used to sit here was
+    # written by nothing and read by nothing — dropping it reclaims a
+    # third of the int arena (~5GB at 15M pins, K=256)
+    int_planes = ['Gid_2_rise_startpoints', 'Gid_2_fall_startpoints']
+
+    float_pairs = (('_paired_arrival', 0), ('_paired_mean', 2), ('_paired_std', 4))
+
+    def _bind_paired_views(into, f_arena, i_arena, k):
+        # [2, max_gid, K] (or [2, max_gid] at K=1) views over each
+        # rise/fall sibling pair, aliasing the per-polarity planes
+        for name, base in float_pairs:
+            pair = f_arena[base:base + 2]
+            into[name] = pair[:, :, 0] if k == 1 else pair[:, :, :k]
+        sp_pair = i_arena[0:2]
+        into['_paired_startpoints'] = sp_pair[:, :, 0] if k == 1 \
+            else sp_pair[:, :, :k]
+
+    # Reuse the existing arena whenever the requested K fits inside it:
+    # the planes are rebound as K-width views (K=1 as a strided view of
+    # column 0), so alternating eval (K=256) and diff (K=1) sweeps never
+    # reallocates the hundreds-of-GB arena — only a larger K does
     if existing_tensors and len(existing_tensors) > 0:
-        first_tensor = next(iter(existing_tensors.values()))
-        if len(first_tensor.shape) > 1 and first_tensor.shape[1] == topk:
-            # Clear existing tensors
-            for name, tensor in existing_tensors.items():
-                if name.startswith('Gid_2_rise') or name.startswith('Gid_2_fall') or name.startswith('Gid_2_max'):
-                    if 'slack' in name:
-                        tensor.fill_(float('-inf'))
-                    elif 'startpoints' in name:
-                        tensor.fill_(-1)
-                    else:
-                        tensor.fill_(float('-inf'))
+        float_arena = existing_tensors.get('_float_arena')
+        if float_arena is not None and topk <= float_arena.shape[2]:
+            float_arena.fill_(float('-inf'))
+            existing_tensors['_int_arena'].fill_(-1)
+            valid_plane = existing_tensors.get('Gid_2_valid')
+            if valid_plane is None:  # cache predates the validity plane
+                existing_tensors['Gid_2_valid'] = torch.zeros(
+                    max_gid, dtype=torch.bool, device=float_arena.device)
+            else:
+                valid_plane.fill_(False)
+            if topk != existing_tensors.get('_effective_topk'):
+                int_arena = existing_tensors['_int_arena']
+                for idx, name in enumerate(float_planes):
+                    plane = float_arena[idx]
+                    existing_tensors[name] = plane[:, 0] if topk == 1 \
+                        else plane[:, :topk]
+                for idx, name in enumerate(int_planes):
+                    plane = int_arena[idx]
+                    existing_tensors[name] = plane[:, 0] if topk == 1 \
+                        else plane[:, :topk]
+                _bind_paired_views(existing_tensors, float_arena, int_arena, topk)
+                existing_tensors['_effective_topk'] = topk
+                log_info(f'[timing cache] rebound plane views to K={topk} '
+                         f'(arena K={float_arena.shape[2]})')
             # Ensure sp_std_tensor exists in the cached tensors (new requirement)
             assert 'sp_std_tensor' in existing_tensors, (
                 "Cached timing tensors missing 'sp_std_tensor'; please reinitialize")
-            print(f'Cache clearing takes {time.time() - start_time:.2f} seconds')
+            log_info(f'Cache clearing takes {time.time() - start_time:.2f} seconds')
             return existing_tensors
+        if float_arena is None:
+            # Legacy per-plane cache: reusable only at an exact K match
+            first_tensor = next(iter(existing_tensors.values()))
+            if len(first_tensor.shape) > 1 and first_tensor.shape[1] == topk:
+                for name, tensor in existing_tensors.items():
+                    if name.startswith('Gid_2_rise') or name.startswith('Gid_2_fall') or name.startswith('Gid_2_max'):
+                        if 'startpoints' in name:
+                            tensor.fill_(-1)
+                        else:
+                            tensor.fill_(float('-inf'))
+                valid_plane = existing_tensors.get('Gid_2_valid')
+                if valid_plane is None:
+                    existing_tensors['Gid_2_valid'] = torch.zeros(
+                        max_gid, dtype=torch.bool, device=first_tensor.device)
+                else:
+                    valid_plane.fill_(False)
+                assert 'sp_std_tensor' in existing_tensors, (
+                    "Cached timing tensors missing 'sp_std_tensor'; please reinitialize")
+                log_info(f'Cache clearing takes {time.time() - start_time:.2f} seconds')
+                return existing_tensors
 
-    print('Initializing timing tensors for the first time')
+    log_info('Initializing timing tensors for the first time')
     tensors = {}
 
-    # Initialize 2D tensors for topK values
-    tensors['Gid_2_rise_arrival'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_rise_arrival_mean'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_rise_arrival_std'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_rise_startpoints'] = torch.full((max_gid, topk), -1, dtype=torch.int32).to(device)
-    tensors['Gid_2_fall_arrival'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_fall_arrival_mean'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_fall_arrival_std'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_fall_startpoints'] = torch.full((max_gid, topk), -1, dtype=torch.int32).to(device)
-    tensors['Gid_2_max_arrival'] = torch.full((max_gid, topk), float('-inf'), dtype=dtype).to(device)
-    tensors['Gid_2_startpoints'] = torch.full((max_gid, topk), -1, dtype=torch.int32).to(device)
-
-    # Reshape if topK == 1
-    if topk == 1 or is_diff_prop:
+    # Optional memory budget: degrade precision first, then K, until the
+    # arena fits (designs past GPU capacity otherwise have to be sharded)
+    if memory_budget_gb is not None:
+        budget_bytes = memory_budget_gb * (1 << 30)
+
+        def arena_bytes(k, dt):
+            return max_gid * k * (len(float_planes) * torch.finfo(dt).bits // 8 +
+                                  len(int_planes) * 4)
+
+        if arena_bytes(topk, dtype) > budget_bytes and dtype == torch.float32:
+            log_info(f'[timing cache] budget {memory_budget_gb}GB: dropping to bfloat16 planes')
+            dtype = torch.bfloat16
+        while arena_bytes(topk, dtype) > budget_bytes and topk > 1:
+            topk = topk // 2 if topk > 8 else 1
+            log_info(f'[timing cache] budget {memory_budget_gb}GB: reducing topK to {topk}')
+
+    from .memory import track
+    with track('arrival planes'):
+        float_arena = torch.full((len(float_planes), max_gid, topk), float('-inf'),
+                                 dtype=dtype, device=device)
+        int_arena = torch.full((len(int_planes), max_gid, topk), -1,
+                               dtype=torch.int32, device=device)
+
+    for idx, name in enumerate(float_planes):
+        tensors[name] = float_arena[idx]
+    for idx, name in enumerate(int_planes):
+        tensors[name] = int_arena[idx]
+
+    # Reshape if topK == 1; the diff path shares the K-column layout now
+    # that soft top-K propagation supports K > 1
+    if topk == 1:
         for name, tensor in list(tensors.items()):
             tensors[name] = tensor.reshape(-1)
 
-    # Move required times to device
-    tensors['ep_rise_required_truth'] = ep_rise_required_truth.to(device)
-    tensors['ep_fall_required_truth'] = ep_fall_required_truth.to(device)
-
-    # Create valid startpoint tensor
-    valid_sps = torch.zeros_like(ep_rise_required_truth).cpu()
+    _bind_paired_views(tensors, float_arena, int_arena, topk)
+
+    # Keep handles to the arenas so cache resets stay two memsets; also
+    # record the K actually allocated (the budget may have lowered it)
+    tensors['_float_arena'] = float_arena
+    tensors['_int_arena'] = int_arena
+    tensors['_effective_topk'] = topk
+
+    # Per-node validity bit plane: the arrival kernels set a node's bit
+    # as they write its arrivals, so coverage questions read one bool
+    # plane instead of isinf-scanning seven float planes — and the float
+    # arithmetic no longer needs the -inf sentinel to be distinguishable
+    # for validation purposes
+    tensors['Gid_2_valid'] = torch.zeros(max_gid, dtype=torch.bool, device=device)
+
+    # Required times on device are endpoint-indexed: only dest_nodes carry
+    # meaningful values in the dense [max_gid] truth tensors, so keep
+    # compact [num_endpoints] vectors aligned with dest_node_tensor plus a
+    # gid -> endpoint-position map for the few gid-keyed consumers. The
+    # dense truths stay host-side on INSTA for reporting.
+    dest_cpu = torch.tensor(list(dest_nodes), dtype=torch.long)
+    tensors['ep_rise_required'] = ep_rise_required_truth[dest_cpu].to(device)
+    tensors['ep_fall_required'] = ep_fall_required_truth[dest_cpu].to(device)
+    gid_2_ep_position = torch.full((max_gid,), -1, dtype=torch.int32)
+    gid_2_ep_position[dest_cpu] = torch.arange(dest_cpu.numel(), dtype=torch.int32)
+    tensors['gid_2_ep_position'] = gid_2_ep_position.to(device)
+
+    # Create valid startpoint tensor (kept dense: the pre-built arrival
+    # kernels consume it as a full [max_gid] plane)
+    valid_sps = torch.zeros(max_gid, dtype=torch.bool)
     sps = [pin_to_id_map[spName] for spName in ep_to_sp_map.values()
            if spName in pin_to_id_map]
-    valid_sps[sps] = 1
-    tensors['valid_sps'] = valid_sps.to(torch.bool).to(device)
+    valid_sps[sps] = True
+    tensors['valid_sps'] = valid_sps.to(device)
 
     # Create node tensors
-    tensors['dest_node_tensor'] = torch.tensor(list(dest_nodes), dtype=torch.int32).to(device)
+    tensors['dest_node_tensor'] = dest_cpu.to(torch.int32).to(device)
     tensors['sp_node_tensor'] = torch.tensor(list(source_nodes), dtype=torch.long).to(device)
     tensors['sp_mean_tensor'] = sp_mean_tensor.to(device)
     tensors['sp_std_tensor'] = sp_std_tensor.to(device)
 
-    # Initialize slack tensors
-    tensors['Gid_2_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=dtype).to(device)
-    tensors['Gid_2_rise_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=dtype).to(device)
-    tensors['Gid_2_fall_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=dtype).to(device)
+    # Initialize slack tensors. Per-level dtype policy: even when the
+    # arena runs half precision the endpoint-facing reductions stay
+    # fp32 — slacks and the WNS/TNS sums are where half-precision
+    # rounding shows up first (see cast_collaterals_dtype_policy)
+    slack_dtype = torch.float32 if dtype in (torch.float16, torch.bfloat16) else dtype
+    tensors['Gid_2_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=slack_dtype).to(device)
+    tensors['Gid_2_rise_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=slack_dtype).to(device)
+    tensors['Gid_2_fall_slack'] = torch.tensor([float('-inf')] * max_gid, dtype=slack_dtype).to(device)
 
-    print(f'Cache initialization takes {time.time() - start_time:.2f} seconds')
+    log_info(f'Cache initialization takes {time.time() - start_time:.2f} seconds')
     return tensors
 
 
+def arrival_coverage(timing_tensors: Dict[str, torch.Tensor]) -> Tuple[int, int]:
+    """
+    (covered, total) node arrival coverage from the validity bit plane
+
+    The kernels maintain Gid_2_valid as they write, so this is one
+    reduction over a bool plane rather than isinf scans of the float
+    planes. Caches created before the plane existed fall back to an
+    isfinite scan of the worst-candidate rise means.
+    """
+    mask = timing_tensors.get('Gid_2_valid')
+    if mask is not None:
+        return int(mask.sum()), mask.numel()
+    plane = timing_tensors['Gid_2_rise_arrival_mean']
+    if plane.ndim > 1:
+        plane = plane[:, 0]
+    return int(torch.isfinite(plane).sum()), plane.numel()
+
+
+def plan_arrival_compaction(
+    level_2_collaterals: Dict[int, Any],
+    max_gid: int,
+    inPinMod: int = 1,
+    keep_gids: Optional[torch.Tensor] = None
+) -> Dict[str, Any]:
+    """
+    Assign arrival-plane rows so dead levels' memory is recycled
+
+    A node's arrival row is written at its own level and read for the
+    last time when its deepest fanout level runs; after that the row is
+    dead weight for the rest of the sweep. The schedule is static, so
+    last use is exact: one pass over the level tables records each gid's
+    write level and deepest read level, and a second pass runs the
+    classic linear-scan allocation — pop a freed row if one exists, else
+    grow — freeing a level's consumed rows only AFTER its writes are
+    placed (a row read and a row written at the same level never share).
+    The result is a STATIC [max_gid] gid -> slot table: two gids share a
+    slot only when their live ranges are disjoint, and the sweep touches
+    a row only while its gid is live, so no per-level remapping is
+    needed at runtime.
+
+    Gids that are never read downstream (endpoints) and anything in
+    keep_gids stay live to the end, so post-sweep readout through the
+    table is safe for them. num_slots is the peak live-set across the
+    schedule — typically a small fraction of max_gid for deep designs —
+    and is what propagate_arrival_compact sizes its arenas with.
+
+    Returns:
+        {'gid_2_slot': int64 [max_gid] (-1 for gids the sweep never
+        writes), 'num_slots', 'num_written'}
+    """
+    start_time = time.time()
+    device = None
+    write_order = []          # [(t, write_gids)] in schedule order
+    read_stamp = None         # deepest schedule position reading each gid
+
+    def _tables(entry):
+        if isinstance(entry, tuple) and len(entry) == 2 \
+                and entry[0] == 'chunks':
+            return entry[1]
+        return [entry]
+
+    num_steps = 0
+    for t, (level, entry) in enumerate(level_2_collaterals.items()):
+        num_steps = t + 1
+        for coll in _tables(entry):
+            if level == 1:
+                writes, reads = coll, None
+            elif level % 2 == inPinMod:  # net arcs
+                writes, reads = coll[0], coll[1]
+            else:  # cell arcs
+                writes, reads = coll[13], coll[11]
+            if device is None:
+                device = writes.device
+                read_stamp = torch.full((max_gid,), -1, dtype=torch.int64,
+                                        device=device)
+            write_gids = writes.to(torch.int64)
+            write_order.append((t, write_gids))
+            if reads is not None:
+                read_stamp[reads.to(torch.int64)] = t
+
+    assert read_stamp is not None, 'no levels to plan'
+    written = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    for _, write_gids in write_order:
+        written[write_gids] = True
+    # Endpoints (written, never read) and pinned gids survive the sweep
+    read_stamp[written & (read_stamp < 0)] = num_steps
+    if keep_gids is not None:
+        read_stamp[keep_gids.to(device).to(torch.int64)] = num_steps
+
+    # Group written gids by the step that frees them; step num_steps
+    # means never freed
+    written_gids = written.nonzero(as_tuple=True)[0]
+    stamps = read_stamp[written_gids]
+    stamps_sorted, order = torch.sort(stamps)
+    steps, counts = torch.unique_consecutive(stamps_sorted,
+                                             return_counts=True)
+    frees_at = {}
+    offset = 0
+    for step, count in zip(steps.tolist(), counts.tolist()):
+        if step < num_steps:
+            frees_at[step] = written_gids[order[offset:offset + count]]
+        offset += count
+
+    gid_2_slot = torch.full((max_gid,), -1, dtype=torch.int64, device=device)
+    free_rows = torch.empty(0, dtype=torch.int64, device=device)
+    next_fresh = 0
+    for t, write_gids in write_order:
+        n = write_gids.numel()
+        reuse = min(n, free_rows.numel())
+        if reuse:
+            gid_2_slot[write_gids[:reuse]] = free_rows[-reuse:]
+            free_rows = free_rows[:-reuse]
+        if n > reuse:
+            gid_2_slot[write_gids[reuse:]] = torch.arange(
+                next_fresh, next_fresh + n - reuse, device=device)
+            next_fresh += n - reuse
+        freed = frees_at.get(t)
+        if freed is not None:
+            free_rows = torch.cat((free_rows, gid_2_slot[freed]))
+
+    num_written = int(written.sum())
+    log_info(f'[compaction plan] {next_fresh} slots for {num_written} '
+             f'written gids ({max_gid} total), '
+             f'{time.time() - start_time:.2f}s')
+    return {'gid_2_slot': gid_2_slot, 'num_slots': next_fresh,
+            'num_written': num_written}
+
+
+def propagate_arrival_compact(
+    level_2_collaterals: Dict[int, Any],
+    inPin_parent_tensor: torch.Tensor,
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    sp_mean_tensor: torch.Tensor,
+    sp_std_tensor: torch.Tensor,
+    ep_rise_required_truth: torch.Tensor,
+    ep_fall_required_truth: torch.Tensor,
+    ep_to_sp_map: Dict,
+    pin_to_id_map: Dict[str, int],
+    dest_nodes: Set[int],
+    topk: int = 1,
+    sigma: float = 3.0,
+    plan: Optional[Dict[str, Any]] = None,
+    log: bool = False
+) -> Tuple[Dict[str, torch.Tensor], float, float]:
+    """
+    Single-shot full propagation on compacted arrival arenas
+
+    Memory-constrained alternative to clear_timing_cache +
+    propagate_arrival_times: the arenas are sized by the schedule's peak
+    live-set (plan_arrival_compaction) instead of max_gid, and the sweep
+    indexes them through the static gid -> slot table. Endpoint rows are
+    pinned live, so WNS/TNS come out of the same fused endpoint pass as
+    the dense path. What this mode gives up is dense post-sweep
+    queryability: only endpoints (and rows that happen not to be
+    recycled) hold their own arrivals afterwards, so required-time /
+    hold propagation and pin-level reporting belong to the dense path.
+
+    Returns:
+        (compact_tensors, wns, tns); compact_tensors holds the
+        [num_slots, K] planes plus 'gid_2_slot' for endpoint lookups,
+        and wns/tns are device scalars
+    """
+    start_time = time.time()
+    dest_cpu = torch.tensor(list(dest_nodes), dtype=torch.long)
+    if plan is None:
+        plan = plan_arrival_compaction(level_2_collaterals, max_gid,
+                                       keep_gids=dest_cpu)
+    gid_2_slot = plan['gid_2_slot']
+    num_slots = plan['num_slots']
+
+    # Same arena layout as clear_timing_cache, minus max plane and paired
+    # views (the eager per-plane paths serve this mode), at 1/compaction
+    # the rows
+    float_planes = [
+        'Gid_2_rise_arrival', 'Gid_2_fall_arrival',
+        'Gid_2_rise_arrival_mean', 'Gid_2_fall_arrival_mean',
+        'Gid_2_rise_arrival_std', 'Gid_2_fall_arrival_std'
+    ]
+    int_planes = ['Gid_2_rise_startpoints', 'Gid_2_fall_startpoints']
+    from .memory import track
+    with track('compact arrival planes'):
+        float_arena = torch.full((len(float_planes), num_slots, topk),
+                                 float('-inf'), dtype=float_dtype,
+                                 device=device)
+        int_arena = torch.full((len(int_planes), num_slots, topk), -1,
+                               dtype=torch.int32, device=device)
+    tensors = {}
+    for idx, name in enumerate(float_planes):
+        tensors[name] = float_arena[idx]
+    for idx, name in enumerate(int_planes):
+        tensors[name] = int_arena[idx]
+    if topk == 1:
+        for name in float_planes + int_planes:
+            tensors[name] = tensors[name].reshape(-1)
+
+    valid_sps = torch.zeros(max_gid, dtype=torch.bool)
+    sps = [pin_to_id_map[spName] for spName in ep_to_sp_map.values()
+           if spName in pin_to_id_map]
+    valid_sps[sps] = True
+    tensors['valid_sps'] = valid_sps.to(device)
+
+    cuda_arrival_propagate_pocv(
+        sp_mean_tensor.to(device),
+        sp_std_tensor.to(device),
+        level_2_collaterals,
+        inPin_parent_tensor,
+        device,
+        max_gid,
+        tensors['Gid_2_rise_arrival'],
+        tensors['Gid_2_rise_arrival_mean'],
+        tensors['Gid_2_rise_arrival_std'],
+        tensors['Gid_2_rise_startpoints'],
+        tensors['Gid_2_fall_arrival'],
+        tensors['Gid_2_fall_arrival_mean'],
+        tensors['Gid_2_fall_arrival_std'],
+        tensors['Gid_2_fall_startpoints'],
+        float_dtype,
+        tensors['valid_sps'],
+        sigma=sigma,
+        topK=topk,
+        log=log,
+        gid_2_slot=gid_2_slot
+    )
+
+    # Endpoint slack on the compact rows: the scatter planes are
+    # slot-indexed, so dest rides through the slot table. Slacks stay
+    # fp32 like the dense path's endpoint reductions.
+    dest_slots = gid_2_slot[dest_cpu.to(gid_2_slot.device)]
+    assert bool((dest_slots >= 0).all()), \
+        'endpoint gid missing from the schedule; compaction plan is stale'
+    slack_dtype = torch.float32 if float_dtype in (torch.float16, torch.bfloat16) \
+        else float_dtype
+    tensors['Gid_2_slack'] = torch.full((num_slots,), float('-inf'),
+                                        dtype=slack_dtype, device=device)
+    tensors['Gid_2_rise_slack'] = torch.full_like(tensors['Gid_2_slack'],
+                                                  float('-inf'))
+    tensors['Gid_2_fall_slack'] = torch.full_like(tensors['Gid_2_slack'],
+                                                  float('-inf'))
+    wns, tns = calculate_slack_fused(
+        tensors['Gid_2_rise_slack'],
+        tensors['Gid_2_fall_slack'],
+        tensors['Gid_2_slack'],
+        tensors['Gid_2_rise_arrival'],
+        tensors['Gid_2_fall_arrival'],
+        ep_rise_required_truth[dest_cpu].to(device),
+        ep_fall_required_truth[dest_cpu].to(device),
+        dest_slots.to(torch.int32),
+        topk
+    )
+    tensors['gid_2_slot'] = gid_2_slot
+    tensors['_compaction_plan'] = plan
+    log_info(f'[compact propagation] {num_slots}/{max_gid} resident rows, '
+             f'{time.time() - start_time:.2f}s')
+    return tensors, wns, tns
+
+
+@py_scope('propagate_arrival_times')
 def propagate_arrival_times(
     timing_tensors: Dict[str, torch.Tensor],
     level_2_collaterals: Dict[int, Any],
@@ -136,7 +524,21 @@ def propagate_arrival_times(
     topk: int = 256,
     temperature: float = 1.0,
     is_diff_prop: bool = False,
-    debug: bool = False
+    debug: bool = False,
+    graph_propagator: Optional[CudaGraphArrivalPropagator] = None,
+    use_persistent: bool = False,
+    fused_slack: bool = False,
+    streaming: bool = False,
+    streaming_plan: Optional[Dict[str, Any]] = None,
+    checkpoint_segment_levels: int = 0,
+    grad_arc_stds: bool = False,
+    second_order: bool = False,
+    deterministic: bool = False,
+    track_startpoints: bool = True,
+    cppr_tensors: Optional[Dict[str, torch.Tensor]] = None,
+    profiler: Optional[Any] = None,
+    tuner: Optional[Any] = None,
+    log: bool = False
 ) -> Dict[str, torch.Tensor]:
     """
     Perform timing propagation to calculate arrival times
@@ -151,6 +553,45 @@ def propagate_arrival_times(
         sigma: Sigma multiplier for statistical timing
         topk: Number of paths to track per endpoint
         temperature: Temperature for softmax operations
+        graph_propagator: Optional CUDA Graph wrapper; when supplied, the
+            level sweep is captured on the first call and replayed afterwards
+        streaming: Out-of-core mode for designs whose collaterals exceed
+            device memory. level_2_collaterals stays in host memory; each
+            level is prefetched on a copy stream while the previous one
+            computes and evicted as soon as its fanout is consumed
+        streaming_plan: Optional build_streaming_transfer_plan schedule;
+            its static earliest-issue points replace the loader's fixed
+            lookahead so transfers provably hide within the memory ceiling
+        checkpoint_segment_levels: When > 0 and is_diff_prop, cut the sweep
+            into segments of this many levels and store arrivals only at
+            segment boundaries, recomputing in-between levels in backward
+        second_order: Keep the arc-delay leaves in the autograd graph for
+            double backward (Hessian-vector products). Skips the
+            ArcGradAccumulator — its hooks detach the leaves — and falls
+            back to marking the cached mean columns with requires_grad_();
+            callers collect them via collect_arc_delay_leaves afterwards
+        deterministic: Bit-identical repeated runs. Incompatible with the
+            persistent kernel and CUDA Graph paths; the eager sweep routes
+            cell levels through the stable-sorted torch formulation
+        track_startpoints: When False, the eager sweep skips the
+            startpoint-plane gathers and scatters (training loops that
+            never read them; see cuda_arrival_propagate_pocv). The
+            planes are left stale, so path backtracing and exception
+            credits need a tracked run first
+        cppr_tensors: Optional build_cppr_tensors tables. When supplied
+            (implies the fused slack path), common-point credit fuses
+            into the endpoint slack pass: corrected slacks land in
+            timing_tensors['Gid_2_cppr_slack'] and corrected WNS/TNS in
+            timing_tensors['cppr_wns'/'cppr_tns'] as device scalars, so
+            optimizer loops can descend on corrected slacks with no
+            separate correction phase. Requires tracked startpoints and
+            topk > 1 for the candidate scan to find the golden path
+        profiler: Optional LevelProfiler bracketing every level with CUDA
+            events (resolved after the run, no syncs during the sweep)
+        tuner: Optional DispatchTuner steering each level to the fused
+            kernels or the torch formulation by measured shape table
+        log: Per-level progress prints; off by default since every print
+            syncs the stream and deep designs emit thousands of lines
 
     Returns:
         Updated dictionary of timing tensors
@@ -162,20 +603,25 @@ def propagate_arrival_times(
     start_time = time.time()
     if is_diff_prop:
         temperature_tensor = torch.tensor([temperature], dtype=float_dtype).to(device)
+        # Fresh per propagation: backward hooks accumulate arc gradients
+        # straight into these flat buffers (see ArcGradAccumulator). Under
+        # mixed precision the activations are bf16/fp16 but the master
+        # gradients stay fp32; the hooks cast on accumulation.
+        grad_dtype = torch.float32 if float_dtype in (torch.float16, torch.bfloat16) \
+            else float_dtype
+        if second_order:
+            arc_grad_accumulator = None
+            timing_tensors['_arc_grad_accumulator'] = None
+        else:
+            arc_grad_accumulator = ArcGradAccumulator.from_collaterals(
+                level_2_collaterals, device, grad_dtype)
+            timing_tensors['_arc_grad_accumulator'] = arc_grad_accumulator
     else:
         temperature_tensor = None
+        arc_grad_accumulator = None
 
     # Execute arrival time propagation
-    (
-        timing_tensors['Gid_2_rise_arrival'],
-        timing_tensors['Gid_2_rise_arrival_mean'],
-        timing_tensors['Gid_2_rise_arrival_std'],
-        timing_tensors['Gid_2_rise_startpoints'],
-        timing_tensors['Gid_2_fall_arrival'],
-        timing_tensors['Gid_2_fall_arrival_mean'],
-        timing_tensors['Gid_2_fall_arrival_std'],
-        timing_tensors['Gid_2_fall_startpoints']
-    ) = cuda_arrival_propagate_pocv(
+    propagate_args = (
         timing_tensors['sp_mean_tensor'],
         timing_tensors['sp_std_tensor'],
         level_2_collaterals,
@@ -191,23 +637,502 @@ def propagate_arrival_times(
         timing_tensors['Gid_2_fall_arrival_std'],
         timing_tensors['Gid_2_fall_startpoints'],
         float_dtype,
-        timing_tensors['valid_sps'],
-        topK=topk,
-        is_diff_prop=is_diff_prop,
-        temperature_tensor=temperature_tensor
+        timing_tensors['valid_sps']
     )
 
+    collateral_loader = None
+    if streaming:
+        # Streaming keeps the sweep data-dependent on host uploads, which is
+        # incompatible with graph capture and the persistent kernel
+        assert graph_propagator is None and not use_persistent, \
+            'streaming propagation requires the eager level sweep'
+        from .collaterals import StreamingCollateralLoader
+        collateral_loader = StreamingCollateralLoader(level_2_collaterals, device,
+                                                      plan=streaming_plan)
+
+    if is_diff_prop and checkpoint_segment_levels > 0:
+        (
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints']
+        ) = cuda_arrival_propagate_pocv_checkpointed(
+            *propagate_args,
+            temperature_tensor=temperature_tensor,
+            sigma=sigma,
+            topK=topk,
+            segment_levels=checkpoint_segment_levels,
+            arc_grad_accumulator=arc_grad_accumulator,
+            # second_order also forces the torch-native cell path: the
+            # fused WithGrad backward is a prebuilt op and cannot be
+            # differentiated a second time
+            grad_arc_stds=grad_arc_stds or second_order,
+            track_startpoints=track_startpoints
+        )
+    elif use_persistent and not is_diff_prop:
+        assert not deterministic, \
+            'deterministic propagation requires the eager level sweep'
+        # Persistent-kernel path: one resident kernel walks all levels
+        # on-device using the flattened collateral buffers
+        import src.installed_ops.sta_compute_arrival.compute_arrival as compute_arrival
+        assert compute_arrival.HAS_PERSISTENT_PROPAGATE, \
+            'installed sta_compute_arrival build lacks persistent_arrival_propagate_pocv'
+        from .collaterals import flatten_level_collaterals
+        flat_collaterals = flatten_level_collaterals(level_2_collaterals, device)
+        sigma_tensor = torch.tensor([sigma], dtype=float_dtype).to(device)
+        compute_arrival.ComputeArrivalPersistent.forward(
+            timing_tensors['sp_mean_tensor'],
+            timing_tensors['sp_std_tensor'],
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints'],
+            flat_collaterals,
+            sigma_tensor,
+            timing_tensors['valid_sps'],
+            topk
+        )
+    elif graph_propagator is not None and not is_diff_prop:
+        assert not deterministic, \
+            'deterministic propagation requires the eager level sweep'
+        # CUDA Graph path: capture once, replay afterwards. The sweep writes
+        # in place into the cached Gid tensors, so no rebinding is needed.
+        if not graph_propagator.is_captured:
+            graph_propagator.capture(
+                *propagate_args,
+                sigma=sigma,
+                topK=topk,
+                is_diff_prop=is_diff_prop,
+                temperature_tensor=temperature_tensor
+            )
+        else:
+            graph_propagator.replay()
+    else:
+        (
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints']
+        ) = cuda_arrival_propagate_pocv(
+            *propagate_args,
+            sigma=sigma,
+            topK=topk,
+            is_diff_prop=is_diff_prop,
+            temperature_tensor=temperature_tensor,
+            paired_planes=_paired_plane_views(timing_tensors),
+            collateral_loader=collateral_loader,
+            arc_grad_accumulator=arc_grad_accumulator,
+            grad_arc_stds=grad_arc_stds or second_order,
+            deterministic=deterministic,
+            track_startpoints=track_startpoints,
+            profiler=profiler,
+            tuner=tuner,
+            log=log,
+            valid_mask=timing_tensors.get('Gid_2_valid')
+        )
+
     print(f"[timing propagation] completed in {time.time() - start_time:.2f} seconds")
 
-    # Calculate slack values
+    # Calculate slack values. The fused variant keeps WNS/TNS as device
+    # scalars with no host sync, which matters when (-tns).backward() runs
+    # thousands of times in an optimizer loop.
+    if cppr_tensors is not None:
+        cppr_plane = timing_tensors.get('Gid_2_cppr_slack')
+        if cppr_plane is None \
+                or cppr_plane.shape != timing_tensors['Gid_2_slack'].shape:
+            cppr_plane = torch.full_like(timing_tensors['Gid_2_slack'],
+                                         float('inf'))
+            timing_tensors['Gid_2_cppr_slack'] = cppr_plane
+        wns, tns, cppr_wns, cppr_tns = calculate_slack_fused(
+            timing_tensors['Gid_2_rise_slack'],
+            timing_tensors['Gid_2_fall_slack'],
+            timing_tensors['Gid_2_slack'],
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['ep_rise_required'],
+            timing_tensors['ep_fall_required'],
+            timing_tensors['dest_node_tensor'],
+            topk,
+            cppr_tensors=cppr_tensors,
+            rise_startpoints=timing_tensors['Gid_2_rise_startpoints'],
+            fall_startpoints=timing_tensors['Gid_2_fall_startpoints'],
+            cppr_slack_out=cppr_plane
+        )
+        timing_tensors['cppr_wns'] = cppr_wns
+        timing_tensors['cppr_tns'] = cppr_tns
+    else:
+        slack_fn = calculate_slack_fused if fused_slack else calculate_slack
+        wns, tns = slack_fn(
+            timing_tensors['Gid_2_rise_slack'],
+            timing_tensors['Gid_2_fall_slack'],
+            timing_tensors['Gid_2_slack'],
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['ep_rise_required'],
+            timing_tensors['ep_fall_required'],
+            timing_tensors['dest_node_tensor'],
+            topk
+        )
+
+    timing_tensors['Gid_2_max_arrival_mean'] = torch.max(timing_tensors['Gid_2_rise_arrival_mean'], timing_tensors['Gid_2_fall_arrival_mean'])
+    timing_tensors['Gid_2_max_arrival_std'] = torch.max(timing_tensors['Gid_2_rise_arrival_std'], timing_tensors['Gid_2_fall_arrival_std'])
+
+    # Always-on coverage counters: one gather over the cached level node
+    # index, reported against expected level sizes. Diff sweeps skip it
+    # so the optimizer loop stays free of the counter readback sync.
+    if not is_diff_prop:
+        check_level_coverage(timing_tensors, level_2_collaterals, device,
+                             log=True)
+
+    if debug:
+        covered, total = arrival_coverage(timing_tensors)
+        print(f"[propagate_arrival_times] valid arrivals: {covered}/{total} nodes")
+
+    stamp_propagation(timing_tensors)
+    return timing_tensors, wns, tns
+
+
+def propagate_arrival_warmstart(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    inPin_parent_tensor: torch.Tensor,
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    epsilon: float,
+    sigma: float = 3.0,
+    topk: int = 1,
+    inPinMod: int = 1,
+    log: bool = False
+) -> Tuple[Dict[str, torch.Tensor], torch.Tensor, torch.Tensor, int]:
+    """
+    Warm-started sweep that stops once the frontier has converged
+
+    Optimizer iterations move the arc delays slightly; re-propagating
+    the full depth recomputes thousands of levels whose arrivals barely
+    change. This sweep keeps the previous arrival planes (no cache
+    clear), re-runs the levels in order, and measures each level's max
+    |mean delta| against the values it just overwrote. Once the
+    frontier's delta drops below epsilon the sweep terminates: arrivals
+    past the stop level keep their previous-iteration values, and since
+    the downstream operators are adds and maxes a frontier perturbation
+    of d can move any downstream arrival by at most d, so the reported
+    WNS/TNS are within epsilon of the converged numbers.
+
+    The per-level delta read syncs the stream once per level — that is
+    the price of the early exit, repaid when most iterations stop at a
+    fraction of the depth. Must follow a completed full propagation on
+    the same timing_tensors; nodes that never propagated (-inf planes)
+    produce NaN deltas, which never compare below epsilon and therefore
+    never trigger a premature stop.
+
+    Returns:
+        (timing_tensors, wns, tns, stop_level); stop_level is the last
+        level actually swept (the deepest level when no early exit hit)
+    """
+    start_time = time.time()
+    assert '_float_arena' in timing_tensors, \
+        'warm-start needs the arena planes of a previous propagation'
+
+    def _level_nodes(level, coll):
+        if isinstance(coll, tuple) and len(coll) == 2 and coll[0] == 'chunks':
+            return torch.cat([_level_nodes(level, chunk) for chunk in coll[1]])
+        if level == 1:
+            return coll
+        if level % 2 == inPinMod:
+            return coll[0]
+        return coll[13]
+
+    rise_mean = timing_tensors['Gid_2_rise_arrival_mean']
+    fall_mean = timing_tensors['Gid_2_fall_arrival_mean']
+    sigma_tensor = torch.tensor([sigma], dtype=float_dtype).to(device)
+    paired_planes = _paired_plane_views(timing_tensors)
+
+    levels = sorted(level_2_collaterals.keys())
+    stop_level = levels[-1]
+    frontier_delta = float('inf')
+    for level in levels:
+        coll = level_2_collaterals[level]
+        nodes = _level_nodes(level, coll).to(device=device, dtype=torch.int64)
+        prev_rise = rise_mean.index_select(0, nodes)
+        prev_fall = fall_mean.index_select(0, nodes)
+
+        cuda_arrival_propagate_pocv(
+            timing_tensors['sp_mean_tensor'],
+            timing_tensors['sp_std_tensor'],
+            {level: coll},
+            inPin_parent_tensor,
+            device,
+            max_gid,
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints'],
+            float_dtype,
+            timing_tensors['valid_sps'],
+            sigma=sigma,
+            topK=topk,
+            inPinMod=inPinMod,
+            sigma_tensor=sigma_tensor,
+            paired_planes=paired_planes
+        )
+
+        frontier_delta = float(torch.maximum(
+            (rise_mean.index_select(0, nodes) - prev_rise).abs().max(),
+            (fall_mean.index_select(0, nodes) - prev_fall).abs().max()))
+        if log:
+            log_debug(f'[warm-start] level: {level}, max |delta|: {frontier_delta:.3e}',
+                      site='warm-start-level')
+        stop_level = level
+        if level > 1 and frontier_delta < epsilon:
+            break
+
+    wns, tns = calculate_slack_fused(
+        timing_tensors['Gid_2_rise_slack'],
+        timing_tensors['Gid_2_fall_slack'],
+        timing_tensors['Gid_2_slack'],
+        timing_tensors['Gid_2_rise_arrival'],
+        timing_tensors['Gid_2_fall_arrival'],
+        timing_tensors['ep_rise_required'],
+        timing_tensors['ep_fall_required'],
+        timing_tensors['dest_node_tensor'],
+        topk
+    )
+    timing_tensors['Gid_2_max_arrival_mean'] = torch.max(rise_mean, fall_mean)
+    timing_tensors['Gid_2_max_arrival_std'] = torch.max(
+        timing_tensors['Gid_2_rise_arrival_std'], timing_tensors['Gid_2_fall_arrival_std'])
+
+    depth = levels.index(stop_level) + 1
+    print(f'[warm-start] stopped at level {stop_level} '
+          f'({depth}/{len(levels)} levels, residual bound {frontier_delta:.3e}) '
+          f'in {time.time() - start_time:.2f} seconds')
+    stamp_propagation(timing_tensors)
+    return timing_tensors, wns, tns, stop_level
+
+
+def build_coverage_index(
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    inPinMod: int = 1
+) -> Dict[str, Any]:
+    """
+    One-time (node, level-slot) index backing the coverage counters
+
+    Concatenates every level's unique node list with an aligned level
+    slot, so a sweep's coverage check is a single gather plus one
+    index_add_ instead of per-level work. Built once per collateral set
+    and cached by check_level_coverage.
+
+    Returns:
+        Dict with 'nodes' / 'level_slots' (device int64, aligned),
+        'levels' (sorted level keys) and 'expected' (host int64 [L]
+        unique-node count per level)
+    """
+    def _nodes(level, coll):
+        if isinstance(coll, tuple) and len(coll) == 2 and coll[0] == 'chunks':
+            return torch.cat([_nodes(level, chunk).to(device)
+                              for chunk in coll[1]])
+        if level == 1:
+            entry = coll
+        elif level % 2 == inPinMod:
+            entry = coll[0]   # net-arc children (repeat per parent)
+        else:
+            entry = coll[13]  # unique child output pins
+        if not torch.is_tensor(entry):
+            entry = torch.tensor(entry, dtype=torch.int64)
+        return entry
+
+    levels = sorted(level_2_collaterals.keys())
+    per_level = [torch.unique(_nodes(level, level_2_collaterals[level])
+                              .to(device=device, dtype=torch.int64))
+                 for level in levels]
+    widths = [n.numel() for n in per_level]
+    return {
+        'nodes': torch.cat(per_level),
+        'level_slots': torch.repeat_interleave(
+            torch.arange(len(levels), dtype=torch.int64, device=device),
+            torch.tensor(widths, dtype=torch.int64, device=device)),
+        'levels': levels,
+        'expected': torch.tensor(widths, dtype=torch.int64),
+    }
+
+
+def check_level_coverage(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    inPinMod: int = 1,
+    log: bool = True,
+    top: int = 5
+) -> Dict[int, Tuple[int, int]]:
+    """
+    Per-level valid-arrival counts against expected level sizes
+
+    Propagation bugs surface as -inf arrivals silently flowing to
+    endpoints, and localizing them used to mean debug=True full-tensor
+    isinf scans plus a multi-run bisect. This is the cheap always-on
+    version: one gather of the max-arrival plane over the cached level
+    node index and one index_add_ into a [num_levels] counter vector —
+    work proportional to the graph's node count, no full-plane scans,
+    no per-level syncs, and a single D2H of the counters at the end.
+    Levels whose valid count falls short of the level size are reported
+    worst-first. Unconstrained nodes legitimately stay -inf, so read
+    the report as a diff against a known-good run, not an assertion.
+
+    Returns:
+        {level: (valid_count, expected_count)} for the short levels
+    """
+    # One cached index per collateral set, so multi-domain sweeps that
+    # alternate collateral dicts against one timing_tensors don't thrash
+    caches = timing_tensors.setdefault('_coverage_index', {})
+    key = (id(level_2_collaterals), tuple(sorted(level_2_collaterals.keys())))
+    cache = caches.get(key)
+    if cache is None:
+        cache = build_coverage_index(level_2_collaterals, device, inPinMod)
+        caches[key] = cache
+
+    arrival = timing_tensors['Gid_2_max_arrival_mean']
+    if arrival.ndim > 1:
+        arrival = arrival[:, 0]
+    valid = torch.isfinite(arrival.index_select(0, cache['nodes']))
+    counts = torch.zeros(len(cache['levels']), dtype=torch.int64,
+                         device=device)
+    counts.index_add_(0, cache['level_slots'], valid.to(torch.int64))
+
+    counts_host = counts.cpu()
+    expected = cache['expected']
+    short = {}
+    for i, level in enumerate(cache['levels']):
+        got, want = int(counts_host[i]), int(expected[i])
+        if got < want:
+            short[level] = (got, want)
+    if log:
+        if short:
+            worst = sorted(short.items(),
+                           key=lambda kv: kv[1][1] - kv[1][0], reverse=True)
+            detail = ', '.join(f'level {lvl}: {got}/{want}'
+                               for lvl, (got, want) in worst[:top])
+            missing = sum(want - got for got, want in short.values())
+            print(f'[coverage] {len(short)}/{len(cache["levels"])} levels '
+                  f'below expected size ({missing} nodes -inf): {detail}')
+        else:
+            print(f'[coverage] all {len(cache["levels"])} levels fully covered')
+    return short
+
+
+def propagate_dual_arrival_times(
+    timing_tensors: Dict[str, torch.Tensor],
+    launch_timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    inPin_parent_tensor: torch.Tensor,
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    sigma: float = 3.0,
+    topk: int = 256,
+    log: bool = False
+) -> Tuple[Dict[str, torch.Tensor], Dict[str, torch.Tensor], float, float]:
+    """
+    One wall-clock sweep over two startpoint configurations
+
+    Launch/capture analysis needs the same graph propagated under two sp
+    latency sets (read_clock_latency_rpt supplies the launch latencies).
+    Running them back to back doubles the wall time even though each
+    level sweep underutilizes the device at small level widths, and the
+    host-side per-endpoint adjustment it replaced serialized on a full
+    plane download. Here both configurations share the (read-only)
+    collaterals and write disjoint Gid planes, so the two eval sweeps
+    are enqueued on separate CUDA streams and overlap level by level;
+    on CPU they simply run in sequence.
+
+    Slack/WNS/TNS are computed against the capture planes
+    (timing_tensors) as usual; launch_timing_tensors comes back with its
+    arrival planes filled for the caller's launch-side math (CPPR,
+    common-path credit).
+
+    Args:
+        timing_tensors: Capture-side tensors (clear_timing_cache output)
+        launch_timing_tensors: Launch-side tensors, same layout but
+            initialized with the launch sp_mean/sp_std tensors
+
+    Returns:
+        (timing_tensors, launch_timing_tensors, wns, tns)
+    """
+    start_time = time.time()
+
+    def _sweep(tensors):
+        (
+            tensors['Gid_2_rise_arrival'],
+            tensors['Gid_2_rise_arrival_mean'],
+            tensors['Gid_2_rise_arrival_std'],
+            tensors['Gid_2_rise_startpoints'],
+            tensors['Gid_2_fall_arrival'],
+            tensors['Gid_2_fall_arrival_mean'],
+            tensors['Gid_2_fall_arrival_std'],
+            tensors['Gid_2_fall_startpoints']
+        ) = cuda_arrival_propagate_pocv(
+            tensors['sp_mean_tensor'],
+            tensors['sp_std_tensor'],
+            level_2_collaterals,
+            inPin_parent_tensor,
+            device,
+            max_gid,
+            tensors['Gid_2_rise_arrival'],
+            tensors['Gid_2_rise_arrival_mean'],
+            tensors['Gid_2_rise_arrival_std'],
+            tensors['Gid_2_rise_startpoints'],
+            tensors['Gid_2_fall_arrival'],
+            tensors['Gid_2_fall_arrival_mean'],
+            tensors['Gid_2_fall_arrival_std'],
+            tensors['Gid_2_fall_startpoints'],
+            float_dtype,
+            tensors['valid_sps'],
+            sigma=sigma,
+            log=log,
+            topK=topk,
+            paired_planes=_paired_plane_views(tensors)
+        )
+
+    if str(device).startswith('cuda'):
+        streams = [torch.cuda.Stream(device=device) for _ in range(2)]
+        for stream in streams:
+            stream.wait_stream(torch.cuda.current_stream(device))
+        with torch.cuda.stream(streams[0]):
+            _sweep(timing_tensors)
+        with torch.cuda.stream(streams[1]):
+            _sweep(launch_timing_tensors)
+        for stream in streams:
+            torch.cuda.current_stream(device).wait_stream(stream)
+    else:
+        _sweep(timing_tensors)
+        _sweep(launch_timing_tensors)
+
+    print(f"[dual propagation] completed in {time.time() - start_time:.2f} seconds")
+
     wns, tns = calculate_slack(
         timing_tensors['Gid_2_rise_slack'],
         timing_tensors['Gid_2_fall_slack'],
         timing_tensors['Gid_2_slack'],
         timing_tensors['Gid_2_rise_arrival'],
         timing_tensors['Gid_2_fall_arrival'],
-        timing_tensors['ep_rise_required_truth'],
-        timing_tensors['ep_fall_required_truth'],
+        timing_tensors['ep_rise_required'],
+        timing_tensors['ep_fall_required'],
         timing_tensors['dest_node_tensor'],
         topk
     )
@@ -215,45 +1140,997 @@ def propagate_arrival_times(
     timing_tensors['Gid_2_max_arrival_mean'] = torch.max(timing_tensors['Gid_2_rise_arrival_mean'], timing_tensors['Gid_2_fall_arrival_mean'])
     timing_tensors['Gid_2_max_arrival_std'] = torch.max(timing_tensors['Gid_2_rise_arrival_std'], timing_tensors['Gid_2_fall_arrival_std'])
 
-    if debug:
-        # Debug: Check how many nodes have valid arrival times
-        valid_rise = (~torch.isinf(timing_tensors['Gid_2_rise_arrival_mean'])).sum().item()
-        valid_fall = (~torch.isinf(timing_tensors['Gid_2_fall_arrival_mean'])).sum().item()
-        valid_max = (~torch.isinf(timing_tensors['Gid_2_max_arrival_mean'])).sum().item()
-        print(f"[propagate_arrival_times] Valid arrivals - rise: {valid_rise}, fall: {valid_fall}, max: {valid_max}")
-        print(f"                          (tensor sized for max_gid={max_gid}")
+    stamp_propagation(timing_tensors)
+    return timing_tensors, launch_timing_tensors, wns, tns
 
-    return timing_tensors, wns, tns
 
+class PropagationContext:
+    """
+    Pre-allocated context for repeated eval propagations
+
+    propagate_arrival_times re-creates the sigma/temperature device scalars
+    on every call and clear_timing_cache re-walks its setup logic even when
+    only arc delays changed. This context, owned by INSTA, registers the
+    constant scalars once, keeps handles to the arena-backed planes, and
+    exposes run() with zero allocations on the hot path: a reset is two
+    arena memsets plus three slack-plane fills, and the sweep reuses the
+    cached argument tuple. Repeated calls therefore hit the CUDA caching
+    allocator fast path and remain safe to capture in a CUDA Graph.
+    """
+
+    def __init__(
+        self,
+        timing_tensors: Dict[str, torch.Tensor],
+        level_2_collaterals: Dict[int, Any],
+        inPin_parent_tensor: torch.Tensor,
+        device: torch.device,
+        max_gid: int,
+        float_dtype: torch.dtype,
+        sigma: float = 3.0,
+        topk: int = 256,
+        temperature: float = 1.0
+    ):
+        self.timing_tensors = timing_tensors
+        self.topk = timing_tensors.get('_effective_topk', topk)
+        # Constant device scalars, registered once
+        self.sigma_tensor = torch.tensor([sigma], dtype=float_dtype, device=device)
+        self.temperature_tensor = torch.tensor([temperature], dtype=float_dtype, device=device)
+        self._propagate_args = (
+            timing_tensors['sp_mean_tensor'],
+            timing_tensors['sp_std_tensor'],
+            level_2_collaterals,
+            inPin_parent_tensor,
+            device,
+            max_gid,
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints'],
+            float_dtype,
+            timing_tensors['valid_sps']
+        )
+        self._slack_args = (
+            timing_tensors['Gid_2_rise_slack'],
+            timing_tensors['Gid_2_fall_slack'],
+            timing_tensors['Gid_2_slack'],
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['ep_rise_required'],
+            timing_tensors['ep_fall_required'],
+            timing_tensors['dest_node_tensor'],
+            self.topk
+        )
+        # Strict allocation checking (INSTA_STRICT_ALLOC=1 or
+        # memory.enable_strict_alloc): watch() is a no-op unless armed,
+        # so the hot path pays nothing in the default configuration
+        self._alloc_guard = AllocationGuard(device)
+
+    def reset(self) -> None:
+        """Re-arm all result planes without allocating"""
+        self.timing_tensors['_float_arena'].fill_(float('-inf'))
+        self.timing_tensors['_int_arena'].fill_(-1)
+        self.timing_tensors['Gid_2_slack'].fill_(float('-inf'))
+        self.timing_tensors['Gid_2_rise_slack'].fill_(float('-inf'))
+        self.timing_tensors['Gid_2_fall_slack'].fill_(float('-inf'))
+
+    def set_sigma(self, sigma: float) -> None:
+        """
+        Retarget the guard-band in place for a sigma sweep (1/2/3 sigma
+        signoff modes). The registered device scalar is filled rather
+        than rebuilt, so the cached argument tuple — and a CUDA Graph
+        that captured it — reads the new value on the next run with no
+        re-capture and no extra plane-sized launches.
+        """
+        self.sigma_tensor.fill_(sigma)
+
+    def run(self) -> Tuple[torch.Tensor, torch.Tensor]:
+        """
+        One full arrival sweep plus fused slack, all into pre-allocated
+        tensors. WNS/TNS come back as device scalars (no host sync).
+
+        Under strict allocation checking each phase is bracketed
+        separately, so a churn regression fails fast and names whether
+        the reset, the sweep, or the slack reduction started allocating
+        beyond its calibrated steady state.
+        """
+        with self._alloc_guard.watch('plane reset'):
+            self.reset()
+        with self._alloc_guard.watch('arrival sweep'):
+            cuda_arrival_propagate_pocv(
+                *self._propagate_args,
+                topK=self.topk,
+                log=False,
+                sigma_tensor=self.sigma_tensor,
+                paired_planes=_paired_plane_views(self.timing_tensors)
+            )
+        with self._alloc_guard.watch('fused slack'):
+            wns, tns = calculate_slack_fused(*self._slack_args)
+        return wns, tns
+
+
+class DiffPropagationContext:
+    """
+    Persistent state for temperature-annealed differentiable training loops
+
+    An annealing run calls the diff sweep hundreds of times while only the
+    temperature (and the patched arc delays) change between iterations, yet
+    each do_diff_propagation re-runs clear_timing_cache (full-plane arena
+    refills), allocates a fresh temperature scalar and a fresh
+    ArcGradAccumulator. This context builds everything once: the
+    temperature updates in place via fill_(), the accumulator buffers are
+    zeroed instead of re-created, and the reset touches only the rows the
+    sweep actually writes — the destination set is fixed by the
+    levelization, so it is collected once up front and each re-arm is a
+    handful of index_fill_ calls instead of full-plane memsets. The diff
+    sweep's autograd graph must be rebuilt every iteration (the backward
+    hooks and the temperature-dependent softmax live in it), which is why
+    this loop is not CUDA-Graph captured like the eval path.
+    """
+
+    def __init__(
+        self,
+        timing_tensors: Dict[str, torch.Tensor],
+        level_2_collaterals: Dict[int, Any],
+        inPin_parent_tensor: torch.Tensor,
+        device: torch.device,
+        max_gid: int,
+        float_dtype: torch.dtype,
+        sigma: float = 3.0,
+        topk: int = 1,
+        checkpoint_segment_levels: int = 0,
+        grad_arc_stds: bool = False,
+        inPinMod: int = 1
+    ):
+        self.timing_tensors = timing_tensors
+        self.level_2_collaterals = level_2_collaterals
+        self.topk = timing_tensors.get('_effective_topk', topk)
+        self.checkpoint_segment_levels = checkpoint_segment_levels
+        self.grad_arc_stds = grad_arc_stds
+        self.sigma_tensor = torch.tensor([sigma], dtype=float_dtype, device=device)
+        self.temperature_tensor = torch.tensor([1.0], dtype=float_dtype, device=device)
+        # fp32 master gradients under mixed precision (see propagate_arrival_times)
+        grad_dtype = torch.float32 if float_dtype in (torch.float16, torch.bfloat16) \
+            else float_dtype
+        self.arc_grad_accumulator = ArcGradAccumulator.from_collaterals(
+            level_2_collaterals, device, grad_dtype)
+        timing_tensors['_arc_grad_accumulator'] = self.arc_grad_accumulator
+        self._written_rows = self._collect_written_rows(
+            level_2_collaterals, device, max_gid, inPinMod)
+        self._dest_rows = timing_tensors['dest_node_tensor'].to(torch.long)
+        self._float_planes = [
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+        ]
+        self._int_planes = [
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_startpoints'],
+        ]
+        self._slack_planes = [
+            timing_tensors['Gid_2_rise_slack'],
+            timing_tensors['Gid_2_fall_slack'],
+            timing_tensors['Gid_2_slack'],
+        ]
+        self._propagate_args = (
+            timing_tensors['sp_mean_tensor'],
+            timing_tensors['sp_std_tensor'],
+            level_2_collaterals,
+            inPin_parent_tensor,
+            device,
+            max_gid,
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints'],
+            float_dtype,
+            timing_tensors['valid_sps']
+        )
+
+    @staticmethod
+    def _collect_written_rows(level_2_collaterals, device, max_gid, inPinMod):
+        """Gids the sweep writes: level-1 nodes, net-arc sinks, cell-arc
+        unique outputs. Fixed for the life of the collaterals."""
+        mask = torch.zeros(max_gid, dtype=torch.bool, device=device)
+        for level, entry in level_2_collaterals.items():
+            if level == 1:
+                mask[entry.to(torch.long)] = True
+            elif level % 2 == inPinMod:
+                if isinstance(entry, tuple) and entry[0] == 'chunks':
+                    chunks = entry[1]
+                else:
+                    chunks = [entry]
+                for chunk in chunks:
+                    mask[chunk[0].to(torch.long)] = True
+            else:
+                mask[entry[13].to(torch.long)] = True
+        return mask.nonzero(as_tuple=True)[0]
+
+    def reset(self) -> None:
+        """
+        Re-arm only the rows written last iteration. detach_() drops the
+        planes out of the previous iteration's (already consumed) graph so
+        the fills are not recorded by autograd.
+        """
+        for plane in self._float_planes:
+            plane.detach_()
+            plane.index_fill_(0, self._written_rows, float('-inf'))
+        for plane in self._int_planes:
+            plane.index_fill_(0, self._written_rows, -1)
+        for plane in self._slack_planes:
+            plane.detach_()
+            plane.index_fill_(0, self._dest_rows, float('-inf'))
+        self.arc_grad_accumulator.zero_()
+
+    def set_sigma(self, sigma: float) -> None:
+        """In-place sigma update, same contract as set_temperature via
+        step(): the next sweep reads it from the registered scalar"""
+        self.sigma_tensor.fill_(sigma)
+
+    def step(self, temperature: float) -> Tuple[torch.Tensor, torch.Tensor]:
+        """
+        One differentiable sweep at the given temperature. WNS/TNS come
+        back as device scalars with the graph attached; the caller runs
+        e.g. (-tns).backward() and reads the accumulator buffers.
+        """
+        self.temperature_tensor.fill_(temperature)
+        self.reset()
+        if self.checkpoint_segment_levels > 0:
+            cuda_arrival_propagate_pocv_checkpointed(
+                *self._propagate_args,
+                temperature_tensor=self.temperature_tensor,
+                topK=self.topk,
+                segment_levels=self.checkpoint_segment_levels,
+                arc_grad_accumulator=self.arc_grad_accumulator,
+                grad_arc_stds=self.grad_arc_stds
+            )
+        else:
+            cuda_arrival_propagate_pocv(
+                *self._propagate_args,
+                topK=self.topk,
+                log=False,
+                is_diff_prop=True,
+                temperature_tensor=self.temperature_tensor,
+                sigma_tensor=self.sigma_tensor,
+                arc_grad_accumulator=self.arc_grad_accumulator,
+                grad_arc_stds=self.grad_arc_stds
+            )
+        wns, tns = calculate_slack_fused(
+            self.timing_tensors['Gid_2_rise_slack'],
+            self.timing_tensors['Gid_2_fall_slack'],
+            self.timing_tensors['Gid_2_slack'],
+            self.timing_tensors['Gid_2_rise_arrival'],
+            self.timing_tensors['Gid_2_fall_arrival'],
+            self.timing_tensors['ep_rise_required'],
+            self.timing_tensors['ep_fall_required'],
+            self.timing_tensors['dest_node_tensor'],
+            self.topk
+        )
+        return wns, tns
+
+
+def build_dirty_subset_collaterals(
+    level_2_collaterals: Dict[int, Any],
+    dirty_mask: torch.Tensor,
+    inPinMod: int = 1
+) -> Dict[int, Any]:
+    """
+    Cut each level's collateral tables down to the rows feeding dirty nodes
+
+    dirty_mask is a bool [max_gid] plane marking nodes whose arrivals must
+    be recomputed (the fanout cone of a set of delay updates). Levels with
+    no dirty node are dropped entirely; within a touched level only the
+    arc rows targeting dirty nodes are kept, with the grouped cell-arc
+    structures (node_start_end boundaries, unique-parent table, p_mapping
+    scatter table) rebuilt for the subset. The result is a drop-in
+    level_2_collaterals dict that turns a sweep into O(changed cone) work.
+    """
+    subset = {}
+    for level, coll in level_2_collaterals.items():
+        if level == 1:
+            continue
+        if level % 2 == inPinMod:  # input pins: one row per net arc sink
+            keep = dirty_mask[coll[0]]
+            if not keep.any():
+                continue
+            if keep.all():
+                subset[level] = coll
+                continue
+            net_arc_ids = coll[8]
+            if isinstance(net_arc_ids, list):
+                net_arc_ids = torch.tensor(net_arc_ids, dtype=torch.int64, device=coll[0].device)
+            subset[level] = [coll[i][keep] for i in range(8)] + [net_arc_ids[keep]]
+        else:  # output pins: rows grouped per unique output node
+            c_unique_idx_tensor = coll[13]
+            keep_unique = dirty_mask[c_unique_idx_tensor]
+            if not keep_unique.any():
+                continue
+            if keep_unique.all():
+                subset[level] = coll
+                continue
+            device = c_unique_idx_tensor.device
+            boundaries = coll[9].to(torch.long)
+            counts = boundaries[1:] - boundaries[:-1]
+            row_mask = torch.repeat_interleave(keep_unique, counts)
+
+            new_boundaries = torch.zeros(int(keep_unique.sum().item()) + 1, dtype=torch.int32, device=device)
+            new_boundaries[1:] = counts[keep_unique].cumsum(0).to(torch.int32)
+
+            dup_nodes = coll[0]
+            if isinstance(dup_nodes, list):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.int64, device=device)
+            cellArc_ids = coll[14]
+            if isinstance(cellArc_ids, list):
+                cellArc_ids = torch.tensor(cellArc_ids, dtype=torch.int64, device=device)
+
+            new_p_indices = coll[8][row_mask]
+            p_idx_unique = torch.unique(new_p_indices)
+            p_mapping = torch.full((int(p_idx_unique.max().item()) + 1,), -1,
+                                   dtype=torch.int32, device=device)
+            p_mapping[p_idx_unique.to(torch.long)] = torch.arange(
+                len(p_idx_unique), dtype=torch.int32, device=device)
+            new_c_unique = c_unique_idx_tensor[keep_unique]
+
+            subset[level] = [
+                dup_nodes[row_mask],
+                coll[1][row_mask], coll[2][row_mask], coll[3][row_mask],
+                coll[4][row_mask], coll[5][row_mask], coll[6][row_mask],
+                coll[7][row_mask], new_p_indices, new_boundaries,
+                new_c_unique,
+                p_idx_unique.to(torch.int32), p_mapping, new_c_unique,
+                cellArc_ids[row_mask]
+            ]
+    return subset
+
+
+def propagate_incremental_event_driven(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    inPin_parent_tensor: torch.Tensor,
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    seed_mask: torch.Tensor,
+    convergence_eps: float,
+    topk: int = 256,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Incremental sweep with an epsilon convergence cutoff
+
+    Even inside a dirty cone most recomputed arrivals are numerically
+    unchanged. This walks the touched levels one at a time: a level's
+    targets are the nodes fed by a still-active parent (plus the seeded
+    sinks of the changed arcs), and after the level computes, targets whose
+    rise/fall means moved by at most convergence_eps drop out of the
+    frontier, so their fanout is never relaunched. Small delay updates
+    typically converge within a couple of levels instead of sweeping the
+    whole cone.
+
+    Args:
+        seed_mask: Bool [max_gid] marking the changed arcs' sink nodes
+        convergence_eps: Arrival-mean change below which a node is
+            considered converged
+
+    Returns:
+        (wns, tns) after recomputing endpoint slack
+    """
+    active_mask = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    target_mask = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    rise_mean_plane = timing_tensors['Gid_2_rise_arrival_mean']
+    fall_mean_plane = timing_tensors['Gid_2_fall_arrival_mean']
+    total_targets, total_converged = 0, 0
+
+    for level in sorted(level_2_collaterals.keys()):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+
+        # Targets: nodes with an active parent, plus the seeded sinks
+        target_mask.fill_(False)
+        if level % 2 == inPinMod:
+            parents = coll[1].to(torch.long)
+            c_nodes = coll[0].to(torch.long)
+            target_mask[c_nodes[active_mask[parents]]] = True
+        else:
+            boundaries = coll[9].to(torch.long)
+            counts = boundaries[1:] - boundaries[:-1]
+            row_active = active_mask[coll[8].to(torch.long)].to(torch.uint8)
+            unique_active = torch.zeros(len(counts), dtype=torch.uint8, device=device)
+            uids = torch.repeat_interleave(
+                torch.arange(len(counts), dtype=torch.long, device=device), counts)
+            unique_active.index_reduce_(0, uids, row_active, 'amax')
+            target_mask[coll[13][unique_active.bool()]] = True
+        target_mask |= seed_mask
+
+        subset = build_dirty_subset_collaterals({level: coll}, target_mask, inPinMod=inPinMod)
+        if level not in subset:
+            continue
+        sub = subset[level]
+        targets = (sub[0] if level % 2 == inPinMod else sub[13]).to(torch.long)
+
+        old_rise = rise_mean_plane[targets]
+        old_fall = fall_mean_plane[targets]
+
+        cuda_arrival_propagate_pocv(
+            timing_tensors['sp_mean_tensor'],
+            timing_tensors['sp_std_tensor'],
+            {level: sub},
+            inPin_parent_tensor,
+            device,
+            max_gid,
+            timing_tensors['Gid_2_rise_arrival'],
+            timing_tensors['Gid_2_rise_arrival_mean'],
+            timing_tensors['Gid_2_rise_arrival_std'],
+            timing_tensors['Gid_2_rise_startpoints'],
+            timing_tensors['Gid_2_fall_arrival'],
+            timing_tensors['Gid_2_fall_arrival_mean'],
+            timing_tensors['Gid_2_fall_arrival_std'],
+            timing_tensors['Gid_2_fall_startpoints'],
+            float_dtype,
+            timing_tensors['valid_sps'],
+            sigma=sigma,
+            log=False,
+            topK=topk,
+            inPinMod=inPinMod
+        )
+
+        # Convergence check: nodes whose means barely moved leave the frontier
+        rise_delta = (rise_mean_plane[targets] - old_rise).abs()
+        fall_delta = (fall_mean_plane[targets] - old_fall).abs()
+        if rise_delta.ndim > 1:
+            rise_delta = rise_delta.amax(dim=1)
+            fall_delta = fall_delta.amax(dim=1)
+        changed = (rise_delta > convergence_eps) | (fall_delta > convergence_eps)
+        active_mask[targets] = changed
+        total_targets += len(targets)
+        total_converged += int((~changed).sum().item())
+
+    print(f'[incremental prop] event-driven: {total_targets} nodes recomputed, '
+          f'{total_converged} converged early (eps={convergence_eps})')
+
+    wns, tns = calculate_slack(
+        timing_tensors['Gid_2_rise_slack'],
+        timing_tensors['Gid_2_fall_slack'],
+        timing_tensors['Gid_2_slack'],
+        timing_tensors['Gid_2_rise_arrival'],
+        timing_tensors['Gid_2_fall_arrival'],
+        timing_tensors['ep_rise_required'],
+        timing_tensors['ep_fall_required'],
+        timing_tensors['dest_node_tensor'],
+        topk
+    )
+    stamp_propagation(timing_tensors)
+    return wns, tns
+
+
+def propagate_required_times(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Backward sweep propagating required times from endpoints to every pin
+
+    Walks the forward level schedule in reverse (the collateral tables
+    already carry the per-arc delay/sense data the backward levelization
+    lacks), seeding endpoint required times from the truth tensors and
+    relaxing each driver with min(child_required - arc_delay). Arc delays
+    use the same mean + sigma*std convention as the forward arrival sweep,
+    and negative-unate senses swap the rise/fall planes exactly as the
+    forward kernel does.
+
+    After the sweep every propagated pin has a true per-pin slack in
+    Gid_2_rise/fall_slack and Gid_2_slack (not just the endpoints), which is
+    what gate sizing needs.
+
+    Returns:
+        timing_tensors updated with 'Gid_2_rise_required' /
+        'Gid_2_fall_required' and per-pin slack planes
+    """
+    start_time = time.time()
+
+    rise_required = torch.full((max_gid,), float('inf'), dtype=float_dtype, device=device)
+    fall_required = torch.full((max_gid,), float('inf'), dtype=float_dtype, device=device)
+
+    # Seed endpoints from the signoff required times (endpoint-indexed,
+    # aligned with dest_node_tensor)
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    rise_required[dest] = timing_tensors['ep_rise_required'].to(float_dtype)
+    fall_required[dest] = timing_tensors['ep_fall_required'].to(float_dtype)
+
+    for level in sorted(level_2_collaterals.keys(), reverse=True):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:  # input pins: relax the single net driver
+            c_nodes = coll[0].to(torch.long)
+            parents = coll[1].to(torch.long)
+            rise_delay = coll[2] + sigma * coll[3]
+            fall_delay = coll[5] + sigma * coll[6]
+            cand_rise = rise_required[c_nodes] - rise_delay
+            cand_fall = fall_required[c_nodes] - fall_delay
+            rise_required.index_reduce_(0, parents, cand_rise, 'amin')
+            fall_required.index_reduce_(0, parents, cand_fall, 'amin')
+        else:  # output pins: relax each input pin across its cell arcs
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            parents = coll[8].to(torch.long)
+            senses = coll[7]
+            out_rise_req = rise_required[dup_nodes] - (coll[1] + sigma * coll[2])
+            out_fall_req = fall_required[dup_nodes] - (coll[4] + sigma * coll[5])
+            # positive senses: in-rise drives out-rise; negative: swapped
+            cand_rise = torch.where(senses == 0, out_rise_req, out_fall_req)
+            cand_fall = torch.where(senses == 0, out_fall_req, out_rise_req)
+            rise_required.index_reduce_(0, parents, cand_rise, 'amin')
+            fall_required.index_reduce_(0, parents, cand_fall, 'amin')
+
+    # Per-pin slack = required - arrival (worst slot if topK > 1)
+    rise_arrival = timing_tensors['Gid_2_rise_arrival']
+    fall_arrival = timing_tensors['Gid_2_fall_arrival']
+    if rise_arrival.ndim > 1:
+        rise_arrival = rise_arrival[:, 0]
+        fall_arrival = fall_arrival[:, 0]
+
+    rise_slack = rise_required - rise_arrival
+    fall_slack = fall_required - fall_arrival
+    invalid_rise = torch.isinf(rise_required) | torch.isinf(rise_arrival)
+    invalid_fall = torch.isinf(fall_required) | torch.isinf(fall_arrival)
+    rise_slack = torch.where(invalid_rise, torch.full_like(rise_slack, float('-inf')), rise_slack)
+    fall_slack = torch.where(invalid_fall, torch.full_like(fall_slack, float('-inf')), fall_slack)
+
+    timing_tensors['Gid_2_rise_required'] = rise_required
+    timing_tensors['Gid_2_fall_required'] = fall_required
+    timing_tensors['Gid_2_rise_slack'] = rise_slack
+    timing_tensors['Gid_2_fall_slack'] = fall_slack
+    timing_tensors['Gid_2_slack'] = torch.minimum(rise_slack, fall_slack)
+
+    print(f'[required propagation] completed in {time.time() - start_time:.2f} seconds')
+    return timing_tensors
+
+
+def propagate_hold_arrival_times(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    ep_hold_rise_required: Optional[torch.Tensor] = None,
+    ep_hold_fall_required: Optional[torch.Tensor] = None,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Tuple[float, float]:
+    """
+    Forward min-delay (early-mode) sweep for hold analysis
+
+    Shares the late-mode level schedule and collateral tables; only the
+    reduction flips. Each pin's early arrival is the minimum over its
+    fanin of parent_early + mean - sigma*std (early mode subtracts the
+    POCV guard-band instead of adding it), accumulated with
+    index_reduce_('amin') — the K=1 analogue of the top-K merge, which
+    the pre-built arrival kernel only exposes as a max. Negative-unate
+    senses swap the rise/fall planes exactly as the late sweep does.
+
+    Hold slack at an endpoint is early_arrival - hold_required. Callers
+    pass per-endpoint hold required-time truths (capture clock edge plus
+    hold margin); with none given the requirement defaults to zero so the
+    early arrivals themselves act as the slack proxy.
+
+    Returns:
+        (hold_wns, hold_tns); timing_tensors gains
+        'Gid_2_rise_arrival_early' / 'Gid_2_fall_arrival_early' and
+        'Gid_2_hold_slack'
+    """
+    start_time = time.time()
+
+    rise_early = torch.full((max_gid,), float('inf'), dtype=float_dtype, device=device)
+    fall_early = torch.full((max_gid,), float('inf'), dtype=float_dtype, device=device)
+
+    # Seed startpoints with their early launch times
+    sps = level_2_collaterals[1].to(torch.long)
+    sp_early = (timing_tensors['sp_mean_tensor'][sps]
+                - sigma * timing_tensors['sp_std_tensor'][sps]).to(float_dtype)
+    rise_early[sps] = sp_early
+    fall_early[sps] = sp_early
+
+    for level in sorted(level_2_collaterals.keys()):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:  # net arcs: relax each input pin from its driver
+            c_nodes = coll[0].to(torch.long)
+            parents = coll[1].to(torch.long)
+            cand_rise = rise_early[parents] + (coll[2] - sigma * coll[3])
+            cand_fall = fall_early[parents] + (coll[5] - sigma * coll[6])
+            rise_early.index_reduce_(0, c_nodes, cand_rise, 'amin')
+            fall_early.index_reduce_(0, c_nodes, cand_fall, 'amin')
+        else:  # cell arcs: relax each output pin across its input arcs
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            parents = coll[8].to(torch.long)
+            senses = coll[7]
+            in_rise = rise_early[parents]
+            in_fall = fall_early[parents]
+            # positive senses: in-rise drives out-rise; negative: swapped
+            src_rise = torch.where(senses == 0, in_rise, in_fall)
+            src_fall = torch.where(senses == 0, in_fall, in_rise)
+            cand_rise = src_rise + (coll[1] - sigma * coll[2])
+            cand_fall = src_fall + (coll[4] - sigma * coll[5])
+            rise_early.index_reduce_(0, dup_nodes, cand_rise, 'amin')
+            fall_early.index_reduce_(0, dup_nodes, cand_fall, 'amin')
+
+    # Endpoint hold slack = early arrival - hold requirement
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    if ep_hold_rise_required is None:
+        ep_hold_rise_required = torch.zeros(max_gid, dtype=float_dtype, device=device)
+    if ep_hold_fall_required is None:
+        ep_hold_fall_required = torch.zeros(max_gid, dtype=float_dtype, device=device)
+    rise_hold_slack = rise_early[dest] - ep_hold_rise_required.to(device)[dest]
+    fall_hold_slack = fall_early[dest] - ep_hold_fall_required.to(device)[dest]
+    ep_hold_slack = torch.minimum(rise_hold_slack, fall_hold_slack)
+
+    hold_slack_plane = torch.full((max_gid,), float('inf'), dtype=float_dtype, device=device)
+    hold_slack_plane.index_copy_(0, dest, ep_hold_slack)
+
+    negative = (ep_hold_slack < 0) & torch.isfinite(ep_hold_slack)
+    masked = torch.where(negative, ep_hold_slack, torch.zeros_like(ep_hold_slack))
+    hold_tns = masked.to(torch.float32).sum().item()
+    hold_wns = masked.min().item() if dest.numel() > 0 else 0.0
+
+    timing_tensors['Gid_2_rise_arrival_early'] = rise_early
+    timing_tensors['Gid_2_fall_arrival_early'] = fall_early
+    timing_tensors['Gid_2_hold_slack'] = hold_slack_plane
+
+    print(f'[hold propagation] completed in {time.time() - start_time:.2f} seconds, '
+          f'hold WNS: {hold_wns:.4f}, hold TNS: {hold_tns:.4f}')
+    return hold_wns, hold_tns
+
+
+def propagate_depths(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Forward sweep tracking the stage count of each pin's argmax path
+
+    ep_rise/fall_depth_truth come from the reference tool, so AOCV
+    depth derates were frozen at the last signoff snapshot. This sweep
+    produces depths on device instead: it re-runs the K=1 worst-arrival
+    recursion over the level schedule and, per cell level, lets the rows
+    that win the arrival reduction also deposit their parent depth + 1
+    (net arcs carry depth through unchanged — stages count cells). The
+    pre-built kernels cannot grow a depth output, so this is its own
+    pass like the hold/required sweeps; one add per level, as the
+    arithmetic suggests.
+
+    Returns:
+        timing_tensors updated with 'Gid_2_rise_depth' /
+        'Gid_2_fall_depth' int16 planes (-1 where unreached)
+    """
+    start_time = time.time()
+
+    rise_arr = torch.full((max_gid,), float('-inf'), dtype=float_dtype, device=device)
+    fall_arr = torch.full((max_gid,), float('-inf'), dtype=float_dtype, device=device)
+    rise_depth = torch.full((max_gid,), -1, dtype=torch.int32, device=device)
+    fall_depth = torch.full((max_gid,), -1, dtype=torch.int32, device=device)
+
+    # Seed startpoints: stage count starts at zero
+    sps = level_2_collaterals[1].to(torch.long)
+    sp_arr = (timing_tensors['sp_mean_tensor'][sps]
+              + sigma * timing_tensors['sp_std_tensor'][sps]).to(float_dtype)
+    rise_arr[sps] = sp_arr
+    fall_arr[sps] = sp_arr
+    rise_depth[sps] = 0
+    fall_depth[sps] = 0
+
+    for level in sorted(level_2_collaterals.keys()):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:  # net arcs: 1:1, depth passes through
+            c_nodes = coll[0].to(torch.long)
+            parents = coll[1].to(torch.long)
+            rise_arr[c_nodes] = rise_arr[parents] + (coll[2] + sigma * coll[3])
+            fall_arr[c_nodes] = fall_arr[parents] + (coll[5] + sigma * coll[6])
+            rise_depth[c_nodes] = rise_depth[parents]
+            fall_depth[c_nodes] = fall_depth[parents]
+        else:  # cell arcs: winners of the arrival max deposit depth + 1
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            parents = coll[8].to(torch.long)
+            senses = coll[7]
+            src_rise = torch.where(senses == 0, rise_arr[parents], fall_arr[parents])
+            src_fall = torch.where(senses == 0, fall_arr[parents], rise_arr[parents])
+            src_rise_depth = torch.where(senses == 0, rise_depth[parents],
+                                         fall_depth[parents])
+            src_fall_depth = torch.where(senses == 0, fall_depth[parents],
+                                         rise_depth[parents])
+            cand_rise = src_rise + (coll[1] + sigma * coll[2])
+            cand_fall = src_fall + (coll[4] + sigma * coll[5])
+            rise_arr.index_reduce_(0, dup_nodes, cand_rise, 'amax')
+            fall_arr.index_reduce_(0, dup_nodes, cand_fall, 'amax')
+            # Second pass: only rows matching the winning arrival may
+            # write depth (ties resolve to the deeper path, the
+            # pessimistic choice for depth-indexed derates)
+            rise_win = cand_rise == rise_arr[dup_nodes]
+            fall_win = cand_fall == fall_arr[dup_nodes]
+            rise_depth.index_reduce_(
+                0, dup_nodes,
+                torch.where(rise_win, src_rise_depth + 1,
+                            torch.full_like(src_rise_depth, -1)), 'amax')
+            fall_depth.index_reduce_(
+                0, dup_nodes,
+                torch.where(fall_win, src_fall_depth + 1,
+                            torch.full_like(src_fall_depth, -1)), 'amax')
+
+    timing_tensors['Gid_2_rise_depth'] = rise_depth.to(torch.int16)
+    timing_tensors['Gid_2_fall_depth'] = fall_depth.to(torch.int16)
+
+    print(f'[depth propagation] completed in {time.time() - start_time:.2f} seconds')
+    return timing_tensors
+
+
+def aocv_derates_from_depths(
+    depth_plane: torch.Tensor,
+    derate_table: torch.Tensor
+) -> torch.Tensor:
+    """
+    Depth-indexed AOCV derate lookup, on device
+
+    derate_table is a 1D tensor of derate factors indexed by stage
+    count (entry 0 = depth 0); depths beyond the table clamp to its
+    last entry, the standard AOCV convention for deep paths. Unreached
+    pins (depth -1) get a derate of 1.0.
+    """
+    table = derate_table.to(depth_plane.device).to(torch.float32)
+    depth = depth_plane.to(torch.long)
+    derates = table[depth.clamp(0, table.numel() - 1)]
+    return torch.where(depth < 0, torch.ones_like(derates), derates)
+
+
+def propagate_slews(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    float_dtype: torch.dtype,
+    delay_model: Optional[Any] = None,
+    delay_index: Optional[Dict[int, Any]] = None,
+    gid_2_load: Optional[torch.Tensor] = None,
+    sp_slew: float = 0.05,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Forward slew sweep over the arrival schedule (first-class slew planes)
+
+    The collaterals carry fixed per-arc delays with no slew dependence,
+    which is where correlation degrades on high-fanout nets after ECO
+    buffering. This sweep walks the same levelized schedule the arrival
+    kernels use (the pre-built kernels cannot be extended with a slew
+    output, so it runs as its own K=1 pass): input pins inherit their
+    driver's slew, and each output pin takes the worst transformed slew
+    over its input arcs. With an NLDM-lite model carrying output-slew
+    tables (and the per-net loads), covered cells transform slew through
+    a (slew, load) lookup; everything else degrades to worst-input
+    pass-through. The resulting planes feed recompute_cell_arc_delays so
+    the load -> slew -> delay loop closes without the reference-tool
+    round trip.
+
+    Returns:
+        timing_tensors updated with 'Gid_2_rise_slew' / 'Gid_2_fall_slew'
+        and matching '_std' planes (std is zero without table stds)
+    """
+    start_time = time.time()
+
+    rise_slew = torch.zeros(max_gid, dtype=float_dtype, device=device)
+    fall_slew = torch.zeros(max_gid, dtype=float_dtype, device=device)
+    rise_slew_std = torch.zeros(max_gid, dtype=float_dtype, device=device)
+    fall_slew_std = torch.zeros(max_gid, dtype=float_dtype, device=device)
 
+    # Seed startpoints with the boundary slew
+    sps = level_2_collaterals[1].to(torch.long)
+    rise_slew[sps] = sp_slew
+    fall_slew[sps] = sp_slew
+
+    use_tables = (delay_model is not None and delay_model.has_slew_tables
+                  and delay_index is not None and gid_2_load is not None)
+
+    for level in sorted(level_2_collaterals.keys()):
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:  # net arcs: input pins inherit driver slew
+            c_nodes = coll[0].to(torch.long)
+            parents = coll[1].to(torch.long)
+            rise_slew[c_nodes] = rise_slew[parents]
+            fall_slew[c_nodes] = fall_slew[parents]
+            rise_slew_std[c_nodes] = rise_slew_std[parents]
+            fall_slew_std[c_nodes] = fall_slew_std[parents]
+        else:  # cell arcs: worst transformed slew over the input arcs
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            parents = coll[8].to(torch.long)
+            senses = coll[7]
+            in_rise = rise_slew[parents]
+            in_fall = fall_slew[parents]
+            # positive senses: in-rise drives out-rise; negative: swapped
+            src_rise = torch.where(senses == 0, in_rise, in_fall)
+            src_fall = torch.where(senses == 0, in_fall, in_rise)
+            cand_rise = src_rise
+            cand_fall = src_fall
+            cand_rise_std = torch.where(senses == 0, rise_slew_std[parents],
+                                        fall_slew_std[parents])
+            cand_fall_std = torch.where(senses == 0, fall_slew_std[parents],
+                                        rise_slew_std[parents])
+
+            if use_tables and level in delay_index:
+                rows, libcell_ids, driver_gids = delay_index[level]
+                out_rise, out_rise_std, out_fall, out_fall_std = \
+                    delay_model.lookup_slew(
+                        libcell_ids,
+                        torch.maximum(src_rise[rows], src_fall[rows]).to(torch.float32),
+                        gid_2_load[driver_gids])
+                cand_rise = cand_rise.clone()
+                cand_fall = cand_fall.clone()
+                cand_rise_std = cand_rise_std.clone()
+                cand_fall_std = cand_fall_std.clone()
+                cand_rise.index_copy_(0, rows, out_rise.to(float_dtype))
+                cand_fall.index_copy_(0, rows, out_fall.to(float_dtype))
+                cand_rise_std.index_copy_(0, rows, out_rise_std.to(float_dtype))
+                cand_fall_std.index_copy_(0, rows, out_fall_std.to(float_dtype))
+
+            rise_slew.index_reduce_(0, dup_nodes, cand_rise, 'amax')
+            fall_slew.index_reduce_(0, dup_nodes, cand_fall, 'amax')
+            rise_slew_std.index_reduce_(0, dup_nodes, cand_rise_std, 'amax')
+            fall_slew_std.index_reduce_(0, dup_nodes, cand_fall_std, 'amax')
+
+    timing_tensors['Gid_2_rise_slew'] = rise_slew
+    timing_tensors['Gid_2_fall_slew'] = fall_slew
+    timing_tensors['Gid_2_rise_slew_std'] = rise_slew_std
+    timing_tensors['Gid_2_fall_slew_std'] = fall_slew_std
+
+    print(f'[slew propagation] completed in {time.time() - start_time:.2f} seconds')
+    return timing_tensors
+
+
+def _compress_startpoint_planes(
+    bundle: Dict[str, torch.Tensor],
+    valid_sps: torch.Tensor
+) -> None:
+    """
+    Remap startpoint planes from gids to dense startpoint indices
+
+    Startpoint ids span max_gid but only the ~100k valid startpoints
+    ever appear, so the planes compress to int16 (int32 past 32k
+    startpoints) against a sorted gid table stored alongside —
+    half/quarter of the dominant int payload in the saved bundle.
+    Consumers map back via startpoint_gid_table[index] (-1 stays -1).
+    """
+    sp_gids = valid_sps.nonzero().squeeze(1).to(torch.int64)
+    compact_dtype = torch.int16 if sp_gids.numel() < (1 << 15) - 1 else torch.int32
+    for name in ('Gid_2_rise_startpoints', 'Gid_2_fall_startpoints'):
+        plane = bundle[name].to(torch.int64)
+        dense = torch.searchsorted(sp_gids, plane.clamp(min=0))
+        dense = torch.where(plane < 0, torch.full_like(dense, -1), dense)
+        bundle[name] = dense.to(compact_dtype)
+    bundle['startpoint_gid_table'] = sp_gids.to(torch.int32)
+
+
+@py_scope('save_arrival_tensors')
 def save_arrival_tensors(
     timing_tensors: Dict[str, torch.Tensor],
-    save_dir: str
+    save_dir: str,
+    output_level: str = 'full',
+    compress_startpoints: bool = False
 ) -> None:
     """
     Save arrival time tensors to disk
 
+    All results go into one preallocated memory-mapped bundle file
+    (serialization.ARRIVAL_BUNDLE_NAME) instead of eleven torch.save
+    calls: the mapping is created once and subsequent calls from an
+    optimization loop are plain per-tensor copies, so serialization no
+    longer stalls the pipeline. Consumers mmap the file zero-copy via
+    load_tensor_bundle (or load_torch_tensor with the old per-tensor
+    names).
+
+    output_level trims what is written: 'full' persists the eleven
+    whole-graph planes, 'endpoints' gathers only the dest_node_tensor
+    rows into compact [E, ...] tensors first (~99% less I/O for flows
+    that only consume endpoint slacks — a bundle for 15M pins shrinks
+    from tens of GB to hundreds of MB), and 'summary' writes just the
+    device-reduced slack statistics (WNS, violation count, histogram,
+    percentiles) as JSON.
+
+    compress_startpoints remaps the two startpoint planes to dense
+    indices over the valid-startpoint table before writing (see
+    _compress_startpoint_planes); the meta records the remapping.
+
     Args:
         timing_tensors: Dictionary of timing tensors
         save_dir: Directory to save tensors
+        output_level: 'full', 'endpoints' or 'summary'
+        compress_startpoints: Persist startpoints as dense table indices
     """
-    # Create directory if it doesn't exist
-    os.makedirs(save_dir, exist_ok=True)
-
-    # Save key tensor results
-    torch.save(timing_tensors['Gid_2_rise_startpoints'], os.path.join(save_dir, 'Gid_2_rise_startpoints.pt'))
-    torch.save(timing_tensors['Gid_2_fall_startpoints'], os.path.join(save_dir, 'Gid_2_fall_startpoints.pt'))
-    torch.save(timing_tensors['Gid_2_rise_arrival_mean'], os.path.join(save_dir, 'Gid_2_rise_arrival_mean.pt'))
-    torch.save(timing_tensors['Gid_2_fall_arrival_mean'], os.path.join(save_dir, 'Gid_2_fall_arrival_mean.pt'))
-    torch.save(timing_tensors['Gid_2_rise_arrival_std'], os.path.join(save_dir, 'Gid_2_rise_arrival_std.pt'))
-    torch.save(timing_tensors['Gid_2_fall_arrival_std'], os.path.join(save_dir, 'Gid_2_fall_arrival_std.pt'))
-    torch.save(timing_tensors['Gid_2_rise_arrival'], os.path.join(save_dir, 'Gid_2_rise_arrival.pt'))
-    torch.save(timing_tensors['Gid_2_fall_arrival'], os.path.join(save_dir, 'Gid_2_fall_arrival.pt'))
-    torch.save(timing_tensors['Gid_2_slack'], os.path.join(save_dir, 'Gid_2_slack.pt'))
-    torch.save(timing_tensors['Gid_2_rise_slack'], os.path.join(save_dir, 'Gid_2_rise_slack.pt'))
-    torch.save(timing_tensors['Gid_2_fall_slack'], os.path.join(save_dir, 'Gid_2_fall_slack.pt'))
-
-
+    assert output_level in ('full', 'endpoints', 'summary'), \
+        f'unknown output level: {output_level}'
+
+    if output_level == 'summary':
+        import json
+        from .pocv import slack_distribution_stats
+        stats = slack_distribution_stats(timing_tensors['Gid_2_slack'],
+                                         timing_tensors['dest_node_tensor'])
+        with open(os.path.join(save_dir, 'slack_summary.json'), 'w') as f:
+            json.dump(stats, f, indent=2)
+        return
+
+    names = [
+        'Gid_2_rise_startpoints', 'Gid_2_fall_startpoints',
+        'Gid_2_rise_arrival_mean', 'Gid_2_fall_arrival_mean',
+        'Gid_2_rise_arrival_std', 'Gid_2_fall_arrival_std',
+        'Gid_2_rise_arrival', 'Gid_2_fall_arrival',
+        'Gid_2_slack', 'Gid_2_rise_slack', 'Gid_2_fall_slack'
+    ]
+    if output_level == 'endpoints':
+        dest = timing_tensors['dest_node_tensor'].to(torch.long)
+        bundle = {name: timing_tensors[name][dest] for name in names}
+        bundle['dest_node_tensor'] = timing_tensors['dest_node_tensor']
+        if compress_startpoints:
+            _compress_startpoint_planes(bundle, timing_tensors['valid_sps'])
+        reference = bundle['Gid_2_rise_arrival']
+        meta = {
+            'max_gid': int(timing_tensors['Gid_2_rise_arrival'].shape[0]),
+            'num_endpoints': int(dest.numel()),
+            'topK': reference.shape[1] if reference.ndim > 1 else 1,
+            'dtype': str(reference.dtype).replace('torch.', ''),
+            'startpoints_compressed': compress_startpoints
+        }
+        save_tensor_bundle(bundle, os.path.join(save_dir, ENDPOINT_BUNDLE_NAME),
+                           meta=meta)
+        return
+
+    bundle = {name: timing_tensors[name] for name in names}
+    if compress_startpoints:
+        _compress_startpoint_planes(bundle, timing_tensors['valid_sps'])
+    reference = timing_tensors['Gid_2_rise_arrival']
+    meta = {
+        'max_gid': reference.shape[0],
+        'topK': reference.shape[1] if reference.ndim > 1 else 1,
+        'dtype': str(reference.dtype).replace('torch.', ''),
+        'startpoints_compressed': compress_startpoints
+    }
+    save_tensor_bundle(bundle, os.path.join(save_dir, ARRIVAL_BUNDLE_NAME), meta=meta)
+
+
+@py_scope('get_critical_paths')
 def get_critical_paths(
     timing_tensors: Dict[str, torch.Tensor],
     dest_nodes: Set[int],
@@ -308,11 +2185,11 @@ def get_critical_paths(
             if is_rise:
                 sp_idx = timing_tensors['Gid_2_rise_startpoints'][dest_idx]
                 arrival = timing_tensors['Gid_2_rise_arrival'][dest_idx]
-                required = timing_tensors['ep_rise_required_truth'][dest_idx]
+                required = timing_tensors['ep_rise_required'][idx]
             else:
                 sp_idx = timing_tensors['Gid_2_fall_startpoints'][dest_idx]
                 arrival = timing_tensors['Gid_2_fall_arrival'][dest_idx]
-                required = timing_tensors['ep_fall_required_truth'][dest_idx]
+                required = timing_tensors['ep_fall_required'][idx]
 
             # Create path dictionary
             path = {
@@ -329,6 +2206,248 @@ def get_critical_paths(
     return paths
 
 
+def build_boundary_topk_table(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    boundary_topk: int = 256,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Two-tier top-K storage: wide candidate lists only where CPPR needs them
+
+    Interior combinational pins never need 256 arrival candidates — only
+    endpoint boundaries do, for the CPPR credit scan. This builds a side
+    table holding up to boundary_topk candidates per endpoint by merging the
+    narrow-K candidate lists of each endpoint's immediate fanin across all
+    of its arcs, so the main Gid_2_* planes can stay at K=4/8 and arrival
+    memory drops by >90% on flat designs.
+
+    Must run after propagation. Returns a dict with 'ep_nodes' [E] plus
+    'rise/fall_arrival' and 'rise/fall_startpoints' [E, boundary_topk]
+    tables ordered consistently (padded with -inf / -1).
+    """
+    rise_arrival = timing_tensors['Gid_2_rise_arrival']
+    fall_arrival = timing_tensors['Gid_2_fall_arrival']
+    rise_sps = timing_tensors['Gid_2_rise_startpoints']
+    fall_sps = timing_tensors['Gid_2_fall_startpoints']
+    if rise_arrival.ndim == 1:
+        rise_arrival = rise_arrival.unsqueeze(1)
+        fall_arrival = fall_arrival.unsqueeze(1)
+        rise_sps = rise_sps.unsqueeze(1)
+        fall_sps = fall_sps.unsqueeze(1)
+    narrow_k = rise_arrival.size(1)
+
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    is_dest = torch.zeros(max_gid, dtype=torch.bool, device=device)
+    is_dest[dest] = True
+    ep_row = torch.full((max_gid,), -1, dtype=torch.long, device=device)
+    ep_row[dest] = torch.arange(dest.numel(), dtype=torch.long, device=device)
+
+    # Per-edge candidate buffers: (endpoint row, arrival, startpoint)
+    cand = {edge: {'row': [], 'arrival': [], 'sp': []} for edge in ('rise', 'fall')}
+
+    def push(edge, rows, arrivals, sps):
+        cand[edge]['row'].append(rows.repeat_interleave(narrow_k))
+        cand[edge]['arrival'].append(arrivals.reshape(-1))
+        cand[edge]['sp'].append(sps.reshape(-1))
+
+    for level in level_2_collaterals:
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:
+            c_nodes = coll[0].to(torch.long)
+            sel = is_dest[c_nodes]
+            if not sel.any():
+                continue
+            parents = coll[1].to(torch.long)[sel]
+            rows = ep_row[c_nodes[sel]]
+            rise_delay = (coll[2] + sigma * coll[3])[sel]
+            fall_delay = (coll[5] + sigma * coll[6])[sel]
+            push('rise', rows, rise_arrival[parents] + rise_delay.unsqueeze(1), rise_sps[parents])
+            push('fall', rows, fall_arrival[parents] + fall_delay.unsqueeze(1), fall_sps[parents])
+        else:
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            sel = is_dest[dup_nodes]
+            if not sel.any():
+                continue
+            parents = coll[8].to(torch.long)[sel]
+            senses = coll[7][sel]
+            rows = ep_row[dup_nodes[sel]]
+            rise_delay = (coll[1] + sigma * coll[2])[sel]
+            fall_delay = (coll[4] + sigma * coll[5])[sel]
+            sense_mask = (senses == 0).unsqueeze(1)
+            push('rise', rows,
+                 torch.where(sense_mask, rise_arrival[parents], fall_arrival[parents]) + rise_delay.unsqueeze(1),
+                 torch.where(sense_mask, rise_sps[parents], fall_sps[parents]))
+            push('fall', rows,
+                 torch.where(sense_mask, fall_arrival[parents], rise_arrival[parents]) + fall_delay.unsqueeze(1),
+                 torch.where(sense_mask, fall_sps[parents], rise_sps[parents]))
+
+    tables = {'ep_nodes': dest}
+    for edge in ('rise', 'fall'):
+        if not cand[edge]['row']:
+            tables[f'{edge}_arrival'] = torch.full((dest.numel(), boundary_topk), float('-inf'),
+                                                   dtype=rise_arrival.dtype, device=device)
+            tables[f'{edge}_startpoints'] = torch.full((dest.numel(), boundary_topk), -1,
+                                                       dtype=torch.int32, device=device)
+            continue
+        rows = torch.cat(cand[edge]['row'])
+        arrivals = torch.cat(cand[edge]['arrival'])
+        sps = torch.cat(cand[edge]['sp'])
+
+        # Segmented top-K: bucket candidates per endpoint row, then one topk
+        order = torch.argsort(rows, stable=True)
+        rows, arrivals, sps = rows[order], arrivals[order], sps[order]
+        counts = torch.bincount(rows, minlength=dest.numel())
+        slots = torch.arange(rows.numel(), device=device) - \
+            torch.repeat_interleave(torch.cumsum(counts, 0) - counts, counts)
+        width = max(int(counts.max().item()), boundary_topk)
+        dense_arrival = torch.full((dest.numel(), width), float('-inf'),
+                                   dtype=arrivals.dtype, device=device)
+        dense_sp = torch.full((dest.numel(), width), -1, dtype=torch.int32, device=device)
+        dense_arrival[rows, slots] = arrivals
+        dense_sp[rows, slots] = sps.to(torch.int32)
+
+        top_vals, top_idx = torch.topk(dense_arrival, boundary_topk, dim=1)
+        tables[f'{edge}_arrival'] = top_vals
+        tables[f'{edge}_startpoints'] = dense_sp.gather(1, top_idx)
+
+    return tables
+
+
+def build_predecessor_pointers(
+    timing_tensors: Dict[str, torch.Tensor],
+    level_2_collaterals: Dict[int, Any],
+    device: torch.device,
+    max_gid: int,
+    sigma: float = 3.0,
+    inPinMod: int = 1
+) -> Dict[str, torch.Tensor]:
+    """
+    Build per-pin worst-predecessor pointer planes on device
+
+    One pass over the level schedule selects, for every pin and edge, the
+    fanin pin (and its edge, honoring unate sense swaps) that maximizes
+    parent_arrival + arc_delay. The resulting pointer planes let
+    backtrace_critical_paths_gpu reconstruct full pin-by-pin paths with one
+    gather per level instead of a per-path host walk.
+    """
+    rise_arr = timing_tensors['Gid_2_rise_arrival']
+    fall_arr = timing_tensors['Gid_2_fall_arrival']
+    if rise_arr.ndim > 1:
+        rise_arr = rise_arr[:, 0].contiguous()
+        fall_arr = fall_arr[:, 0].contiguous()
+
+    pred_pin_rise = torch.full((max_gid,), -1, dtype=torch.int64, device=device)
+    pred_pin_fall = torch.full((max_gid,), -1, dtype=torch.int64, device=device)
+    pred_edge_rise = torch.zeros(max_gid, dtype=torch.int8, device=device)
+    pred_edge_fall = torch.ones(max_gid, dtype=torch.int8, device=device)
+
+    for level in level_2_collaterals:
+        if level == 1:
+            continue
+        coll = level_2_collaterals[level]
+        if level % 2 == inPinMod:
+            # Net arcs have a single driver; rise feeds rise, fall feeds fall
+            c_nodes = coll[0].to(torch.long)
+            parents = coll[1].to(torch.long)
+            pred_pin_rise[c_nodes] = parents
+            pred_pin_fall[c_nodes] = parents
+            pred_edge_rise[c_nodes] = 0
+            pred_edge_fall[c_nodes] = 1
+        else:
+            dup_nodes = coll[0]
+            if not isinstance(dup_nodes, torch.Tensor):
+                dup_nodes = torch.tensor(dup_nodes, dtype=torch.long, device=device)
+            dup_nodes = dup_nodes.to(torch.long)
+            parents = coll[8].to(torch.long)
+            senses = coll[7]
+            rise_delay = coll[1] + sigma * coll[2]
+            fall_delay = coll[4] + sigma * coll[5]
+
+            # Output rise: from parent rise (positive sense) or fall (negative)
+            cand_rise = torch.where(senses == 0, rise_arr[parents], fall_arr[parents]) + rise_delay
+            best_rise = torch.full((max_gid,), float('-inf'), dtype=cand_rise.dtype, device=device)
+            best_rise.index_reduce_(0, dup_nodes, cand_rise, 'amax')
+            winner = cand_rise == best_rise[dup_nodes]
+            pred_pin_rise[dup_nodes[winner]] = parents[winner]
+            pred_edge_rise[dup_nodes[winner]] = senses[winner].to(torch.int8)
+
+            cand_fall = torch.where(senses == 0, fall_arr[parents], rise_arr[parents]) + fall_delay
+            best_fall = torch.full((max_gid,), float('-inf'), dtype=cand_fall.dtype, device=device)
+            best_fall.index_reduce_(0, dup_nodes, cand_fall, 'amax')
+            winner = cand_fall == best_fall[dup_nodes]
+            pred_pin_fall[dup_nodes[winner]] = parents[winner]
+            # negative sense means the fall output came from the rise input
+            pred_edge_fall[dup_nodes[winner]] = 1 - senses[winner].to(torch.int8)
+
+    return {
+        'pred_pin_rise': pred_pin_rise,
+        'pred_pin_fall': pred_pin_fall,
+        'pred_edge_rise': pred_edge_rise,
+        'pred_edge_fall': pred_edge_fall,
+    }
+
+
+def backtrace_critical_paths_gpu(
+    timing_tensors: Dict[str, torch.Tensor],
+    predecessors: Dict[str, torch.Tensor],
+    num_paths: int = 10,
+    max_depth: int = 8192
+) -> Tuple[torch.Tensor, torch.Tensor, torch.Tensor]:
+    """
+    Backtrace the argmax predecessor chains of the N worst endpoints
+
+    All N paths advance in lockstep: each step is one gather through the
+    pointer planes from build_predecessor_pointers, so reconstructing 10k
+    paths costs depth gathers rather than 10k host round trips.
+
+    Returns:
+        Tuple of (path_matrix, path_slacks, path_edges) where path_matrix is
+        an int64 [N, depth] tensor padded with -1 past each path's
+        startpoint, path_slacks the endpoint slacks, and path_edges the
+        endpoint edge (0=rise, 1=fall) per path
+    """
+    dest = timing_tensors['dest_node_tensor'].to(torch.long)
+    slacks = timing_tensors['Gid_2_slack'][dest]
+    valid = ~torch.isinf(slacks)
+    dest = dest[valid]
+    slacks = slacks[valid]
+
+    num_paths = min(num_paths, dest.numel())
+    path_slacks, order = torch.topk(slacks, num_paths, largest=False)
+    cur = dest[order]
+
+    rise_slack = timing_tensors['Gid_2_rise_slack'][cur]
+    fall_slack = timing_tensors['Gid_2_fall_slack'][cur]
+    edge = (fall_slack < rise_slack).to(torch.int8)
+    path_edges = edge.clone()
+
+    steps = [cur.clone()]
+    for _ in range(max_depth):
+        nxt = torch.where(edge == 0,
+                          predecessors['pred_pin_rise'][cur.clamp(min=0)],
+                          predecessors['pred_pin_fall'][cur.clamp(min=0)])
+        nxt_edge = torch.where(edge == 0,
+                               predecessors['pred_edge_rise'][cur.clamp(min=0)],
+                               predecessors['pred_edge_fall'][cur.clamp(min=0)])
+        nxt = torch.where(cur < 0, cur, nxt)  # keep finished paths at -1
+        if (nxt < 0).all():
+            break
+        steps.append(nxt.clone())
+        edge = nxt_edge
+        cur = nxt
+
+    return torch.stack(steps, dim=1), path_slacks, path_edges
+
+
 def write_analysis_csv(
     output_dir: str,
     true_slacks: torch.Tensor,
@@ -394,17 +2513,25 @@ def propagate_subgraph_collateral(
     sp_std_tensor: torch.Tensor,
     sigma: float = 3.0,
     inPinMod: int = 1,
-    endpoint_globals: List[int] = None
+    endpoint_globals: List[int] = None,
+    validated: bool = True,
+    debug: bool = False
 ):
     """Compute rise/fall arrivals for a cone using CUDA kernels only.
 
     Args:
         level_2_collaterals : per-cone collateral dict (from precompute_collaterals subgraph mode)
-        cone_gid_list       : global-gid list (maps local index→global)
+        cone_gid_list       : global-gid list (maps local index→global), sorted ascending
         sp_mean/std_tensors : full-chip tensors (read only)
         sigma               : sigma multiplier (default 3)
         inPinMod            : parity for input-pin levels (default 1)
         endpoint_globals    : list of global gids for endpoint calculation
+        validated           : skip host-side scanning and resolve local
+                              indices by device searchsorted on
+                              cone_gid_list; the hot path for services
+                              calling this hundreds of times per second
+        debug               : run device-side bounds validation and print
+                              the init summary (implies the slow dict path)
 
     Returns (rise_mean, fall_mean, endpoint_dict) where rise/fall_mean are **local** tensors (size |cone|)
     and endpoint_dict maps *global gid* → arrival (mean+σ·std).
@@ -414,6 +2541,7 @@ def propagate_subgraph_collateral(
     device = sp_mean_tensor.device
     float_dtype = sp_mean_tensor.dtype
     sigma_tensor = torch.tensor([sigma], dtype=float_dtype, device=device)
+    temperature_tensor = torch.tensor([1.0], dtype=float_dtype, device=device)
 
     N = cone_gid_list.size(0)
     rise_mean = torch.zeros(N, dtype=float_dtype, device=device)
@@ -421,68 +2549,38 @@ def propagate_subgraph_collateral(
     fall_mean = torch.zeros(N, dtype=float_dtype, device=device)
     fall_std  = torch.zeros(N, dtype=float_dtype, device=device)
 
-    # CRITICAL: Validate all node IDs in the collateral are within bounds
-    max_allowed_idx = sp_mean_tensor.size(0) - 1
-    all_nodes = set()
-    
-    # Collect all node IDs from all levels
-    for lvl, content in level_2_collaterals.items():
-        if lvl == 1:
-            all_nodes.update(content.tolist())
-        elif isinstance(content, list) and len(content) > 0:
-            # Input pin levels
-            if isinstance(content[0], torch.Tensor):
-                all_nodes.update(content[0].tolist())
-            # Output pin levels - check multiple positions
-            if len(content) > 10 and isinstance(content[10], (list, torch.Tensor)):
-                if isinstance(content[10], torch.Tensor):
-                    all_nodes.update(content[10].tolist())
-                else:
-                    all_nodes.update(content[10])
-    
-    # Check for out of bounds nodes
-    invalid_nodes = [n for n in all_nodes if n > max_allowed_idx or n < 0]
-    if invalid_nodes:
-        print(f"\n[CRITICAL ERROR] Found {len(invalid_nodes)} invalid node IDs in collateral!")
-        print(f"  Max allowed index: {max_allowed_idx}")
-        print(f"  Invalid nodes sample: {sorted(invalid_nodes)[:10]}")
-        print(f"  This indicates a problem with subgraph merging!")
-        raise RuntimeError(f"Invalid node IDs found: min={min(invalid_nodes)}, max={max(invalid_nodes)}, allowed_max={max_allowed_idx}")
+    if debug:
+        # Device-side bounds validation: tensor min/max per level, no
+        # Python set materialization
+        max_allowed_idx = sp_mean_tensor.size(0) - 1
+        for lvl, content in level_2_collaterals.items():
+            nodes = content if lvl == 1 else content[0]
+            if not isinstance(nodes, torch.Tensor):
+                nodes = torch.tensor(nodes, dtype=torch.int64)
+            if nodes.numel() and (int(nodes.max()) > max_allowed_idx or int(nodes.min()) < 0):
+                raise RuntimeError(
+                    f"Invalid node IDs in level {lvl}: min={int(nodes.min())}, "
+                    f"max={int(nodes.max())}, allowed_max={max_allowed_idx}")
 
     # --- level-1 initialisation ----------------------------------
     lvl1_nodes: torch.Tensor = level_2_collaterals[1]
-    
-    # DEBUG: Check bounds before accessing
-    print(f"\n[SUBGRAPH INIT DEBUG]")
-    print(f"  Level-1 nodes: {len(lvl1_nodes)} nodes")
-    print(f"  sp_mean_tensor size: {sp_mean_tensor.size()}")
-    print(f"  Max node ID in lvl1: {lvl1_nodes.max().item() if lvl1_nodes.numel() > 0 else 'empty'}")
-    print(f"  Min node ID in lvl1: {lvl1_nodes.min().item() if lvl1_nodes.numel() > 0 else 'empty'}")
-    
-    # Check if any indices are out of bounds
-    if lvl1_nodes.numel() > 0:
-        max_allowed_idx = sp_mean_tensor.size(0) - 1
-        out_of_bounds = lvl1_nodes[lvl1_nodes > max_allowed_idx]
-        if out_of_bounds.numel() > 0:
-            print(f"  ERROR: {out_of_bounds.numel()} nodes have indices > {max_allowed_idx}")
-            print(f"  Out of bounds indices: {out_of_bounds[:5].tolist()}")
-            print(f"  This likely means the merging created invalid node IDs!")
-            # Don't access the tensor with invalid indices
-            valid_mask = lvl1_nodes <= max_allowed_idx
-            lvl1_nodes = lvl1_nodes[valid_mask]
-            print(f"  Filtered to {len(lvl1_nodes)} valid nodes")
-    
-    lvl1_local_idx = torch.tensor([gid2local_map[int(g)] for g in lvl1_nodes.tolist()],
-                                  dtype=torch.int64, device=device)
+
+    if validated and not debug:
+        # cone_gid_list is sorted, so local indices come from one device
+        # searchsorted instead of a Python dict walk
+        lvl1_local_idx = torch.searchsorted(cone_gid_list, lvl1_nodes)
+    else:
+        lvl1_local_idx = torch.tensor([gid2local_map[int(g)] for g in lvl1_nodes.tolist()],
+                                      dtype=torch.int64, device=device)
     lvl1_means = sp_mean_tensor[lvl1_nodes].to(device)
     lvl1_stds  = sp_std_tensor[lvl1_nodes].to(device)
     nan_mask = torch.isinf(lvl1_means)
     lvl1_means = torch.where(nan_mask, torch.zeros_like(lvl1_means), lvl1_means)
     lvl1_stds  = torch.where(nan_mask, torch.zeros_like(lvl1_stds), lvl1_stds)
 
-    print(f"  First few level-1 node GIDs: {lvl1_nodes[:5].tolist() if lvl1_nodes.numel() >= 5 else lvl1_nodes.tolist()}")
-    print(f"  Initialized to 0: {nan_mask.sum().item()} nodes")
-    print(f"  Non-zero initialization: {(~nan_mask).sum().item()} nodes")
+    if debug:
+        log_debug(f"[subgraph init] level-1 nodes: {len(lvl1_nodes)}, "
+                  f"zero-initialized: {int(nan_mask.sum())}")
 
     rise_mean.index_copy_(0, lvl1_local_idx, lvl1_means)
     fall_mean.index_copy_(0, lvl1_local_idx, lvl1_means)
@@ -516,9 +2614,9 @@ def propagate_subgraph_collateral(
 
         else:  # output-pin level (child pins)
             # Collateral layout (same as precompute_collaterals):
-            # 0 dup_nodes(list[int]), 1-6 rise/fall tensors, 7 senses, 8 p_indices(int32),
-            # 9 node_start_end(int32), 10 c_unique_indices(list[int]),
-            # 11 p_idx_unique(int32), 12 p_mapping(int32), 13 c_unique_indices(int64),
+            # 0 dup_nodes(int32), 1-6 rise/fall tensors, 7 senses, 8 p_indices(int32),
+            # 9 node_start_end(int32), 10/13 c_unique_indices(int64, same tensor),
+            # 11 p_idx_unique(int32), 12 p_mapping(int32),
             # 14 cellArc_ids(int32), 15 p_local_unique(int64), 16 c_unique_local(int64)
 
             (dup_nodes,
@@ -543,20 +2641,16 @@ def propagate_subgraph_collateral(
             p_fall_start = p_rise_start
 
             # Compute arrivals for child uniques via CUDA op
-            try:
-                (cur_rise_means, cur_rise_stds, _, _,
-                 cur_fall_means, cur_fall_stds, _, _) = \
-                    compute_arrival.ComputeArrivalPOCVWithGrad.apply(
-                        p_rise_means, p_rise_stds, p_rise_start,
-                        p_fall_means, p_fall_stds, p_fall_start,
-                        c_rise_means, c_rise_stds, c_rise_sigmas,
-                        c_fall_means, c_fall_stds, c_fall_sigmas,
-                        senses, node_se, sigma_tensor,
-                        p_indices, p_mapping,
-                        torch.tensor([1.0], dtype=float_dtype, device=device))
-            except Exception as e:
-                print(f"[propagate_subgraph_collateral] CUDA compute error: {e}")
-                import ipdb; ipdb.set_trace()
+            (cur_rise_means, cur_rise_stds, _, _,
+             cur_fall_means, cur_fall_stds, _, _) = \
+                compute_arrival.ComputeArrivalPOCVWithGrad.apply(
+                    p_rise_means, p_rise_stds, p_rise_start,
+                    p_fall_means, p_fall_stds, p_fall_start,
+                    c_rise_means, c_rise_stds, c_rise_sigmas,
+                    c_fall_means, c_fall_stds, c_fall_sigmas,
+                    senses, node_se, sigma_tensor,
+                    p_indices, p_mapping,
+                    temperature_tensor)
 
             # Update local tensors at child unique positions
             c_unique_idx = c_unique_local.to(torch.int64)
@@ -573,7 +2667,12 @@ def propagate_subgraph_collateral(
         end_globals = endpoint_globals
 
     # Vectorised endpoint calculation
-    end_idx_tensor = torch.tensor([gid2local_map[int(g)] for g in end_globals], dtype=torch.int64, device=device)
+    if validated and not debug:
+        end_global_tensor = (end_globals if isinstance(end_globals, torch.Tensor)
+                             else torch.tensor(list(end_globals), dtype=torch.int64, device=device))
+        end_idx_tensor = torch.searchsorted(cone_gid_list, end_global_tensor)
+    else:
+        end_idx_tensor = torch.tensor([gid2local_map[int(g)] for g in end_globals], dtype=torch.int64, device=device)
     rise_end = rise_mean[end_idx_tensor] + sigma*rise_std[end_idx_tensor]
     fall_end = fall_mean[end_idx_tensor] + sigma*fall_std[end_idx_tensor]
     combined  = torch.minimum(rise_end, fall_end)
@@ -594,10 +2693,32 @@ def propagate_subgraph_collateral(
 #       netArcId_2_inCellName, netArcId_2_outCellName, netArcKey_2_netArcId,
 #       netArcId_2_netArcKey, cone_gid_list, gid2local_map)
 #
-# These helpers assume the cones are node-disjoint – this is the normal case
-# after using `select_nonoverlapping_khop`. If overlap occurs we keep the first
-# occurrence and silently ignore subsequent duplicates.
+# Cones may overlap (placer move candidates routinely share fanout). Nodes
+# that appear in several cones with identical arc rows – and whose in-cone
+# ancestors are likewise identical – are provably cone-independent, so the
+# merge carries ONE copy of them (a shared pre-pass, see step 1b) and
+# redirects every other owner's references to it. Nodes downstream of a
+# cone's own patched arcs fail the row-equality test and keep strict
+# per-cone copies, preserving what-if isolation.
+
+class _IdentityGidMap(dict):
+    """Identity gid2local map for merged cones (synthetic idx == local idx).
+
+    The merge assigns synthetic gids densely, so materializing a real dict
+    of millions of identity entries is pure overhead; this answers every
+    lookup in O(1) without storing anything."""
 
+    def __getitem__(self, key):
+        return key
+
+    def get(self, key, default=None):
+        return key
+
+    def __contains__(self, key):
+        return True
+
+
+@py_scope('_merge_subgraph_collaterals')
 def _merge_subgraph_collaterals(
     subgraph_tuples: List[Tuple[Any, ...]],
     device: torch.device,
@@ -605,11 +2726,12 @@ def _merge_subgraph_collaterals(
 ):
     """High-throughput merge of many sub-graph collateral tuples.
 
-    The previous implementation called `torch.cat` inside the per-cone loop,
-    leading to O(N_cones) kernel launches *per tensor field*.  Here we buffer
-    every piece first and concatenate once, reducing launches to O(#levels).
-    In addition we vectorise gid-mapping with dense lookup tensors instead of
-    Python comprehensions.
+    All gid remapping is concat-plus-offset tensor arithmetic done on
+    device: each cone's sorted gid list maps originals to local indices
+    via searchsorted, and adding the cone's running node offset yields the
+    synthetic id. No dense (max_orig_gid+1) lookup tensor per cone, no
+    round trips through Python lists, and every field concatenates once
+    per level.
     """
 
     assert subgraph_tuples, "No subgraph tuples supplied"
@@ -617,39 +2739,204 @@ def _merge_subgraph_collaterals(
     # ------------------------------------------------------------------
     # 1.  Synthetic Gid assignment – ***STRICT per-cone uniqueness***
     # ------------------------------------------------------------------
-    # Requirement:
-    #   !!!  A node appearing in *different* cones with the same global Gid
-    #   !!!  MUST be treated as TWO *distinct* timing variables in the
-    #   !!!  merged collateral.
-    #   Therefore we generate an *individual* dense map for every cone and
-    #   never reuse synthetic IDs across cones.
-
-    new2orig: List[int] = []          # synthetic_gid -> original_gid
-    new2cone: List[int] = []          # synthetic_gid -> cone_idx
-    cone_old2new: List[torch.Tensor] = []  # per-cone dense mapping
+    # A node appearing in *different* cones with the same global Gid MUST
+    # be treated as TWO distinct timing variables in the merged collateral,
+    # so synthetic ids are never reused across cones: cone k's nodes map to
+    # [offset_k, offset_k + n_k) in cone-gid-list order.
 
-    max_orig_gid = max(int(tpl[-2].max()) for tpl in subgraph_tuples)
+    cone_gid_lists: List[torch.Tensor] = []
+    cone_offsets: List[int] = []
 
     next_gid = 0
-    for cone_idx, tpl in enumerate(subgraph_tuples):
-        cone_gids: torch.Tensor = tpl[-2].to(torch.int64)  # global gids (unique within cone)
-        n_nodes = cone_gids.numel()
+    for tpl in subgraph_tuples:
+        cone_gids = tpl[-2].to(torch.int64).to(device)  # sorted, unique within cone
+        cone_gid_lists.append(cone_gids)
+        cone_offsets.append(next_gid)
+        next_gid += cone_gids.numel()
 
-        # Build dense mapping for this cone -------------------------------
-        dense_map = torch.full((max_orig_gid + 1,), -1, dtype=torch.int32, device=device)
-        dense_map[cone_gids] = torch.arange(next_gid, next_gid + n_nodes, dtype=torch.int32, device=device)
-        cone_old2new.append(dense_map)
-
-        # Record synthetic ↔ metadata relations
-        new2orig.extend(cone_gids.tolist())
-        new2cone.extend([cone_idx] * n_nodes)
+    merged_cone_gid_list = torch.arange(next_gid, dtype=torch.int32, device=device)
+    gid2local = _IdentityGidMap()  # synthetic idx == local idx
+    new2orig_tensor = torch.cat(cone_gid_lists).to(torch.int32)
+    new2cone_tensor = torch.repeat_interleave(
+        torch.arange(len(subgraph_tuples), dtype=torch.int32, device=device),
+        torch.tensor([g.numel() for g in cone_gid_lists], dtype=torch.int64, device=device))
 
-        next_gid += n_nodes
+    # ------------------------------------------------------------------
+    # 1b. Overlap pre-pass – propagate provably shared nodes once
+    # ------------------------------------------------------------------
+    # A duplicated node is cone-independent iff its in-cone arc rows are
+    # bit-identical in every owning cone AND every parent is likewise
+    # shareable: its arrival is then the same number everywhere, so one
+    # copy (the first owner's) suffices and the other owners' references
+    # redirect to it. Row equality is checked with per-node multiset
+    # signatures over (parent, delays, sense, arc id); anything a cone's
+    # delay patches touched differs bitwise and stays per-cone, which is
+    # exactly the isolation what-if semantics require. Endpoint
+    # candidates are never shared so each cone keeps private endpoint
+    # ids for result routing.
+    # All per-node state lives in the COMPACT index space of the batch's
+    # sorted unique gid list — never in dense (max_orig_gid+1) planes, so
+    # a merge over a few-hundred-K-node batch on a 15M-gid design touches
+    # only batch-sized tensors.
+    all_orig = torch.cat(cone_gid_lists)
+    batch_uniq = torch.unique(all_orig)  # sorted
+    share_flag = None     # bool [U] over batch_uniq, True = one shared copy
+    canon = None          # int64 [U], shared gid -> canonical synthetic id
+    cone_remaps = [None] * len(subgraph_tuples)
+
+    def _cidx(gids: torch.Tensor) -> torch.Tensor:
+        """Original gids -> compact batch index (all gids are members)"""
+        return torch.searchsorted(batch_uniq, gids)
+
+    if all_orig.numel() != batch_uniq.numel():
+        num_uniq = batch_uniq.numel()
+        _MIX = -4658895080050727687  # odd 64-bit constant; int64 mul wraps
+
+        def _mix(v: torch.Tensor) -> torch.Tensor:
+            v = v * _MIX
+            return v ^ (v >> 29)
+
+        def _i64(plane) -> torch.Tensor:
+            t = plane if torch.is_tensor(plane) else torch.tensor(plane)
+            return t.to(device).to(torch.int64)
+
+        def _bits(plane) -> torch.Tensor:
+            """Float plane -> exact int64 bit pattern (via fp32)"""
+            t = plane if torch.is_tensor(plane) else torch.tensor(plane)
+            return t.to(device).to(torch.float32).contiguous() \
+                    .view(torch.int32).to(torch.int64)
+
+        ent_sig = [torch.zeros(g.numel(), dtype=torch.int64, device=device)
+                   for g in cone_gid_lists]
+        ent_cnt = [torch.zeros(g.numel(), dtype=torch.int64, device=device)
+                   for g in cone_gid_lists]
+        is_child = torch.zeros(num_uniq, dtype=torch.bool, device=device)
+        level_rows: Dict[int, Tuple[list, list]] = {}
+
+        for cone_idx, tpl in enumerate(subgraph_tuples):
+            cgids = cone_gid_lists[cone_idx]
+            for lvl, coll in tpl[0].items():
+                if lvl == 1:
+                    sp = _i64(coll)
+                    pos = torch.searchsorted(cgids, sp)
+                    ent_sig[cone_idx].index_add_(0, pos, torch.ones_like(pos))
+                    ent_cnt[cone_idx].index_add_(0, pos, torch.ones_like(pos))
+                    continue
+                if lvl % 2 == inPinMod:  # input-pin (net) level
+                    child, parent = _i64(coll[0]), _i64(coll[1])
+                    h = _mix(parent)
+                    for plane in coll[2:8]:
+                        h = _mix(h ^ _bits(plane))
+                    h = _mix(h ^ _i64(coll[8]))
+                else:                    # output-pin (cell) level
+                    child, parent = _i64(coll[0]), _i64(coll[8])
+                    h = _mix(parent)
+                    for plane in coll[1:7]:
+                        h = _mix(h ^ _bits(plane))
+                    h = _mix(h ^ _i64(coll[7]))
+                    h = _mix(h ^ _i64(coll[14]))
+                pos = torch.searchsorted(cgids, child)
+                ent_sig[cone_idx].index_add_(0, pos, h)
+                ent_cnt[cone_idx].index_add_(0, pos, torch.ones_like(pos))
+                child_ci, parent_ci = _cidx(child), _cidx(parent)
+                is_child[child_ci] = True
+                rows = level_rows.setdefault(lvl, ([], []))
+                rows[0].append(child_ci)
+                rows[1].append(parent_ci)
+
+        # rows equal across owners <=> per-gid signature/count extremes agree
+        all_ci = _cidx(all_orig)
+        dup_mask = torch.bincount(all_ci, minlength=num_uniq) > 1
+        sig_all, cnt_all = torch.cat(ent_sig), torch.cat(ent_cnt)
+        sig_min = torch.full((num_uniq,), torch.iinfo(torch.int64).max,
+                             dtype=torch.int64, device=device)
+        sig_max = torch.full((num_uniq,), torch.iinfo(torch.int64).min,
+                             dtype=torch.int64, device=device)
+        cnt_min, cnt_max = sig_min.clone(), sig_max.clone()
+        sig_min.index_reduce_(0, all_ci, sig_all, 'amin')
+        sig_max.index_reduce_(0, all_ci, sig_all, 'amax')
+        cnt_min.index_reduce_(0, all_ci, cnt_all, 'amin')
+        cnt_max.index_reduce_(0, all_ci, cnt_all, 'amax')
+        rows_equal = dup_mask & (sig_min == sig_max) & (cnt_min == cnt_max)
+
+        # Ancestor closure, levels ascending: startpoints and parent-only
+        # boundary nodes seed identically in every cone, children inherit
+        # the AND of their parents' flags
+        share_flag = rows_equal & ~is_child
+        tmp = torch.ones(num_uniq, dtype=torch.uint8, device=device)
+        for lvl in sorted(level_rows.keys()):
+            child = torch.cat(level_rows[lvl][0])
+            parent = torch.cat(level_rows[lvl][1])
+            cand = rows_equal[child]
+            if not bool(cand.any()):
+                continue
+            child_c, parent_c = child[cand], parent[cand]
+            tmp.index_fill_(0, child_c, 1)
+            tmp.index_reduce_(0, child_c,
+                              share_flag[parent_c].to(torch.uint8), 'amin')
+            share_flag[child_c] = tmp[child_c].bool()
+
+        # Never share a cone's endpoint candidates (same walk-back rule as
+        # the endpoint collection below, so this is a tight superset)
+        for cone_idx, tpl in enumerate(subgraph_tuples):
+            lvl2 = tpl[0]
+            for lvl in sorted(lvl2.keys(), reverse=True):
+                if lvl == 1:
+                    cand_ep = _i64(lvl2[lvl])
+                elif lvl % 2 == inPinMod:
+                    cand_ep = _i64(lvl2[lvl][0])
+                else:
+                    cand_ep = _i64(lvl2[lvl][10])
+                if cand_ep.numel() > 0:
+                    share_flag[_cidx(cand_ep)] = False
+                    break
 
-    merged_cone_gid_list = torch.arange(next_gid, dtype=torch.int32, device=device)
-    gid2local = {int(i): int(i) for i in merged_cone_gid_list.tolist()}  # identity (synthetic idx = local idx)
-    new2orig_tensor = torch.tensor(new2orig, dtype=torch.int32, device=device)
-    new2cone_tensor = torch.tensor(new2cone, dtype=torch.int32, device=device)
+        # Canonical id = first owner's synthetic slot; other owners remap
+        # their references onto it (their own slots stay unused)
+        canon = torch.full((num_uniq,), -1, dtype=torch.int64, device=device)
+        for cone_idx, cgids in enumerate(cone_gid_lists):
+            base = torch.arange(cgids.numel(), dtype=torch.int64,
+                                device=device) + cone_offsets[cone_idx]
+            ci = _cidx(cgids)
+            sh = share_flag[ci]
+            first = sh & (canon[ci] < 0)
+            canon[ci[first]] = base[first]
+            remap = base.clone()
+            remap[sh] = canon[ci[sh]]
+            cone_remaps[cone_idx] = remap
+        if not bool(share_flag.any()):
+            share_flag, canon = None, None
+            cone_remaps = [None] * len(subgraph_tuples)
+        else:
+            log_debug(f"[merge_subgraph_collaterals] overlap: "
+                      f"{int(dup_mask.sum())} duplicated gids, "
+                      f"{int(share_flag.sum())} propagated once via shared copies")
+
+    def _to_synthetic(cone_idx: int, gids) -> torch.Tensor:
+        """Original gids -> synthetic ids, via searchsorted on the cone's
+        sorted gid list plus the cone's offset (or the cone's remap when
+        the overlap pre-pass redirected shared nodes)"""
+        if not isinstance(gids, torch.Tensor):
+            gids = torch.tensor(gids, dtype=torch.int64, device=device)
+        gids = gids.to(torch.int64).to(device)
+        pos = torch.searchsorted(cone_gid_lists[cone_idx], gids)
+        if cone_remaps[cone_idx] is not None:
+            return cone_remaps[cone_idx][pos]
+        return pos + cone_offsets[cone_idx]
+
+    def _keep_rows(cone_idx: int, child_orig: torch.Tensor):
+        """Row keep-mask for a cone's arcs: shared children contribute
+        their rows only through their first owner. None = keep all."""
+        if canon is None:
+            return None
+        ci = _cidx(child_orig)
+        sh = share_flag[ci]
+        if not bool(sh.any()):
+            return None
+        lo = cone_offsets[cone_idx]
+        hi = lo + cone_gid_lists[cone_idx].numel()
+        own = (canon[ci] >= lo) & (canon[ci] < hi)
+        return ~sh | own
 
     # ------------------------------------------------------------------
     # 2.  Buffer per-level fields & collect per-cone endpoints
@@ -661,14 +2948,12 @@ def _merge_subgraph_collaterals(
     def push(level, key, tensor_or_list):
         buf[level][key].append(tensor_or_list)
 
-    # Accumulate original-gid endpoints for each cone
-    endpoints_global: List[int] = []
+    # Accumulate synthetic-gid endpoints for each cone
+    endpoints_global: List[torch.Tensor] = []
 
     for cone_idx, tpl in enumerate(subgraph_tuples):
         lvl2 = tpl[0]
-        # Per-cone dense mapping – ensures duplicate global Gids across
-        # cones receive *different* synthetic IDs.
-        mp_dense = cone_old2new[cone_idx]
+        cone_gids = cone_gid_lists[cone_idx]
 
         # Identify endpoints of this cone (its own last level) ------------
         max_lvl_cone = max(lvl2.keys())
@@ -692,10 +2977,13 @@ def _merge_subgraph_collaterals(
             assert len(preferred) > 0, f"Cone {cone_idx} has no endpoints at level {lvl}"
             return preferred if isinstance(preferred, torch.Tensor) else torch.tensor(preferred, dtype=torch.int64, device=device)
 
-        cone_endpoints_orig = _collect_endpoints(max_lvl_cone)
-
-        # Map original Gids to synthetic ones
-        cone_endpoints_syn = mp_dense[cone_endpoints_orig.to(torch.int64)].to(torch.int32)
+        def _endpoints_synthetic(lvl: int) -> torch.Tensor:
+            """Map a level's endpoint candidates to synthetic ids, dropping
+            any gid not actually present in this cone"""
+            orig = _collect_endpoints(lvl).to(torch.int64).to(device)
+            pos = torch.searchsorted(cone_gids, orig).clamp(max=cone_gids.numel() - 1)
+            valid = cone_gids[pos] == orig
+            return (pos[valid] + cone_offsets[cone_idx]).to(torch.int32)
 
         # ------------------------------------------------------------------
         # Robustness: ensure each cone contributes *at least* one endpoint.
@@ -704,52 +2992,85 @@ def _merge_subgraph_collaterals(
         # In that case we walk back towards level-1 until we hit a non-empty
         # candidate set.
         # ------------------------------------------------------------------
-        # Filter out unmapped (-1) ids before emptiness check
-        cone_endpoints_syn = cone_endpoints_syn[cone_endpoints_syn >= 0]
-
+        cone_endpoints_syn = _endpoints_synthetic(max_lvl_cone)
         if cone_endpoints_syn.numel() == 0:
             for lvl_fb in sorted((l for l in lvl2.keys() if l < max_lvl_cone), reverse=True):
-                cand_orig = _collect_endpoints(lvl_fb)
-                cand_syn = mp_dense[cand_orig.to(torch.int64)].to(torch.int32)
-                cand_syn = cand_syn[cand_syn >= 0]
+                cand_syn = _endpoints_synthetic(lvl_fb)
                 if cand_syn.numel() > 0:
                     cone_endpoints_syn = cand_syn
                     break
 
         # If still empty, emit warning and continue (cone will be ignored later)
         if cone_endpoints_syn.numel() == 0:
-            print(f"[merge_subgraph_collaterals] warning: cone {cone_idx} has no endpoints – it will be skipped")
+            log_warn(f"[merge_subgraph_collaterals] warning: cone {cone_idx} has no endpoints – it will be skipped")
         else:
-            endpoints_global.extend(cone_endpoints_syn.tolist())
+            endpoints_global.append(cone_endpoints_syn)
+
+        def _as_dev_i64(x) -> torch.Tensor:
+            x = x if torch.is_tensor(x) else torch.tensor(x, dtype=torch.int64)
+            return x.to(device=device, dtype=torch.int64)
+
+        def _filt(plane, keep):
+            """Row-filter a collateral plane (tolerating legacy lists)"""
+            plane = plane if torch.is_tensor(plane) else torch.tensor(plane)
+            return plane[keep.to(plane.device)]
 
         for lvl, coll in lvl2.items():
             if lvl == 1:
-                push(lvl, 'clk', mp_dense[coll.to(torch.int64)].to(torch.int64))
+                sp = _as_dev_i64(coll)
+                keep = _keep_rows(cone_idx, sp)
+                if keep is not None:
+                    sp = sp[keep]
+                push(lvl, 'clk', _to_synthetic(cone_idx, sp))
                 continue
 
             if lvl % 2 == inPinMod:  # input pin level
-                cur_nodes  = mp_dense[coll[0].to(torch.int64)].to(torch.int64)
-                parents    = mp_dense[coll[1].to(torch.int64)].to(torch.int64)
-
-                push(lvl, 'cur', cur_nodes)
-                push(lvl, 'par', parents)
-                for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
-                    push(lvl, tag, coll[2+idx])
-                push(lvl, 'net_ids', coll[8])   # python list, keep as list
+                child = _as_dev_i64(coll[0])
+                keep = _keep_rows(cone_idx, child)
+                if keep is None:
+                    push(lvl, 'cur', _to_synthetic(cone_idx, child))
+                    push(lvl, 'par', _to_synthetic(cone_idx, coll[1]))
+                    for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
+                        push(lvl, tag, coll[2+idx])
+                    push(lvl, 'net_ids', coll[8])   # int32 tensor (list on legacy caches)
+                else:
+                    push(lvl, 'cur', _to_synthetic(cone_idx, child[keep]))
+                    push(lvl, 'par', _to_synthetic(cone_idx, _filt(coll[1], keep)))
+                    for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
+                        push(lvl, tag, _filt(coll[2+idx], keep))
+                    push(lvl, 'net_ids', _filt(coll[8], keep))
             else:                   # output-pin (child) level
-                dup_nodes      = mp_dense[torch.tensor(coll[0], dtype=torch.int64, device=device)].tolist()
-                p_indices_m    = mp_dense[coll[8].to(torch.int64)].to(torch.int32)
-                c_unique_m     = mp_dense[torch.tensor(coll[10], dtype=torch.int64, device=device)].tolist()
-
-                # shift node_start_end later – store original + cone_idx for now
-                push(lvl, 'dup_nodes', dup_nodes)
-                for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
-                    push(lvl, tag, coll[1+idx])
-                push(lvl, 'senses', coll[7])
-                push(lvl, 'p_indices', p_indices_m)
-                push(lvl, 'node_se', (coll[9], cone_idx))
-                push(lvl, 'c_unique_list', c_unique_m)
-                push(lvl, 'cellArc_ids', coll[14])
+                child = _as_dev_i64(coll[0])
+                keep = _keep_rows(cone_idx, child)
+                if keep is None:
+                    push(lvl, 'dup_nodes', _to_synthetic(cone_idx, child))
+                    for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
+                        push(lvl, tag, coll[1+idx])
+                    push(lvl, 'senses', coll[7])
+                    push(lvl, 'p_indices', _to_synthetic(cone_idx, coll[8]).to(torch.int32))
+                    push(lvl, 'node_se', (coll[9], cone_idx))
+                    push(lvl, 'c_unique_list', _to_synthetic(cone_idx, coll[10]))
+                    push(lvl, 'cellArc_ids', coll[14])
+                else:
+                    # Dropping whole children keeps rows and the unique
+                    # child list consistent; node_start_end is rebuilt
+                    # from the surviving children's row counts
+                    push(lvl, 'dup_nodes', _to_synthetic(cone_idx, child[keep]))
+                    for idx, tag in enumerate(('rm','rs','rsig','fm','fs','fsig')):
+                        push(lvl, tag, _filt(coll[1+idx], keep))
+                    push(lvl, 'senses', _filt(coll[7], keep))
+                    push(lvl, 'p_indices',
+                         _to_synthetic(cone_idx, _filt(coll[8], keep)).to(torch.int32))
+                    cu = _as_dev_i64(coll[10])
+                    keep_c = _keep_rows(cone_idx, cu)
+                    se = _as_dev_i64(coll[9])
+                    cnts = (se[1:] - se[:-1])[keep_c]
+                    new_se = torch.cat([
+                        torch.zeros(1, dtype=torch.int64, device=device),
+                        torch.cumsum(cnts, 0)]).to(torch.int32)
+                    push(lvl, 'node_se', (new_se, cone_idx))
+                    push(lvl, 'c_unique_list', _to_synthetic(cone_idx, cu[keep_c]))
+                    push(lvl, 'cellArc_ids', _filt(coll[14], keep))
 
     # ------------------------------------------------------------------
     # 3.  Finalise each level (single concat per tensor field)
@@ -769,12 +3090,14 @@ def _merge_subgraph_collaterals(
             par_local = par.to(torch.int64)
 
             tensors_cat = [torch.cat(fields[tag]) for tag in ('rm','rs','rsig','fm','fs','fsig')]
-            net_ids = [nid for sub in fields['net_ids'] for nid in sub]
+            net_ids = torch.cat([
+                ids if torch.is_tensor(ids) else torch.tensor(ids, dtype=torch.int32)
+                for ids in fields['net_ids']])
 
             merged[lvl] = [cur, par, *tensors_cat, net_ids, cur_local, par_local]
         else:
             # Output-pin level ---------------------------------------------------------------
-            dup_nodes = [d for sub in fields['dup_nodes'] for d in sub]
+            dup_nodes = torch.cat(fields['dup_nodes'])
 
             c_rm, c_rs, c_rsig, c_fm, c_fs, c_fsig = [torch.cat(fields[tag]) for tag in
                                                       ('rm','rs','rsig','fm','fs','fsig')]
@@ -782,24 +3105,21 @@ def _merge_subgraph_collaterals(
             p_indices = torch.cat(fields['p_indices'])
 
             # Reconstruct node_start_end index array across cones.
-            # Each individual cone's `se` tensor has length (#unique_child + 1) and
-            # starts with 0.  For the merged cone we must preserve a single leading 0
-            # and then append the shifted slice[1:] of each subsequent cone.
-            # This guarantees:
-            #   len(node_se_shift) == len(c_unique_all) + 1
-            # which is required by the CUDA arrival kernel.
-            node_se_shift: List[int] = [0]
-            offset: int = 0
-            for se, _ in fields['node_se']:
-                # `se` is a 1-D tensor of shape (n_child_unique + 1,).  The final
-                # value equals n_child_unique for that cone.
-                se_int = se.to(torch.int32)
-                node_se_shift.extend((se_int[1:] + offset).tolist())
-                offset += int(se_int[-1].item())
-            node_se_shift = torch.tensor(node_se_shift, dtype=torch.int32, device=device)
-
-            c_unique_all = [u for sub in fields['c_unique_list'] for u in sub]
-            c_unique_tensor = torch.tensor(c_unique_all, dtype=torch.int64, device=device)
+            # Each individual cone's `se` tensor has length (#unique_child + 1)
+            # and starts with 0: keep a single leading 0 and append each
+            # cone's slice[1:] shifted by the running row count, so that
+            #   len(node_se_shift) == len(c_unique_tensor) + 1
+            # as the CUDA arrival kernel requires. Offsets stay device
+            # tensors, so no per-cone host sync.
+            ses = [se.to(torch.int32).to(device) for se, _ in fields['node_se']]
+            lasts = torch.stack([se[-1] for se in ses])
+            se_offsets = torch.cumsum(lasts, 0) - lasts
+            node_se_shift = torch.cat(
+                [torch.zeros(1, dtype=torch.int32, device=device)] +
+                [se[1:] + off for se, off in zip(ses, se_offsets)])
+
+            c_unique_tensor = torch.cat(fields['c_unique_list'])
+            c_unique_all = c_unique_tensor
 
             # parent uniqueness mapping
             uniq_par = torch.unique(p_indices, sorted=True)
@@ -823,7 +3143,8 @@ def _merge_subgraph_collaterals(
                            p_local_unique,
                            c_local_unique]
 
-    endpoints_tensor = torch.tensor(endpoints_global, dtype=torch.int32, device=device)
+    endpoints_tensor = (torch.cat(endpoints_global) if endpoints_global
+                        else torch.empty(0, dtype=torch.int32, device=device))
     return merged, merged_cone_gid_list, gid2local, new2orig_tensor, new2cone_tensor, endpoints_tensor
 
 
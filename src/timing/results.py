@@ -0,0 +1,91 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/results.py
+# @brief typed propagation result with lazy cached host views
+
+import torch
+from typing import Dict, Optional, Tuple
+
+
+def stamp_propagation(timing_tensors: Dict[str, torch.Tensor]) -> None:
+    """Bump the serial that marks a fresh propagation; PropagationResult
+    objects stamped with an older serial are stale and get replaced by
+    do_get_propagation_result"""
+    timing_tensors['_propagation_serial'] = \
+        timing_tensors.get('_propagation_serial', 0) + 1
+
+
+class PropagationResult:
+    """
+    Typed view over one propagation's timing planes
+
+    Reporting-side callers used to `.cpu()` whole gid-space planes on
+    every query, paying full-plane D2H transfers for fields they read
+    once — or only at endpoint rows. This object keeps the device
+    planes by reference and materializes host views lazily: each field
+    crosses PCIe at most once per propagation (cached on first access),
+    and the endpoint accessor slices to dest_node_tensor on device
+    first, so endpoint-level queries move kilobytes instead of planes.
+
+    A result is tied to the propagation serial that stamped it; run a
+    new sweep and do_get_propagation_result hands out a fresh object
+    with empty caches, so a cached host view can never show stale data.
+    """
+
+    def __init__(self, timing_tensors: Dict[str, torch.Tensor], wns, tns):
+        self._timing_tensors = timing_tensors
+        self._wns, self._tns = wns, tns
+        self.serial = timing_tensors.get('_propagation_serial', 0)
+        self._host_cache: Dict[str, torch.Tensor] = {}
+        self._endpoint_cache: Dict[str, torch.Tensor] = {}
+        self._wns_tns: Optional[Tuple[float, float]] = None
+
+    def device_tensor(self, key: str) -> torch.Tensor:
+        """The live device plane, no copy"""
+        return self._timing_tensors[key]
+
+    def host(self, key: str) -> torch.Tensor:
+        """
+        Full host copy of a plane, one D2H per field per propagation
+
+        Repeated reads (plot + csv + report over the same sweep) hit the
+        cache instead of re-crossing PCIe.
+        """
+        cached = self._host_cache.get(key)
+        if cached is None:
+            cached = self._timing_tensors[key].cpu()
+            self._host_cache[key] = cached
+        return cached
+
+    def endpoint(self, key: str) -> torch.Tensor:
+        """
+        Endpoint-sliced host view of a plane, aligned with
+        dest_node_tensor
+
+        The gather runs on device and only the endpoint rows transfer;
+        topK planes are reduced to the worst candidate ([:, 0]) first.
+        """
+        cached = self._endpoint_cache.get(key)
+        if cached is None:
+            dest = self._timing_tensors['dest_node_tensor'].to(torch.long)
+            plane = self._timing_tensors[key]
+            if plane.dim() > 1:
+                plane = plane[:, 0]
+            cached = plane.index_select(0, dest.to(plane.device)).cpu()
+            self._endpoint_cache[key] = cached
+        return cached
+
+    def wns_tns(self) -> Tuple[float, float]:
+        """(wns, tns) as Python floats — the only host sync this object
+        forces on the fused-slack path, and only on first call"""
+        if self._wns_tns is None:
+            self._wns_tns = (float(self._wns), float(self._tns))
+        return self._wns_tns
@@ -0,0 +1,394 @@
+# Copyright (c) 2025, NVIDIA CORPORATION & AFFILIATES.  All rights reserved.
+#
+# NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+# property and proprietary rights in and to this material, related
+# documentation and any modifications thereto. Any use, reproduction,
+# disclosure or distribution of this material and related documentation
+# without an express license agreement from NVIDIA CORPORATION or
+# its affiliates is strictly prohibited.
+#
+# @author Yi-Chen Lu
+# @file timing/verification.py
+# @brief golden-tensor differential harness for arrival-kernel changes
+
+import time
+import torch
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+# Kernel changes used to be hand-verified by correlating aes plus two
+# internal blocks — slow, and blind to shapes those designs never
+# produce. This harness generates randomized collateral fixtures
+# (property-based: fanin distributions, dangling/-inf parents, K widths),
+# runs a deliberately naive pure-torch golden propagator next to the
+# shipped kernel path, and asserts elementwise agreement on the worst
+# candidate per node plus reports the perf delta per fixture. The golden
+# path shares no code with cuda_ops/compute_arrival, so a bug has to
+# appear independently in both to slip through.
+
+_NEG_INF = float('-inf')
+
+
+def make_random_fixture(
+    num_arc_levels: int = 8,
+    width: int = 64,
+    max_fanin: int = 4,
+    phantom_fraction: float = 0.1,
+    delay_scale: float = 0.2,
+    seed: int = 0,
+    float_dtype: torch.dtype = torch.float32,
+    device: torch.device = torch.device('cpu'),
+    name: Optional[str] = None
+) -> Dict[str, Any]:
+    """
+    Random levelized collateral fixture in the live v2 layout
+
+    Levels alternate net (odd) and cell (even) above the level-1
+    startpoints, exactly as precompute_collaterals emits them. Fanin per
+    cell sink is uniform in [1, max_fanin]; phantom_fraction of parent
+    references point at gids no level ever writes, so every fixture
+    exercises the -inf/unreached handling that real dangling pins hit.
+    """
+    generator = torch.Generator().manual_seed(seed)
+
+    def _rand(*shape):
+        return torch.rand(*shape, generator=generator)
+
+    sp_nodes = torch.arange(width, dtype=torch.int64)
+    num_phantoms = max(1, int(width * phantom_fraction))
+    phantoms = torch.arange(width, width + num_phantoms, dtype=torch.int64)
+    next_gid = width + num_phantoms
+
+    def _sample_parents(pool: torch.Tensor, count: int) -> torch.Tensor:
+        picks = pool[torch.randint(pool.numel(), (count,), generator=generator)]
+        if phantom_fraction > 0:
+            use_phantom = _rand(count) < phantom_fraction
+            phantom_picks = phantoms[torch.randint(
+                phantoms.numel(), (count,), generator=generator)]
+            picks = torch.where(use_phantom, phantom_picks, picks)
+        return picks
+
+    def _delays(count: int) -> Tuple[torch.Tensor, ...]:
+        means = (0.05 + _rand(count) * delay_scale).to(float_dtype)
+        stds = (0.002 + _rand(count) * delay_scale * 0.1).to(float_dtype)
+        return means, stds
+
+    level_2_collaterals: Dict[int, Any] = {1: sp_nodes.to(device)}
+    prev_gids = sp_nodes
+    net_arc_count = cell_arc_count = 0
+    level = 3
+    for _ in range(num_arc_levels):
+        sinks = torch.arange(next_gid, next_gid + width, dtype=torch.int64)
+        next_gid += width
+        if level % 2 == 1: # net level: one driver per input pin
+            parents = _sample_parents(prev_gids, width)
+            rise_means, rise_stds = _delays(width)
+            fall_means, fall_stds = _delays(width)
+            arc_ids = torch.arange(net_arc_count, net_arc_count + width,
+                                   dtype=torch.int64)
+            net_arc_count += width
+            level_2_collaterals[level] = [
+                sinks.to(device), parents.to(device),
+                rise_means.to(device), rise_stds.to(device),
+                torch.add(rise_means, rise_stds, alpha=3.0).to(device),
+                fall_means.to(device), fall_stds.to(device),
+                torch.add(fall_means, fall_stds, alpha=3.0).to(device),
+                arc_ids.to(device)
+            ]
+        else: # cell level: ragged fanin segments per sink
+            fanins = torch.randint(1, max_fanin + 1, (width,),
+                                   generator=generator)
+            num_rows = int(fanins.sum())
+            dup_sinks = torch.repeat_interleave(sinks, fanins)
+            parents = _sample_parents(prev_gids, num_rows)
+            node_start_end = torch.zeros(width + 1, dtype=torch.int64)
+            node_start_end[1:] = torch.cumsum(fanins, dim=0)
+            senses = torch.randint(0, 2, (num_rows,), generator=generator,
+                                   dtype=torch.int32)
+            rise_means, rise_stds = _delays(num_rows)
+            fall_means, fall_stds = _delays(num_rows)
+            p_idx_unique = torch.unique(parents)
+            p_mapping = torch.full((int(p_idx_unique.max()) + 1,), -1,
+                                   dtype=torch.int64)
+            p_mapping[p_idx_unique] = torch.arange(p_idx_unique.numel(),
+                                                   dtype=torch.int64)
+            arc_ids = torch.arange(cell_arc_count, cell_arc_count + num_rows,
+                                   dtype=torch.int64)
+            cell_arc_count += num_rows
+            c_unique_tensor = sinks.to(device)
+            level_2_collaterals[level] = [
+                dup_sinks.to(torch.int32).to(device),
+                rise_means.to(device), rise_stds.to(device),
+                torch.add(rise_means, rise_stds, alpha=3.0).to(device),
+                fall_means.to(device), fall_stds.to(device),
+                torch.add(fall_means, fall_stds, alpha=3.0).to(device),
+                senses.to(device),
+                parents.to(torch.int32).to(device),
+                node_start_end.to(torch.int32).to(device),
+                c_unique_tensor,
+                p_idx_unique.to(torch.int32).to(device),
+                p_mapping.to(torch.int32).to(device),
+                c_unique_tensor,
+                arc_ids.to(torch.int32).to(device)
+            ]
+        prev_gids = sinks
+        level += 1
+
+    num_nodes = next_gid
+    sp_mean_tensor = torch.zeros(num_nodes, dtype=float_dtype)
+    sp_std_tensor = torch.zeros(num_nodes, dtype=float_dtype)
+    sp_mean_tensor[sp_nodes] = (_rand(width) * 0.1).to(float_dtype)
+    sp_std_tensor[sp_nodes] = (_rand(width) * 0.01).to(float_dtype)
+
+    inPin_parent_tensor = torch.full((num_nodes,), -1, dtype=torch.int64)
+    for lvl, coll in level_2_collaterals.items():
+        if lvl != 1 and lvl % 2 == 1:
+            inPin_parent_tensor[coll[0].cpu()] = coll[1].cpu()
+
+    valid_sps = torch.zeros(num_nodes, dtype=torch.bool)
+    valid_sps[sp_nodes] = True
+
+    return {
+        'name': name or f'seed{seed}_L{num_arc_levels}_W{width}_F{max_fanin}',
+        'level_2_collaterals': level_2_collaterals,
+        'sp_mean_tensor': sp_mean_tensor.to(device),
+        'sp_std_tensor': sp_std_tensor.to(device),
+        'inPin_parent_tensor': inPin_parent_tensor.to(device),
+        'valid_sps': valid_sps.to(device),
+        'num_nodes': num_nodes,
+        'float_dtype': float_dtype,
+        'device': device
+    }
+
+
+def golden_arrival_reference(fixture: Dict[str, Any],
+                             sigma: float = 3.0) -> Dict[str, torch.Tensor]:
+    """
+    Naive worst-candidate POCV propagation, independent of the kernels
+
+    Walks the levels with plain per-level torch ops: delay add, RSS std,
+    worst candidate by mean + sigma * std, sense-swapped sources on cell
+    arcs, -inf parents excluded. Everything computes in float64 so the
+    golden values carry no accumulation error of their own. Returns the
+    worst-1 planes plus the reached mask; K-wide kernel runs compare
+    their leading candidate against these.
+    """
+    num_nodes = fixture['num_nodes']
+    device = fixture['device']
+    rise_mean = torch.full((num_nodes,), _NEG_INF, dtype=torch.float64, device=device)
+    rise_std = torch.zeros(num_nodes, dtype=torch.float64, device=device)
+    fall_mean = torch.full((num_nodes,), _NEG_INF, dtype=torch.float64, device=device)
+    fall_std = torch.zeros(num_nodes, dtype=torch.float64, device=device)
+
+    for level in sorted(fixture['level_2_collaterals'].keys()):
+        coll = fixture['level_2_collaterals'][level]
+        if level == 1:
+            sps = coll.to(torch.int64)
+            rise_mean[sps] = fixture['sp_mean_tensor'][sps].to(torch.float64)
+            rise_std[sps] = fixture['sp_std_tensor'][sps].to(torch.float64)
+            fall_mean[sps] = rise_mean[sps]
+            fall_std[sps] = rise_std[sps]
+        elif level % 2 == 1: # net arcs
+            sinks = coll[0].to(torch.int64)
+            parents = coll[1].to(torch.int64)
+            for mean_plane, std_plane, arc_mean, arc_std in (
+                    (rise_mean, rise_std, coll[2], coll[3]),
+                    (fall_mean, fall_std, coll[5], coll[6])):
+                src_mean = mean_plane[parents]
+                src_std = std_plane[parents]
+                reached = torch.isfinite(src_mean)
+                mean_plane[sinks] = torch.where(
+                    reached, src_mean + arc_mean.to(torch.float64),
+                    torch.full_like(src_mean, _NEG_INF))
+                std_plane[sinks] = torch.where(
+                    reached,
+                    torch.sqrt(src_std.pow(2) + arc_std.to(torch.float64).pow(2)),
+                    torch.zeros_like(src_std))
+        else: # cell arcs
+            dup_sinks = coll[0].to(torch.int64)
+            parents = coll[8].to(torch.int64)
+            negative = coll[7].to(torch.bool)
+            for out_mean, out_std, src_a, src_a_std, src_b, src_b_std, \
+                    arc_mean, arc_std in (
+                    (rise_mean, rise_std, rise_mean, rise_std,
+                     fall_mean, fall_std, coll[1], coll[2]),
+                    (fall_mean, fall_std, fall_mean, fall_std,
+                     rise_mean, rise_std, coll[4], coll[5])):
+                src_mean = torch.where(negative, src_b[parents], src_a[parents])
+                src_std = torch.where(negative, src_b_std[parents], src_a_std[parents])
+                reached = torch.isfinite(src_mean)
+                cand_mean = src_mean + arc_mean.to(torch.float64)
+                cand_std = torch.sqrt(src_std.pow(2)
+                                      + arc_std.to(torch.float64).pow(2))
+                cand_arr = torch.where(reached, cand_mean + sigma * cand_std,
+                                       torch.full_like(cand_mean, _NEG_INF))
+                best_arr = torch.full((num_nodes,), _NEG_INF,
+                                      dtype=torch.float64, device=device)
+                best_arr.scatter_reduce_(0, dup_sinks, cand_arr, 'amax')
+                winner = torch.isfinite(cand_arr) & (cand_arr == best_arr[dup_sinks])
+                neg_inf = torch.full_like(cand_mean, _NEG_INF)
+                out_mean.scatter_reduce_(
+                    0, dup_sinks, torch.where(winner, cand_mean, neg_inf), 'amax')
+                picked_std = torch.where(winner, cand_std, neg_inf)
+                std_best = torch.full((num_nodes,), _NEG_INF,
+                                      dtype=torch.float64, device=device)
+                std_best.scatter_reduce_(0, dup_sinks, picked_std, 'amax')
+                touched = torch.zeros(num_nodes, dtype=torch.bool, device=device)
+                touched[dup_sinks[winner]] = True
+                out_std[touched] = std_best[touched]
+
+    reached = torch.isfinite(rise_mean) | torch.isfinite(fall_mean)
+    return {
+        'rise_mean': rise_mean, 'rise_std': rise_std,
+        'fall_mean': fall_mean, 'fall_std': fall_std,
+        'rise_arrival': rise_mean + sigma * rise_std,
+        'fall_arrival': fall_mean + sigma * fall_std,
+        'reached': reached
+    }
+
+
+def run_kernel_fixture(fixture: Dict[str, Any], topk: int = 1,
+                       sigma: float = 3.0,
+                       deterministic: bool = False) -> Dict[str, Any]:
+    """
+    Run the shipped arrival path (cuda_arrival_propagate_pocv) over a
+    fixture into freshly allocated planes; returns the planes plus wall
+    seconds. deterministic=True forces the torch formulation even on
+    GPU, which is how the fused kernel and its fallback get compared
+    against each other.
+    """
+    from .cuda_ops import cuda_arrival_propagate_pocv
+
+    num_nodes = fixture['num_nodes']
+    device = fixture['device']
+    float_dtype = fixture['float_dtype']
+    shape = (num_nodes,) if topk == 1 else (num_nodes, topk)
+    planes = {name: torch.full(shape, _NEG_INF, dtype=float_dtype, device=device)
+              for name in ('rise_arrival', 'rise_mean', 'rise_std',
+                           'fall_arrival', 'fall_mean', 'fall_std')}
+    sps = {name: torch.full(shape, -1, dtype=torch.int32, device=device)
+           for name in ('rise_sps', 'fall_sps')}
+
+    if str(device).startswith('cuda'):
+        torch.cuda.synchronize(device)
+    start_time = time.time()
+    cuda_arrival_propagate_pocv(
+        fixture['sp_mean_tensor'], fixture['sp_std_tensor'],
+        fixture['level_2_collaterals'],
+        fixture['inPin_parent_tensor'],
+        device, num_nodes,
+        planes['rise_arrival'], planes['rise_mean'], planes['rise_std'],
+        sps['rise_sps'],
+        planes['fall_arrival'], planes['fall_mean'], planes['fall_std'],
+        sps['fall_sps'],
+        float_dtype, fixture['valid_sps'],
+        sigma=sigma, log=False, topK=topk,
+        deterministic=deterministic
+    )
+    if str(device).startswith('cuda'):
+        torch.cuda.synchronize(device)
+    planes['seconds'] = time.time() - start_time
+    return planes
+
+
+def _worst(plane: torch.Tensor) -> torch.Tensor:
+    return plane[:, 0] if plane.dim() > 1 else plane
+
+
+def compare_against_golden(golden: Dict[str, torch.Tensor],
+                           planes: Dict[str, Any],
+                           atol: float = 1e-4,
+                           rtol: float = 1e-4) -> Dict[str, float]:
+    """
+    Elementwise agreement of a kernel run's worst candidate vs the
+    golden planes. Returns per-plane max abs error over reached nodes
+    and the count of reachability disagreements; raises AssertionError
+    on the first plane out of tolerance.
+    """
+    reached = golden['reached']
+    report = {}
+    kernel_reached = torch.isfinite(_worst(planes['rise_mean'])) \
+        | torch.isfinite(_worst(planes['fall_mean']))
+    report['reachability_mismatches'] = int((kernel_reached != reached).sum())
+    assert report['reachability_mismatches'] == 0, \
+        f"kernel and golden disagree on {report['reachability_mismatches']} " \
+        f"reached nodes"
+    for name in ('rise_mean', 'rise_std', 'fall_mean', 'fall_std',
+                 'rise_arrival', 'fall_arrival'):
+        got = _worst(planes[name]).to(torch.float64)[reached]
+        want = golden[name][reached]
+        finite = torch.isfinite(want)
+        err = (got[finite] - want[finite]).abs()
+        bound = atol + rtol * want[finite].abs()
+        report[f'{name}_max_err'] = float(err.max()) if err.numel() else 0.0
+        assert bool((err <= bound).all()), \
+            f"{name} out of tolerance: max err {float(err.max()):.3e} " \
+            f"(atol {atol:g}, rtol {rtol:g})"
+    return report
+
+
+def default_fixtures(device: torch.device = torch.device('cpu'),
+                     float_dtype: torch.dtype = torch.float32) -> List[Dict[str, Any]]:
+    """The property sweep: shapes and edge cases a kernel change must survive"""
+    specs = [
+        dict(seed=0), # baseline
+        dict(seed=1, max_fanin=16, width=32), # heavy fanin segments
+        dict(seed=2, max_fanin=1, num_arc_levels=24), # deep serial chains
+        dict(seed=3, phantom_fraction=0.5), # -inf/dangling heavy
+        dict(seed=4, width=1, num_arc_levels=4), # degenerate single-pin levels
+        dict(seed=5, width=512, num_arc_levels=4), # wide shallow
+        dict(seed=6, delay_scale=0.0), # tie-heavy (equal delays)
+    ]
+    return [make_random_fixture(device=device, float_dtype=float_dtype, **spec)
+            for spec in specs]
+
+
+def run_differential_harness(
+    candidate_fn: Optional[Callable] = None,
+    baseline_fn: Optional[Callable] = None,
+    fixtures: Optional[List[Dict[str, Any]]] = None,
+    topk_values: Tuple[int, ...] = (1, 8),
+    sigma: float = 3.0,
+    atol: float = 1e-4,
+    rtol: float = 1e-4,
+    log: bool = True
+) -> List[Dict[str, Any]]:
+    """
+    Differential check of an arrival path against the golden reference
+
+    candidate_fn(fixture, topk, sigma) defaults to the shipped kernel
+    path; pass a wrapper around a modified path to vet kernel work
+    before it lands. When baseline_fn is also given, both run over
+    every fixture and the perf delta is reported candidate vs baseline
+    (correctness is still judged against the golden planes, never
+    baseline vs candidate — two paths sharing a bug should both fail).
+    Raises AssertionError on the first disagreement; returns the
+    per-fixture report rows.
+    """
+    candidate_fn = candidate_fn or run_kernel_fixture
+    reports = []
+    for fixture in (fixtures if fixtures is not None else default_fixtures()):
+        golden = golden_arrival_reference(fixture, sigma=sigma)
+        for topk in topk_values:
+            planes = candidate_fn(fixture, topk=topk, sigma=sigma)
+            row = {'fixture': fixture['name'], 'topk': topk,
+                   'candidate_s': planes['seconds']}
+            row.update(compare_against_golden(golden, planes,
+                                              atol=atol, rtol=rtol))
+            if baseline_fn is not None:
+                base = baseline_fn(fixture, topk=topk, sigma=sigma)
+                compare_against_golden(golden, base, atol=atol, rtol=rtol)
+                row['baseline_s'] = base['seconds']
+                row['speedup'] = base['seconds'] / max(planes['seconds'], 1e-12)
+            reports.append(row)
+            if log:
+                worst_err = max(value for key, value in row.items()
+                                if key.endswith('_max_err'))
+                line = f"[diff harness] {row['fixture']} K={topk}: " \
+                       f"max|err| {worst_err:.2e}, {row['candidate_s'] * 1e3:.2f} ms"
+                if 'speedup' in row:
+                    line += f" ({row['speedup']:.2f}x vs baseline)"
+                print(line)
+    if log:
+        print(f'[diff harness] {len(reports)} fixture runs agreed with the '
+              f'golden reference')
+    return reports